@@ -249,6 +249,35 @@ typedef struct __attribute__ ((packed)) { //vsd_s
    //Additional bytes may be present, but the HDMI spec says they shall be zero.
 } vsd_hdmi14_t;
 
+//VSD: HDMI Forum: HF-VSDB, IEEE OUI C4-5D-D8 (HDMI 2.1)
+typedef struct __attribute__ ((packed)) { //vsd_hf_s
+   u8_t   ieee_id[3]; //1-3: IEEE OUI
+   u8_t   version;    //4  : version (1)
+   u8_t   max_tmds;   //5  : Max_TMDS_Character_Rate / 5MHz, 0: <= 340MHz
+   u8_t   feat_scdc;  //6  : SCDC_Present, RR_Capable, CABLE_STATUS, CCBPCI, LTE_340Mcsc_scramble, 3D
+   u8_t   frl_dc420;  //7  : Max_FRL_Rate (7-4), UHD_VIC, DC_48/36/30bit_420
+   u8_t   feat_vrr;   //8  : (opt) FAPA_End_Extended, QMS, M_delta, CinemaVRR, CNMVRR, FVA, ALLM, FAPA_start
+   u8_t   vrr_min;    //9  : (opt) VRRmax bits 9-8 (7-6), VRRmin (5-0)
+   u8_t   vrr_max;    //10 : (opt) VRRmax bits 7-0
+   u8_t   feat_dsc;   //11 : (opt) DSC_1p2, DSC_Native_420, QMS_TFRmax, QMS_TFRmin, DSC_All_bpp, DSC_16/12/10bpc
+   u8_t   dsc_frl;    //12 : (opt) DSC_Max_FRL_Rate (7-4), DSC_Max_Slices (3-0)
+   u8_t   dsc_chunk;  //13 : (opt) DSC_TotalChunkKBytes (5-0)
+} vsd_hf_t;
+
+//VSD: AMD FreeSync, IEEE OUI 00-00-1A
+//NOTE: no public spec, the layout is reverse-engineered from existing EDIDs.
+typedef struct __attribute__ ((packed)) { //vsd_amd_s
+   u8_t   ieee_id[3]; //1-3 : IEEE OUI
+   u8_t   ver_major;  //4   : version
+   u8_t   ver_minor;  //5
+   u8_t   min_refr;   //6   : minimum refresh rate, Hz
+   u8_t   max_refr;   //7   : maximum refresh rate, Hz
+   u8_t   flags_1x;   //8   : FreeSync 1.x flags, 0xE6 mask: MCCS is used to switch the range
+   u8_t   flags_2x;   //9   : (opt) FreeSync 2.x flags
+   u8_t   max_lum;    //10  : (opt) max luminance, code value
+   u8_t   min_lum;    //11  : (opt) min luminance, code value
+} vsd_amd_t;
+
 //SAB: Speaker Allocation Block: bit val. 1 means "present"
 //     Field naming convention used after CTA-861-G
 typedef struct __attribute__ ((packed)) { //spm0_s
@@ -66,6 +66,20 @@ typedef struct __attribute__ ((packed)) { //vsd_s
    //payload (ethdr.ehdr.hdr.tag.blk_len - 4) bytes, max 27
 } vs_vadb_t;
 
+//VSVD: Dolby Vision, IEEE OUI 00-D0-46
+//NOTE: only the 1st payload byte is common for all the VSVDB versions.
+typedef struct __attribute__ ((packed)) { //vsvd_dovi_s
+   u8_t  ieee_id[3]; //2-4: IEEE OUI
+   u8_t  ver_flags;  //5  : version (7-5), version-specific (4-2), 2160p60/backlight ctrl (1), YUV422_12bit (0)
+   //payload: version-specific
+} vsvd_dovi_t;
+
+//VSVD: HDR10+, IEEE OUI 90-84-8B
+typedef struct __attribute__ ((packed)) { //vsvd_hdr10p_s
+   u8_t  ieee_id[3]; //2-4: IEEE OUI
+   u8_t  app_ver;    //5  : Peak_Lum_Idx (7-4), FF_Peak_Lum_Idx (3-2), Application_Version (1-0)
+} vsvd_hdr10p_t;
+
 //VDDD: VESA Display Device Data Block (DBC_EXT_VDDD = 2)
 typedef struct __attribute__ ((packed)) { //byte 2
    uint  n_lanes   :4; //number of lanes/channels
@@ -52,14 +52,6 @@ extern const gpfld_dsc_t SAB_SPM_fields;
 const char  cea_vcdb_cl::Desc[] =
 "VCDB is used to declare display capability to overscan/underscan and the quantization range.";
 
-const gpfld_dsc_t cea_vcdb_cl::fields = {
-   .flags    = 0,
-   .fcount   = 5,
-   .dat_sz   = 1,
-   .inst_cnt = 1,
-   .fields   = cea_vcdb_cl::fld_dsc
-};
-
 const edi_field_t cea_vcdb_cl::fld_dsc[] = {
    //VCDB data
    {&EDID_cl::BitF8Val, NULL, 2, 0, 2, EF_BFLD|EF_INT, 0, 3, "S_CE01",
@@ -74,6 +66,16 @@ const edi_field_t cea_vcdb_cl::fld_dsc[] = {
    "Quantization Range:\n1= selectable via AVI YQ (YCC only), 0= no data" }
 };
 
+const gpfld_dsc_t cea_vcdb_cl::fields = {
+   .flags    = 0,
+   .fcount   = dsc_count(cea_vcdb_cl::fld_dsc),
+   .dat_sz   = 1,
+   .inst_cnt = 1,
+   .fields   = cea_vcdb_cl::fld_dsc
+};
+
+static gpflat_lay_t *VCDB_layout[32];
+
 const gpflat_dsc_t cea_vcdb_cl::VCDB_grp = {
    .CodN     = "VCDB",
    .Name     = "Video Capability Data Block",
@@ -82,11 +84,12 @@ const gpflat_dsc_t cea_vcdb_cl::VCDB_grp = {
    .flags    = 0,
    .min_len  = 2,
    .max_len  = 2,
-   .max_fld  = (32 - sizeof(vcdb_t) - sizeof(ethdr_t) + 5),
+   .max_fld  = (32 - sizeof(vcdb_t) - sizeof(ethdr_t) + 5 + CEA_EXTHDR_FCNT),
    .hdr_fcnt = CEA_EXTHDR_FCNT,
    .hdr_sz   = sizeof(ethdr_t),
    .fld_arsz = 1,
-   .fld_ar   = &fields
+   .fld_ar   = &fields,
+   .layout   = VCDB_layout
 };
 
 rcode cea_vcdb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
@@ -97,7 +100,7 @@ rcode cea_vcdb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 }
 
 //VSVD: Vendor-Specific Video Data Block (DBC_EXT_VSVD =  1)
-const char cea_vsvd_cl::Desc[] = "Vendor-Specific Video Data Block: undefined data.";
+const char cea_vsvd_cl::Desc[] = "Vendor-Specific Video Data Block: the IEEE-OUI is not known to wxEDID, the payload is shown as unknown bytes.";
 
 //fields shared with VSAD
 static const edi_field_t fld_dsc[] = {
@@ -108,12 +111,14 @@ static const edi_field_t fld_dsc[] = {
 
 static const gpfld_dsc_t VSVD_VSAD_fields = {
    .flags    = 0,
-   .fcount   = 1,
+   .fcount   = dsc_count(fld_dsc),
    .dat_sz   = 3,
    .inst_cnt = 1,
    .fields   = fld_dsc
 };
 
+static gpflat_lay_t *VSVD_layout[32];
+
 const gpflat_dsc_t cea_vsvd_cl::VSVD_grp = {
    .CodN     = "VSVD",
    .Name     = "Vendor-Specific Video Data Block",
@@ -122,17 +127,152 @@ const gpflat_dsc_t cea_vsvd_cl::VSVD_grp = {
    .flags    = 0,
    .min_len  = (sizeof(vs_vadb_t) +1),
    .max_len  = 31,
-   .max_fld  = (32 - sizeof(vs_vadb_t) - sizeof(ethdr_t) + 1),
+   .max_fld  = (32 - sizeof(vs_vadb_t) - sizeof(ethdr_t) + 1 + CEA_EXTHDR_FCNT),
    .hdr_fcnt = CEA_EXTHDR_FCNT,
    .hdr_sz   = sizeof(ethdr_t),
    .fld_arsz = 1,
-   .fld_ar   = &VSVD_VSAD_fields
+   .fld_ar   = &VSVD_VSAD_fields,
+   .layout   = VSVD_layout
+};
+
+//VSVD: Dolby Vision
+const char cea_vsvd_cl::DoVi_Desc[] =
+"Dolby Vision Vendor-Specific Video Data Block, IEEE-OUI 00-D0-46.\n"
+"Only the first payload byte is decoded: the layout of the following bytes depends on the version.";
+
+const edi_field_t cea_vsvd_cl::dovi_fld_dsc[] = {
+   {&EDID_cl::ByteStr, NULL, offsetof(vsvd_dovi_t, ieee_id)+2, 0, 3, EF_STR|EF_HEX|EF_LE|EF_RD, 0, 0xFFFFFF, "IEEE-OUI",
+   "IEEE OUI (Organizationally Unique Identifier)" },
+   {&EDID_cl::BitVal, NULL, offsetof(vsvd_dovi_t, ver_flags)+2, 0, 1, EF_BIT, 0, 1, "YUV422_12bit",
+   "YCbCr 4:2:2 12bit mode is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsvd_dovi_t, ver_flags)+2, 1, 1, EF_BIT, 0, 1, "2160p60",
+   "Version 0, 1: 3840x2160@60Hz is supported.\n"
+   "Version 2: backlight control is supported." },
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsvd_dovi_t, ver_flags)+2, 2, 3, EF_BFLD|EF_INT, 0, 0x07, "ver_spec",
+   "Version-specific bits" },
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsvd_dovi_t, ver_flags)+2, 5, 3, EF_BFLD|EF_INT, 0, 0x07, "Version",
+   "Dolby Vision VSVD version" }
+};
+
+const gpfld_dsc_t cea_vsvd_cl::dovi_fld_grp[] = {
+   { //dovi_oui
+      .flags    = 0,
+      .fcount   = 1,
+      .dat_sz   = 3,
+      .inst_cnt = 1,
+      .fields   = cea_vsvd_cl::dovi_fld_dsc
+   },
+   { //dovi_ver
+      .flags    = 0,
+      .fcount   = (dsc_count(cea_vsvd_cl::dovi_fld_dsc) -1),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = &cea_vsvd_cl::dovi_fld_dsc[1]
+   }
 };
 
+static gpflat_lay_t *VSVD_DoVi_layout[32];
+
+const gpflat_dsc_t cea_vsvd_cl::VSVD_DoVi_grp = {
+   .CodN     = "VSVD",
+   .Name     = "Vendor-Specific Video Data Block: Dolby Vision",
+   .Desc     = DoVi_Desc,
+   .type_id  = ID_VSVD,
+   .flags    = TG_FLEX_LAYOUT,
+   .min_len  = (sizeof(vsvd_dovi_t) +1),
+   .max_len  = 31,
+   .max_fld  = (32 - sizeof(vsvd_dovi_t) - sizeof(ethdr_t) + dsc_count(cea_vsvd_cl::dovi_fld_dsc) + CEA_EXTHDR_FCNT),
+   .hdr_fcnt = CEA_EXTHDR_FCNT,
+   .hdr_sz   = sizeof(ethdr_t),
+   .fld_arsz = dsc_count(cea_vsvd_cl::dovi_fld_grp),
+   .fld_ar   = cea_vsvd_cl::dovi_fld_grp,
+   .layout   = VSVD_DoVi_layout
+};
+
+//VSVD: HDR10+
+const char cea_vsvd_cl::HDR10P_Desc[] =
+"HDR10+ Vendor-Specific Video Data Block, IEEE-OUI 90-84-8B.\n"
+"Defined by HDMI 2.1 Amendment A1: dynamic HDR metadata support.";
+
+const edi_field_t cea_vsvd_cl::hdr10p_fld_dsc[] = {
+   {&EDID_cl::ByteStr, NULL, offsetof(vsvd_hdr10p_t, ieee_id)+2, 0, 3, EF_STR|EF_HEX|EF_LE|EF_RD, 0, 0xFFFFFF, "IEEE-OUI",
+   "IEEE OUI (Organizationally Unique Identifier)" },
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsvd_hdr10p_t, app_ver)+2, 0, 2, EF_BFLD|EF_INT, 0, 0x03, "Application_Version",
+   "HDR10+ application version" },
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsvd_hdr10p_t, app_ver)+2, 2, 2, EF_BFLD|EF_INT, 0, 0x03, "FF_Peak_Lum_Idx",
+   "Full frame peak luminance index" },
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsvd_hdr10p_t, app_ver)+2, 4, 4, EF_BFLD|EF_INT, 0, 0x0F, "Peak_Lum_Idx",
+   "Peak luminance index" }
+};
+
+const gpfld_dsc_t cea_vsvd_cl::hdr10p_fld_grp[] = {
+   { //hdr10p_oui
+      .flags    = 0,
+      .fcount   = 1,
+      .dat_sz   = 3,
+      .inst_cnt = 1,
+      .fields   = cea_vsvd_cl::hdr10p_fld_dsc
+   },
+   { //hdr10p_ver
+      .flags    = 0,
+      .fcount   = (dsc_count(cea_vsvd_cl::hdr10p_fld_dsc) -1),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = &cea_vsvd_cl::hdr10p_fld_dsc[1]
+   }
+};
+
+static gpflat_lay_t *VSVD_HDR10P_layout[32];
+
+const gpflat_dsc_t cea_vsvd_cl::VSVD_HDR10P_grp = {
+   .CodN     = "VSVD",
+   .Name     = "Vendor-Specific Video Data Block: HDR10+",
+   .Desc     = HDR10P_Desc,
+   .type_id  = ID_VSVD,
+   .flags    = TG_FLEX_LAYOUT,
+   .min_len  = (sizeof(vsvd_hdr10p_t) +1),
+   .max_len  = 31,
+   .max_fld  = (32 - sizeof(vsvd_hdr10p_t) - sizeof(ethdr_t) + dsc_count(cea_vsvd_cl::hdr10p_fld_dsc) + CEA_EXTHDR_FCNT),
+   .hdr_fcnt = CEA_EXTHDR_FCNT,
+   .hdr_sz   = sizeof(ethdr_t),
+   .fld_arsz = dsc_count(cea_vsvd_cl::hdr10p_fld_grp),
+   .fld_ar   = cea_vsvd_cl::hdr10p_fld_grp,
+   .layout   = VSVD_HDR10P_layout
+};
+
+//VSDEC_* -> group descriptor
+const gpflat_dsc_t* const cea_vsvd_cl::dec_ar[VSDEC_COUNT] = {
+   NULL,                           //VSDEC_RAW
+   NULL,                           //VSDEC_HDMI14: VSD only
+   NULL,                           //VSDEC_HF:     VSD only
+   NULL,                           //VSDEC_AMD:    VSD only
+   &cea_vsvd_cl::VSVD_DoVi_grp,    //VSDEC_DOVI
+   &cea_vsvd_cl::VSVD_HDR10P_grp   //VSDEC_HDR10P
+};
+
+//VSVD/VSAD: decoder selected by the IEEE OUI, NULL: raw payload
+static const gpflat_dsc_t* VS_ExtDecoder(const u8_t* inst, u32_t blk_type, const gpflat_dsc_t* const *dec_ar) {
+   u32_t  blk_len;
+   u32_t  dec;
+
+   blk_len = reinterpret_cast <const bhdr_t*> (inst)->tag.blk_len;
+   if (blk_len < (sizeof(vs_vadb_t) +1)) return NULL;
+
+   dec = oui_cl::Decoder(oui_cl::FromLE(inst +2), blk_type);
+   if (NULL == dec_ar[dec]) return NULL;
+   if (blk_len < dec_ar[dec]->min_len) return NULL;
+
+   return dec_ar[dec];
+}
+
 rcode cea_vsvd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
-   rcode retU;
+   rcode               retU;
+   const gpflat_dsc_t *pGDsc;
+
+   pGDsc = VS_ExtDecoder(inst, OUI_BLK_VSVD, dec_ar);
+   if (NULL == pGDsc) pGDsc = &VSVD_grp;
 
-   retU = base_DBC_Init_FlatGrp(inst, &VSVD_grp, orflags, parent);
+   retU = base_DBC_Init_FlatGrp(inst, pGDsc, orflags, parent);
    return retU;
 }
 
@@ -426,7 +566,7 @@ rcode cea_vddd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 
    dlen = reinterpret_cast <const ethdr_t*> (inst)->ehdr.hdr.tag.blk_len;
    if (dlen != 31) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, CodN);
       if (! b_edit_mode) return retU2;
       goto unk;
    }
@@ -690,14 +830,6 @@ rcode EDID_cl::VDDD_AudioDelay(u32_t op, wxString& sval, u32_t& ival, edi_dynfld
 const char  cea_cldb_cl::Desc[] =
 "The Colorimetry Data Block indicates support of specific extended colorimetry standards";
 
-const gpfld_dsc_t cea_cldb_cl::fields = {
-   .flags    = 0,
-   .fcount   = 11,
-   .dat_sz   = sizeof(cldb_t),
-   .inst_cnt = 1,
-   .fields   = cea_cldb_cl::fld_dsc
-};
-
 const edi_field_t cea_cldb_cl::fld_dsc[] = {
     //byte2
    {&EDID_cl::BitVal, NULL, 2, 0, 1, EF_BIT, 0, 1, "xvYCC601",
@@ -726,6 +858,16 @@ const edi_field_t cea_cldb_cl::fld_dsc[] = {
    "Colorimetry based on DCI-P3" }
 };
 
+const gpfld_dsc_t cea_cldb_cl::fields = {
+   .flags    = 0,
+   .fcount   = dsc_count(cea_cldb_cl::fld_dsc),
+   .dat_sz   = sizeof(cldb_t),
+   .inst_cnt = 1,
+   .fields   = cea_cldb_cl::fld_dsc
+};
+
+static gpflat_lay_t *CLDB_layout[32];
+
 const gpflat_dsc_t cea_cldb_cl::CLDB_grp = {
    .CodN     = "CLDB",
    .Name     = "Colorimetry Data Block",
@@ -734,11 +876,12 @@ const gpflat_dsc_t cea_cldb_cl::CLDB_grp = {
    .flags    = 0,
    .min_len  = (sizeof(cldb_t) +1),
    .max_len  = (sizeof(cldb_t) +1),
-   .max_fld  = (32 - sizeof(cldb_t) - sizeof(ethdr_t) + 11),
+   .max_fld  = (32 - sizeof(cldb_t) - sizeof(ethdr_t) + 11 + CEA_EXTHDR_FCNT),
    .hdr_fcnt = CEA_EXTHDR_FCNT,
    .hdr_sz   = sizeof(ethdr_t),
    .fld_arsz = 1,
-   .fld_ar   = &fields
+   .fld_ar   = &fields,
+   .layout   = CLDB_layout
 };
 
 rcode cea_cldb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
@@ -784,38 +927,41 @@ const edi_field_t cea_hdrs_cl::fld_opt_byte_4_5_6_dsc[] = {
    "(Optional) Desired Content Min Luminance data (8 bits)" }
 };
 
-const gpflat_dsc_t cea_hdrs_cl::HDRS_grp = {
-   .CodN     = "HDRS",
-   .Name     = "HDR Static Metadata Data Block",
-   .Desc     = Desc,
-   .type_id  = ID_HDRS,
-   .flags    = 0,
-   .min_len  = 3,
-   .max_len  = (sizeof(hdrs_t) +1),
-   .max_fld  = (32 - sizeof(hdrs_t) - sizeof(ethdr_t) + 12),
-   .hdr_fcnt = CEA_EXTHDR_FCNT,
-   .hdr_sz   = sizeof(ethdr_t),
-   .fld_arsz = 2,
-   .fld_ar   = cea_hdrs_cl::fields
-};
-
 const gpfld_dsc_t cea_hdrs_cl::fields[] = {
    { //fld_byte_2_3
       .flags    = 0,
-      .fcount   = 9,
+      .fcount   = dsc_count(cea_hdrs_cl::fld_byte_2_3_dsc),
       .dat_sz   = 2,
       .inst_cnt = 1,
       .fields   = cea_hdrs_cl::fld_byte_2_3_dsc
    },
    { //fld_opt_byte_4_5_6
       .flags    = TG_FLEX_LAYOUT|TG_FLEX_LEN,
-      .fcount   = 3,
+      .fcount   = dsc_count(cea_hdrs_cl::fld_opt_byte_4_5_6_dsc),
       .dat_sz   = 3,
       .inst_cnt = 1,
       .fields   = cea_hdrs_cl::fld_opt_byte_4_5_6_dsc
    }
 };
 
+static gpflat_lay_t *HDRS_layout[32];
+
+const gpflat_dsc_t cea_hdrs_cl::HDRS_grp = {
+   .CodN     = "HDRS",
+   .Name     = "HDR Static Metadata Data Block",
+   .Desc     = Desc,
+   .type_id  = ID_HDRS,
+   .flags    = 0,
+   .min_len  = 3,
+   .max_len  = (sizeof(hdrs_t) +1),
+   .max_fld  = (32 - sizeof(hdrs_t) - sizeof(ethdr_t) + 12 + CEA_EXTHDR_FCNT),
+   .hdr_fcnt = CEA_EXTHDR_FCNT,
+   .hdr_sz   = sizeof(ethdr_t),
+   .fld_arsz = dsc_count(cea_hdrs_cl::fields),
+   .fld_ar   = cea_hdrs_cl::fields,
+   .layout   = HDRS_layout
+};
+
 rcode cea_hdrs_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
    rcode retU;
 
@@ -881,16 +1027,16 @@ rcode hdrd_mtd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 
    if (m_type != HDR_dmtd3) {
       if (blk_len < 4) {
-         wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
+         DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
       }
    } else {
       if (blk_len != 2) {
-         wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
+         DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
       }
    }
 
    if (blk_len < 2) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
       blk_len = 2; //use trash data from local buffer
    }
 
@@ -909,7 +1055,7 @@ rcode hdrd_mtd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
          unk_byte -= 1;
 
       } else { //DBC length ?> max length for HDR_dmtd3
-         wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
+         DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, MTD_hdr.CodN);
       }
    }
 
@@ -1139,7 +1285,7 @@ rcode cea_y42c_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 
    dlen = reinterpret_cast<const ethdr_t*> (inst)->ehdr.hdr.tag.blk_len;
    if (dlen < 2) { //min 1 bitmap byte
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, CodN);
       if (! b_edit_mode) return retU2;
    }
 
@@ -1173,7 +1319,7 @@ rcode cea_y42c_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
    memcpy( p_fld, CEA_BlkHdr_fields, (CEA_EXTHDR_FCNT * EDI_FIELD_SZ) );
 
    if (dlen == 0) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, CodN);
       goto grp_empty; //manual editing of blk_len
    }
 
@@ -1217,6 +1363,8 @@ grp_empty:
 //VSAD: Vendor-Specific Audio Data Block (DBC_EXT_VSAD = 17)
 const char  cea_vsad_cl::Desc[] = "Vendor-Specific Audio Data Block: undefined data.";
 
+static gpflat_lay_t *VSAD_layout[32];
+
 const gpflat_dsc_t cea_vsad_cl::VSAD_grp = {
    .CodN     = "VSAD",
    .Name     = "Vendor-Specific Audio Data Block",
@@ -1225,17 +1373,27 @@ const gpflat_dsc_t cea_vsad_cl::VSAD_grp = {
    .flags    = 0,
    .min_len  = (sizeof(vs_vadb_t) +1),
    .max_len  = 31,
-   .max_fld  = (32 - sizeof(vs_vadb_t) - sizeof(ethdr_t) + 1),
+   .max_fld  = (32 - sizeof(vs_vadb_t) - sizeof(ethdr_t) + 1 + CEA_EXTHDR_FCNT),
    .hdr_fcnt = CEA_EXTHDR_FCNT,
    .hdr_sz   = sizeof(ethdr_t),
    .fld_arsz = 1,
-   .fld_ar   = &VSVD_VSAD_fields //fields shared with VSVD
+   .fld_ar   = &VSVD_VSAD_fields, //fields shared with VSVD
+   .layout   = VSAD_layout
+};
+
+//VSDEC_* -> group descriptor: no audio decoders yet, all the OUIs are shown as raw payload
+const gpflat_dsc_t* const cea_vsad_cl::dec_ar[VSDEC_COUNT] = {
+   NULL, NULL, NULL, NULL, NULL, NULL
 };
 
 rcode cea_vsad_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
-   rcode retU;
+   rcode               retU;
+   const gpflat_dsc_t *pGDsc;
+
+   pGDsc = VS_ExtDecoder(inst, OUI_BLK_VSAD, dec_ar);
+   if (NULL == pGDsc) pGDsc = &VSAD_grp;
 
-   retU = base_DBC_Init_FlatGrp(inst, &VSAD_grp, orflags, parent);
+   retU = base_DBC_Init_FlatGrp(inst, pGDsc, orflags, parent);
    return retU;
 }
 
@@ -1548,7 +1706,7 @@ rcode slocd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 
    if (slocd->channel.coord != 0) { //speaker coordinates data present
       if (dlen < sizeof(slocd_t)) {
-         wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, SLOCD_subg.CodN);
+         DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, SLOCD_subg.CodN);
          unk_byte  = dlen;
          unk_byte -= SLOCD_subg.min_len;
          fcount   -= 3;
@@ -1734,7 +1892,7 @@ rcode cea_ifdb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
    //sizeof(ethdr_t) + 2 bytes IFPDH
    if (dlen < 4) {
       if (! b_edit_mode) RCD_RETURN_FAULT(retU);
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, CodN);
       grp_sz = 32;
    }
 
@@ -1758,7 +1916,7 @@ rcode cea_ifdb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
    g_inst += hdr_sz;
 
    if (subg_sz < ifdb_ifpdh_cl::IFPD_subg.min_len) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, CodN);
       goto unk;
    }
 
@@ -1790,7 +1948,7 @@ rcode cea_ifdb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 
       } else { //Check InfoFrame Type Code
          if (g_type == 0x00) {
-            wxedid_RCD_SET_FAULT_VMSG(retU2, "[E!] %s: Bad InfoFrame Type Code", CodN);
+            DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, "[E!] %s: Bad InfoFrame Type Code", CodN);
             if (! b_edit_mode) return retU2;
             goto unk;
          }
@@ -1809,7 +1967,7 @@ rcode cea_ifdb_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
       relo   += grp_sz;
    }
 
-   if (relo > dlen) wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, CodN);
+   if (relo > dlen) DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, CodN);
 
 unk:
    if (! RCD_IS_OK(retU2)) { //blk_len too small or bad InfoFrame Type Code
@@ -1848,7 +2006,7 @@ rcode edi_grp_cl::IFDB_Init_SubGrp(const u8_t* inst, const subgrp_dsc_t* pSGDsc,
 
    if (gplen > parent->getFreeSubgSZ()) {
       if (! b_edit_mode) RCD_RETURN_FAULT(retU);
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pSGDsc->CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pSGDsc->CodN);
       if (blklen > pSGDsc->min_len) return retU2; //insert UNK-DAT group
       gplen = parent->getFreeSubgSZ();
    }
@@ -11,6 +11,7 @@
 #define CEA_EXT_CLASS_H 1
 
 #include "EDID_shared.h"
+#include "oui.h"
 
 //----------------- DBC Extended Tag Codes
 
@@ -27,11 +28,24 @@ class cea_vcdb_cl : public edi_grp_cl {
       edi_grp_cl* Clone(rcode& rcd, u32_t flags) {return base_clone(rcd, new cea_vcdb_cl(), inst_data, flags); };
 };
 //VSVD: Vendor-Specific Video Data Block (DBC_EXT_VSVD = 1)
+//The payload decoder is selected by the IEEE OUI, see oui.h
 class cea_vsvd_cl : public edi_grp_cl {
    private:
       static const char         Desc[];
       //fields shared with VSAD
       static const gpflat_dsc_t VSVD_grp;
+      //Dolby Vision
+      static const char         DoVi_Desc[];
+      static const edi_field_t  dovi_fld_dsc[];
+      static const gpfld_dsc_t  dovi_fld_grp[];
+      static const gpflat_dsc_t VSVD_DoVi_grp;
+      //HDR10+
+      static const char         HDR10P_Desc[];
+      static const edi_field_t  hdr10p_fld_dsc[];
+      static const gpfld_dsc_t  hdr10p_fld_grp[];
+      static const gpflat_dsc_t VSVD_HDR10P_grp;
+      //VSDEC_* -> group descriptor, NULL: raw
+      static const gpflat_dsc_t* const dec_ar[VSDEC_COUNT];
 
    public:
       rcode       init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent);
@@ -235,6 +249,8 @@ class cea_vsad_cl : public edi_grp_cl {
       static const char       Desc[];
       //fields shared with VSVD
       static const gpflat_dsc_t VSAD_grp;
+      //VSDEC_* -> group descriptor, NULL: raw
+      static const gpflat_dsc_t* const dec_ar[VSDEC_COUNT];
 
    public:
       rcode       init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent);
@@ -377,9 +377,10 @@ static const char sadAFC_Desc[] =
 
 /* SAD (Short Audio Descriptor) uses different data layouts, depending
    on Audio Format Code (AFC) and Audio Coding Extension Type Code (ACE).
-   All the possible data layouts are defined here, and the final SAD is
+   All the possible data layouts are defined here: cea_sad_cl::layouts[] holds
+   the fields of bytes 0-2 for each AFC/ACE combination, the final SAD is
    constructed by cea_sad_cl::gen_data_layout(), which is also setting the
-   cea_sad_cl::fcount variable.
+   dyn_fcnt variable.
 */
 
 const subgrp_dsc_t cea_sad_cl::SAD_subg = {
@@ -568,181 +569,167 @@ const edi_field_t cea_sad_cl::byte2_afc15_ace13[] = {
    "Audio Coding Extension Type Code." }
 };
 
+//SAD unknown/invalid bytes 0-2
+const edi_field_t cea_sad_cl::byte_unk[] = {
+   {&EDID_cl::ByteVal, NULL, 0, 0, 1, EF_BYTE|EF_HEX|EF_RD, 0, 0xFF, "unknown", "Unknown data" },
+   {&EDID_cl::ByteVal, NULL, 1, 0, 1, EF_BYTE|EF_HEX|EF_RD, 0, 0xFF, "unknown", "Unknown data" },
+   {&EDID_cl::ByteVal, NULL, 2, 0, 1, EF_BYTE|EF_HEX|EF_RD, 0, 0xFF, "unknown", "Unknown data" }
+};
+
+//SAD data layouts: bytes 0, 1, 2
+const cea_sad_cl::sad_lay_t cea_sad_cl::layouts[] = {
+   { //lay_bad_afc
+      {{&byte_unk[0], 1}, {&byte_unk[1], 1}, {&byte_unk[2], 1}}
+   },
+   { //lay_bad_ace
+      {{&byte_unk[0], 1}, {&byte_unk[1], 1}, {&byte_unk[2], 1}}
+   },
+   { //lay_afc1: LPCM
+      {FLD_LAYOUT(byte0_afc1_14), FLD_LAYOUT(byte1_afc1_14_ace11), FLD_LAYOUT(byte2_afc1)}
+   },
+   { //lay_afc2_8: bitrate
+      {FLD_LAYOUT(byte0_afc1_14), FLD_LAYOUT(byte1_afc1_14_ace11), FLD_LAYOUT(byte2_afc2_8)}
+   },
+   { //lay_afc9_13: AFC dependent value
+      {FLD_LAYOUT(byte0_afc1_14), FLD_LAYOUT(byte1_afc1_14_ace11), FLD_LAYOUT(byte2_afc9_13)}
+   },
+   { //lay_afc14: WMA-Pro
+      {FLD_LAYOUT(byte0_afc1_14), FLD_LAYOUT(byte1_afc1_14_ace11), FLD_LAYOUT(byte2_afc14)}
+   },
+   { //lay_afc15_ace456
+      {FLD_LAYOUT(byte0_afc1_14), FLD_LAYOUT(byte1_afc15_ace456810), FLD_LAYOUT(byte2_afc15_ace456)}
+   },
+   { //lay_afc15_ace8_10
+      {FLD_LAYOUT(byte0_afc1_14), FLD_LAYOUT(byte1_afc15_ace456810), FLD_LAYOUT(byte2_afc15_ace8_10)}
+   },
+   { //lay_afc15_ace11: MPEG-H 3D Audio
+      {FLD_LAYOUT(byte0_afc15_ace11_12), FLD_LAYOUT(byte1_afc1_14_ace11), FLD_LAYOUT(byte2_afc15_ace11_12)}
+   },
+   { //lay_afc15_ace12: AC-4
+      {FLD_LAYOUT(byte0_afc15_ace11_12), FLD_LAYOUT(byte1_afc15_ace12_fsmp), FLD_LAYOUT(byte2_afc15_ace11_12)}
+   },
+   { //lay_afc15_ace13: L-PCM 3D Audio
+      {FLD_LAYOUT(byte0_afc15_ace13), FLD_LAYOUT(byte1_afc15_ace13), FLD_LAYOUT(byte2_afc15_ace13)}
+   }
+};
+
+//AFC = 0...14
+const u8_t cea_sad_cl::afc_layout[] = {
+   lay_bad_afc,
+   lay_afc1,
+   lay_afc2_8   , lay_afc2_8   , lay_afc2_8 , lay_afc2_8 , lay_afc2_8, lay_afc2_8, lay_afc2_8,
+   lay_afc9_13  , lay_afc9_13  , lay_afc9_13, lay_afc9_13, lay_afc9_13,
+   lay_afc14
+};
+
+//AFC = 15: ACE = 0...31
+const u8_t cea_sad_cl::ace_layout[] = {
+   lay_bad_ace      , lay_bad_ace      , lay_bad_ace      , lay_bad_ace      ,  //0-3
+   lay_afc15_ace456 , lay_afc15_ace456 , lay_afc15_ace456 , lay_bad_ace      ,  //4-7
+   lay_afc15_ace8_10, lay_bad_ace      , lay_afc15_ace8_10, lay_afc15_ace11  ,  //8-11
+   lay_afc15_ace12  , lay_afc15_ace13  , lay_bad_ace      , lay_bad_ace      ,  //12-15
+   lay_bad_ace      , lay_bad_ace      , lay_bad_ace      , lay_bad_ace      ,  //16-19
+   lay_bad_ace      , lay_bad_ace      , lay_bad_ace      , lay_bad_ace      ,  //20-23
+   lay_bad_ace      , lay_bad_ace      , lay_bad_ace      , lay_bad_ace      ,  //24-27
+   lay_bad_ace      , lay_bad_ace      , lay_bad_ace      , lay_bad_ace         //28-31
+};
+
+edi_field_t* cea_sad_cl::lay_fields[lay_afc15_ace13 +1];
+
+//Bytes 0-2 fields of the layout, concatenated: generated on the first use of the layout,
+//shared by all the instances, never freed. Batch workers can initialize SADs concurrently.
+const edi_field_t* cea_sad_cl::lay_get(u32_t lay_idx, u32_t& fcount) {
+   const sad_lay_t *play;
+   edi_field_t     *fldar;
+   edi_field_t     *p_fld;
+   edi_field_t     *pnull;
+
+   play   = &layouts[lay_idx];
+   fcount = 0;
+   for (u32_t itb=0; itb<3; ++itb) fcount += play->byte[itb].fcount;
+
+   fldar = __atomic_load_n(&lay_fields[lay_idx], __ATOMIC_ACQUIRE);
+   if (fldar != NULL) return fldar;
+
+   fldar = (edi_field_t*) malloc( fcount * EDI_FIELD_SZ );
+   if (NULL == fldar) return NULL;
+
+   p_fld = fldar;
+   for (u32_t itb=0; itb<3; ++itb) {
+      const fld_lay_t *pbyte = &play->byte[itb];
+
+      memcpy( p_fld, pbyte->fields, (pbyte->fcount * EDI_FIELD_SZ) );
+      p_fld += pbyte->fcount;
+   }
+
+   pnull = NULL;
+   if (! __atomic_compare_exchange_n(&lay_fields[lay_idx], &pnull, fldar, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) {
+      free(fldar);
+      fldar = pnull;
+   }
+
+   return fldar;
+}
+
 rcode cea_sad_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
-   rcode retU;
-   rcode retU2;
+   rcode              retU;
+   rcode              retU2;
+   const edi_field_t *pfields;
 
    parent_grp = parent;
    type_id    = ID_SAD | T_DBC_SUBGRP | orflags;
 
-   //pre-alloc buffer for array of fields
-   dyn_fldar = (edi_field_t*) malloc( 31 * EDI_FIELD_SZ );
-   if (NULL == dyn_fldar) RCD_RETURN_FAULT(retU);
-
    CopyInstData(inst, sizeof(sad_t));
 
-   retU = gen_data_layout(inst_data);
+   retU = gen_data_layout(inst_data, pfields);
+   if (NULL == pfields) RCD_RETURN_FAULT(retU2);
 
-   retU2 = init_fields(dyn_fldar, inst_data, dyn_fcnt, 0, SAD_subg.Name, SAD_subg.Desc, SAD_subg.CodN);
+   retU2 = init_fields(pfields, inst_data, dyn_fcnt, 0, SAD_subg.Name, SAD_subg.Desc, SAD_subg.CodN);
 
    if (! RCD_IS_OK(retU)) return retU;
    return retU2;
 }
 
 rcode cea_sad_cl::ForcedGroupRefresh() {
-   rcode retU;
-   rcode retU2;
-
-   //clear fields
-   memset( (void*) dyn_fldar, 0, ( 31 * EDI_FIELD_SZ ) );
+   rcode              retU;
+   rcode              retU2;
+   const edi_field_t *pfields;
 
-   //on error, "unknown data" layout is generated, init_fields is always called.
-   retU  = gen_data_layout(inst_data);
+   //on error, "unknown data" layout is used, init_fields is always called.
+   retU = gen_data_layout(inst_data, pfields);
+   if (NULL == pfields) RCD_RETURN_FAULT(retU2);
 
-   retU2 = init_fields(dyn_fldar, inst_data, dyn_fcnt, 0);
+   retU2 = init_fields(pfields, inst_data, dyn_fcnt, 0);
 
    if (! RCD_IS_OK(retU)) return retU;
    return retU2;
 }
 
-rcode cea_sad_cl::gen_data_layout(const u8_t* inst) {
+rcode cea_sad_cl::gen_data_layout(const u8_t* inst, const edi_field_t*& pfields) {
+   static_assert(dsc_count(afc_layout) == 15, "SAD: afc_layout[]: AFC 0...14");
+   static_assert(dsc_count(ace_layout) == 32, "SAD: ace_layout[]: ACE 0...31");
+   static_assert(dsc_count(layouts) == (lay_afc15_ace13 +1), "SAD: layouts[]: missing entries");
 
-   rcode        retU;
-   edi_field_t *p_fld;
-   int          AFC;
-   int          ACE;
-
-   p_fld = dyn_fldar;
+   rcode  retU;
+   u32_t  AFC;
+   u32_t  ACE;
+   u32_t  lay_idx;
 
    AFC = reinterpret_cast <const sad0_t*> (inst  )->afc1_14.audio_fmt;
    ACE = reinterpret_cast <const sad2_t*> (inst+2)->afc15_ace.ace_456.ace_tc;
 
-   { // SAD byte 0
-      if (AFC < 1 ) {
-         insert_unk_byte(p_fld, 3, 0);
-         dyn_fcnt = 3;
-         RCD_RETURN_FAULT_MSG(retU, "[E!] SAD: bad Audio Format Code (AFC)");
-      }
-      if (AFC < 15) { //AFC = 1...14
-         memcpy( p_fld, byte0_afc1_14, (byte0_afc1_14_fcnt * EDI_FIELD_SZ) );
-         p_fld    += byte0_afc1_14_fcnt;
-         dyn_fcnt  = byte0_afc1_14_fcnt;
-      } else
-      {  //AFC = 15 && ACE = 4-6,8,10: same as for AFC = 1...14
-         if ((ACE >= 4 && 6 >= ACE) || (ACE = 8) || (ACE = 10)) {
-            memcpy( p_fld, byte0_afc1_14, (byte0_afc1_14_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte0_afc1_14_fcnt;
-            dyn_fcnt  = byte0_afc1_14_fcnt;
-
-         } else
-         //AFC = 15 && ACE = 11,12 (MPEG-H 3D Audio, AC-4)
-         if ((ACE = 11) || (ACE = 12)) {
-            memcpy( p_fld, byte0_afc15_ace11_12, (byte0_afc15_ace11_12_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte0_afc15_ace11_12_fcnt;
-            dyn_fcnt  = byte0_afc15_ace11_12_fcnt;
-
-         } else
-         // AFC == 15, ACE = 13 (L-PCM 3D Audio)
-         if (ACE == 13) {
-            memcpy( p_fld, byte0_afc15_ace13, (byte0_afc15_ace13_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte0_afc15_ace13_fcnt;
-            dyn_fcnt  = byte0_afc15_ace13_fcnt;
-         } else {
-         // AFC == 15, ACE > 13 || ACE = 9 || ACE = 7 || ACE < 4 : unknown
-            insert_unk_byte(p_fld, 3, 0);
-            dyn_fcnt = 3;
-            RCD_RETURN_FAULT_MSG(retU, "[E!] SAD: bad Audio Coding Extension Type Code (ACE)");
-         }
-      }
-   }
-   { // SAD byte 1
-      //AFC = 1...14 || AFC = 15 && ACE = 11 (MPEG-H 3D Audio)
-      if ( (AFC < 15) || ( AFC == 15 && ACE == 11 ) ) {
-         memcpy( p_fld, byte1_afc1_14_ace11, (byte1_afc1_14_ace11_fcnt * EDI_FIELD_SZ) );
-         p_fld    += byte1_afc1_14_ace11_fcnt;
-         dyn_fcnt += byte1_afc1_14_ace11_fcnt;
-      } else {
-         //AFC == 15
-         if ( (ACE >= 4 && 6 >= ACE) || ACE==8 || ACE==10 ) { //ACE = 4,5,6,8,10
-            memcpy( p_fld, byte1_afc15_ace456810, (byte1_afc15_ace456810_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte1_afc15_ace456810_fcnt;
-            dyn_fcnt += byte1_afc15_ace456810_fcnt;
-         } else
-         if ( ACE==12 ) { //ACE = 12 (AC-4)
-            memcpy( p_fld, byte1_afc15_ace12_fsmp, (byte1_afc15_ace12_fsmp_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte1_afc15_ace12_fsmp_fcnt;
-            dyn_fcnt += byte1_afc15_ace12_fsmp_fcnt;
-         } else
-         if ( ACE==13 ) { //ACE = 13 (L-PCM 3D Audio)
-            memcpy( p_fld, byte1_afc15_ace13, (byte1_afc15_ace13_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte1_afc15_ace13_fcnt;
-            dyn_fcnt += byte1_afc15_ace13_fcnt;
-         } else {
-         // AFC == 15, ACE > 13 || ACE = 9 || ACE = 7 || ACE < 4 :
-         // insert "unknown byte" on error
-            insert_unk_byte(p_fld, 2, 1);
-            dyn_fcnt += 2;
-            RCD_RETURN_FAULT_MSG(retU, "[E!] SAD: bad Audio Coding Extension Type Code (ACE)");
-         }
-      }
+   lay_idx = (AFC < 15) ? afc_layout[AFC] : ace_layout[ACE];
+   pfields = lay_get(lay_idx, dyn_fcnt);
+
+   //on error, "unknown data" layout is generated
+   if (lay_idx == lay_bad_afc) {
+      RCD_RETURN_FAULT_MSG(retU, "[E!] SAD: bad Audio Format Code (AFC)");
    }
-   { // SAD byte 2
-      if (AFC == 1 ) { //AFC = 1: LPCM
-         memcpy( p_fld, byte2_afc1, (byte2_afc1_fcnt * EDI_FIELD_SZ) );
-         p_fld    += byte2_afc1_fcnt;
-         dyn_fcnt += byte2_afc1_fcnt;
-         RCD_RETURN_OK(retU);
-      } else
-      if (AFC >= 2 && 8 >= AFC ) { //AFC = 2...8 : bitrate
-         memcpy( p_fld, byte2_afc2_8, (byte2_afc2_8_fcnt * EDI_FIELD_SZ) );
-         p_fld    += byte2_afc2_8_fcnt;
-         dyn_fcnt += byte2_afc2_8_fcnt;
-         RCD_RETURN_OK(retU);
-      } else
-      if (AFC >= 9 && 13 >= AFC ) { //AFC = 9...13: AFC dependent value
-         memcpy( p_fld, byte2_afc9_13, (byte2_afc9_13_fcnt * EDI_FIELD_SZ) );
-         p_fld    += byte2_afc9_13_fcnt;
-         dyn_fcnt += byte2_afc9_13_fcnt;
-         RCD_RETURN_OK(retU);
-      } else
-      if (AFC == 14) { //AFC = 14: WMA-Pro
-         memcpy( p_fld, byte2_afc14, (byte2_afc14_fcnt * EDI_FIELD_SZ) );
-         p_fld    += byte2_afc14_fcnt;
-         dyn_fcnt += byte2_afc14_fcnt;
-         RCD_RETURN_OK(retU);
-      } else
-      if (AFC == 15) {
-         if ( ACE >= 4 && 6 >= ACE ) { //AFC = 15, ACE = 4, 5, 6
-            memcpy( p_fld, byte2_afc15_ace456, (byte2_afc15_ace456_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte2_afc15_ace456_fcnt;
-            dyn_fcnt += byte2_afc15_ace456_fcnt;
-            RCD_RETURN_OK(retU);
-         } else
-         if ( ACE==8 || ACE==10 ) { //AFC = 15, ACE = 8 or 10
-            memcpy( p_fld, byte2_afc15_ace8_10, (byte2_afc15_ace8_10_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte2_afc15_ace8_10_fcnt;
-            dyn_fcnt += byte2_afc15_ace8_10_fcnt;
-            RCD_RETURN_OK(retU);
-         } else
-         if ( ACE==11 || ACE==12 ) { //AFC = 15, ACE = 11 (MPEG-H 3D Audio) or 12 (AC-4)
-            memcpy( p_fld, byte2_afc15_ace11_12, (byte2_afc15_ace11_12_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte2_afc15_ace11_12_fcnt;
-            dyn_fcnt += byte2_afc15_ace11_12_fcnt;
-            RCD_RETURN_OK(retU);
-         } else
-         if ( ACE==13 ) { //AFC = 15, ACE = 13 (L-PCM 3D Audio)
-            memcpy( p_fld, byte2_afc15_ace13, (byte2_afc15_ace13_fcnt * EDI_FIELD_SZ) );
-            p_fld    += byte2_afc15_ace13_fcnt;
-            dyn_fcnt += byte2_afc15_ace13_fcnt;
-            RCD_RETURN_OK(retU);
-         }
-         // AFC == 15, ACE > 13 || ACE = 9 || ACE = 7 || ACE < 4 : unknown
-      }
+   if (lay_idx == lay_bad_ace) {
+      RCD_RETURN_FAULT_MSG(retU, "[E!] SAD: bad Audio Coding Extension Type Code (ACE)");
    }
-   //unknown byte format:
-   insert_unk_byte(p_fld, 1, 2);
-   dyn_fcnt += 1;
-   RCD_RETURN_FAULT_MSG(retU, "[E!] SAD: bad Audio Coding Extension Type Code (ACE)");
+   RCD_RETURN_OK(retU);
 }
 
 //ADB: Audio Data Block: handlers
@@ -1001,6 +988,41 @@ rcode EDID_cl::VSD_MaxTMDS(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t*
    return retU;
 }
 
+//HF-VSDB: VRRmax: 10 bits: byte 9 bits 7-6: VRRmax[9:8], byte 10: VRRmax[7:0]
+rcode EDID_cl::VSD_HF_VRRmax(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field) {
+   rcode  retU;
+   u8_t  *inst;
+
+   inst = getValPtr(p_field);
+
+   if (op == OP_READ) {
+      ival  = (inst[0] >> 6);
+      ival <<= 8;
+      ival |= inst[1];
+      sval << ival;
+      RCD_SET_OK(retU);
+   } else {
+      ulong       tmpv;
+      RCD_SET_FAULT(retU);
+
+      if (op == OP_WRSTR) {
+         retU = getStrUint(sval, 10, p_field->field.minv, p_field->field.maxv, tmpv);
+         if (! RCD_IS_OK(retU)) return retU;
+      } else if (op == OP_WRINT) {
+         tmpv = ival;
+         RCD_SET_OK(retU);
+      } else {
+         RCD_RETURN_FAULT(retU); //wrong op code
+      }
+
+      tmpv   &= 0x3FF;
+      inst[0] &= 0x3F;
+      inst[0] |= ((tmpv >> 8) << 6);
+      inst[1]  = (tmpv & 0xFF);
+   }
+   return retU;
+}
+
 //VSD: Vendor Specific Data Block
 const char  cea_vsd_cl::Desc[] =
 "Vendor Specific Data Block is required to contain the following fields:\n"
@@ -1011,8 +1033,10 @@ const char  cea_vsd_cl::Desc[] =
 "- 00-0C-03 \"HDMI Licensing, LLC\" -> provides HDMI 1.4 payload\n"
 "- C4-5D-D8 \"HDMI Forum\" -> provides HDMI 2.0 payload\n"
 "- 00-D0-46 \"DOLBY LABORATORIES, INC.\" -> provides Dolby Vision payload\n"
-"- 90-84-8b \"HDR10+ Technologies, LLC\" -> provides HDR10+ payload as part of HDMI 2.1 Amendment A1 standard\n\n"
-"NOTE: Currently, wxEDID interprets the payload as for 00-0C-03 \"HDMI Licensing, LLC\".\n";
+"- 90-84-8b \"HDR10+ Technologies, LLC\" -> provides HDR10+ payload as part of HDMI 2.1 Amendment A1 standard\n"
+"- 00-00-1A \"Advanced Micro Devices, Inc.\" -> provides AMD FreeSync payload\n\n"
+"NOTE: The payload is decoded according to the IEEE-OUI, unknown OUI: the payload is shown as unknown bytes.\n"
+"Dolby Vision and HDR10+ payloads are decoded in VSVD: Vendor-Specific Video Data Block.\n";
 
 const edi_field_t cea_vsd_cl::hdr_fld_dsc[] = {
    {&EDID_cl::ByteStr, NULL, offsetof(vsd_hdmi14_t, ieee_id)+1, 0, 3, EF_STR|EF_HEX|EF_LE|EF_RD|EF_FGR, 0, 0xFFFFFF, "IEEE-OUI",
@@ -1068,41 +1092,43 @@ const edi_field_t cea_vsd_cl::av_latency_fld_dsc[] = {
 const gpfld_dsc_t cea_vsd_cl::sub_fld_grp[] = {
    { //vsd_hdr_idphy
       .flags    = TG_FLEX_LAYOUT,
-      .fcount   = 2,
+      .fcount   = dsc_count(cea_vsd_cl::hdr_fld_dsc),
       .dat_sz   = 5,
       .inst_cnt = 1,
       .fields   = cea_vsd_cl::hdr_fld_dsc
    },
    { //vsd_sink_feat
       .flags    = 0,
-      .fcount   = 8,
+      .fcount   = dsc_count(cea_vsd_cl::sink_feat_fld_dsc),
       .dat_sz   = 1,
       .inst_cnt = 1,
       .fields   = cea_vsd_cl::sink_feat_fld_dsc
    },
    { //vsd_max_tmds
       .flags    = 0,
-      .fcount   = 1,
+      .fcount   = dsc_count(cea_vsd_cl::max_tmds_fld_dsc),
       .dat_sz   = 1,
       .inst_cnt = 1,
       .fields   = cea_vsd_cl::max_tmds_fld_dsc
    },
    { //vsd_latency
       .flags    = 0,
-      .fcount   = 3,
+      .fcount   = dsc_count(cea_vsd_cl::latency_fld_dsc),
       .dat_sz   = 1,
       .inst_cnt = 1,
       .fields   = cea_vsd_cl::latency_fld_dsc
    },
    { //vsd_av_latency
       .flags    = TG_FLEX_LAYOUT|TG_FLEX_LEN,
-      .fcount   = 4,
+      .fcount   = dsc_count(cea_vsd_cl::av_latency_fld_dsc),
       .dat_sz   = 4,
       .inst_cnt = 1,
       .fields   = cea_vsd_cl::av_latency_fld_dsc
    }
 };
 
+static gpflat_lay_t *VSD_layout[32];
+
 const gpflat_dsc_t cea_vsd_cl::VSD_grp = {
    .CodN     = "VSD",
    .Name     = "Vendor Specific Data Block",
@@ -1111,17 +1137,329 @@ const gpflat_dsc_t cea_vsd_cl::VSD_grp = {
    .flags    = TG_FLEX_LAYOUT,
    .min_len  = 3,
    .max_len  = 31,
-   .max_fld  = (32 - sizeof(vsd_hdmi14_t) - sizeof(bhdr_t) + 18),
+   .max_fld  = (32 - sizeof(vsd_hdmi14_t) - sizeof(bhdr_t) + 18 + CEA_DBCHDR_FCNT),
+   .hdr_fcnt = CEA_DBCHDR_FCNT,
+   .hdr_sz   = sizeof(bhdr_t),
+   .fld_arsz = dsc_count(cea_vsd_cl::sub_fld_grp),
+   .fld_ar   = cea_vsd_cl::sub_fld_grp,
+   .layout   = VSD_layout
+};
+
+//VSD: HDMI Forum: HF-VSDB
+const char  cea_vsd_cl::HF_Desc[] =
+"HDMI Forum Vendor Specific Data Block (HF-VSDB), IEEE-OUI C4-5D-D8.\n"
+"Defined by HDMI 2.0/2.1: TMDS character rate above 340MHz, SCDC, FRL: Fixed Rate Link, "
+"VRR: Variable Refresh Rate, ALLM: Auto Low Latency Mode, DSC: Display Stream Compression.\n"
+"Bytes 8 and above are optional.";
+
+const edi_field_t cea_vsd_cl::hf_hdr_fld_dsc[] = {
+   {&EDID_cl::ByteStr, NULL, offsetof(vsd_hf_t, ieee_id)+1, 0, 3, EF_STR|EF_HEX|EF_LE|EF_RD|EF_FGR, 0, 0xFFFFFF, "IEEE-OUI",
+   "IEEE Registration Id LE" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_hf_t, version)+1, 0, 1, EF_BYTE|EF_INT, 0, 0xFF, "Version",
+   "HF-VSDB version, 1" },
+   {&EDID_cl::VSD_MaxTMDS, NULL, offsetof(vsd_hf_t, max_tmds)+1, 0, 1, EF_INT|EF_MHZ, 0, 1275, "Max_TMDS_Char_Rate",
+   "Max_TMDS_Character_Rate / 5MHz, 0: TMDS character rates above 340MHz are not supported." }
+};
+
+const edi_field_t cea_vsd_cl::hf_scdc_fld_dsc[] = {
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 0, 1, EF_BIT, 0, 1, "3D_OSD_Disparity",
+   "3D OSD disparity indication in the HF-VSIF is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 1, 1, EF_BIT, 0, 1, "3D_Dual_View",
+   "3D dual-view signaling is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 2, 1, EF_BIT, 0, 1, "3D_Indep_View",
+   "3D independent view signaling is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 3, 1, EF_BIT, 0, 1, "LTE_340Mcsc_scramble",
+   "Scrambling is supported for TMDS character rates <= 340MHz." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 4, 1, EF_BIT, 0, 1, "CCBPCI",
+   "Color Content Bits Per Component Indication is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 5, 1, EF_BIT, 0, 1, "CABLE_STATUS",
+   "Cable status register in SCDC is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 6, 1, EF_BIT, 0, 1, "RR_Capable",
+   "SCDC Read Request is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_scdc)+1, 7, 1, EF_BIT, 0, 1, "SCDC_Present",
+   "SCDC: Status and Control Data Channel is supported." }
+};
+
+const vname_map_t hf_frl_rate_map[] = {
+   {0, "FRL not supported"},
+   {1, "3Gbps x 3 lanes"},
+   {2, "6Gbps x 3 lanes"},
+   {3, "6Gbps x 4 lanes"},
+   {4, "8Gbps x 4 lanes"},
+   {5, "10Gbps x 4 lanes"},
+   {6, "12Gbps x 4 lanes"}
+};
+
+const vmap_t HF_FRL_rate = {
+   0, 7,
+   hf_frl_rate_map
+};
+
+const edi_field_t cea_vsd_cl::hf_frl_fld_dsc[] = {
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, frl_dc420)+1, 0, 1, EF_BIT, 0, 1, "DC_30bit_420",
+   "10-bit-per-channel deep color support for YCbCr 4:2:0." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, frl_dc420)+1, 1, 1, EF_BIT, 0, 1, "DC_36bit_420",
+   "12-bit-per-channel deep color support for YCbCr 4:2:0." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, frl_dc420)+1, 2, 1, EF_BIT, 0, 1, "DC_48bit_420",
+   "16-bit-per-channel deep color support for YCbCr 4:2:0." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, frl_dc420)+1, 3, 1, EF_BIT, 0, 1, "UHD_VIC",
+   "Support for the VIC codes listed in the HDMI 1.4 VSD (HDMI_VIC) signaled with AVI InfoFrame." },
+   {&EDID_cl::BitF8Val, &HF_FRL_rate, offsetof(vsd_hf_t, frl_dc420)+1, 4, 4, EF_BFLD|EF_INT|EF_VS, 0, 0x0F, "Max_FRL_Rate",
+   "Maximum Fixed Rate Link rate, 0: FRL not supported, TMDS only." }
+};
+
+const edi_field_t cea_vsd_cl::hf_vrr_fld_dsc[] = {
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 0, 1, EF_BIT, 0, 1, "FAPA_start_location",
+   "Fast Active Pixel Area starts on the first horizontal blank pixel after the VSync." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 1, 1, EF_BIT, 0, 1, "ALLM",
+   "Auto Low Latency Mode is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 2, 1, EF_BIT, 0, 1, "FVA",
+   "Fast Vactive is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 3, 1, EF_BIT, 0, 1, "CNMVRR",
+   "Negative M_VRR values are supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 4, 1, EF_BIT, 0, 1, "CinemaVRR",
+   "Cinema VRR: VRR range down to 23.976Hz is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 5, 1, EF_BIT, 0, 1, "M_delta",
+   "Frame-to-frame M_VRR variation is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 6, 1, EF_BIT, 0, 1, "QMS",
+   "Quick Media Switching is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_vrr)+1, 7, 1, EF_BIT, 0, 1, "FAPA_End_Extended",
+   "Fast Active Pixel Area may extend into the vertical front porch." }
+};
+
+const edi_field_t cea_vsd_cl::hf_vrr_rng_fld_dsc[] = {
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsd_hf_t, vrr_min)+1, 0, 6, EF_BFLD|EF_INT|EF_HZ, 0, 0x3F, "VRRmin",
+   "Minimum refresh rate for VRR, Hz. 0: VRR not supported." },
+   {&EDID_cl::VSD_HF_VRRmax, NULL, offsetof(vsd_hf_t, vrr_min)+1, 0, 2, EF_INT|EF_HZ, 0, 0x3FF, "VRRmax",
+   "Maximum refresh rate for VRR, Hz, 10 bits: byte 9, bits 7-6: bits 9-8, byte 10: bits 7-0.\n"
+   "0: the maximum is defined by the timing of the video mode." }
+};
+
+const edi_field_t cea_vsd_cl::hf_dsc_fld_dsc[] = {
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 0, 1, EF_BIT, 0, 1, "DSC_10bpc",
+   "DSC: 10 bits per component is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 1, 1, EF_BIT, 0, 1, "DSC_12bpc",
+   "DSC: 12 bits per component is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 2, 1, EF_BIT, 0, 1, "DSC_16bpc",
+   "DSC: 16 bits per component is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 3, 1, EF_BIT, 0, 1, "DSC_All_bpp",
+   "DSC: all bits per pixel values are supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 4, 1, EF_BIT, 0, 1, "QMS_TFRmin",
+   "QMS: TFRmin is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 5, 1, EF_BIT, 0, 1, "QMS_TFRmax",
+   "QMS: TFRmax is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 6, 1, EF_BIT, 0, 1, "DSC_Native_420",
+   "DSC: native YCbCr 4:2:0 is supported." },
+   {&EDID_cl::BitVal, NULL, offsetof(vsd_hf_t, feat_dsc)+1, 7, 1, EF_BIT, 0, 1, "DSC_1p2",
+   "VESA DSC 1.2a is supported." }
+};
+
+const edi_field_t cea_vsd_cl::hf_dsc_frl_fld_dsc[] = {
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsd_hf_t, dsc_frl)+1, 0, 4, EF_BFLD|EF_INT, 0, 0x0F, "DSC_Max_Slices",
+   "DSC: max number of slices and the max pixel clock per slice, 0: DSC not supported." },
+   {&EDID_cl::BitF8Val, &HF_FRL_rate, offsetof(vsd_hf_t, dsc_frl)+1, 4, 4, EF_BFLD|EF_INT|EF_VS, 0, 0x0F, "DSC_Max_FRL_Rate",
+   "DSC: maximum Fixed Rate Link rate." }
+};
+
+const edi_field_t cea_vsd_cl::hf_dsc_chunk_fld_dsc[] = {
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsd_hf_t, dsc_chunk)+1, 0, 6, EF_BFLD|EF_INT, 0, 0x3F, "DSC_TotalChunkKBytes",
+   "DSC: total chunk size: 1024 * (1 + value) bytes." },
+   {&EDID_cl::BitF8Val, NULL, offsetof(vsd_hf_t, dsc_chunk)+1, 6, 2, EF_BFLD, 0, 0, "reserved",
+   "reserved (0)" }
+};
+
+const gpfld_dsc_t cea_vsd_cl::hf_fld_grp[] = {
+   { //hf_hdr
+      .flags    = TG_FLEX_LAYOUT,
+      .fcount   = dsc_count(cea_vsd_cl::hf_hdr_fld_dsc),
+      .dat_sz   = 5,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_hdr_fld_dsc
+   },
+   { //hf_scdc
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_scdc_fld_dsc),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_scdc_fld_dsc
+   },
+   { //hf_frl
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_frl_fld_dsc),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_frl_fld_dsc
+   },
+   { //hf_vrr
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_vrr_fld_dsc),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_vrr_fld_dsc
+   },
+   { //hf_vrr_rng
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_vrr_rng_fld_dsc),
+      .dat_sz   = 2,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_vrr_rng_fld_dsc
+   },
+   { //hf_dsc
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_dsc_fld_dsc),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_dsc_fld_dsc
+   },
+   { //hf_dsc_frl
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_dsc_frl_fld_dsc),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_dsc_frl_fld_dsc
+   },
+   { //hf_dsc_chunk
+      .flags    = 0,
+      .fcount   = dsc_count(cea_vsd_cl::hf_dsc_chunk_fld_dsc),
+      .dat_sz   = 1,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hf_dsc_chunk_fld_dsc
+   }
+};
+
+static gpflat_lay_t *VSD_HF_layout[32];
+
+const gpflat_dsc_t cea_vsd_cl::VSD_HF_grp = {
+   .CodN     = "VSD",
+   .Name     = "Vendor Specific Data Block: HF-VSDB",
+   .Desc     = HF_Desc,
+   .type_id  = ID_VSD,
+   .flags    = TG_FLEX_LAYOUT,
+   .min_len  = 7,
+   .max_len  = 31,
+   .max_fld  = (32 - sizeof(vsd_hf_t) - sizeof(bhdr_t) + 38 + CEA_DBCHDR_FCNT),
    .hdr_fcnt = CEA_DBCHDR_FCNT,
    .hdr_sz   = sizeof(bhdr_t),
-   .fld_arsz = 5,
-   .fld_ar   = cea_vsd_cl::sub_fld_grp
+   .fld_arsz = dsc_count(cea_vsd_cl::hf_fld_grp),
+   .fld_ar   = cea_vsd_cl::hf_fld_grp,
+   .layout   = VSD_HF_layout
+};
+
+//VSD: AMD FreeSync
+const char  cea_vsd_cl::AMD_Desc[] =
+"AMD FreeSync Vendor Specific Data Block, IEEE-OUI 00-00-1A.\n"
+"Declares the refresh rate range for the variable refresh rate (Adaptive-Sync) operation.\n"
+"NOTE: there is no public specification, the layout is reverse-engineered from existing EDIDs.";
+
+const edi_field_t cea_vsd_cl::amd_fld_dsc[] = {
+   {&EDID_cl::ByteStr, NULL, offsetof(vsd_amd_t, ieee_id)+1, 0, 3, EF_STR|EF_HEX|EF_LE|EF_RD|EF_FGR, 0, 0xFFFFFF, "IEEE-OUI",
+   "IEEE Registration Id LE" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, ver_major)+1, 0, 1, EF_BYTE|EF_INT, 0, 0xFF, "ver_major",
+   "Version: major" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, ver_minor)+1, 0, 1, EF_BYTE|EF_INT, 0, 0xFF, "ver_minor",
+   "Version: minor" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, min_refr)+1, 0, 1, EF_BYTE|EF_INT|EF_HZ, 0, 0xFF, "min_refresh",
+   "Minimum refresh rate, Hz" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, max_refr)+1, 0, 1, EF_BYTE|EF_INT|EF_HZ, 0, 0xFF, "max_refresh",
+   "Maximum refresh rate, Hz" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, flags_1x)+1, 0, 1, EF_BYTE|EF_HEX, 0, 0xFF, "flags_1x",
+   "FreeSync 1.x flags, 0xE6 mask: MCCS is used to switch the refresh rate range." },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, flags_2x)+1, 0, 1, EF_BYTE|EF_HEX, 0, 0xFF, "flags_2x",
+   "Optional: FreeSync 2.x (Premium Pro) flags" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, max_lum)+1, 0, 1, EF_BYTE|EF_INT, 0, 0xFF, "max_lum",
+   "Optional: maximum luminance, code value" },
+   {&EDID_cl::ByteVal, NULL, offsetof(vsd_amd_t, min_lum)+1, 0, 1, EF_BYTE|EF_INT, 0, 0xFF, "min_lum",
+   "Optional: minimum luminance, code value" }
+};
+
+const gpfld_dsc_t cea_vsd_cl::amd_fld_grp[] = {
+   { //amd_freesync
+      .flags    = TG_FLEX_LAYOUT|TG_FLEX_LEN,
+      .fcount   = dsc_count(cea_vsd_cl::amd_fld_dsc),
+      .dat_sz   = sizeof(vsd_amd_t),
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::amd_fld_dsc
+   }
+};
+
+static gpflat_lay_t *VSD_AMD_layout[32];
+
+const gpflat_dsc_t cea_vsd_cl::VSD_AMD_grp = {
+   .CodN     = "VSD",
+   .Name     = "Vendor Specific Data Block: AMD FreeSync",
+   .Desc     = AMD_Desc,
+   .type_id  = ID_VSD,
+   .flags    = TG_FLEX_LAYOUT,
+   .min_len  = (offsetof(vsd_amd_t, flags_1x) +1),
+   .max_len  = 31,
+   .max_fld  = (32 - sizeof(vsd_amd_t) - sizeof(bhdr_t) + dsc_count(cea_vsd_cl::amd_fld_dsc) + CEA_DBCHDR_FCNT),
+   .hdr_fcnt = CEA_DBCHDR_FCNT,
+   .hdr_sz   = sizeof(bhdr_t),
+   .fld_arsz = dsc_count(cea_vsd_cl::amd_fld_grp),
+   .fld_ar   = cea_vsd_cl::amd_fld_grp,
+   .layout   = VSD_AMD_layout
+};
+
+//VSD: unknown IEEE-OUI: raw payload
+const char  cea_vsd_cl::Raw_Desc[] =
+"Vendor Specific Data Block: the IEEE-OUI is not known to wxEDID, the payload is shown as unknown bytes.";
+
+const gpfld_dsc_t cea_vsd_cl::raw_fld_grp[] = {
+   { //vsd_oui
+      .flags    = TG_FLEX_LAYOUT,
+      .fcount   = 1,
+      .dat_sz   = 3,
+      .inst_cnt = 1,
+      .fields   = cea_vsd_cl::hdr_fld_dsc //IEEE-OUI
+   }
+};
+
+static gpflat_lay_t *VSD_Raw_layout[32];
+
+const gpflat_dsc_t cea_vsd_cl::VSD_Raw_grp = {
+   .CodN     = "VSD",
+   .Name     = "Vendor Specific Data Block",
+   .Desc     = Raw_Desc,
+   .type_id  = ID_VSD,
+   .flags    = TG_FLEX_LAYOUT,
+   .min_len  = 3,
+   .max_len  = 31,
+   .max_fld  = (32 - 3 - sizeof(bhdr_t) + 1 + CEA_DBCHDR_FCNT),
+   .hdr_fcnt = CEA_DBCHDR_FCNT,
+   .hdr_sz   = sizeof(bhdr_t),
+   .fld_arsz = dsc_count(cea_vsd_cl::raw_fld_grp),
+   .fld_ar   = cea_vsd_cl::raw_fld_grp,
+   .layout   = VSD_Raw_layout
+};
+
+//VSDEC_* -> group descriptor
+const gpflat_dsc_t* const cea_vsd_cl::dec_ar[VSDEC_COUNT] = {
+   NULL,                     //VSDEC_RAW
+   &cea_vsd_cl::VSD_grp,     //VSDEC_HDMI14
+   &cea_vsd_cl::VSD_HF_grp,  //VSDEC_HF
+   &cea_vsd_cl::VSD_AMD_grp, //VSDEC_AMD
+   NULL,                     //VSDEC_DOVI:   VSVD only
+   NULL                      //VSDEC_HDR10P: VSVD only
 };
 
 rcode cea_vsd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
-   rcode  retU;
+   rcode               retU;
+   const gpflat_dsc_t *pGDsc;
+   u32_t               blk_len;
+   u32_t               dec;
+
+   pGDsc   = &VSD_Raw_grp;
+   blk_len = reinterpret_cast <const bhdr_t*> (inst)->tag.blk_len;
+
+   if (blk_len >= 3) {
+      //the OUI selects the decoder, too short for the decoder: raw payload
+      dec = oui_cl::Decoder(oui_cl::FromLE(inst +1), OUI_BLK_VSD);
+      if ((NULL != dec_ar[dec]) && (blk_len >= dec_ar[dec]->min_len)) {
+         pGDsc = dec_ar[dec];
+      }
+   }
 
-   retU = base_DBC_Init_FlatGrp(inst, &VSD_grp, orflags, parent);
+   retU = base_DBC_Init_FlatGrp(inst, pGDsc, orflags, parent);
    return retU;
 }
 
@@ -1162,16 +1500,6 @@ extern const char SAB_SPM_Desc[];
 extern const gpfld_dsc_t SAB_SPM_fields[];
 extern const edi_field_t SAB_SPM_fld_dsc[];
 
-const gpfld_dsc_t SAB_SPM_fields[] = {
-   {
-      .flags    = 0,
-      .fcount   = 24,
-      .dat_sz   = sizeof(sab_t),
-      .inst_cnt = 1,
-      .fields   = SAB_SPM_fld_dsc
-   }
-};
-
 const edi_field_t SAB_SPM_fld_dsc[] = {
    //SAB byte 0
    {&EDID_cl::BitVal, NULL, offsetof(sab_t, spm0)+1, 0, 1, EF_BIT, 0, 1, "FL_FR",
@@ -1226,6 +1554,18 @@ const edi_field_t SAB_SPM_fld_dsc[] = {
    "reserved (0)" }
 };
 
+const gpfld_dsc_t SAB_SPM_fields[] = {
+   {
+      .flags    = 0,
+      .fcount   = dsc_count(SAB_SPM_fld_dsc),
+      .dat_sz   = sizeof(sab_t),
+      .inst_cnt = 1,
+      .fields   = SAB_SPM_fld_dsc
+   }
+};
+
+static gpflat_lay_t *SAB_layout[32];
+
 const gpflat_dsc_t cea_sab_cl::SAB_grp = {
    .CodN     = "SAB",
    .Name     = "Speaker Allocation Block",
@@ -1234,11 +1574,12 @@ const gpflat_dsc_t cea_sab_cl::SAB_grp = {
    .flags    = 0,
    .min_len  = sizeof(sab_t),
    .max_len  = sizeof(sab_t),
-   .max_fld  = (32 - sizeof(sab_t) - sizeof(bhdr_t) + 24),
+   .max_fld  = (32 - sizeof(sab_t) - sizeof(bhdr_t) + 24 + CEA_DBCHDR_FCNT),
    .hdr_fcnt = CEA_DBCHDR_FCNT,
    .hdr_sz   = sizeof(bhdr_t),
-   .fld_arsz = 1,
-   .fld_ar   = SAB_SPM_fields
+   .fld_arsz = dsc_count(SAB_SPM_fields),
+   .fld_ar   = SAB_SPM_fields,
+   .layout   = SAB_layout
 };
 
 rcode cea_sab_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
@@ -1253,20 +1594,22 @@ const char  cea_vdtc_cl::Desc[] =
 "Gamma value for the display device.\n"
 "The format is exactly the same as in EDID block 0, byte 23";
 
+const edi_field_t cea_vdtc_cl::fld_dsc[] = {
+   {&EDID_cl::Gamma, NULL, offsetof(vtc_t, gamma)+1, 0, 1, EF_FLT|EF_NI, 0, 255, "gamma",
+   "Byte value = (gamma*100)-100 (range 1.00–3.54)" }
+};
+
 const gpfld_dsc_t cea_vdtc_cl::fields[] = {
    {
       .flags    = 0,
-      .fcount   = 1,
+      .fcount   = dsc_count(cea_vdtc_cl::fld_dsc),
       .dat_sz   = sizeof(vtc_t),
       .inst_cnt = 1,
       .fields   = cea_vdtc_cl::fld_dsc
    }
 };
 
-const edi_field_t cea_vdtc_cl::fld_dsc[] = {
-   {&EDID_cl::Gamma, NULL, offsetof(vtc_t, gamma)+1, 0, 1, EF_FLT|EF_NI, 0, 255, "gamma",
-   "Byte value = (gamma*100)-100 (range 1.00–3.54)" }
-};
+static gpflat_lay_t *VDTC_layout[32];
 
 const gpflat_dsc_t cea_vdtc_cl::VDTC_grp = {
    .CodN     = "VDTC",
@@ -1279,8 +1622,9 @@ const gpflat_dsc_t cea_vdtc_cl::VDTC_grp = {
    .max_fld  = (31 + CEA_DBCHDR_FCNT),
    .hdr_fcnt = CEA_DBCHDR_FCNT,
    .hdr_sz   = sizeof(bhdr_t),
-   .fld_arsz = 1,
-   .fld_ar   = cea_vdtc_cl::fields
+   .fld_arsz = dsc_count(cea_vdtc_cl::fields),
+   .fld_ar   = cea_vdtc_cl::fields,
+   .layout   = VDTC_layout
 };
 
 rcode cea_vdtc_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
@@ -1291,6 +1635,8 @@ rcode cea_vdtc_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 }
 
 //UNK-TC: Unknown Data Block (Tag Code)
+static gpflat_lay_t *UNK_TC_layout[32];
+
 const gpflat_dsc_t cea_unktc_cl::UNK_TC_grp = {
    .CodN     = "UNK-TC",
    .Name     = "Unknown Data Block",
@@ -1303,7 +1649,8 @@ const gpflat_dsc_t cea_unktc_cl::UNK_TC_grp = {
    .hdr_fcnt = CEA_DBCHDR_FCNT,
    .hdr_sz   = sizeof(bhdr_t),
    .fld_arsz = 0,
-   .fld_ar   = NULL
+   .fld_ar   = NULL,
+   .layout   = UNK_TC_layout
 };
 
 rcode cea_unktc_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
@@ -1366,7 +1713,7 @@ rcode edi_grp_cl::base_DBC_Init_RootGrp(const u8_t* inst, const gproot_dsc_t *pG
    dlen  = reinterpret_cast <const bhdr_t*> (inst)->tag.blk_len;
    dlen2 = dlen;
    if (dlen < pGDsc->min_len) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
       if (! b_edit_mode) return retU2;
    }
 
@@ -1400,7 +1747,7 @@ rcode edi_grp_cl::base_DBC_Init_RootGrp(const u8_t* inst, const gproot_dsc_t *pG
          if (dlen < pSubGDsc->min_len) {
             if (dlen > 0) {
                //no space left for next sub-group
-               wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
+               DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
             }
             goto payload;
          }
@@ -1412,7 +1759,7 @@ rcode edi_grp_cl::base_DBC_Init_RootGrp(const u8_t* inst, const gproot_dsc_t *pG
          retU2 = pgrp->init(pgrp_inst, type_id, this);
          if (! RCD_IS_OK(retU2)) {
             if (retU2.detail.rcode > RCD_FVMSG) {
-               wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
+               DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
                delete pgrp;
                goto payload;
             }
@@ -1434,7 +1781,7 @@ rcode edi_grp_cl::base_DBC_Init_RootGrp(const u8_t* inst, const gproot_dsc_t *pG
 
 payload:
    if (dlen2 > pGDsc->max_len) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
    }
 
    //unspecified payload: interpreted as unknown sub-group.
@@ -1452,171 +1799,196 @@ payload:
    return retU;
 }
 
-//Universal Init function for DBC blocks (no sub-groups)
-rcode edi_grp_cl::base_DBC_Init_FlatGrp(const u8_t* inst, const gpflat_dsc_t *pGDsc, u32_t orflags, edi_grp_cl* parent) {
-   rcode        retU, retU2;
+//DBC flat group: fields layout for the data length, see flat_layout().
+//The layout depends only on the descriptor and on the data length.
+static rcode flat_layout_gen(const gpflat_dsc_t *pGDsc, u32_t blk_len, gpflat_lay_t *play) {
+   rcode        retU;
    u32_t        dlen;
-   u32_t        dlen2;
    u32_t        offs;
-   u32_t        buflen;
-   u32_t        fldgr_idx;
-   u32_t        gr_inst;
+   u32_t        fcnt;
+   edi_field_t *fldar;
    edi_field_t *p_fld;
-   bool         b_edit_mode;
-
-   //NOTE: All the fault messages are logged, but ignored -> edi_grp_cl::base_clone()
 
    RCD_SET_OK(retU);
-   RCD_SET_OK(retU2);
-   b_edit_mode  = (0 != (T_MODE_EDIT & orflags));
 
-   dlen  = reinterpret_cast <const bhdr_t*> (inst)->tag.blk_len;
-   dlen2 = dlen;
-   if (dlen < pGDsc->min_len) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
-      if (! b_edit_mode) return retU2;
-   }
-
-   parent_grp = parent;
-   type_id    = pGDsc->type_id;
+   play->fields   = NULL;
+   play->fcount   = 0;
+   play->b_badlen = false;
 
-   dlen   += 1; //DBC header
-   buflen  = (b_edit_mode) ? 32 : dlen;
-   memcpy(inst_data, inst, buflen); //Local data copy
-   dat_sz  = dlen;
+   dlen = blk_len +1; //DBC header
    if (dlen >= pGDsc->hdr_sz) {
       dlen  -= pGDsc->hdr_sz;
    } else {
       dlen  -= 1;
    }
 
-   //max fields:
-   dyn_fldar = (edi_field_t*) malloc( pGDsc->max_fld * EDI_FIELD_SZ );
-   if (NULL == dyn_fldar) RCD_RETURN_FAULT(retU);
-   dyn_fcnt  = pGDsc->hdr_fcnt;
-   p_fld     = dyn_fldar;
+   fldar = (edi_field_t*) malloc( pGDsc->max_fld * EDI_FIELD_SZ );
+   if (NULL == fldar) RCD_RETURN_FAULT(retU);
 
-   memcpy( p_fld, CEA_BlkHdr_fields, (pGDsc->hdr_fcnt * EDI_FIELD_SZ) );
-   p_fld += pGDsc->hdr_fcnt;
-   offs   = pGDsc->hdr_sz;
+   if (pGDsc->hdr_fcnt > pGDsc->max_fld) goto dsc_err;
 
-   for (fldgr_idx=0; fldgr_idx<pGDsc->fld_arsz; ++fldgr_idx) {
+   memcpy( fldar, CEA_BlkHdr_fields, (pGDsc->hdr_fcnt * EDI_FIELD_SZ) );
+   fcnt  = pGDsc->hdr_fcnt;
+   p_fld = &fldar[fcnt];
+   offs  = pGDsc->hdr_sz;
+
+   for (u32_t fldgr_idx=0; fldgr_idx<pGDsc->fld_arsz; ++fldgr_idx) {
       const gpfld_dsc_t *pgFld;
-      u32_t fcnt;
-      u32_t dsz;
+            bool         b_offs;
 
-      pgFld = &pGDsc->fld_ar[fldgr_idx];
+      pgFld  = &pGDsc->fld_ar[fldgr_idx];
+      b_offs = ( (TG_FLEX_OFFS & pgFld->flags) != 0);
 
       if ( (TG_FLEX_LAYOUT & pgFld->flags) != 0) {
-         retU2 = base_DBC_Init_GrpFields(pgFld, &p_fld, &dlen, &offs);
-         if (! RCD_IS_OK(retU2)) {
-            wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
-            goto payload;
+         //fields up to the data end
+         u32_t  grlen = 0;
+
+         for (u32_t fidx=0; fidx<pgFld->fcount; ++fidx) {
+            u32_t  fldlen;
+
+            fldlen = pgFld->fields[fidx].fldsize;
+            if (dlen < fldlen) break;
+
+            if (fcnt >= pGDsc->max_fld) goto dsc_err;
+            memcpy( p_fld, &pgFld->fields[fidx], EDI_FIELD_SZ );
+            if (b_offs) p_fld->offs = offs;
+
+            dlen  -= fldlen;
+            grlen += fldlen;
+            offs  += fldlen;
+            p_fld ++ ;
+            fcnt  ++ ;
          }
-         if (RCD_IS_TRUE(retU2)) {
-            continue;
+
+         if ((grlen != pgFld->dat_sz) && ((TG_FLEX_LEN & pgFld->flags) == 0)) {
+            play->b_badlen = true;
+            goto payload;
          }
+         continue;
       }
 
-      fcnt = pgFld->fcount;
-      dsz  = pgFld->dat_sz;
-
       //num of sub-group instances to spawn, if inst_cnt==(-1) -> until data end
-      for (gr_inst=0; gr_inst<(u32_t)pgFld->inst_cnt; ++gr_inst) {
-         bool  b_flex;
+      for (u32_t gr_inst=0; gr_inst<(u32_t)pgFld->inst_cnt; ++gr_inst) {
+
+         if (dlen < pgFld->dat_sz) {
+            bool  b_flex;
 
-         if (dlen < dsz) {
             b_flex  = ((TG_FLEX_LAYOUT & pGDsc->flags)  != 0);
             b_flex |= (                  pgFld->inst_cnt < 0);
-            if (! b_flex) {
-               wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
-            }
+            play->b_badlen = (! b_flex);
             goto payload;
          }
 
-         b_flex = ( (TG_FLEX_OFFS & pgFld->flags) != 0);
-
-         memcpy( p_fld, pgFld->fields, (fcnt * EDI_FIELD_SZ) );
+         if ((fcnt + pgFld->fcount) > pGDsc->max_fld) goto dsc_err;
 
-         if (b_flex) { //update field offsets: all fields have to be of size ==1
-            edi_field_t *p_dstf;
+         memcpy( p_fld, pgFld->fields, (pgFld->fcount * EDI_FIELD_SZ) );
 
-            p_dstf = p_fld;
-            for (u32_t fidx=0; fidx<fcnt; ++fidx) {
-               p_dstf->offs = (offs + fidx);
-               p_dstf      ++ ;
+         if (b_offs) { //update field offsets: all fields have to be of size ==1
+            for (u32_t fidx=0; fidx<pgFld->fcount; ++fidx) {
+               p_fld[fidx].offs = (offs + fidx);
             }
          }
 
-         p_fld    += fcnt;
-         dyn_fcnt += fcnt;
-         dlen     -= dsz;
-         offs     += dsz;
+         p_fld += pgFld->fcount;
+         fcnt  += pgFld->fcount;
+         dlen  -= pgFld->dat_sz;
+         offs  += pgFld->dat_sz;
       }
    }
 
 payload:
-   if (dlen2 > pGDsc->max_len) {
-      wxedid_RCD_SET_FAULT_VMSG(retU2, DBC_BAD_LEN_MSG, pGDsc->CodN);
-   }
-
    //unspecified payload: interpreted as unknown bytes.
    if (dlen > 0) {
-      dyn_fcnt += dlen;
+      if ((fcnt + dlen) > pGDsc->max_fld) goto dsc_err;
+
       insert_unk_byte(p_fld, dlen, offs);
+      fcnt += dlen;
    }
-   retU = init_fields(&dyn_fldar[0], inst_data, dyn_fcnt, 0, pGDsc->Name, pGDsc->Desc, pGDsc->CodN);
 
-   if (RCD_IS_OK(retU)) return retU2;
+   play->fields = fldar;
+   play->fcount = fcnt;
    return retU;
+
+dsc_err:
+   free(fldar);
+   wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] %s: group descriptor: max_fld=%u is too small, blk_len=%u",
+                                pGDsc->CodN, pGDsc->max_fld, blk_len);
 }
 
-rcode edi_grp_cl::base_DBC_Init_GrpFields(const gpfld_dsc_t *pgFld, edi_field_t **pp_fld, u32_t *pdlen, u32_t *poffs) {
-   rcode  retU;
-   u32_t  dlen   = *pdlen;
-   u32_t  offs   = *poffs;
-   u32_t  nfld   = 0;
-   u32_t  grlen  = 0;
-   bool   b_offs = ( (TG_FLEX_OFFS & pgFld->flags) != 0);
+//The layouts are shared by all the EDID_cl instances: the batch workers are initializing
+//the groups concurrently, the first generated layout is used.
+static const gpflat_lay_t* flat_layout(const gpflat_dsc_t *pGDsc, u32_t blk_len, rcode& retU) {
+   gpflat_lay_t  *play;
+   gpflat_lay_t  *pnull;
+
+   RCD_SET_OK(retU);
 
-         edi_field_t *p_fld  = *pp_fld;
-   const edi_field_t *p_srcf = &pgFld->fields[0];
+   play = __atomic_load_n(&pGDsc->layout[blk_len], __ATOMIC_ACQUIRE);
+   if (play != NULL) return play;
 
-   p_srcf -- ;
+   play = new gpflat_lay_t;
+   if (play == NULL) {
+      RCD_SET_FAULT(retU);
+      return NULL;
+   }
 
-   for (; nfld<pgFld->fcount; ++nfld) {
-      u32_t  fldlen;
+   retU = flat_layout_gen(pGDsc, blk_len, play);
+   if (! RCD_IS_OK(retU)) {
+      delete play;
+      return NULL;
+   }
 
-      p_srcf ++ ;
-      fldlen  = p_srcf->fldsize;
+   pnull = NULL;
+   if (! __atomic_compare_exchange_n(&pGDsc->layout[blk_len], &pnull, play, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) ) {
+      free( (void*) play->fields );
+      delete play;
+      play = pnull;
+   }
 
-      if (dlen < fldlen) break;
+   return play;
+}
 
-      memcpy( p_fld, p_srcf, EDI_FIELD_SZ );
-      if (b_offs) { //update fields offsets:
-         p_fld->offs = offs;
-      }
-      dlen  -= fldlen;
-      grlen += fldlen;
-      offs  += fldlen;
-      p_fld ++ ;
+//Universal Init function for DBC blocks (no sub-groups)
+rcode edi_grp_cl::base_DBC_Init_FlatGrp(const u8_t* inst, const gpflat_dsc_t *pGDsc, u32_t orflags, edi_grp_cl* parent) {
+   rcode               retU, retU2;
+   u32_t               blk_len;
+   u32_t               dlen;
+   u32_t               buflen;
+   bool                b_edit_mode;
+   const gpflat_lay_t *play;
+
+   //NOTE: All the fault messages are logged, but ignored -> edi_grp_cl::base_clone()
+
+   RCD_SET_OK(retU2);
+   b_edit_mode  = (0 != (T_MODE_EDIT & orflags));
+
+   blk_len = reinterpret_cast <const bhdr_t*> (inst)->tag.blk_len;
+   if (blk_len < pGDsc->min_len) {
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
+      if (! b_edit_mode) return retU2;
    }
 
-   retU = RCD_SET_VAL(RCD_UNIT, RCD_TRUE, __LINE__);
+   parent_grp = parent;
+   type_id    = pGDsc->type_id;
 
-   if (grlen != pgFld->dat_sz) {
-      bool  b_flex;
-      b_flex  = ((TG_FLEX_LEN & pgFld->flags) != 0);
-      if (! b_flex) {
-         RCD_SET_FAULT(retU); //Bad length
-      }
+   dlen    = blk_len +1; //DBC header
+   buflen  = (b_edit_mode) ? 32 : dlen;
+   memcpy(inst_data, inst, buflen); //Local data copy
+   dat_sz  = dlen;
+
+   play = flat_layout(pGDsc, blk_len, retU);
+   if (NULL == play) return retU;
+
+   if (play->b_badlen) {
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
+   }
+   if (blk_len > pGDsc->max_len) {
+      DIAG_SET_FAULT_VMSG(retU2, DIAG_OFFS_CTX, DBC_BAD_LEN_MSG, pGDsc->CodN);
    }
 
-   *pp_fld   = p_fld;
-   *poffs    = offs;
-   *pdlen    = dlen;
-   dyn_fcnt += nfld;
+   retU = init_fields(play->fields, inst_data, play->fcount, 0, pGDsc->Name, pGDsc->Desc, pGDsc->CodN);
 
+   if (RCD_IS_OK(retU)) return retU2;
    return retU;
 }
-
@@ -11,6 +11,7 @@
 #define CEA_CLASS_H 1
 
 #include "EDID_shared.h"
+#include "oui.h"
 
 //----------------- CEA/CTA-861 extension
 
@@ -41,27 +42,25 @@ class cea_adb_cl : public dbc_grp_cl {
 //SAD: Short Audio Descriptor
 class cea_sad_cl : public edi_grp_cl {
    private:
-      enum {
-         //SAD byte 0: AFC = 1...14
-         byte0_afc1_14_fcnt          = 3,
-         byte0_afc15_ace11_12_fcnt   = 3,
-         byte0_afc15_ace13_fcnt      = 2,
-         //SAD byte 1: AFC = 1...14 || AFC = 15 && ACE = 11 (MPEG-H 3D Audio)
-         byte1_afc1_14_ace11_fcnt    = 8,
-         byte1_afc15_ace456810_fcnt  = 8,
-         byte1_afc15_ace12_fsmp_fcnt = 8,
-         byte1_afc15_ace13_fcnt      = 8,
-         //SAD byte 2: AFC = 1: LPCM
-         byte2_afc1_fcnt             = 4,
-         byte2_afc2_8_fcnt           = 1,
-         byte2_afc9_13_fcnt          = 1,
-         byte2_afc14_fcnt            = 2,
-         byte2_afc15_ace456_fcnt     = 4,
-         byte2_afc15_ace8_10_fcnt    = 4,
-         byte2_afc15_ace11_12_fcnt   = 2,
-         byte2_afc15_ace13_fcnt      = 4,
+      enum { //data layouts: index in layouts[]
+         lay_bad_afc = 0,
+         lay_bad_ace,
+         lay_afc1,
+         lay_afc2_8,
+         lay_afc9_13,
+         lay_afc14,
+         lay_afc15_ace456,
+         lay_afc15_ace8_10,
+         lay_afc15_ace11,
+         lay_afc15_ace12,
+         lay_afc15_ace13
       };
 
+      //fields of SAD bytes 0-2
+      typedef struct {
+         fld_lay_t  byte[3];
+      } sad_lay_t;
+
       //block data layouts
       static const edi_field_t byte0_afc1_14[];
       static const edi_field_t byte0_afc15_ace11_12[];
@@ -84,10 +83,19 @@ class cea_sad_cl : public edi_grp_cl {
       //SAD unknown/invalid byte:
       static const edi_field_t byte_unk[];
 
+      static const sad_lay_t   layouts[];
+      static const u8_t        afc_layout[];  //[AFC], AFC < 15
+      static const u8_t        ace_layout[];  //[ACE], AFC = 15
+
       static const char        Desc[];
 
-      //SAD needs custom constructor for field array
-      rcode  gen_data_layout(const u8_t* inst);
+      //layouts[] fields, concatenated: NULL until the layout is used
+      static edi_field_t      *lay_fields[];
+
+      static const edi_field_t* lay_get(u32_t lay_idx, u32_t& fcount);
+
+      //pfields: shared array of dyn_fcnt fields, NULL if out of memory
+      rcode  gen_data_layout(const u8_t* inst, const edi_field_t*& pfields);
 
    public:
       static const subgrp_dsc_t SAD_subg;
@@ -127,8 +135,10 @@ class cea_svd_cl : public edi_grp_cl {
       static edi_grp_cl* group_new() {return new cea_svd_cl();};
 };
 //VSD: Vendor Specific Data Block
+//The payload decoder is selected by the IEEE OUI, see oui.h
 class cea_vsd_cl : public edi_grp_cl {
    private:
+      //HDMI Licensing, LLC: HDMI 1.4
       static const char          Desc[];
       static const edi_field_t   hdr_fld_dsc[];
       static const edi_field_t   sink_feat_fld_dsc[];
@@ -137,6 +147,29 @@ class cea_vsd_cl : public edi_grp_cl {
       static const edi_field_t   av_latency_fld_dsc[];
       static const gpfld_dsc_t   sub_fld_grp[];
       static const gpflat_dsc_t  VSD_grp;
+      //HDMI Forum: HF-VSDB
+      static const char          HF_Desc[];
+      static const edi_field_t   hf_hdr_fld_dsc[];
+      static const edi_field_t   hf_scdc_fld_dsc[];
+      static const edi_field_t   hf_frl_fld_dsc[];
+      static const edi_field_t   hf_vrr_fld_dsc[];
+      static const edi_field_t   hf_vrr_rng_fld_dsc[];
+      static const edi_field_t   hf_dsc_fld_dsc[];
+      static const edi_field_t   hf_dsc_frl_fld_dsc[];
+      static const edi_field_t   hf_dsc_chunk_fld_dsc[];
+      static const gpfld_dsc_t   hf_fld_grp[];
+      static const gpflat_dsc_t  VSD_HF_grp;
+      //AMD FreeSync
+      static const char          AMD_Desc[];
+      static const edi_field_t   amd_fld_dsc[];
+      static const gpfld_dsc_t   amd_fld_grp[];
+      static const gpflat_dsc_t  VSD_AMD_grp;
+      //unknown OUI: raw payload
+      static const char          Raw_Desc[];
+      static const gpfld_dsc_t   raw_fld_grp[];
+      static const gpflat_dsc_t  VSD_Raw_grp;
+      //VSDEC_* -> group descriptor, NULL: raw
+      static const gpflat_dsc_t* const dec_ar[VSDEC_COUNT];
 
    public:
       rcode       init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent);
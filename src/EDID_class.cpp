@@ -235,8 +235,8 @@ rcode EDID_cl::ParseDBC_TAG(u8_t *pinst, edi_grp_cl** pp_grp) {
                   //CTA-861-G: reserved Extended Tag Codes: 8-12, 21-31, 33-255
                   //UNK-ET: Unknown Data Block (Extended Tag Code)
                   pgrp = new cea_unket_cl;
-                  wxedid_RCD_SET_FAULT_VMSG(retU,
-                                            "[E!] CTA-861 DBC: invalid Extended Tag Code=%u",
+                  DIAG_SET_FAULT_VMSG(retU, DIAG_OFFS_CTX,
+                                      "[E!] CTA-861 DBC: invalid Extended Tag Code=%u",
                                             etag);
             }
          }
@@ -245,8 +245,8 @@ rcode EDID_cl::ParseDBC_TAG(u8_t *pinst, edi_grp_cl** pp_grp) {
          //CTA-861-G: reserved Tag Codes: 0,6
          //UNK-TC: Unknown Data Block (Tag Code)
          pgrp = new cea_unktc_cl;
-         wxedid_RCD_SET_FAULT_VMSG(retU,
-                                   "[E!] CTA-861 DBC: invalid Tag Code=%u", tagcode);
+         DIAG_SET_FAULT_VMSG(retU, DIAG_OFFS_CTX,
+                             "[E!] CTA-861 DBC: invalid Tag Code=%u", tagcode);
    }
 
   *pp_grp = pgrp;
@@ -303,6 +303,8 @@ rcode EDID_cl::ParseEDID_CEA() {
 
    u8_t *pext = EDID_buff.edi.ext0;
 
+   diag_scope_cl  dscope(b_ERR_Ignore ? pDiag : NULL);
+
    // CEA/CTA-861 header
    pgrp = new cea_hdr_cl;
    if (pgrp == NULL) RCD_RETURN_FAULT(retU);
@@ -340,12 +342,14 @@ rcode EDID_cl::ParseEDID_CEA() {
          ethdr.w16 = reinterpret_cast<u16_t*> (pinst)[0];
          blklen    = ethdr.ehdr.hdr.tag.blk_len;
 
+         if (pDiag != NULL) pDiag->SetCtxOffs(calcGroupOffs(pinst));
+
          if (p8_dtd < (pinst + blklen)) {
-            wxedid_RCD_SET_FAULT_VMSG(retU,
-                                      "[E!] CTA-861: Collision: DTD offset=%u and DBC@offset=%u, len=%u",
-                                      dtd_offs, (u32_t) (calcGroupOffs(pinst) % sizeof(edid_t)), blklen);
+            DIAG_SET_FAULT_VMSG(retU, calcGroupOffs(pinst),
+                                "[E!] CTA-861: Collision: DTD offset=%u and DBC@offset=%u, len=%u",
+                                dtd_offs, (u32_t) (calcGroupOffs(pinst) % sizeof(edid_t)), blklen);
             if (! b_ERR_Ignore) return retU;
-            pGLog->PrintRcode(retU);
+            PrintFault(retU);
             RCD_SET_OK(retU);
          }
 
@@ -362,11 +366,11 @@ rcode EDID_cl::ParseEDID_CEA() {
       } while (pinst < pend);
 
       if (pinst != p8_dtd) {
-         wxedid_RCD_SET_FAULT_VMSG(retU,
-                                   "[E!] CTA-861: DTD offset=%u != DBC_end=%u",
-                                   dtd_offs, (u32_t) (calcGroupOffs(pinst) % sizeof(edid_t)) );
+         DIAG_SET_FAULT_VMSG(retU, calcGroupOffs(pinst),
+                             "[E!] CTA-861: DTD offset=%u != DBC_end=%u",
+                             dtd_offs, (u32_t) (calcGroupOffs(pinst) % sizeof(edid_t)) );
          if (! b_ERR_Ignore) return retU;
-         pGLog->PrintRcode(retU);
+         PrintFault(retU);
          RCD_SET_OK(retU);
       }
    }
@@ -387,11 +391,11 @@ rcode EDID_cl::ParseEDID_CEA() {
       //mandatory DTDs for *native* mode
       if (num_dtd > 0) {
          if (max_dtd < num_dtd) {
-            wxedid_RCD_SET_FAULT_VMSG(retU,
-                                      "[E!] CTA-861: insufficient space for declared number of native DTDs: %u, max: %u",
-                                      num_dtd, max_dtd);
+            DIAG_SET_FAULT_VMSG(retU, calcGroupOffs(pinst),
+                                "[E!] CTA-861: insufficient space for declared number of native DTDs: %u, max: %u",
+                                num_dtd, max_dtd);
             if (! b_ERR_Ignore) return retU;
-            pGLog->PrintRcode(retU);
+            PrintFault(retU);
             num_dtd = max_dtd;
             RCD_SET_OK(retU);
          }
@@ -399,11 +403,11 @@ rcode EDID_cl::ParseEDID_CEA() {
          for (i32_t itd=0; itd<num_dtd; itd++) {
 
             if (pdtd->pix_clk == 0) {
-               wxedid_RCD_SET_FAULT_VMSG(retU,
-                                         "[E!] CTA-861: missing mandatory DTD @ offset %u",
-                                         (u32_t) (reinterpret_cast <u8_t*> (pdtd) - EDID_buff.buff) );
+               DIAG_SET_FAULT_VMSG(retU, calcGroupOffs(pdtd),
+                                   "[E!] CTA-861: missing mandatory DTD @ offset %u",
+                                   (u32_t) (reinterpret_cast <u8_t*> (pdtd) - EDID_buff.buff) );
                if (! b_ERR_Ignore) return retU;
-               pGLog->PrintRcode(retU);
+               PrintFault(retU);
                RCD_SET_OK(retU);
                break;
             }
@@ -459,11 +463,11 @@ rcode EDID_cl::ParseEDID_CEA() {
 
       for (i32_t itb=0; itb<space_left; itb++) {
          if (*p8_dtd != 0) {
-            wxedid_RCD_SET_FAULT_VMSG(retU,
-                                      "[E!] CTA-861: padding byte != 0 @ offset %u",
-                                      (u32_t) (p8_dtd - EDID_buff.buff) );
+            DIAG_SET_FAULT_VMSG(retU, calcGroupOffs(p8_dtd),
+                                "[E!] CTA-861: padding byte != 0 @ offset %u",
+                                (u32_t) (p8_dtd - EDID_buff.buff) );
             if (! b_ERR_Ignore) return retU;
-            pGLog->PrintRcode(retU);
+            PrintFault(retU);
             RCD_SET_OK(retU);
          }
 
@@ -486,6 +490,10 @@ rcode EDID_cl::ParseEDID_Base(u32_t& n_extblk) {
    EDI_BaseGrpAr.Empty();
    num_valid_blocks = 0;
 
+   //new parse: ParseEDID_CEA() appends to the list
+   if (pDiag != NULL) pDiag->Clear();
+   diag_scope_cl  dscope(b_ERR_Ignore ? pDiag : NULL);
+
    //check header
    if (!b_ERR_Ignore && ((EDID_buff.edi.base.hdr.hdr_uint[0] != 0xFFFFFF00) ||
                        (EDID_buff.edi.base.hdr.hdr_uint[1] != 0x00FFFFFF)) )
@@ -629,10 +637,10 @@ edi_grp_cl* EDID_cl::ParseDetDtor(u32_t blkidx, dsctor_u* pdsc, rcode& retU) {
          //UNK: Unknown Descriptor (fallback)
          pgrp = new unk_cl;
          if (pgrp == NULL) {RCD_SET_FAULT(retU); return NULL; }
-         wxedid_RCD_SET_FAULT_VMSG(retU,
-                                   "[E!] EDID block%u: unknown descriptor type=0x%02X @offset=%u",
-                                   blkidx, dsctype, calcGroupOffs(pdsc));
-         pGLog->PrintRcode(retU);
+         DIAG_SET_FAULT_VMSG(retU, calcGroupOffs(pdsc),
+                             "[E!] EDID block%u: unknown descriptor type=0x%02X @offset=%u",
+                             blkidx, dsctype, calcGroupOffs(pdsc));
+         PrintFault(retU);
          break;
    }
 
@@ -660,8 +668,12 @@ bool EDID_cl::VerifyChksum(u32_t block) {
 u32_t EDID_cl::genChksum(u32_t block) {
    if (block > EDI_EXT2_IDX) return 0;
 
+   return calcChksum(EDID_buff.blk[block]);
+}
+
+//checksum of a block in any buffer: the result is written to the last byte
+u32_t EDID_cl::calcChksum(u8_t *pblk) {
    u32_t csum = 0;
-   u8_t *pblk = EDID_buff.blk[block];
 
    for (u32_t itb=0; itb<(EDI_BLK_SIZE-1); itb++) {
       csum += pblk[itb];
@@ -676,7 +688,62 @@ void EDID_cl::Clear() {
    memset(EDID_buff.buff, 0, sizeof(edi_buf_t) );
 }
 
-void EDID_cl::CEA_Set_DTD_Offset(u8_t *pbuf, GroupAr_cl *p_grp_ar) {
+//take over the data buffer and the group arrays parsed by another instance.
+//current groups are not deleted: these are owned by the BlockTree items.
+void EDID_cl::MoveFrom(EDID_cl& src) {
+   GroupAr_cl *p_dst_ar;
+   GroupAr_cl *p_src_ar;
+   GroupAr_cl *sub_ar;
+   edi_grp_cl *pgrp;
+
+   memcpy(EDID_buff.buff, src.EDID_buff.buff, sizeof(edi_buf_t) );
+   num_valid_blocks = src.num_valid_blocks;
+
+   for (u32_t itb=0; itb<4; itb++) {
+      p_dst_ar = BlkGroupsAr[itb];
+      p_src_ar = src.BlkGroupsAr[itb];
+
+      p_dst_ar->Empty();
+
+      for (u32_t itg=0; itg<p_src_ar->GetCount(); itg++) {
+         pgrp = p_src_ar->Item(itg);
+         //re-link the group and its sub-groups array to the new parent array
+         p_dst_ar->Append(pgrp);
+
+         sub_ar = pgrp->getSubArray();
+         if (sub_ar != NULL) {
+            sub_ar->setParentArray(p_dst_ar);
+         }
+      }
+      p_src_ar->Empty();
+
+      //free/used used bytes in the block
+      p_dst_ar->CalcDataSZ(NULL);
+   }
+}
+
+//delete groups of an instance not attached to the BlockTree (parser threads, corpus decoder)
+void EDID_cl::DeleteGroups() {
+   GroupAr_cl *p_grp_ar;
+   edi_grp_cl *pgrp;
+
+   for (u32_t itb=0; itb<4; itb++) {
+      p_grp_ar = BlkGroupsAr[itb];
+
+      for (u32_t itg=0; itg<p_grp_ar->GetCount(); itg++) {
+         pgrp = p_grp_ar->Item(itg);
+         //sub-groups are not owned by the parent group
+         for (u32_t its=0; its<pgrp->getSubGrpCount(); its++) {
+            delete pgrp->getSubGroup(its);
+         }
+         delete pgrp;
+      }
+      p_grp_ar->Empty();
+   }
+}
+
+//b_log: the const AssembleEDID() logs nothing
+void EDID_cl::CEA_Set_DTD_Offset(u8_t *pbuf, GroupAr_cl *p_grp_ar, bool b_log) const {
    edi_grp_cl *pgrp;
    cea_hdr_t  *cea_hdr;
    u32_t       num_dtd;
@@ -709,7 +776,7 @@ void EDID_cl::CEA_Set_DTD_Offset(u8_t *pbuf, GroupAr_cl *p_grp_ar) {
 done:
    cea_hdr->dtd_offs = dtd_offs;
 
-   {
+   if (b_log) {
       u32_t num_dbc;
 
       num_dbc  = grp_cnt;
@@ -723,6 +790,29 @@ done:
 }
 
 rcode EDID_cl::AssembleEDID() {
+   return assemble(EDID_buff, true);
+}
+
+//Non-destructive assembly: the groups are copied to the dst buffer, the EDID_buff and the
+//group data are not modified. Blocks without parsed groups are copied from EDID_buff.
+rcode EDID_cl::AssembleEDID(edi_buf_t& dst, bool b_chksum) const {
+   rcode  retU;
+
+   memcpy(dst.buff, EDID_buff.buff, sizeof(edi_buf_t) );
+
+   retU = assemble(dst, false);
+   if (! RCD_IS_OK(retU)) return retU;
+
+   if (b_chksum) {
+      for (u32_t block=0; block<num_valid_blocks; ++block) {
+         calcChksum(dst.blk[block]);
+      }
+   }
+
+   return retU;
+}
+
+rcode EDID_cl::assemble(edi_buf_t& dst, bool b_log) const {
    edi_grp_cl  *pgrp;
    GroupAr_cl  *p_grp_ar;
 
@@ -735,8 +825,8 @@ rcode EDID_cl::AssembleEDID() {
    rcode  retU;
 
    for (block=0; block<num_valid_blocks; ++block) {
-      pbuf     = EDID_buff.blk[block];
-      p_grp_ar = BlkGroupsAr  [block];
+      pbuf     = dst.blk   [block];
+      p_grp_ar = BlkGroupsAr[block];
       blk_sz   = sizeof(edid_t);
       blk_sz  -= 1; //checksum byte
       offs     = 0;
@@ -782,7 +872,7 @@ rcode EDID_cl::AssembleEDID() {
       //CEA:
       if (block == 1) {
          //Update DTD offset
-         CEA_Set_DTD_Offset(pbuf, p_grp_ar);
+         CEA_Set_DTD_Offset(pbuf, p_grp_ar, b_log);
          //clear unused bytes
          for (i32_t itb=0; itb<blk_sz; ++itb) {
             pbuf[offs] = 0;
@@ -954,6 +1044,194 @@ rcode EDID_cl::ByteVal(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_fi
    return retU;
 }
 
+//Typed accessors: the flags are template parameters, the format is resolved at compile time.
+template <u32_t shift, u32_t flags>
+rcode EDID_cl::BitValT(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field) {
+   static_assert(shift < 8, "BitValT: bit position out of range");
+   static const u8_t  bmask = (1 << shift);
+
+   rcode  retU;
+   u8_t  *inst;
+   ulong  val;
+
+   inst = getValPtr(p_field);
+
+   if (op == OP_READ) {
+      ival = ((inst[0] & bmask) >> shift);
+      sval << ival;
+      RCD_RETURN_OK(retU);
+   }
+
+   if (op == OP_WRSTR) {
+      retU = getStrUint(sval, 10, 0, 1, val);
+      if (! RCD_IS_OK(retU)) return retU;
+   } else
+   if (op == OP_WRINT) {
+      if ((flags & EF_NI) != 0) RCD_RETURN_FAULT(retU);
+      val = ival;
+      RCD_SET_OK(retU);
+   } else {
+      RCD_RETURN_FAULT(retU); //wrong op code
+   }
+
+   inst[0] &= ~bmask;
+   inst[0] |= ((val << shift) & bmask);
+   return retU;
+}
+
+template <u32_t flags>
+rcode EDID_cl::BitF8ValT(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field) {
+   static const int  base = ((flags & EF_INT) != 0) ? 10 : ((flags & EF_HEX) != 0) ? 16 : 2;
+
+   rcode  retU;
+   u8_t  *inst;
+   u32_t  shift;
+   u32_t  bmask;
+   ulong  tmpv;
+
+   inst  = getValPtr(p_field);
+   shift = p_field->field.shift;
+   bmask = (0xFF >> (8 - p_field->field.fldsize));
+
+   if (op == OP_READ) {
+      ival = ((inst[0] >> shift) & bmask);
+
+      if (base == 10) {
+         sval.Empty(); sval << ival;
+      } else
+      if (base == 16) {
+         sval.Printf("0x%02X", ival);
+      } else {
+         u32_t  nbit;
+         char   chbit[12];
+
+         //"0b" + bits, MSB first
+         nbit     = p_field->field.fldsize;
+         chbit[0] = '0';
+         chbit[1] = 'b';
+         for (u32_t itb=0; itb<nbit; itb++) {
+            chbit[1 + nbit - itb] = 0x30 + ((ival >> itb) & 0x01); //to ASCII
+         }
+         chbit[2 + nbit] = 0;
+         sval = chbit;
+      }
+      RCD_RETURN_OK(retU);
+   }
+
+   if (op == OP_WRSTR) {
+      retU = getStrUint(sval, base, p_field->field.minv, p_field->field.maxv, tmpv);
+      if (! RCD_IS_OK(retU)) return retU;
+   } else
+   if (op == OP_WRINT) {
+      if ((flags & EF_NI) != 0) RCD_RETURN_FAULT(retU);
+      tmpv = ival;
+      RCD_SET_OK(retU);
+   } else {
+      RCD_RETURN_FAULT(retU); //wrong op code
+   }
+
+   bmask <<= shift;
+   inst[0] &= ~bmask;
+   inst[0] |= ((tmpv << shift) & bmask);
+   return retU;
+}
+
+template <u32_t flags>
+rcode EDID_cl::ByteValT(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field) {
+   static const bool  b_hex = ((flags & EF_HEX) != 0);
+
+   rcode  retU;
+   u8_t  *inst;
+   ulong  val;
+
+   inst = getValPtr(p_field);
+
+   if (op == OP_READ) {
+      ival = inst[0];
+      if (b_hex) {
+         sval.Printf("0x%02X", ival);
+      } else {
+         sval.Empty(); sval << ival;
+      }
+      RCD_RETURN_OK(retU);
+   }
+
+   if (op == OP_WRSTR) {
+      if (b_hex && (sval.SubString(0, 1) != "0x")) RCD_RETURN_FAULT(retU);
+      retU = getStrUint(sval, (b_hex ? 16 : 10), p_field->field.minv, p_field->field.maxv, val);
+      if (! RCD_IS_OK(retU)) return retU;
+   } else
+   if (op == OP_WRINT) {
+      if ((flags & EF_NI) != 0) RCD_RETURN_FAULT(retU);
+      val = ival;
+      RCD_SET_OK(retU);
+   } else {
+      RCD_RETURN_FAULT(retU); //wrong op code
+   }
+
+   inst[0] = val;
+   return retU;
+}
+
+//BitVal/BitF8Val/ByteVal -> typed accessor, other handlers are returned unchanged.
+//Fields with inconsistent flags keep the generic handler, which reports the error on access.
+field_fn EDID_cl::TypedHandler(const edi_field_t& field) {
+   static const field_fn  bitval_fn[2][8] = {
+      {&EDID_cl::BitValT<0, 0>, &EDID_cl::BitValT<1, 0>, &EDID_cl::BitValT<2, 0>, &EDID_cl::BitValT<3, 0>,
+       &EDID_cl::BitValT<4, 0>, &EDID_cl::BitValT<5, 0>, &EDID_cl::BitValT<6, 0>, &EDID_cl::BitValT<7, 0>},
+      {&EDID_cl::BitValT<0, EF_NI>, &EDID_cl::BitValT<1, EF_NI>, &EDID_cl::BitValT<2, EF_NI>, &EDID_cl::BitValT<3, EF_NI>,
+       &EDID_cl::BitValT<4, EF_NI>, &EDID_cl::BitValT<5, EF_NI>, &EDID_cl::BitValT<6, EF_NI>, &EDID_cl::BitValT<7, EF_NI>}
+   };
+   //[EF_NI][bin, int, hex]
+   static const field_fn  bitf8_fn[2][3] = {
+      {&EDID_cl::BitF8ValT<0>    , &EDID_cl::BitF8ValT<EF_INT>      , &EDID_cl::BitF8ValT<EF_HEX>      },
+      {&EDID_cl::BitF8ValT<EF_NI>, &EDID_cl::BitF8ValT<EF_INT|EF_NI>, &EDID_cl::BitF8ValT<EF_HEX|EF_NI>}
+   };
+   //[EF_NI][int, hex]
+   static const field_fn  byteval_fn[2][2] = {
+      {&EDID_cl::ByteValT<EF_INT>      , &EDID_cl::ByteValT<EF_HEX>      },
+      {&EDID_cl::ByteValT<EF_INT|EF_NI>, &EDID_cl::ByteValT<EF_HEX|EF_NI>}
+   };
+
+   u32_t  flags;
+   u32_t  ni;
+
+   flags = field.flags;
+   ni    = ((flags & EF_NI) != 0) ? 1 : 0;
+
+   if (field.handlerfn == &EDID_cl::BitVal) {
+      if ((flags & EF_BIT) == 0) return field.handlerfn;
+      if (field.shift > 7) return field.handlerfn;
+
+      return bitval_fn[ni][field.shift];
+   }
+
+   if (field.handlerfn == &EDID_cl::BitF8Val) {
+      if ((flags & EF_BFLD) == 0) return field.handlerfn;
+      if ((field.fldsize + field.shift) > 8) return field.handlerfn;
+
+      //BitF8Val: EF_INT takes precedence over EF_HEX
+      if ((flags & EF_INT) != 0) return bitf8_fn[ni][1];
+      if ((flags & EF_HEX) != 0) return bitf8_fn[ni][2];
+      return bitf8_fn[ni][0];
+   }
+
+   if (field.handlerfn == &EDID_cl::ByteVal) {
+      if ((flags & (EF_BIT|EF_STR)) != 0) return field.handlerfn;
+
+      switch (flags & (EF_INT|EF_HEX)) {
+         case EF_INT:
+            return byteval_fn[ni][0];
+         case EF_HEX:
+            return byteval_fn[ni][1];
+         default: //no format or both: the generic handler
+            break;
+      }
+   }
+
+   return field.handlerfn;
+}
+
 rcode EDID_cl::FldPadString(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field) {
    rcode  retU;
    u32_t  itb;
@@ -1474,9 +1752,16 @@ const edi_field_t vindsc_cl::in_digital[] = {
    "NOTE: This field overlap fields defined for Analog input." },
 };
 
+//VID: input type: 0=analog, 1=digital
+const fld_lay_t vindsc_cl::layouts[] = {
+   FLD_LAYOUT(in_analog),
+   FLD_LAYOUT(in_digital)
+};
+
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 rcode vindsc_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
-   rcode retU;
+   rcode            retU;
+   const fld_lay_t *play;
 
    parent_grp = parent;
    type_id    = ID_VID | T_EDID_FIXED;
@@ -1485,49 +1770,32 @@ rcode vindsc_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 
    CopyInstData(inst, sizeof(vid_in_t));
 
-   //pre-alloc buffer for array of fields
-   dyn_fldar = (edi_field_t*) malloc( max_fcnt * sizeof(edi_field_t) );
-   if (NULL == dyn_fldar) RCD_RETURN_FAULT(retU);
-
-   //no error possible, init_fields is always called.
-   retU = gen_data_layout(inst_data);
-
-   retU = init_fields(&dyn_fldar[0], inst_data, dyn_fcnt, 0, Name, Desc, CodN);
+   play = data_layout(inst_data);
+   retU = init_fields(play->fields, inst_data, play->fcount, 0, Name, Desc, CodN);
 
    return retU;
 }
 #pragma GCC diagnostic warning "-Wunused-parameter"
 
 rcode vindsc_cl::ForcedGroupRefresh() {
-   rcode retU;
-
-   //clear fields
-   memset( (void*) dyn_fldar, 0, ( max_fcnt * EDI_FIELD_SZ ) );
+   rcode            retU;
+   const fld_lay_t *play;
 
-   //no error possible, init_fields is always called.
-   retU = gen_data_layout(inst_data);
-
-   retU = init_fields(dyn_fldar, inst_data, dyn_fcnt, 0); //note: orflags are cleared.
+   play = data_layout(inst_data);
+   retU = init_fields(play->fields, inst_data, play->fcount, 0); //note: orflags are cleared.
 
    return retU;
 }
 
-rcode vindsc_cl::gen_data_layout(const u8_t* inst) {
-   rcode  retU;
-   int    md_digital;
+const fld_lay_t* vindsc_cl::data_layout(const u8_t* inst) {
+   static_assert(dsc_count(layouts) == 2, "VID: layouts[]: analog, digital");
+
+   u32_t  md_digital;
 
    //note: EDID block 0: static descriptors use block0 ptr as instance ptr.
    md_digital = reinterpret_cast <const vid_in_t*> (inst)->digital.input_type;
 
-   if (1 == md_digital) {
-      memcpy( dyn_fldar, in_digital, (in_digital_fcnt * EDI_FIELD_SZ) );
-      dyn_fcnt = in_digital_fcnt;
-   } else {
-      memcpy( dyn_fldar, in_analog, (in_analog_fcnt * EDI_FIELD_SZ) );
-      dyn_fcnt = in_analog_fcnt;
-   }
-
-   RCD_RETURN_OK(retU);
+   return &layouts[md_digital];
 }
 
 //BDD: basic display descriptor : handlers
@@ -2529,6 +2797,139 @@ rcode dtd_cl::init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent) {
 }
 #pragma GCC diagnostic warning "-Wunused-parameter"
 
+//DTD constructor: direct access to the timing fields.
+//Same bit layout and masking as the DTD_* handlers, but without the string
+//conversions done by the OP_READ/OP_WRSTR handler modes.
+rcode dtd_cl::RawRead(const u8_t* inst, u32_t fld_idx, u32_t& val) {
+   rcode        retU;
+   const dtd_t *pdtd;
+
+   if (inst == NULL) RCD_RETURN_FAULT(retU);
+
+   pdtd = reinterpret_cast <const dtd_t*> (inst);
+
+   switch (fld_idx) {
+      case DTD_IDX_PIXCLK:
+         val  = pdtd->pix_clk;
+         break;
+      case DTD_IDX_HAPIX:
+         val  = pdtd->HApix_8lsb;
+         val |= (pdtd->HApix_4msb << 8);
+         break;
+      case DTD_IDX_HBPIX:
+         val  = pdtd->HBpix_8lsb;
+         val |= (pdtd->HBpix_4msb << 8);
+         break;
+      case DTD_IDX_VALIN:
+         val  = pdtd->VAlin_8lsb;
+         val |= (pdtd->VAlin_4msb << 8);
+         break;
+      case DTD_IDX_VBLIN:
+         val  = pdtd->VBlin_8lsb;
+         val |= (pdtd->VBlin_4msb << 8);
+         break;
+      case DTD_IDX_HSOFFS:
+         val  = pdtd->HOsync_8lsb;
+         val |= (pdtd->HOsync_2msb << 8);
+         break;
+      case DTD_IDX_HSWIDTH:
+         val  = pdtd->HsyncW_8lsb;
+         val |= (pdtd->HsyncW_2msb << 8);
+         break;
+      case DTD_IDX_VSOFFS:
+         val  = pdtd->VOsync_4lsb;
+         val |= (pdtd->VOsync_2msb << 4);
+         break;
+      case DTD_IDX_VSWIDTH:
+         val  = pdtd->VsyncW_4lsb;
+         val |= (pdtd->VsyncW_2msb << 4);
+         break;
+      case DTD_IDX_HSIZE:
+         val  = pdtd->Hsize_8lsb;
+         val |= (pdtd->Hsize_4msb << 8);
+         break;
+      case DTD_IDX_VSIZE:
+         val  = pdtd->Vsize_8lsb;
+         val |= (pdtd->Vsize_4msb << 8);
+         break;
+      case DTD_IDX_HBORD:
+         val  = pdtd->Hborder_pix;
+         break;
+      case DTD_IDX_VBORD:
+         val  = pdtd->Vborder_lin;
+         break;
+      default:
+         RCD_RETURN_FAULT(retU);
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+rcode dtd_cl::RawWrite(u8_t* inst, u32_t fld_idx, u32_t val) {
+   rcode   retU;
+   dtd_t  *pdtd;
+
+   if (inst == NULL) RCD_RETURN_FAULT(retU);
+
+   pdtd = reinterpret_cast <dtd_t*> (inst);
+
+   switch (fld_idx) {
+      case DTD_IDX_PIXCLK:
+         pdtd->pix_clk     = (val & 0xFFFF);
+         break;
+      case DTD_IDX_HAPIX:
+         pdtd->HApix_8lsb  = (val & 0xFF);
+         pdtd->HApix_4msb  = ((val >> 8) & 0x0F);
+         break;
+      case DTD_IDX_HBPIX:
+         pdtd->HBpix_8lsb  = (val & 0xFF);
+         pdtd->HBpix_4msb  = ((val >> 8) & 0x0F);
+         break;
+      case DTD_IDX_VALIN:
+         pdtd->VAlin_8lsb  = (val & 0xFF);
+         pdtd->VAlin_4msb  = ((val >> 8) & 0x0F);
+         break;
+      case DTD_IDX_VBLIN:
+         pdtd->VBlin_8lsb  = (val & 0xFF);
+         pdtd->VBlin_4msb  = ((val >> 8) & 0x0F);
+         break;
+      case DTD_IDX_HSOFFS:
+         pdtd->HOsync_8lsb = (val & 0xFF);
+         pdtd->HOsync_2msb = ((val >> 8) & 0x03);
+         break;
+      case DTD_IDX_HSWIDTH:
+         pdtd->HsyncW_8lsb = (val & 0xFF);
+         pdtd->HsyncW_2msb = ((val >> 8) & 0x03);
+         break;
+      case DTD_IDX_VSOFFS:
+         pdtd->VOsync_4lsb = (val & 0x0F);
+         pdtd->VOsync_2msb = ((val >> 4) & 0x03);
+         break;
+      case DTD_IDX_VSWIDTH:
+         pdtd->VsyncW_4lsb = (val & 0x0F);
+         pdtd->VsyncW_2msb = ((val >> 4) & 0x03);
+         break;
+      case DTD_IDX_HSIZE:
+         pdtd->Hsize_8lsb  = (val & 0xFF);
+         pdtd->Hsize_4msb  = ((val >> 8) & 0x0F);
+         break;
+      case DTD_IDX_VSIZE:
+         pdtd->Vsize_8lsb  = (val & 0xFF);
+         pdtd->Vsize_4msb  = ((val >> 8) & 0x0F);
+         break;
+      case DTD_IDX_HBORD:
+         pdtd->Hborder_pix = (val & 0xFF);
+         break;
+      case DTD_IDX_VBORD:
+         pdtd->Vborder_lin = (val & 0xFF);
+         break;
+      default:
+         RCD_RETURN_FAULT(retU);
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
 //----> Alternative Descriptors
 
 static const char AltDesc[] = "Defined descriptor types:\n"
@@ -3146,6 +3547,17 @@ rcode edi_grp_cl::create_selector(edi_dynfld_t *pfld) {
    RCD_RETURN_OK(retU);
 }
 
+wxMenu* edi_grp_cl::getSelector(edi_dynfld_t *pfld) {
+   if (pfld == NULL) return NULL;
+   if ((pfld->field.flags & EF_VS) == 0) return NULL;
+
+   if (pfld->selector == NULL) {
+      //do not fail on fault : selector == NULL, vmap == NULL
+      create_selector(pfld);
+   }
+   return pfld->selector;
+}
+
 rcode edi_grp_cl::init_fields(const edi_field_t* field_ar, const u8_t* inst, u32_t fcount, u32_t orflags,
                               const char *pname, const char *pdesc, const char *pcodn)
 {
@@ -3167,16 +3579,12 @@ rcode edi_grp_cl::init_fields(const edi_field_t* field_ar, const u8_t* inst, u32
 
       memcpy( &pfld->field, &field_ar[itf], EDI_FIELD_SZ);
 
-      pfld->field.flags |= orflags;
-      pfld->base         = const_cast<u8_t*> (inst);
-
-      if ((pfld->field.flags & EF_VS) == 0) {
-         pfld->selector = NULL;
-      } else {
-         //create value selector for this field
-         retU = create_selector(pfld);
-         //do not exit on fault : selector == NULL, vmap == NULL
-      }
+      pfld->field.flags    |= orflags;
+      pfld->field.handlerfn = EDID_cl::TypedHandler(pfld->field);
+      pfld->base            = const_cast<u8_t*> (inst);
+      //value selector menus are created by getSelector(), in the GUI thread:
+      //groups can be initialized by the background parser.
+      pfld->selector     = NULL;
 
       FieldsAr.Add(pfld);
    }
@@ -30,21 +30,16 @@ class edibase_cl : public edi_grp_cl {
 //VID: Video Input Descriptor
 class vindsc_cl : public edi_grp_cl {
    private:
-      enum {
-         in_analog_fcnt  = 7,
-         in_digital_fcnt = 4,
-         max_fcnt        = in_analog_fcnt //for pre-allocating array of fields
-      };
-
       //block data layouts
       static const edi_field_t in_analog[];
       static const edi_field_t in_digital[];
+      static const fld_lay_t   layouts[]; //[input type]
 
       static const char  CodN[];
       static const char  Name[];
       static const char  Desc[];
 
-      rcode  gen_data_layout(const u8_t* inst);
+      static const fld_lay_t* data_layout(const u8_t* inst);
 
    public:
       rcode  init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent);
@@ -145,6 +140,10 @@ class dtd_cl : public edi_grp_cl {
    public:
       rcode       init(const u8_t* inst, u32_t orflags, edi_grp_cl* parent);
       edi_grp_cl* Clone(rcode& rcd, u32_t flags) {return base_clone(rcd, new dtd_cl(), inst_data, flags); };
+
+      //binary access to the timing fields (DTD_IDX_PIXCLK...DTD_IDX_VBORD), no string conversions
+      static rcode RawRead (const u8_t* inst, u32_t fld_idx, u32_t& val);
+      static rcode RawWrite(u8_t* inst, u32_t fld_idx, u32_t val);
 };
 //MRL : Monitor Range Limits Descriptor
 class mrl_cl : public edi_grp_cl {
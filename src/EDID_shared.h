@@ -24,6 +24,7 @@
 #include "rcode/rcode.h"
 
 #include "guilog.h"
+#include "diag.h"
 
 #define EDI_FIELD_SZ sizeof(edi_field_t)
 enum {
@@ -220,6 +221,17 @@ typedef struct __attribute__ ((packed)) edi_dynfld_s {
 class edi_grp_cl;
 typedef edi_grp_cl* (*psub_ctor)();
 
+//number of entries in a descriptor array: a pointer instead of an array fails to build
+template <typename T, u32_t N>
+constexpr u32_t dsc_count(const T (&)[N]) {return N;}
+
+//Fields layout: static array of field descriptors
+typedef struct {
+   const edi_field_t *fields;
+         u32_t        fcount;
+} fld_lay_t;
+#define FLD_LAYOUT(fld_ar) {fld_ar, dsc_count(fld_ar)}
+
 //Field group descriptor
 typedef struct gpfld_dsc_s {
          u32_t        flags;
@@ -228,6 +240,13 @@ typedef struct gpfld_dsc_s {
          i32_t        inst_cnt; //instance count, (-1) == until data end
    const edi_field_t *fields;
 } gpfld_dsc_t;
+//Flat group: fields layout for a single data length (bhdr_t.tag.blk_len), shared by all the
+//instances. Generated on the first use of the length, never freed.
+typedef struct gpflat_lay_s {
+   const edi_field_t  *fields;
+         u32_t         fcount;
+         bool          b_badlen; //DBC_BAD_LEN_MSG
+} gpflat_lay_t;
 //Base group descriptor: no sub-groups
 typedef struct gpflat_dsc_s {
    const char         *CodN;
@@ -242,6 +261,7 @@ typedef struct gpflat_dsc_s {
          u32_t         hdr_sz;   //sizeof(bhdr_t) | //sizeof(ethdr_t)
          u32_t         fld_arsz;
    const gpfld_dsc_t  *fld_ar;
+         gpflat_lay_t **layout;  //[32]: per blk_len, NULL: not generated yet
 } gpflat_dsc_t;
 //Field group descriptor
 typedef struct subgrp_dsc_s {
@@ -300,7 +320,6 @@ class edi_grp_cl : public wxTreeItemData {
       edi_grp_cl* base_clone(rcode& rcd, edi_grp_cl* grp, u8_t* inst, u32_t orflags);
 
       rcode       base_DBC_Init_FlatGrp(const u8_t* inst, const gpflat_dsc_t *pgdsc, u32_t orflags, edi_grp_cl* parent);
-      rcode       base_DBC_Init_GrpFields(const gpfld_dsc_t *pgfld, edi_field_t **pp_fld, u32_t *pdlen, u32_t *poffs);
 
       rcode       base_DBC_Init_RootGrp(const u8_t* inst, const gproot_dsc_t *pGDsc, u32_t orflags, edi_grp_cl* parent);
 
@@ -327,6 +346,8 @@ class edi_grp_cl : public wxTreeItemData {
       inline  u8_t*  getInsPtr    () {return inst_data;};
       inline  u32_t  getFreeSubgSZ() {return subg_sz;};
 
+              wxMenu* getSelector(edi_dynfld_t *pfld); //value selector menu, created on first use
+
       inline  GroupAr_cl* getParentAr   () {return grp_ar ;};
       inline  u32_t       getParentArIdx() {return grp_idx;};
 
@@ -401,6 +422,7 @@ class EDID_cl {
       edi_buf_t    EDID_buff;
 
       guilog_cl   *pGLog;
+      diag_list_cl *pDiag;  //parser diagnostics, used if b_ERR_Ignore is set
 
       u32_t        num_valid_blocks;
       bool         b_RD_Ignore;
@@ -413,6 +435,10 @@ class EDID_cl {
       static const wxString prop_flag_name[];
 
       edi_grp_cl*  ParseDetDtor(u32_t blkidx, dsctor_u* pdsc, rcode& retU);
+      rcode        assemble    (edi_buf_t& dst, bool b_log) const;
+
+      //ignored parser faults: recorded in the active diagnostics list, or logged
+      inline void  PrintFault  (rcode retU) {if (diag_list_cl::Active() == NULL) pGLog->PrintRcode(retU);};
 
       //Common handlers: helpers
       inline u32_t calcGroupOffs (void *inst) {return (reinterpret_cast <u8_t*> (inst) - EDID_buff.buff);};
@@ -435,23 +461,29 @@ class EDID_cl {
 
       inline  edi_buf_t* getEDID() {return &EDID_buff;};
       inline  void       SetGuiLogPtr(guilog_cl *p_glog) {pGLog = p_glog;};
+      inline  void       SetDiagPtr(diag_list_cl *p_diag) {pDiag = p_diag;};
       inline  void       Set_ERR_Ignore(bool errign) {b_ERR_Ignore = errign;};
       inline  bool       Get_ERR_Ignore() {return b_ERR_Ignore;};
       inline  void       Set_RD_Ignore(bool rd) {b_RD_Ignore = rd;};
       inline  bool       Get_RD_Ignore() {return b_RD_Ignore;};
       inline  u32_t      getNumValidBlocks() {return num_valid_blocks;};
       inline  void       ForceNumValidBlocks(u32_t nblk) {num_valid_blocks = (nblk%5);}; //max 4
-      inline  void       CEA_Set_DTD_Offset(u8_t *pbuf, GroupAr_cl *p_grp_ar);
+      inline  void       CEA_Set_DTD_Offset(u8_t *pbuf, GroupAr_cl *p_grp_ar, bool b_log) const;
 
       u32_t genChksum(u32_t block);
+      static u32_t calcChksum(u8_t *pblk);
       bool  VerifyChksum(u32_t block);
       void  Clear();
+      void  MoveFrom(EDID_cl& src);
+      void  DeleteGroups();
 
       rcode ParseEDID_Base(u32_t& n_extblk);
       rcode ParseEDID_CEA();
       rcode ParseCEA_DBC(u8_t *pinst);
       rcode ParseDBC_TAG(u8_t *pinst, edi_grp_cl** pp_grp);
       rcode AssembleEDID();
+      //non-destructive: groups assembled to dst, EDID_buff not modified
+      rcode AssembleEDID(edi_buf_t& dst, bool b_chksum = true) const;
 
       //field flags
       rcode getValUnitName     (wxString& sval, const u32_t flags);
@@ -466,6 +498,16 @@ class EDID_cl {
       rcode BitF8Val    (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
       rcode BitVal      (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
       rcode Gamma       (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
+      //Typed accessors: BitVal/BitF8Val/ByteVal specialized for the bit position and the field
+      //format (EF_INT|EF_HEX|EF_NI), selected once per field by TypedHandler()
+      template <u32_t shift, u32_t flags>
+      rcode BitValT     (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
+      template <u32_t flags>
+      rcode BitF8ValT   (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
+      template <u32_t flags>
+      rcode ByteValT    (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
+
+      static field_fn TypedHandler(const edi_field_t& field);
       //BED handlers
       rcode MfcId (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
       rcode ProdSN(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
@@ -518,6 +560,7 @@ class EDID_cl {
       //CEA:VSD
       rcode VSD_ltncy    (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
       rcode VSD_MaxTMDS  (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
+      rcode VSD_HF_VRRmax(u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
       //CEA-Ext: VDDD
       rcode VDDD_IF_MaxF   (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
       rcode VDDD_HVpix_cnt (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
@@ -530,7 +573,7 @@ class EDID_cl {
       rcode HDRD_mtd_type  (u32_t op, wxString& sval, u32_t& ival, edi_dynfld_t* p_field);
 
 
-      EDID_cl() : num_valid_blocks(0), b_RD_Ignore(false), b_ERR_Ignore(false) {
+      EDID_cl() : pDiag(NULL), num_valid_blocks(0), b_RD_Ignore(false), b_ERR_Ignore(false) {
          BlkGroupsAr[0] = &EDI_BaseGrpAr;
          BlkGroupsAr[1] = &EDI_Ext0GrpAr;
          BlkGroupsAr[2] = &EDI_Ext1GrpAr;
@@ -0,0 +1,449 @@
+/***************************************************************
+ * Name:      bulk_rd.cpp
+ * Purpose:   Batched reader for small EDID files
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-02
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idBULK_RD
+   #error "bulk_rd.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idBULK_RD
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "bulk_rd.h"
+#include "EDID_class.h"
+
+#include <wx/dir.h>
+#include <wx/file.h>
+
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+enum {
+   BENCH_CHUNK = 4096 //files per Read() call
+};
+
+static inline double bulk_rd_time() {
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+wxThread::ExitCode bulk_rd_thr_cl::Entry() {
+   bulk_rd_req_t *reqs;
+   u32_t          count;
+   u32_t          idx;
+   u32_t          ndone;
+   u32_t          gen = 0;
+
+   while (reader->pool_job(gen)) {
+      reqs  = reader->job_reqs;
+      count = reader->job_count;
+      ndone = 0;
+
+      for (;;) {
+         idx = __atomic_fetch_add(&reader->job_next, 1, __ATOMIC_RELAXED);
+         if (idx >= count) break;
+
+         bulk_reader_cl::pread_one(&reqs[idx]);
+         ndone ++ ;
+      }
+
+      wxMutexLocker lock(reader->mtx);
+      reader->job_done += ndone;
+      reader->nthr_busy -- ;
+      reader->cond_done.Broadcast();
+   }
+   return 0;
+}
+
+bulk_reader_cl::bulk_reader_cl() :
+   mode(BULK_RD_PREAD), cond_job(mtx), cond_done(mtx), nthr(0), nthr_busy(0),
+   job_reqs(NULL), job_count(0), job_next(0), job_done(0), job_gen(0), b_quit(false)
+{
+   memset(thr_ar, 0, sizeof(thr_ar));
+}
+
+bulk_reader_cl::~bulk_reader_cl() {
+   Close();
+}
+
+rcode bulk_reader_cl::Init(u32_t threads, bool b_uring) {
+   rcode retU;
+
+   Close();
+
+#ifdef HAVE_LIBURING
+   if (b_uring) {
+      retU = uring_init();
+      if (RCD_IS_OK(retU)) {
+         mode = BULK_RD_URING;
+         return retU;
+      }
+   }
+#endif
+
+   mode = BULK_RD_PREAD;
+   if (threads == 0) RCD_RETURN_OK(retU);
+
+   if (threads > BULK_RD_MAX_THR) threads = BULK_RD_MAX_THR;
+   b_quit = false;
+
+   for (nthr=0; nthr<threads; nthr++) {
+      bulk_rd_thr_cl *thr;
+
+      thr = new bulk_rd_thr_cl(this);
+      if (thr == NULL) break;
+
+      if (thr->Run() != wxTHREAD_NO_ERROR) {
+         delete thr;
+         break;
+      }
+      thr_ar[nthr] = thr;
+   }
+
+   if (nthr > 0) mode = BULK_RD_POOL;
+   RCD_RETURN_OK(retU);
+}
+
+void bulk_reader_cl::Close() {
+
+#ifdef HAVE_LIBURING
+   if (mode == BULK_RD_URING) io_uring_queue_exit(&ring);
+#endif
+
+   mtx.Lock();
+   b_quit = true;
+   cond_job.Broadcast();
+   mtx.Unlock();
+
+   for (u32_t itt=0; itt<nthr; itt++) {
+      thr_ar[itt]->Wait();
+      delete thr_ar[itt];
+      thr_ar[itt] = NULL;
+   }
+   nthr = 0;
+   mode = BULK_RD_PREAD;
+}
+
+const char* bulk_reader_cl::getModeName() {
+   switch (mode) {
+      case BULK_RD_URING:
+         return "io_uring";
+      case BULK_RD_POOL:
+         return "pread pool";
+      default:
+         return "pread";
+   }
+}
+
+void bulk_reader_cl::Read(bulk_rd_req_t *reqs, u32_t count) {
+
+   switch (mode) {
+#ifdef HAVE_LIBURING
+      case BULK_RD_URING:
+         uring_read(reqs, count);
+         break;
+#endif
+      case BULK_RD_POOL:
+         pool_read(reqs, count);
+         break;
+      default:
+         for (u32_t itr=0; itr<count; itr++) pread_one(&reqs[itr]);
+         break;
+   }
+}
+
+void bulk_reader_cl::pread_one(bulk_rd_req_t *req) {
+   ssize_t len;
+   int     fd;
+
+   fd = open(req->fpath, O_RDONLY|O_CLOEXEC);
+   if (fd < 0) {
+      req->len = -errno;
+      return;
+   }
+
+   len = pread(fd, req->buf, req->bsz, 0);
+   req->len = (len < 0) ? -errno : len;
+
+   close(fd);
+}
+
+void bulk_reader_cl::pool_read(bulk_rd_req_t *reqs, u32_t count) {
+   u32_t  idx;
+   u32_t  ndone = 0;
+
+   mtx.Lock();
+   //workers late for the previous job must not see the new one half-initialized
+   while (nthr_busy > 0) cond_done.Wait();
+
+   job_reqs  = reqs;
+   job_count = count;
+   job_next  = 0;
+   job_done  = 0;
+   job_gen  ++ ;
+   cond_job.Broadcast();
+   mtx.Unlock();
+
+   //the caller takes part in the job
+   for (;;) {
+      idx = __atomic_fetch_add(&job_next, 1, __ATOMIC_RELAXED);
+      if (idx >= count) break;
+
+      pread_one(&reqs[idx]);
+      ndone ++ ;
+   }
+
+   mtx.Lock();
+   job_done += ndone;
+   while ((job_done < count) || (nthr_busy > 0)) cond_done.Wait();
+   mtx.Unlock();
+}
+
+bool bulk_reader_cl::pool_job(u32_t& gen) {
+   wxMutexLocker lock(mtx);
+
+   while ((! b_quit) && (gen == job_gen)) cond_job.Wait();
+   if (b_quit) return false;
+
+   gen = job_gen;
+   nthr_busy ++ ;
+   return true;
+}
+
+#ifdef HAVE_LIBURING
+
+rcode bulk_reader_cl::uring_init() {
+   rcode                  retU;
+   struct io_uring_probe *probe;
+   bool                   b_ops;
+
+   if (io_uring_queue_init(BULK_RD_BATCH, &ring, 0) < 0) RCD_RETURN_FAULT(retU);
+
+   //OPENAT, READ, CLOSE: kernel 5.6+
+   probe = io_uring_get_probe_ring(&ring);
+   b_ops = (probe != NULL);
+   if (b_ops) {
+      b_ops  = io_uring_opcode_supported(probe, IORING_OP_OPENAT);
+      b_ops &= io_uring_opcode_supported(probe, IORING_OP_READ  );
+      b_ops &= io_uring_opcode_supported(probe, IORING_OP_CLOSE );
+      io_uring_free_probe(probe);
+   }
+   if (! b_ops) {
+      io_uring_queue_exit(&ring);
+      RCD_RETURN_FAULT(retU);
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+u32_t bulk_reader_cl::uring_wait(u32_t nsub, i32_t *res) {
+   struct io_uring_cqe *cqe;
+   u32_t                ndone;
+
+   if (nsub == 0) return 0;
+   if (io_uring_submit_and_wait(&ring, nsub) < 0) return 0;
+
+   for (ndone=0; ndone<nsub; ndone++) {
+      if (io_uring_wait_cqe(&ring, &cqe) < 0) break;
+
+      res[cqe->user_data] = cqe->res;
+      io_uring_cqe_seen(&ring, cqe);
+   }
+   return ndone;
+}
+
+void bulk_reader_cl::uring_read(bulk_rd_req_t *reqs, u32_t count) {
+   struct io_uring_sqe *sqe;
+   bulk_rd_req_t       *preq;
+   i32_t                fd [BULK_RD_BATCH];
+   i32_t                res[BULK_RD_BATCH];
+   u32_t                nreq;
+   u32_t                nsub;
+
+   for (u32_t base=0; base<count; base+=nreq) {
+      preq = &reqs[base];
+      nreq = count - base;
+      if (nreq > BULK_RD_BATCH) nreq = BULK_RD_BATCH;
+
+      //step 1: open
+      for (u32_t itr=0; itr<nreq; itr++) {
+         res[itr] = -EIO;
+         sqe = io_uring_get_sqe(&ring);
+         io_uring_prep_openat(sqe, AT_FDCWD, preq[itr].fpath, O_RDONLY|O_CLOEXEC, 0);
+         sqe->user_data = itr;
+      }
+      nsub = uring_wait(nreq, res);
+      for (u32_t itr=0; itr<nreq; itr++) fd[itr] = res[itr];
+      if (nsub != nreq) goto fallback_close;
+
+      //step 2: read
+      nsub = 0;
+      for (u32_t itr=0; itr<nreq; itr++) {
+         if (fd[itr] < 0) {
+            preq[itr].len = fd[itr];
+            continue;
+         }
+         res[itr] = -EIO;
+         sqe = io_uring_get_sqe(&ring);
+         io_uring_prep_read(sqe, fd[itr], preq[itr].buf, preq[itr].bsz, 0);
+         sqe->user_data = itr;
+         nsub ++ ;
+      }
+      if (uring_wait(nsub, res) != nsub) goto fallback_close;
+
+      //step 3: close
+      nsub = 0;
+      for (u32_t itr=0; itr<nreq; itr++) {
+         if (fd[itr] < 0) continue;
+
+         preq[itr].len = res[itr];
+
+         sqe = io_uring_get_sqe(&ring);
+         io_uring_prep_close(sqe, fd[itr]);
+         sqe->user_data = itr;
+         nsub ++ ;
+      }
+      if (uring_wait(nsub, res) != nsub) {
+         //the ring is unusable: the rest is read with pread()
+         mode = BULK_RD_PREAD;
+         io_uring_queue_exit(&ring);
+         Read(&reqs[base + nreq], count - (base + nreq));
+         return;
+      }
+      continue;
+
+fallback_close:
+      for (u32_t itr=0; itr<nreq; itr++) {
+         if (fd[itr] >= 0) close(fd[itr]);
+      }
+      mode = BULK_RD_PREAD;
+      io_uring_queue_exit(&ring);
+      Read(preq, count - base);
+      return;
+   }
+}
+
+#endif //HAVE_LIBURING
+
+rcode bulk_reader_cl::Benchmark(const wxString& dir, u32_t threads, FILE *out) {
+   static const char *pass_name[] = {"cold", "warm"};
+
+   rcode           retU;
+   wxArrayString   fnames;
+   bulk_reader_cl  reader;
+   bulk_rd_req_t  *reqs;
+   wxCharBuffer   *paths;
+   u8_t           *bufs;
+   u32_t           nfiles;
+   double          t_start;
+   double          secs;
+
+   if (! wxDir::Exists(dir)) RCD_RETURN_FAULT(retU);
+
+   wxDir::GetAllFiles(dir, &fnames, "*.bin");
+   fnames.Sort();
+   nfiles = fnames.GetCount();
+   if (nfiles == 0) RCD_RETURN_FAULT(retU);
+
+   reqs  = new bulk_rd_req_t[BENCH_CHUNK];
+   paths = new wxCharBuffer [BENCH_CHUNK];
+   bufs  = new u8_t[BENCH_CHUNK * sizeof(edi_buf_t)];
+   if ((reqs == NULL) || (paths == NULL) || (bufs == NULL)) {
+      RCD_SET_FAULT(retU);
+      goto out;
+   }
+
+   reader.Init(threads);
+
+   fprintf(out, "files: %u, bulk reader: %s\n", nfiles, reader.getModeName());
+
+   for (u32_t pass=0; pass<2; pass++) {
+
+      //OpenEDID() read loop: wxFile, 128 bytes per read() call
+      if (pass == 0) evict_files(fnames);
+
+      t_start = bulk_rd_time();
+      for (u32_t itf=0; itf<nfiles; itf++) {
+         wxFile  file;
+         u8_t   *pblk;
+         u32_t   nblk;
+
+         if (! file.Open(fnames[itf], wxFile::read)) continue;
+
+         pblk = bufs;
+         if (EDI_BLK_SIZE == file.Read(pblk, EDI_BLK_SIZE)) {
+            nblk = pblk[offsetof(edid_t, num_extblk)];
+            if (nblk > EDI_EXT1_IDX) nblk = EDI_EXT1_IDX;
+
+            for (u32_t itb=1; itb<=nblk; itb++) {
+               pblk += EDI_BLK_SIZE;
+               if (EDI_BLK_SIZE != file.Read(pblk, EDI_BLK_SIZE)) break;
+            }
+         }
+         file.Close();
+      }
+      secs = bulk_rd_time() - t_start;
+      fprintf(out, "%s %-12s %10.3f s %10.0f files/s\n",
+              pass_name[pass], "wxFile", secs, nfiles / secs);
+
+      //bulk reader
+      if (pass == 0) evict_files(fnames);
+
+      t_start = bulk_rd_time();
+      for (u32_t base=0; base<nfiles; base+=BENCH_CHUNK) {
+         u32_t nreq;
+
+         nreq = nfiles - base;
+         if (nreq > BENCH_CHUNK) nreq = BENCH_CHUNK;
+
+         for (u32_t itr=0; itr<nreq; itr++) {
+            paths[itr]    = fnames[base + itr].fn_str();
+            reqs [itr].fpath = paths[itr].data();
+            reqs [itr].buf   = &bufs[itr * sizeof(edi_buf_t)];
+            reqs [itr].bsz   = sizeof(edi_buf_t);
+            reqs [itr].len   = 0;
+         }
+         reader.Read(reqs, nreq);
+      }
+      secs = bulk_rd_time() - t_start;
+      fprintf(out, "%s %-12s %10.3f s %10.0f files/s\n",
+              pass_name[pass], reader.getModeName(), secs, nfiles / secs);
+   }
+
+   RCD_SET_OK(retU);
+
+out:
+   if (reqs  != NULL) delete [] reqs;
+   if (paths != NULL) delete [] paths;
+   if (bufs  != NULL) delete [] bufs;
+
+   return retU;
+}
+
+void bulk_reader_cl::evict_files(const wxArrayString& fnames) {
+   int fd;
+   //clean pages only: no root privileges required, inodes & dentries stay cached
+   for (u32_t itf=0; itf<fnames.GetCount(); itf++) {
+      fd = open(fnames[itf].fn_str(), O_RDONLY|O_CLOEXEC);
+      if (fd < 0) continue;
+
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      close(fd);
+   }
+}
@@ -0,0 +1,109 @@
+/***************************************************************
+ * Name:      bulk_rd.h
+ * Purpose:   Batched reader for small EDID files
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-02
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef BULK_RD_H
+#define BULK_RD_H 1
+
+#ifndef _RCD_AUTOGEN
+   #include "config.h"
+#endif
+
+#include <wx/thread.h>
+#include <wx/arrstr.h>
+#include <stdio.h>
+
+#ifdef HAVE_LIBURING
+   #include <liburing.h>
+#endif
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+
+enum {
+   BULK_RD_BATCH   = 256, //io_uring: SQ entries, max files per submission
+   BULK_RD_MAX_THR = 64
+};
+
+enum { //reader mode
+   BULK_RD_PREAD  = 0, //pread() in the calling thread
+   BULK_RD_POOL   = 1, //pread() thread pool
+   BULK_RD_URING  = 2  //io_uring: open/read/close, one submission per step for the whole batch
+};
+
+//read request: the buffer is owned by the caller
+typedef struct {
+   const char *fpath;
+   u8_t       *buf;
+   u32_t       bsz;
+   i32_t       len;  //result: bytes read, < 0: -errno
+} bulk_rd_req_t;
+
+class bulk_reader_cl;
+
+class bulk_rd_thr_cl : public wxThread {
+   protected:
+      bulk_reader_cl *reader;
+
+      ExitCode Entry();
+
+   public:
+      bulk_rd_thr_cl(bulk_reader_cl *rd) : wxThread(wxTHREAD_JOINABLE), reader(rd) {};
+};
+
+//Not thread-safe: single instance per thread, f.e. one per pipeline worker.
+class bulk_reader_cl {
+   friend class bulk_rd_thr_cl;
+
+   protected:
+      u32_t            mode;
+
+#ifdef HAVE_LIBURING
+      struct io_uring  ring;
+
+      rcode  uring_init();
+      void   uring_read(bulk_rd_req_t *reqs, u32_t count);
+      u32_t  uring_wait(u32_t nsub, i32_t *res);
+#endif
+
+      //pread() pool
+      wxMutex          mtx;
+      wxCondition      cond_job;
+      wxCondition      cond_done;
+      bulk_rd_thr_cl  *thr_ar[BULK_RD_MAX_THR];
+      u32_t            nthr;
+      u32_t            nthr_busy; //workers inside the current job
+      bulk_rd_req_t   *job_reqs;
+      u32_t            job_count;
+      u32_t            job_next;  //atomic
+      u32_t            job_done;
+      u32_t            job_gen;
+      bool             b_quit;
+
+      static void  pread_one (bulk_rd_req_t *req);
+             void  pool_read (bulk_rd_req_t *reqs, u32_t count);
+             bool  pool_job  (u32_t& gen);
+
+      static void  evict_files(const wxArrayString& fnames);
+
+   public:
+      //threads: pread() pool size if io_uring is not available, 0: read in the calling thread
+      rcode Init(u32_t threads, bool b_uring = true);
+      void  Read(bulk_rd_req_t *reqs, u32_t count);
+      void  Close();
+
+      const char* getModeName();
+
+      //files/s: wxFile read loop (OpenEDID) vs bulk reader, cold & warm page cache
+      static rcode Benchmark(const wxString& dir, u32_t threads, FILE *out);
+
+      bulk_reader_cl();
+      ~bulk_reader_cl();
+};
+
+#endif /* BULK_RD_H */
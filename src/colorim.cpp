@@ -0,0 +1,498 @@
+/***************************************************************
+ * Name:      colorim.cpp
+ * Purpose:   Colorimetry: gamut area & coverage, white point, HDR luminance
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idCOLORIM
+   #error "colorim.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idCOLORIM
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "colorim.h"
+#include "EDID_shared.h"
+#include "bulk_rd.h"
+
+#include <wx/dir.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+//D65 white point, CIE 1976 u'v'
+#define D65_U  0.19784f
+#define D65_V  0.46832f
+
+//reference gamuts: R, G, B, counter-clockwise in xy
+static const float ref_x[CLR_NREF][3] = {
+   {0.640f, 0.300f, 0.150f}, //sRGB / BT.709
+   {0.680f, 0.265f, 0.150f}, //DCI-P3
+   {0.708f, 0.170f, 0.131f}  //BT.2020
+};
+static const float ref_y[CLR_NREF][3] = {
+   {0.330f, 0.600f, 0.060f},
+   {0.320f, 0.690f, 0.060f},
+   {0.292f, 0.797f, 0.046f}
+};
+
+//10-bit chromaticity coord: 8 msbits + 2 lsbits
+static inline float chr10(u32_t msb, u32_t lsb_byte, u32_t lsb_shift) {
+   return (float) ((msb << 2) | ((lsb_byte >> lsb_shift) & 0x03)) / 1024.0f;
+}
+
+static float poly_area(const float *px, const float *py, u32_t nv) {
+   float  area = 0.0f;
+
+   for (u32_t itv=0, prv=(nv-1); itv<nv; prv=itv, itv++) {
+      area += (px[prv] * py[itv]) - (px[itv] * py[prv]);
+   }
+   return (0.5f * fabsf(area));
+}
+
+//convex hull, counter-clockwise (monotone chain): nv <= CLR_MAX_PRIM
+static u32_t hull(const float *px, const float *py, u32_t nv, float *hx, float *hy) {
+   float  sx[CLR_MAX_PRIM];
+   float  sy[CLR_MAX_PRIM];
+   u32_t  nh;
+   u32_t  nlow;
+
+   //insertion sort by x, y
+   for (u32_t itv=0; itv<nv; itv++) {
+      u32_t  pos = itv;
+
+      while ((pos > 0) && ((sx[pos-1] > px[itv]) || ((sx[pos-1] == px[itv]) && (sy[pos-1] > py[itv])))) {
+         sx[pos] = sx[pos-1];
+         sy[pos] = sy[pos-1];
+         pos --;
+      }
+      sx[pos] = px[itv];
+      sy[pos] = py[itv];
+   }
+
+   #define CROSS(_o, _a, _b) \
+      (((hx[_a] - hx[_o]) * (sy[_b] - hy[_o])) - ((hy[_a] - hy[_o]) * (sx[_b] - hx[_o])))
+
+   nh = 0;
+   for (u32_t itv=0; itv<nv; itv++) { //lower hull
+      while ((nh >= 2) && (CROSS(nh-2, nh-1, itv) <= 0.0f)) nh--;
+      hx[nh] = sx[itv]; hy[nh] = sy[itv]; nh++;
+   }
+   nlow = nh + 1;
+   for (i32_t itv=(nv-2); itv>=0; itv--) { //upper hull
+      while ((nh >= nlow) && (CROSS(nh-2, nh-1, itv) <= 0.0f)) nh--;
+      hx[nh] = sx[itv]; hy[nh] = sy[itv]; nh++;
+   }
+   #undef CROSS
+
+   return (nh - 1); //last point == first point
+}
+
+//Sutherland-Hodgman: convex polygon clipped by a counter-clockwise triangle, returns the area
+static float clip_area(const float *px, const float *py, u32_t nv, const float *cx, const float *cy) {
+   float  bx[2][CLR_MAX_VERT];
+   float  by[2][CLR_MAX_VERT];
+   u32_t  nin = nv;
+   u32_t  src = 0;
+
+   memcpy(bx[0], px, nv * sizeof(float));
+   memcpy(by[0], py, nv * sizeof(float));
+
+   for (u32_t ite=0; ite<3; ite++) {
+      float  ax  = cx[ite];
+      float  ay  = cy[ite];
+      float  ex  = cx[(ite+1) % 3] - ax;
+      float  ey  = cy[(ite+1) % 3] - ay;
+      u32_t  dst = (src ^ 1);
+      u32_t  nout = 0;
+
+      for (u32_t itv=0, prv=(nin-1); itv<nin; prv=itv, itv++) {
+         float  d_prv = (ex * (by[src][prv] - ay)) - (ey * (bx[src][prv] - ax));
+         float  d_cur = (ex * (by[src][itv] - ay)) - (ey * (bx[src][itv] - ax));
+
+         if ((d_prv >= 0.0f) != (d_cur >= 0.0f)) { //edge crossing
+            float  t = d_prv / (d_prv - d_cur);
+
+            if (nout >= CLR_MAX_VERT) break;
+            bx[dst][nout] = bx[src][prv] + t * (bx[src][itv] - bx[src][prv]);
+            by[dst][nout] = by[src][prv] + t * (by[src][itv] - by[src][prv]);
+            nout ++ ;
+         }
+         if (d_cur >= 0.0f) {
+            if (nout >= CLR_MAX_VERT) break;
+            bx[dst][nout] = bx[src][itv];
+            by[dst][nout] = by[src][itv];
+            nout ++ ;
+         }
+      }
+      if (nout < 3) return 0.0f;
+      nin = nout;
+      src = dst;
+   }
+
+   return poly_area(bx[src], by[src], nin);
+}
+
+//CTA-861 extension: HDRS luminance & VDDD additional primaries
+void clr_batch_cl::decode_cta(const u8_t *pblk, u32_t row) {
+   //VDDD additional primaries: msb offset, lsb byte & shift; col4..col6
+   static const u8_t addp_msb[3]   = {24, 26, 28};
+   static const u8_t addp_lsb[3]   = {22, 22, 23};
+   static const u8_t addp_shx[3]   = { 6,  2,  6};
+   static const u8_t addp_shy[3]   = { 4,  0,  4};
+
+   u32_t  dtd_offs;
+   u32_t  offs;
+
+   dtd_offs = pblk[2];
+   if (dtd_offs < 4) return; //no data blocks
+   if (dtd_offs > 127) dtd_offs = 127;
+
+   for (offs=4; offs<dtd_offs; ) {
+      const u8_t *pdbc;
+      u32_t       tag;
+      u32_t       len;
+
+      pdbc = &pblk[offs];
+      tag  = (pdbc[0] >> 5);
+      len  = (pdbc[0] & 0x1F);
+      if ((offs + len) >= dtd_offs) break;
+      offs += (len + 1);
+
+      if ((tag != 7) || (len < 1)) continue; //extended tag codes only
+
+      if (pdbc[1] == 6) { //HDRS
+         flags[row] |= CLRF_HDRS;
+         if (len >= 2) eotf[row] = pdbc[2];
+         if (len >= 4) {
+            flags  [row] |= CLRF_LUM;
+            lcv_max[row]  = pdbc[4];
+         }
+         if (len >= 5) lcv_avg[row] = pdbc[5];
+         if (len >= 6) lcv_min[row] = pdbc[6];
+
+      } else if ((pdbc[1] == 2) && (len >= 29)) { //VDDD
+         u32_t  ncol;
+
+         ncol = (pdbc[23] & 0x03);
+         for (u32_t itc=0; (itc<ncol) && (nprim[row]<CLR_MAX_PRIM); itc++) {
+            u32_t  ip = nprim[row];
+
+            px[ip][row] = chr10(pdbc[addp_msb[itc]   ], pdbc[addp_lsb[itc]], addp_shx[itc]);
+            py[ip][row] = chr10(pdbc[addp_msb[itc] +1], pdbc[addp_lsb[itc]], addp_shy[itc]);
+            nprim[row] ++ ;
+            flags[row] |= CLRF_ADDPRIM;
+         }
+      }
+   }
+}
+
+bool clr_batch_cl::Add(const u8_t *pedid, u32_t len) {
+   static const u8_t edid_hdr[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+
+   u32_t  row;
+   u32_t  nblk;
+   u8_t   lsb_rg;
+   u8_t   lsb_bw;
+
+   if (nrows >= CLR_BATCH) return false;
+   row = nrows ++ ;
+
+   for (u32_t ip=0; ip<CLR_MAX_PRIM; ip++) {
+      px[ip][row] = 0.0f;
+      py[ip][row] = 0.0f;
+   }
+   wx     [row] = 0.0f;
+   wy     [row] = 0.0f;
+   lcv_max[row] = 0.0f;
+   lcv_avg[row] = 0.0f;
+   lcv_min[row] = 0.0f;
+   nprim  [row] = 0;
+   flags  [row] = 0;
+   eotf   [row] = 0;
+
+   if ((pedid == NULL) || (len < sizeof(edid_t))) return true;
+   if (memcmp(pedid, edid_hdr, sizeof(edid_hdr)) != 0) return true;
+   flags[row] = CLRF_VALID;
+
+   //base block: bytes 25-34
+   lsb_rg = pedid[25];
+   lsb_bw = pedid[26];
+   px[0][row] = chr10(pedid[27], lsb_rg, 6);
+   py[0][row] = chr10(pedid[28], lsb_rg, 4);
+   px[1][row] = chr10(pedid[29], lsb_rg, 2);
+   py[1][row] = chr10(pedid[30], lsb_rg, 0);
+   px[2][row] = chr10(pedid[31], lsb_bw, 6);
+   py[2][row] = chr10(pedid[32], lsb_bw, 4);
+   wx   [row] = chr10(pedid[33], lsb_bw, 2);
+   wy   [row] = chr10(pedid[34], lsb_bw, 0);
+   nprim[row] = 3;
+
+   for (u32_t itb=25; itb<=34; itb++) {
+      if (pedid[itb] != 0) {
+         flags[row] |= CLRF_CHROMA;
+         break;
+      }
+   }
+
+   nblk = pedid[126] + 1;
+   if (nblk > (len / sizeof(edid_t))) nblk = (len / sizeof(edid_t));
+   if (nblk > (sizeof(edi_t) / sizeof(edid_t))) nblk = (sizeof(edi_t) / sizeof(edid_t));
+
+   for (u32_t itb=1; itb<nblk; itb++) {
+      const u8_t *pblk = &pedid[itb * sizeof(edid_t)];
+
+      if (pblk[0] != 0x02) continue; //CTA-861 extension tag
+      decode_cta(pblk, row);
+   }
+   return true;
+}
+
+void clr_batch_cl::Compute(clr_stat_t *stat_ar) {
+   float  duv [CLR_BATCH];
+   float  area[CLR_BATCH];
+   float  lmax[CLR_BATCH];
+   float  lavg[CLR_BATCH];
+   float  lmin[CLR_BATCH];
+   float  ref_area[CLR_NREF];
+
+   //column passes: no branches, no row dependencies
+
+   //white point: CIE 1931 xy -> CIE 1976 u'v', distance to D65
+   for (u32_t row=0; row<nrows; row++) {
+      float  den = (-2.0f * wx[row]) + (12.0f * wy[row]) + 3.0f; //>= 1 for x,y in [0,1)
+      float  du  = ((4.0f * wx[row]) / den) - D65_U;
+      float  dv  = ((9.0f * wy[row]) / den) - D65_V;
+
+      duv[row] = sqrtf((du * du) + (dv * dv));
+   }
+
+   //R, G, B triangle area
+   for (u32_t row=0; row<nrows; row++) {
+      float  cr = ((px[1][row] - px[0][row]) * (py[2][row] - py[0][row])) -
+                  ((px[2][row] - px[0][row]) * (py[1][row] - py[0][row]));
+
+      area[row] = 0.5f * fabsf(cr);
+   }
+
+   //CTA-861 HDRS: max/avg luminance = 50 * 2^(CV/32), min = max * (CV/255)^2 / 100
+   for (u32_t row=0; row<nrows; row++) {
+      float  cvmin = (lcv_min[row] / 255.0f);
+
+      lmax[row] = 50.0f * exp2f(lcv_max[row] / 32.0f);
+      lavg[row] = 50.0f * exp2f(lcv_avg[row] / 32.0f);
+      lmin[row] = lmax[row] * cvmin * cvmin / 100.0f;
+   }
+
+   for (u32_t itr=0; itr<CLR_NREF; itr++) {
+      ref_area[itr] = poly_area(ref_x[itr], ref_y[itr], 3);
+   }
+
+   //row pass: gamut polygon & coverage
+   for (u32_t row=0; row<nrows; row++) {
+      clr_stat_t *pstat = &stat_ar[row];
+      float       gx[CLR_MAX_PRIM +1];
+      float       gy[CLR_MAX_PRIM +1];
+      u32_t       ngv;
+
+      memset(pstat, 0, sizeof(clr_stat_t));
+      pstat->flags = flags[row];
+      pstat->nprim = nprim[row];
+      pstat->eotf  = eotf [row];
+
+      if ((flags[row] & CLRF_LUM) != 0) {
+         pstat->lum_max = lmax[row];
+         pstat->lum_avg = lavg[row];
+         pstat->lum_min = lmin[row];
+      }
+
+      if ((flags[row] & CLRF_CHROMA) == 0) continue;
+
+      for (u32_t ip=0; ip<nprim[row]; ip++) {
+         pstat->prim_x[ip] = px[ip][row];
+         pstat->prim_y[ip] = py[ip][row];
+      }
+      pstat->wht_x  = wx [row];
+      pstat->wht_y  = wy [row];
+      pstat->wp_duv = duv[row];
+
+      ngv = hull(pstat->prim_x, pstat->prim_y, nprim[row], gx, gy);
+      if (ngv < 3) continue; //degenerate
+
+      //additional primaries: polygon area, otherwise the column result is exact
+      pstat->area = (nprim[row] > 3) ? poly_area(gx, gy, ngv) : area[row];
+
+      for (u32_t itr=0; itr<CLR_NREF; itr++) {
+         pstat->cov[itr] = 100.0f * clip_area(gx, gy, ngv, ref_x[itr], ref_y[itr]) / ref_area[itr];
+      }
+   }
+}
+
+void colorim_cl::Analyse(const u8_t *pedid, u32_t len, clr_stat_t& stat) {
+   clr_batch_cl  batch;
+
+   batch.Add(pedid, len);
+   batch.Compute(&stat);
+}
+
+void colorim_cl::Print(const clr_stat_t& stat, wxString& str) {
+   wxString  tmps;
+
+   if ((stat.flags & CLRF_CHROMA) == 0) {
+      str << "chromaticity coords not set";
+   } else {
+      tmps.Printf("sRGB %.1f%%, DCI-P3 %.1f%%, BT.2020 %.1f%%, area %.4f, white (%.3f, %.3f) dUV %.4f",
+                  stat.cov[CLR_REF_SRGB], stat.cov[CLR_REF_P3], stat.cov[CLR_REF_BT2020],
+                  stat.area, stat.wht_x, stat.wht_y, stat.wp_duv);
+      str << tmps;
+      if ((stat.flags & CLRF_ADDPRIM) != 0) {
+         tmps.Printf(", %u primaries", stat.nprim);
+         str << tmps;
+      }
+   }
+
+   if ((stat.flags & CLRF_LUM) != 0) {
+      tmps.Printf("; HDR luminance: max %.0f, avg %.0f, min %.4f cd/m2",
+                  stat.lum_max, stat.lum_avg, stat.lum_min);
+      str << tmps;
+   }
+}
+
+//ranking: valid data first, then BT.2020, P3, sRGB coverage and the peak luminance
+typedef struct {
+   const clr_stat_t *pstat;
+   u32_t             idx;
+} clr_rank_t;
+
+static int rank_cmp(const void *pa, const void *pb) {
+   const clr_rank_t *ra = reinterpret_cast <const clr_rank_t*> (pa);
+   const clr_rank_t *rb = reinterpret_cast <const clr_rank_t*> (pb);
+   const clr_stat_t *sa = ra->pstat;
+   const clr_stat_t *sb = rb->pstat;
+   bool  b_va = ((sa->flags & CLRF_CHROMA) != 0);
+   bool  b_vb = ((sb->flags & CLRF_CHROMA) != 0);
+
+   if (b_va != b_vb) return (b_va ? -1 : 1);
+
+   for (i32_t itr=(CLR_NREF-1); itr>=0; itr--) {
+      if (sa->cov[itr] != sb->cov[itr]) return ((sa->cov[itr] > sb->cov[itr]) ? -1 : 1);
+   }
+   if (sa->lum_max != sb->lum_max) return ((sa->lum_max > sb->lum_max) ? -1 : 1);
+
+   return ((ra->idx < rb->idx) ? -1 : 1); //input order
+}
+
+rcode colorim_cl::Rank(const wxString& dir, FILE *out, u32_t threads) {
+   rcode            retU;
+   wxArrayString    fnames;
+   bulk_reader_cl   reader;
+   clr_batch_cl     batch;
+   bulk_rd_req_t    reqs [CLR_BATCH];
+   wxCharBuffer     paths[CLR_BATCH];
+   clr_stat_t      *stat_ar;
+   clr_rank_t      *rank_ar;
+   u8_t            *bufs;
+   u32_t            nfiles;
+   u32_t            nchroma = 0;
+   u32_t            nlum    = 0;
+   struct timespec  ts0;
+   struct timespec  ts1;
+   double           secs;
+
+   if (! wxDir::Exists(dir)) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Directory not found: '%s'",
+                                   (const char*) dir.ToUTF8());
+   }
+
+   wxDir::GetAllFiles(dir, &fnames, "*.bin");
+   fnames.Sort();
+   nfiles = fnames.GetCount();
+   if (nfiles == 0) RCD_RETURN_OK(retU);
+
+   stat_ar = (clr_stat_t*) malloc(nfiles * sizeof(clr_stat_t));
+   rank_ar = (clr_rank_t*) malloc(nfiles * sizeof(clr_rank_t));
+   bufs    = (u8_t*)       malloc(CLR_BATCH * sizeof(edi_buf_t));
+   if ((stat_ar == NULL) || (rank_ar == NULL) || (bufs == NULL)) {
+      RCD_SET_FAULT(retU);
+      goto out;
+   }
+
+   retU = reader.Init(threads);
+   if (! RCD_IS_OK(retU)) goto out;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts0);
+
+   for (u32_t first=0; first<nfiles; first+=CLR_BATCH) {
+      u32_t  count = (nfiles - first);
+
+      if (count > CLR_BATCH) count = CLR_BATCH;
+
+      for (u32_t itr=0; itr<count; itr++) {
+         paths[itr]       = fnames[first + itr].fn_str();
+         reqs [itr].fpath = paths[itr].data();
+         reqs [itr].buf   = &bufs[itr * sizeof(edi_buf_t)];
+         reqs [itr].bsz   = sizeof(edi_buf_t);
+         reqs [itr].len   = 0;
+      }
+      reader.Read(reqs, count);
+
+      batch.Clear();
+      for (u32_t itr=0; itr<count; itr++) {
+         u32_t  len = (reqs[itr].len > 0) ? reqs[itr].len : 0;
+
+         batch.Add(reqs[itr].buf, len);
+      }
+      batch.Compute(&stat_ar[first]);
+   }
+   reader.Close();
+
+   for (u32_t itf=0; itf<nfiles; itf++) {
+      rank_ar[itf].pstat = &stat_ar[itf];
+      rank_ar[itf].idx   = itf;
+      if ((stat_ar[itf].flags & CLRF_CHROMA) != 0) nchroma ++ ;
+      if ((stat_ar[itf].flags & CLRF_LUM   ) != 0) nlum    ++ ;
+   }
+   qsort(rank_ar, nfiles, sizeof(clr_rank_t), rank_cmp);
+
+   clock_gettime(CLOCK_MONOTONIC, &ts1);
+   secs  = (ts1.tv_sec - ts0.tv_sec);
+   secs += (ts1.tv_nsec - ts0.tv_nsec) / 1e9;
+
+   //rank, path, sRGB/P3/BT.2020 coverage [%], xy area, white point dUV, HDR max/avg/min [cd/m2]
+   for (u32_t itr=0; itr<nfiles; itr++) {
+      const clr_stat_t *pstat = rank_ar[itr].pstat;
+
+      fprintf(out, "%u\t%s", (itr + 1), (const char*) fnames[rank_ar[itr].idx].ToUTF8());
+      if ((pstat->flags & CLRF_CHROMA) != 0) {
+         fprintf(out, "\t%.1f\t%.1f\t%.1f\t%.4f\t%.4f",
+                 pstat->cov[CLR_REF_SRGB], pstat->cov[CLR_REF_P3],
+                 pstat->cov[CLR_REF_BT2020], pstat->area, pstat->wp_duv);
+      } else {
+         fprintf(out, "\t-\t-\t-\t-\t-");
+      }
+      if ((pstat->flags & CLRF_LUM) != 0) {
+         fprintf(out, "\t%.0f\t%.0f\t%.4f\n", pstat->lum_max, pstat->lum_avg, pstat->lum_min);
+      } else {
+         fprintf(out, "\t-\t-\t-\n");
+      }
+   }
+   fflush(out);
+
+   fprintf(stderr, "%u file(s): %u with chromaticity coords, %u with HDR luminance, %.3f s\n",
+           nfiles, nchroma, nlum, secs);
+
+out:
+   free(stat_ar);
+   free(rank_ar);
+   free(bufs);
+   return retU;
+}
@@ -0,0 +1,96 @@
+/***************************************************************
+ * Name:      colorim.h
+ * Purpose:   Colorimetry: gamut area & coverage, white point, HDR luminance
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef COLORIM_H
+#define COLORIM_H 1
+
+#include <wx/string.h>
+#include <stdio.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+
+enum {
+   CLR_BATCH    = 64, //EDIDs analysed at once
+   CLR_MAX_PRIM = 6,  //R, G, B + up to 3 VDDD additional primaries
+   CLR_MAX_VERT = 16  //gamut polygon clipped by a reference triangle
+};
+
+enum { //reference gamuts: clr_stat_t.cov[]
+   CLR_REF_SRGB   = 0, //BT.709 primaries
+   CLR_REF_P3     = 1, //DCI-P3
+   CLR_REF_BT2020 = 2,
+   CLR_NREF       = 3
+};
+
+enum { //clr_stat_t.flags
+   CLRF_VALID   = 0x01, //EDID header found
+   CLRF_CHROMA  = 0x02, //base block chromaticity coords are set
+   CLRF_ADDPRIM = 0x04, //VDDD: additional primaries included in the gamut
+   CLRF_HDRS    = 0x08, //CTA-861 HDR Static Metadata Data Block found
+   CLRF_LUM     = 0x10  //HDRS: Desired Content Max Luminance is declared
+};
+
+typedef struct {
+   u32_t  flags;    //CLRF_*
+   u32_t  nprim;
+   float  prim_x[CLR_MAX_PRIM]; //CIE 1931 xy
+   float  prim_y[CLR_MAX_PRIM];
+   float  wht_x;
+   float  wht_y;
+   float  area;           //gamut area in CIE 1931 xy
+   float  cov[CLR_NREF];  //% of the reference gamut area covered
+   float  wp_duv;         //white point distance to D65 in CIE 1976 u'v'
+   u8_t   eotf;           //HDRS byte 2: supported EOTFs
+   float  lum_max;        //cd/m^2, 0: not declared
+   float  lum_avg;
+   float  lum_min;
+} clr_stat_t;
+
+//Structure-of-arrays batch: the EDIDs are decoded once into columns, the per-row
+//arithmetic runs in separate passes over whole columns; polygon clipping is per row.
+class clr_batch_cl {
+   protected:
+      float  px[CLR_MAX_PRIM][CLR_BATCH];
+      float  py[CLR_MAX_PRIM][CLR_BATCH];
+      float  wx[CLR_BATCH];
+      float  wy[CLR_BATCH];
+      float  lcv_max[CLR_BATCH]; //HDRS code values
+      float  lcv_avg[CLR_BATCH];
+      float  lcv_min[CLR_BATCH];
+      u32_t  nprim[CLR_BATCH];
+      u32_t  flags[CLR_BATCH];
+      u8_t   eotf [CLR_BATCH];
+      u32_t  nrows;
+
+      void  decode_cta(const u8_t *pblk, u32_t row);
+
+   public:
+      inline u32_t  Count() {return nrows;};
+      inline void   Clear() {nrows = 0;};
+
+      //raw EDID data: base block + extensions, false: batch is full
+      bool  Add    (const u8_t *pedid, u32_t len);
+      //stat_ar[Count()]
+      void  Compute(clr_stat_t *stat_ar);
+
+      clr_batch_cl() : nrows(0) {};
+};
+
+class colorim_cl {
+   public:
+      //single EDID: raw data
+      static void   Analyse(const u8_t *pedid, u32_t len, clr_stat_t& stat);
+      //"sRGB 98.1% P3 72.4% BT.2020 51.0%, area 0.1120, white dUV 0.0021, max 600 cd/m2 ..."
+      static void   Print  (const clr_stat_t& stat, wxString& str);
+      //all *.bin files in dir, ranked by the color capability: widest gamut first
+      static rcode  Rank   (const wxString& dir, FILE *out, u32_t threads);
+};
+
+#endif /* COLORIM_H */
@@ -0,0 +1,647 @@
+/***************************************************************
+ * Name:      corpus.cpp
+ * Purpose:   EDID corpus browser: EDID binaries from a directory, archive or firmware image
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-11
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idCORPUS
+   #error "corpus.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idCORPUS
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "corpus.h"
+#include "pnp_id.h"
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <string.h>
+#include <stdio.h>
+
+//corpus_thr_cl: row decoder
+corpus_thr_cl::corpus_thr_cl(corpus_cl *pcorp) :
+   wxThread(wxTHREAD_JOINABLE), corpus(pcorp)
+{
+   //corpus rows are decoded with errors ignored: the validity column shows the result
+   EDID.Set_ERR_Ignore(true);
+   EDID.SetGuiLogPtr(&tlog);
+   EDID.SetDiagPtr(&diag);
+}
+
+wxThread::ExitCode corpus_thr_cl::Entry() {
+   corpus_row_t row;
+   wxString     fpath;
+   u32_t        idx;
+
+   if (corpus->src == CORP_SRC_ARCH) {
+      decode_archive();
+      return 0;
+   }
+   if (corpus->src == CORP_SRC_IMAGE) {
+      decode_image();
+      return 0;
+   }
+
+   while (corpus->next_job(idx, fpath)) {
+      decode(fpath, row);
+      corpus->done_job(idx, row);
+   }
+   return 0;
+}
+
+void corpus_thr_cl::decode(const wxString& fpath, corpus_row_t& row) {
+   wxFile   file;
+   ssize_t  len;
+
+   memset(&row, 0, sizeof(corpus_row_t));
+
+   if (! file.Open(fpath, wxFile::read) ) {
+      strncpy(row.valid, "read error", sizeof(row.valid)-1);
+      return;
+   }
+
+   EDID.Clear();
+   len = file.Read(EDID.getEDID()->buff, sizeof(edi_buf_t));
+   file.Close();
+
+   decode_data(len, row);
+}
+
+void corpus_thr_cl::decode_archive() {
+   rcode         retU;
+   corpus_row_t  row;
+   wxString      mname;
+   u32_t         len;
+   u64_t         msize;
+   bool          b_end;
+
+   //one member at a time, straight into the EDID buffer
+   for (;;) {
+      EDID.Clear();
+      retU = corpus->tar.Next(mname, EDID.getEDID()->buff, sizeof(edi_buf_t), len, msize, b_end);
+      if (b_end) break;
+
+      memset(&row, 0, sizeof(corpus_row_t));
+
+      if (! RCD_IS_OK(retU)) {
+         //corrupted stream: the rest of the archive can't be read
+         strncpy(row.valid, "archive error", sizeof(row.valid)-1);
+         corpus->add_row(mname, row);
+         break;
+      }
+
+      decode_data(len, row);
+      if (! corpus->add_row(mname, row)) break;
+   }
+}
+
+void corpus_thr_cl::decode_data(ssize_t len, corpus_row_t& row) {
+   u8_t    *pbuf;
+
+   pbuf = EDID.getEDID()->buff;
+
+   if (len <= 0) {
+      strncpy(row.valid, "read error", sizeof(row.valid)-1);
+      return;
+   }
+
+   //keep the raw data for loading the row into the editor
+   row.raw = new u8_t[len];
+   if (row.raw == NULL) return;
+   memcpy(row.raw, pbuf, len);
+   row.datsz = len;
+
+   if (len < EDI_BLK_SIZE) {
+      snprintf(row.valid, sizeof(row.valid), "short file: %d B", (int) len);
+      return;
+   }
+
+   corpus_cl::DecodeRow(EDID, row);
+}
+
+void corpus_thr_cl::decode_image() {
+   rcode         retU;
+   fw_scan_cl    scanner;
+   corpus_row_t  row;
+
+   retU = scanner.Scan(corpus->dpath, *this);
+   if (RCD_IS_OK(retU)) return;
+
+   memset(&row, 0, sizeof(corpus_row_t));
+   strncpy(row.valid, "image read error", sizeof(row.valid)-1);
+   corpus->add_row(wxEmptyString, row);
+}
+
+bool corpus_thr_cl::OnHit(const fw_hit_t& hit, const u8_t *pdata) {
+   corpus_row_t  row;
+   wxString      name;
+
+   EDID.Clear();
+   memcpy(EDID.getEDID()->buff, pdata, hit.datsz);
+
+   memset(&row, 0, sizeof(corpus_row_t));
+   decode_data(hit.datsz, row);
+
+   //scan result replaces the validity, if not OK
+   if (hit.flags != 0) fw_scan_cl::FlagsToStr(hit, row.valid, sizeof(row.valid));
+
+   name.Printf("0x%08llX", (unsigned long long) hit.offset);
+   return corpus->add_row(name, row);
+}
+
+void corpus_cl::DecodeRow(EDID_cl& EDID, corpus_row_t& row) {
+   rcode        retU;
+   u32_t        n_extblk = 0;
+   bool         b_csum;
+   const char  *verr = NULL;
+
+   b_csum = EDID.VerifyChksum(EDI_BASE_IDX);
+
+   retU = EDID.ParseEDID_Base(n_extblk);
+   if (! RCD_IS_OK(retU)) {
+      verr = "invalid: base block";
+      goto out;
+   }
+
+   if (n_extblk > 0) {
+      if (row.datsz < (2 * EDI_BLK_SIZE)) {
+         verr = "missing ext. block";
+      } else {
+         b_csum &= EDID.VerifyChksum(EDI_EXT0_IDX);
+
+         retU = EDID.ParseEDID_CEA();
+         if (! RCD_IS_OK(retU)) verr = "invalid: CTA-861";
+      }
+   }
+
+   GetRowInfo(EDID, row);
+
+out:
+   EDID.DeleteGroups();
+
+   if (verr != NULL) {
+      strncpy(row.valid, verr, sizeof(row.valid)-1);
+   } else if (! b_csum) {
+      strncpy(row.valid, "bad checksum", sizeof(row.valid)-1);
+   } else {
+      strncpy(row.valid, "OK", sizeof(row.valid)-1);
+   }
+}
+
+const char* corpus_cl::GetVendor(const corpus_row_t& row) {
+   const char *vendor;
+
+   vendor = pnp_id_cl::Vendor(row.mfc);
+   return (vendor != NULL) ? vendor : "";
+}
+
+void corpus_cl::GetRowInfo(EDID_cl& EDID, corpus_row_t& row) {
+   rcode         retU;
+   edi_grp_cl   *pgrp;
+   edi_dynfld_t *p_fld;
+   wxString      sval;
+   u32_t         ival;
+   bool          b_dtd = false;
+
+   snprintf(row.prod, sizeof(row.prod), "%04X", EDID.getEDID()->edi.base.prod_id);
+
+   for (u32_t itg=0; itg<EDID.EDI_BaseGrpAr.GetCount(); itg++) {
+      u32_t tid;
+
+      pgrp = EDID.EDI_BaseGrpAr.Item(itg);
+      tid  = pgrp->getTypeID() & ID_EDID_MASK;
+
+      switch (tid) {
+         case ID_BED:
+            //BED.mfc_id
+            p_fld = pgrp->FieldsAr.Item(1);
+            retU  = (EDID.*p_fld->field.handlerfn)(OP_READ, sval, ival, p_fld);
+            if (RCD_IS_OK(retU)) {
+               strncpy(row.mfc, sval.ToAscii(), sizeof(row.mfc)-1);
+            }
+            break;
+
+         case ID_MND:
+            //MND.text: padded with LF, SP
+            p_fld = pgrp->FieldsAr.Item(3);
+            retU  = (EDID.*p_fld->field.handlerfn)(OP_READ, sval, ival, p_fld);
+            if (RCD_IS_OK(retU)) {
+               sval = sval.BeforeFirst('\n');
+               sval.Trim();
+               strncpy(row.name, sval.ToAscii(), sizeof(row.name)-1);
+            }
+            break;
+
+         case ID_DTD:
+            //first DTD is the preferred timing mode
+            if (! b_dtd) {
+               u32_t  pixclk, hapix, hbpix, valin, vblin;
+               u32_t  htotal, vtotal;
+               u8_t  *inst;
+
+               b_dtd = true;
+               inst  = pgrp->getInsPtr();
+
+               dtd_cl::RawRead(inst, DTD_IDX_PIXCLK, pixclk);
+               dtd_cl::RawRead(inst, DTD_IDX_HAPIX , hapix );
+               dtd_cl::RawRead(inst, DTD_IDX_HBPIX , hbpix );
+               dtd_cl::RawRead(inst, DTD_IDX_VALIN , valin );
+               dtd_cl::RawRead(inst, DTD_IDX_VBLIN , vblin );
+
+               htotal = hapix + hbpix;
+               vtotal = valin + vblin;
+
+               if ((htotal == 0) || (vtotal == 0)) {
+                  snprintf(row.mode, sizeof(row.mode), "%ux%u", hapix, valin);
+               } else {
+                  double vrefresh;
+                  //pix_clk: 10kHz units
+                  vrefresh  = (pixclk * 10000.0);
+                  vrefresh /= (htotal * vtotal);
+                  snprintf(row.mode, sizeof(row.mode), "%ux%u@%.2f", hapix, valin, vrefresh);
+               }
+            }
+            break;
+
+         default:
+            break;
+      }
+   }
+}
+
+//corpus_cl: row model & decoder pool
+corpus_cl::corpus_cl(wxEvtHandler *dst, int evtid) :
+   cond(mtx), rows(NULL), nrows(0), rows_max(0), req_next(0), req_last(0), b_quit(false), gen(0),
+   src(CORP_SRC_DIR), evt_dst(dst), evt_id(evtid), nthr(0)
+{
+   memset(thr_ar, 0, sizeof(thr_ar));
+}
+
+corpus_cl::~corpus_cl() {
+   Close();
+}
+
+rcode corpus_cl::Open(const wxString& path, u32_t src_type) {
+   rcode  retU;
+   u32_t  ncpu;
+
+   Close();
+
+   if (src_type == CORP_SRC_ARCH) {
+      retU = tar.Open(path);
+      if (! RCD_IS_OK(retU)) return retU;
+
+      src      = CORP_SRC_ARCH;
+      rows_max = CORPUS_ARCH_ROWS;
+      //the archive is streamed: only a single thread can read it
+      ncpu     = 1;
+   } else if (src_type == CORP_SRC_IMAGE) {
+      if (! wxFileExists(path)) RCD_RETURN_FAULT(retU);
+
+      src      = CORP_SRC_IMAGE;
+      rows_max = CORPUS_ARCH_ROWS;
+      //sequential scan
+      ncpu     = 1;
+   } else {
+      if (! wxDir::Exists(path)) RCD_RETURN_FAULT(retU);
+
+      wxDir::GetAllFiles(path, &fnames, "*.bin", wxDIR_FILES);
+      fnames.Sort();
+
+      //GetAllFiles() returns full paths: keep the file names only
+      for (u32_t itf=0; itf<fnames.GetCount(); itf++) {
+         fnames[itf] = wxFileName(fnames[itf]).GetFullName();
+      }
+
+      nrows    = fnames.GetCount();
+      rows_max = nrows;
+
+      ncpu = wxThread::GetCPUCount();
+      if (ncpu < 1) ncpu = 1;
+      if (ncpu > CORPUS_MAX_THR) ncpu = CORPUS_MAX_THR;
+   }
+
+   dpath = path;
+   gen  ++ ;
+
+   if (rows_max == 0) RCD_RETURN_OK(retU);
+
+   rows = new corpus_row_t[rows_max];
+   if (rows == NULL) {
+      nrows = 0;
+      RCD_RETURN_FAULT(retU);
+   }
+   memset(rows, 0, rows_max * sizeof(corpus_row_t));
+
+   req_next = 0;
+   req_last = 0;
+   b_quit   = false;
+
+   for (nthr=0; nthr<ncpu; nthr++) {
+      corpus_thr_cl *thr;
+
+      thr = new corpus_thr_cl(this);
+      if (thr == NULL) break;
+
+      if (thr->Run() != wxTHREAD_NO_ERROR) {
+         delete thr;
+         break;
+      }
+      thr_ar[nthr] = thr;
+   }
+   if (nthr == 0) RCD_RETURN_FAULT(retU);
+
+   RCD_RETURN_OK(retU);
+}
+
+void corpus_cl::Close() {
+   mtx.Lock();
+   b_quit = true;
+   cond.Broadcast();
+   mtx.Unlock();
+
+   for (u32_t itt=0; itt<nthr; itt++) {
+      thr_ar[itt]->Wait();
+      delete thr_ar[itt];
+      thr_ar[itt] = NULL;
+   }
+   nthr = 0;
+
+   if (rows != NULL) {
+      for (u32_t itr=0; itr<nrows; itr++) {
+         if (rows[itr].raw != NULL) delete [] rows[itr].raw;
+      }
+      delete [] rows;
+      rows = NULL;
+   }
+   nrows    = 0;
+   rows_max = 0;
+   fnames.Empty();
+
+   tar.Close();
+   src = CORP_SRC_DIR;
+}
+
+void corpus_cl::Request(u32_t first, u32_t last) {
+   //archive & image rows are added already decoded
+   if (src != CORP_SRC_DIR) return;
+   if (nrows == 0) return;
+   if (last >= nrows) last = (nrows -1);
+   if (first > last) return;
+
+   mtx.Lock();
+   //the previous window is dropped: rows scrolled out of view are not decoded
+   req_next = first;
+   req_last = last;
+   cond.Broadcast();
+   mtx.Unlock();
+}
+
+bool corpus_cl::next_job(u32_t& idx, wxString& fpath) {
+   wxMutexLocker lock(mtx);
+
+   while (! b_quit) {
+      for (; req_next<=req_last; req_next++) {
+         if (rows[req_next].state != CROW_EMPTY) continue;
+
+         idx   = req_next ++ ;
+         rows[idx].state = CROW_PENDING;
+
+         fpath = dpath;
+         fpath << wxFileName::GetPathSeparator() << fnames[idx];
+         return true;
+      }
+      cond.Wait();
+   }
+   return false;
+}
+
+void corpus_cl::done_job(u32_t idx, corpus_row_t& row) {
+
+   mtx.Lock();
+   row.state = CROW_DONE;
+   memcpy(&rows[idx], &row, sizeof(corpus_row_t));
+   mtx.Unlock();
+
+   post_row(idx);
+}
+
+bool corpus_cl::add_row(const wxString& name, corpus_row_t& row) {
+   u32_t  idx;
+
+   mtx.Lock();
+   if (b_quit) goto drop;
+
+   if (nrows == rows_max) {
+      corpus_row_t *new_rows;
+
+      new_rows = new corpus_row_t[rows_max * 2];
+      if (new_rows == NULL) goto drop;
+
+      memcpy(new_rows, rows, nrows * sizeof(corpus_row_t));
+      memset(&new_rows[nrows], 0, (rows_max * 2 - nrows) * sizeof(corpus_row_t));
+      delete [] rows;
+      rows      = new_rows;
+      rows_max *= 2;
+   }
+
+   idx = nrows;
+   row.state = CROW_DONE;
+   memcpy(&rows[idx], &row, sizeof(corpus_row_t));
+   fnames.Add(name);
+   __atomic_store_n(&nrows, (idx +1), __ATOMIC_RELEASE);
+   mtx.Unlock();
+
+   post_row(idx);
+   return true;
+
+drop:
+   mtx.Unlock();
+   if (row.raw != NULL) delete [] row.raw;
+   return false;
+}
+
+void corpus_cl::post_row(u32_t idx) {
+   wxThreadEvent *evt;
+
+   evt = new wxThreadEvent(wxEVT_THREAD, evt_id);
+   if (evt == NULL) return;
+
+   evt->SetInt      (idx);
+   evt->SetExtraLong(gen);
+   wxQueueEvent(evt_dst, evt);
+}
+
+bool corpus_cl::getRowText(u32_t idx, u32_t col, wxString& sval) {
+   wxMutexLocker  lock(mtx);
+   corpus_row_t  *prow;
+
+   sval.Empty();
+   if (idx >= nrows) return false;
+
+   if (col == CORP_COL_FILE) {
+      sval = fnames[idx];
+      return true;
+   }
+
+   prow = &rows[idx];
+   if (prow->state != CROW_DONE) return false;
+
+   switch (col) {
+      case CORP_COL_MFC:
+         sval = wxString::FromAscii(prow->mfc);
+         break;
+      case CORP_COL_VEND:
+         sval = wxString::FromUTF8(GetVendor(*prow));
+         break;
+      case CORP_COL_PROD:
+         sval = wxString::FromAscii(prow->prod);
+         break;
+      case CORP_COL_NAME:
+         sval = wxString::FromAscii(prow->name);
+         break;
+      case CORP_COL_MODE:
+         sval = wxString::FromAscii(prow->mode);
+         break;
+      case CORP_COL_VALID:
+         sval = wxString::FromAscii(prow->valid);
+         break;
+      default:
+         break;
+   }
+   return true;
+}
+
+bool corpus_cl::getRowData(u32_t idx, u8_t *pbuf, u32_t bsz) {
+   wxMutexLocker  lock(mtx);
+   corpus_row_t  *prow;
+   u32_t          dsz;
+
+   if (idx >= nrows) return false;
+
+   prow = &rows[idx];
+   if (prow->state != CROW_DONE) return false;
+   if (prow->raw   == NULL     ) return false;
+
+   dsz = prow->datsz;
+   if (dsz > bsz) dsz = bsz;
+
+   memset(pbuf, 0, bsz);
+   memcpy(pbuf, prow->raw, dsz);
+   return true;
+}
+
+void corpus_cl::getRowPath(u32_t idx, wxString& fpath) {
+   wxMutexLocker lock(mtx);
+
+   fpath.Empty();
+   if (idx >= nrows) return;
+
+   if (src == CORP_SRC_DIR) {
+      fpath  = dpath;
+      fpath << wxFileName::GetPathSeparator() << fnames[idx];
+      return;
+   }
+
+   //archive members & image hits have no path of their own: the row name in the directory
+   //of the archive/image is used, so the path never points to the archive/image itself.
+   fpath  = wxPathOnly(dpath);
+   fpath << wxFileName::GetPathSeparator();
+   if (src == CORP_SRC_IMAGE) {
+      fpath << wxFileName(dpath).GetFullName() << "@" << fnames[idx];
+   } else {
+      fpath << wxFileName(fnames[idx], wxPATH_UNIX).GetFullName();
+   }
+}
+
+void corpus_cl::getRowName(u32_t idx, wxString& fname) {
+   wxMutexLocker lock(mtx);
+
+   fname.Empty();
+   if (idx >= nrows) return;
+
+   //image hit: "image.bin@0x00012345"
+   if (src == CORP_SRC_IMAGE) {
+      fname  = wxFileName(dpath).GetFullName();
+      fname << "@";
+   }
+   fname << fnames[idx];
+}
+
+//corpus_list_cl: virtual list control
+wxBEGIN_EVENT_TABLE(corpus_list_cl, wxListCtrl)
+   EVT_THREAD(wxID_ANY, corpus_list_cl::evt_row_done)
+wxEND_EVENT_TABLE()
+
+corpus_list_cl::corpus_list_cl(wxWindow *parent, wxWindowID id, const wxPoint &pos, const wxSize &size) :
+   wxListCtrl(parent, id, pos, size, wxLC_REPORT|wxLC_VIRTUAL|wxLC_SINGLE_SEL|wxLC_HRULES)
+{
+   corpus = new corpus_cl(this, GetId());
+
+   InsertColumn(CORP_COL_FILE , "File"          , wxLIST_FORMAT_LEFT, 160);
+   InsertColumn(CORP_COL_MFC  , "Mfc"           , wxLIST_FORMAT_LEFT,  48);
+   InsertColumn(CORP_COL_VEND , "Vendor"        , wxLIST_FORMAT_LEFT, 120);
+   InsertColumn(CORP_COL_PROD , "Product"       , wxLIST_FORMAT_LEFT,  64);
+   InsertColumn(CORP_COL_NAME , "Name"          , wxLIST_FORMAT_LEFT, 120);
+   InsertColumn(CORP_COL_MODE , "Preferred mode", wxLIST_FORMAT_LEFT, 130);
+   InsertColumn(CORP_COL_VALID, "Validity"      , wxLIST_FORMAT_LEFT, 110);
+}
+
+corpus_list_cl::~corpus_list_cl() {
+   delete corpus;
+}
+
+rcode corpus_list_cl::Open(const wxString& path, u32_t src_type) {
+   rcode retU;
+
+   SetItemCount(0);
+   retU = corpus->Open(path, src_type);
+   SetItemCount(corpus->getCount());
+   Refresh();
+
+   return retU;
+}
+
+void corpus_list_cl::Close() {
+   SetItemCount(0);
+   corpus->Close();
+}
+
+wxString corpus_list_cl::OnGetItemText(long item, long column) const {
+   wxString  sval;
+
+   if (! corpus->getRowText(item, column, sval)) {
+      u32_t  first;
+      u32_t  last;
+      //row not decoded yet: request the visible rows + read-ahead
+      first  = GetTopItem();
+      last   = first;
+      last  += GetCountPerPage();
+      last  += CORPUS_READ_AHEAD;
+      if ((u32_t) item < first) first = item;
+      if ((u32_t) item > last ) last  = item;
+
+      corpus->Request(first, last);
+   }
+   return sval;
+}
+
+void corpus_list_cl::evt_row_done(wxThreadEvent& evt) {
+   //drop rows from previously opened dir
+   if (evt.GetExtraLong() != corpus->getGeneration()) return;
+
+   //archive & image: new row
+   if (evt.GetInt() >= GetItemCount()) SetItemCount(corpus->getCount());
+
+   RefreshItem(evt.GetInt());
+}
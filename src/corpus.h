@@ -0,0 +1,170 @@
+/***************************************************************
+ * Name:      corpus.h
+ * Purpose:   EDID corpus browser: EDID binaries from a directory, archive or firmware image
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-11
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef CORPUS_H
+#define CORPUS_H 1
+
+#include <wx/thread.h>
+#include <wx/event.h>
+#include <wx/listctrl.h>
+#include <wx/arrstr.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+#include "tar_src.h"
+#include "fw_scan.h"
+
+enum {
+   CORPUS_MAX_THR    = 8,   //decoder threads
+   CORPUS_READ_AHEAD = 256, //rows decoded ahead of the last visible row
+   CORPUS_ARCH_ROWS  = 256  //archive: initial size of the row array
+};
+
+enum { //corpus list column idx'es
+   CORP_COL_FILE  = 0,
+   CORP_COL_MFC   = 1,
+   CORP_COL_VEND  = 2,
+   CORP_COL_PROD  = 3,
+   CORP_COL_NAME  = 4,
+   CORP_COL_MODE  = 5,
+   CORP_COL_VALID = 6,
+   CORP_NCOL      = 7
+};
+
+enum { //row source
+   CORP_SRC_DIR   = 0,
+   CORP_SRC_ARCH  = 1, //tar / tar.gz archive
+   CORP_SRC_IMAGE = 2  //firmware image: EDIDs found by fw_scan_cl
+};
+
+enum { //row state
+   CROW_EMPTY   = 0,
+   CROW_PENDING = 1,
+   CROW_DONE    = 2
+};
+
+//decoded row: fixed-size C strings, no shared wxString data between threads
+typedef struct {
+   u32_t  state;
+   u32_t  datsz;    //raw data size, 0: file not loaded
+   u8_t  *raw;      //datsz bytes, max sizeof(edi_buf_t): selected row is loaded without re-reading the source
+   char   mfc  [4];
+   char   prod [8];
+   char   name [16];
+   char   mode [24];
+   char   valid[32];
+} corpus_row_t;
+
+class corpus_cl;
+
+class corpus_thr_cl : public wxThread, public fw_scan_sink_cl {
+   protected:
+      corpus_cl  *corpus;
+      EDID_cl       EDID;
+      guilog_cl     tlog;
+      diag_list_cl  diag; //ignored faults are only recorded: not formatted
+
+      ExitCode Entry();
+
+      void  decode(const wxString& fpath, corpus_row_t& row);
+      void  decode_data(ssize_t len, corpus_row_t& row);
+      void  decode_archive();
+      void  decode_image();
+
+   public:
+      bool  OnHit(const fw_hit_t& hit, const u8_t *pdata);
+
+      corpus_thr_cl(corpus_cl *pcorp);
+};
+
+//Row model & decoder pool. Rows are decoded on request, in the window set by Request():
+//the list control requests the visible rows + CORPUS_READ_AHEAD.
+//Archive & firmware image: a single thread reads the file, the rows are added in the file order.
+class corpus_cl {
+   friend class corpus_thr_cl;
+
+   protected:
+      wxMutex        mtx;
+      wxCondition    cond;
+
+      wxArrayString  fnames;
+      wxString       dpath;    //directory or archive path
+      corpus_row_t  *rows;
+      u32_t          nrows;    //atomic: growing while the archive is read
+      u32_t          rows_max;
+      u32_t          req_next; //next row to check in the request window
+      u32_t          req_last;
+      bool           b_quit;
+      long           gen;      //incremented on Open(): events from previous dir are dropped
+      u32_t          src;      //CORP_SRC_*
+      tar_src_cl     tar;
+
+      wxEvtHandler  *evt_dst;
+      int            evt_id;
+
+      corpus_thr_cl *thr_ar[CORPUS_MAX_THR];
+      u32_t          nthr;
+
+      bool  next_job(u32_t& idx, wxString& fpath);
+      void  done_job(u32_t idx, corpus_row_t& row);
+      bool  add_row (const wxString& name, corpus_row_t& row);
+      void  post_row(u32_t idx);
+
+   public:
+      //src: CORP_SRC_*
+      rcode Open(const wxString& path, u32_t src_type = CORP_SRC_DIR);
+      void  Close();
+      void  Request(u32_t first, u32_t last);
+
+      bool  getRowText(u32_t idx, u32_t col, wxString& sval);
+      bool  getRowData(u32_t idx, u8_t *pbuf, u32_t bsz);
+      //archive & image rows: directory of the archive/image + row name
+      void  getRowPath(u32_t idx, wxString& fpath);
+      void  getRowName(u32_t idx, wxString& fname);
+
+      //mfc, prod, name & mode columns from parsed groups: shared with the batch pipeline
+      static void GetRowInfo(EDID_cl& EDID, corpus_row_t& row);
+      //parse the data in EDID buffer: row.datsz bytes, the groups are deleted afterwards
+      static void DecodeRow (EDID_cl& EDID, corpus_row_t& row);
+      //vendor name from the PNP ID registry, "" if the ID is unknown
+      static const char* GetVendor(const corpus_row_t& row);
+
+      inline u32_t getCount     () {return __atomic_load_n(&nrows, __ATOMIC_ACQUIRE);};
+      inline long  getGeneration() {return gen;};
+      inline u32_t getSource    () {return src;};
+
+      corpus_cl(wxEvtHandler *dst, int evtid);
+      ~corpus_cl();
+};
+
+class corpus_list_cl : public wxListCtrl {
+   protected:
+      corpus_cl  *corpus;
+
+      wxString    OnGetItemText(long item, long column) const;
+
+      void  evt_row_done(wxThreadEvent& evt);
+
+   public:
+      rcode Open(const wxString& path, u32_t src_type = CORP_SRC_DIR);
+      void  Close();
+
+      inline corpus_cl* getCorpus() {return corpus;};
+
+      corpus_list_cl(wxWindow *parent, wxWindowID id=wxID_ANY,
+                     const wxPoint &pos=wxDefaultPosition,
+                     const wxSize &size=wxDefaultSize);
+      ~corpus_list_cl();
+
+   wxDECLARE_EVENT_TABLE();
+};
+
+#endif /* CORPUS_H */
@@ -0,0 +1,224 @@
+/***************************************************************
+ * Name:      diag.cpp
+ * Purpose:   Parser diagnostics: fault records with deferred formatting
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-06
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idDIAG
+   #error "diag.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idDIAG
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "diag.h"
+
+#include <string.h>
+#include <stdio.h>
+
+__thread diag_list_cl* diag_list_cl::active = NULL;
+
+diag_ent_t* diag_list_cl::alloc_ent() {
+   diag_ent_t *pnew;
+   u32_t       nmax;
+
+   if (nent < ent_max) {
+      nent ++ ;
+      return &ent_ar[nent -1];
+   }
+   if (ent_max >= DIAG_MAX_ENT) {
+      ndrop ++ ;
+      return NULL;
+   }
+
+   nmax = (ent_max == 0) ? 16 : (ent_max * 2);
+   if (nmax > DIAG_MAX_ENT) nmax = DIAG_MAX_ENT;
+
+   pnew = new diag_ent_t[nmax];
+   if (pnew == NULL) {
+      ndrop ++ ;
+      return NULL;
+   }
+   if (ent_ar != NULL) {
+      memcpy(pnew, ent_ar, nent * sizeof(diag_ent_t));
+      delete [] ent_ar;
+   }
+   ent_ar  = pnew;
+   ent_max = nmax;
+
+   nent ++ ;
+   return &ent_ar[nent -1];
+}
+
+//the buffer is kept for the next parse
+void diag_list_cl::Clear() {
+   nent     = 0;
+   ndrop    = 0;
+   ctx_offs = DIAG_OFFS_NA;
+}
+
+void diag_list_cl::Swap(diag_list_cl& src) {
+   diag_ent_t *tmp_ar;
+   u32_t       tmp;
+
+   tmp_ar = ent_ar ; ent_ar  = src.ent_ar ; src.ent_ar  = tmp_ar;
+   tmp    = nent   ; nent    = src.nent   ; src.nent    = tmp;
+   tmp    = ent_max; ent_max = src.ent_max; src.ent_max = tmp;
+   tmp    = ndrop  ; ndrop   = src.ndrop  ; src.ndrop   = tmp;
+}
+
+u32_t diag_list_cl::CountSev(u32_t min_sev) {
+   u32_t  cnt = 0;
+
+   for (u32_t ite=0; ite<nent; ite++) {
+      if (ent_ar[ite].sev >= min_sev) cnt ++ ;
+   }
+   return cnt;
+}
+
+i32_t diag_list_cl::Find(u32_t idx, u32_t min_sev, u32_t offs_lo, u32_t offs_hi) {
+
+   for (u32_t ite=idx; ite<nent; ite++) {
+      diag_ent_t *pent = &ent_ar[ite];
+
+      if (pent->sev  < min_sev) continue;
+      if (pent->offs < offs_lo) continue;
+      if (pent->offs > offs_hi) continue;
+      return ite;
+   }
+   return -1;
+}
+
+//printf-like: each conversion is formatted separately, the length modifiers from the
+//format string are replaced with the ones matching the recorded argument type.
+void diag_list_cl::Render(u32_t idx, wxString& str) {
+   enum {
+      buf_sz  = 1024,
+      spec_sz = 32
+   };
+
+   diag_ent_t  *pent;
+   const char  *pfmt;
+   char         buf[buf_sz];
+   char         spec[spec_sz];
+   u32_t        len;
+   u32_t        narg;
+
+   str.Empty();
+   if (idx >= nent) return;
+
+   pent = &ent_ar[idx];
+   len  = 0;
+
+   if (pent->offs != DIAG_OFFS_NA) {
+      len = snprintf(buf, buf_sz, "@%u: ", pent->offs);
+   }
+
+   {  //source location only: the rcode has no formatted message
+      rcode  retU;
+
+      retU = RCD_SET_VAL(RCD_GET_UNIT(pent->retU), RCD_F, RCD_GET_DATA(pent->retU));
+      wxedid_RCD_GET_MSG(retU, &buf[len], (buf_sz - len));
+      len += strlen(&buf[len]);
+   }
+
+   pfmt = pent->fmt;
+   narg = 0;
+
+   while ((*pfmt != 0) && (len < (buf_sz -1))) {
+      const diag_arg_t *parg;
+      u32_t  slen;
+      char   conv;
+      int    nwr;
+
+      if (*pfmt != '%') {
+         buf[len] = *pfmt;
+         len  ++ ;
+         pfmt ++ ;
+         continue;
+      }
+      if (pfmt[1] == '%') {
+         buf[len] = '%';
+         len  ++ ;
+         pfmt += 2;
+         continue;
+      }
+
+      //flags, width, precision
+      slen = 0;
+      spec[slen] = *pfmt; slen ++ ; pfmt ++ ;
+      while ((*pfmt != 0) && (strchr("-+ #0123456789.", *pfmt) != NULL) && (slen < (spec_sz -4))) {
+         spec[slen] = *pfmt; slen ++ ; pfmt ++ ;
+      }
+      //length modifiers are dropped
+      while ((*pfmt != 0) && (strchr("hlLqjzt", *pfmt) != NULL)) pfmt ++ ;
+
+      conv = *pfmt;
+      if (conv == 0) break;
+      pfmt ++ ;
+
+      if (narg >= pent->nargs) {
+         nwr = snprintf(&buf[len], (buf_sz - len), "<?>");
+         goto next;
+      }
+      parg = &pent->args[narg];
+      narg ++ ;
+
+      nwr = -1;
+      switch (conv) {
+         case 'd':
+         case 'i':
+         case 'u':
+         case 'o':
+         case 'x':
+         case 'X':
+         case 'c':
+            if (parg->type > DIAG_ARG_INT) break;
+            spec[slen] = 'l'; spec[slen +1] = 'l'; spec[slen +2] = conv; spec[slen +3] = 0;
+            if (conv == 'c') {
+               spec[slen] = conv; spec[slen +1] = 0;
+               nwr = snprintf(&buf[len], (buf_sz - len), spec, (int) parg->v.i);
+            } else if (parg->type == DIAG_ARG_INT) {
+               nwr = snprintf(&buf[len], (buf_sz - len), spec, (long long) parg->v.i);
+            } else {
+               nwr = snprintf(&buf[len], (buf_sz - len), spec, (unsigned long long) parg->v.u);
+            }
+            break;
+         case 'f':
+         case 'F':
+         case 'e':
+         case 'E':
+         case 'g':
+         case 'G':
+            if (parg->type != DIAG_ARG_DBL) break;
+            spec[slen] = conv; spec[slen +1] = 0;
+            nwr = snprintf(&buf[len], (buf_sz - len), spec, parg->v.d);
+            break;
+         case 's':
+            if (parg->type != DIAG_ARG_STR) break;
+            spec[slen] = conv; spec[slen +1] = 0;
+            nwr = snprintf(&buf[len], (buf_sz - len), spec, (parg->v.s != NULL) ? parg->v.s : "(null)");
+            break;
+         default:
+            break;
+      }
+      if (nwr < 0) {
+         //unsupported conversion or argument type mismatch
+         nwr = snprintf(&buf[len], (buf_sz - len), "<?>");
+      }
+next:
+      if (nwr > 0) len += nwr;
+      if (len > (buf_sz -1)) len = (buf_sz -1);
+   }
+   buf[len] = 0;
+
+   str = wxString::FromAscii(buf, len);
+}
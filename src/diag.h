@@ -0,0 +1,164 @@
+/***************************************************************
+ * Name:      diag.h
+ * Purpose:   Parser diagnostics: fault records with deferred formatting
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-06
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef DIAG_H
+#define DIAG_H 1
+
+#include <wx/string.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+
+enum { //severity: from the message prefix
+   DIAG_INFO = 0,
+   DIAG_WARN = 1, //"[W!]"
+   DIAG_ERR  = 2  //"[E!]"
+};
+
+enum {
+   DIAG_MAX_ARGS = 6,
+   DIAG_MAX_ENT  = 4096,
+   DIAG_OFFS_CTX = 0xFFFFFFFE, //use the context offset: SetCtxOffs()
+   DIAG_OFFS_NA  = 0xFFFFFFFF  //no offset
+};
+
+enum { //diag_arg_t.type
+   DIAG_ARG_UINT = 0,
+   DIAG_ARG_INT  = 1,
+   DIAG_ARG_DBL  = 2,
+   DIAG_ARG_STR  = 3
+};
+
+typedef struct {
+   u32_t  type;
+   union {
+      u64_t        u;
+      i64_t        i;
+      double       d;
+      const char  *s;  //static strings only: group code names, descriptor names
+   } v;
+} diag_arg_t;
+
+//rcode holds the unit & line, the message is formatted only by Render()
+typedef struct {
+   rcode        retU;
+   u32_t        sev;
+   u32_t        offs;
+   const char  *fmt;
+   u32_t        nargs;
+   diag_arg_t   args[DIAG_MAX_ARGS];
+} diag_ent_t;
+
+//Per-parse diagnostics list. The list is attached to the current thread with diag_scope_cl,
+//DIAG_SET_FAULT_VMSG() records the fault instead of formatting the message immediately.
+class diag_list_cl {
+   protected:
+      diag_ent_t  *ent_ar;
+      u32_t        nent;
+      u32_t        ent_max;
+      u32_t        ndrop;     //entries over DIAG_MAX_ENT
+      u32_t        ctx_offs;
+
+      static __thread diag_list_cl *active;
+
+      diag_ent_t*  alloc_ent();
+
+      static inline void set_arg(diag_arg_t& arg, int val               ) {arg.type = DIAG_ARG_INT ; arg.v.i = val;};
+      static inline void set_arg(diag_arg_t& arg, long val              ) {arg.type = DIAG_ARG_INT ; arg.v.i = val;};
+      static inline void set_arg(diag_arg_t& arg, long long val         ) {arg.type = DIAG_ARG_INT ; arg.v.i = val;};
+      static inline void set_arg(diag_arg_t& arg, unsigned int val      ) {arg.type = DIAG_ARG_UINT; arg.v.u = val;};
+      static inline void set_arg(diag_arg_t& arg, unsigned long val     ) {arg.type = DIAG_ARG_UINT; arg.v.u = val;};
+      static inline void set_arg(diag_arg_t& arg, unsigned long long val) {arg.type = DIAG_ARG_UINT; arg.v.u = val;};
+      static inline void set_arg(diag_arg_t& arg, double val            ) {arg.type = DIAG_ARG_DBL ; arg.v.d = val;};
+      static inline void set_arg(diag_arg_t& arg, const char *val       ) {arg.type = DIAG_ARG_STR ; arg.v.s = val;};
+
+      static inline void put_args(diag_ent_t&) {return;};
+
+      template <typename T, typename... A>
+      static inline void put_args(diag_ent_t& ent, T val, A... rest) {
+         if (ent.nargs < DIAG_MAX_ARGS) {
+            set_arg(ent.args[ent.nargs], val);
+            ent.nargs ++ ;
+         }
+         put_args(ent, rest...);
+      };
+
+   public:
+      template <typename... A>
+      void Add(rcode retU, u32_t offs, const char *fmt, A... args) {
+         diag_ent_t *pent;
+
+         pent = alloc_ent();
+         if (pent == NULL) return;
+
+         pent->retU  = retU;
+         pent->offs  = (offs == DIAG_OFFS_CTX) ? ctx_offs : offs;
+         pent->fmt   = fmt;
+         pent->nargs = 0;
+         pent->sev   = DIAG_INFO;
+         if ((fmt[0] == '[') && (fmt[2] == '!')) {
+            if (fmt[1] == 'E') pent->sev = DIAG_ERR;
+            if (fmt[1] == 'W') pent->sev = DIAG_WARN;
+         }
+         put_args(*pent, args...);
+      };
+
+      void   Clear();
+      void   Swap (diag_list_cl& src);
+
+      //queries
+      inline u32_t              Count  () {return nent;};
+      inline u32_t              Dropped() {return ndrop;};
+      inline const diag_ent_t&  Item   (u32_t idx) {return ent_ar[idx];};
+
+      u32_t  CountSev(u32_t min_sev);
+      //first entry from idx, with sev >= min_sev and offs in [offs_lo, offs_hi]: -1 if not found
+      i32_t  Find    (u32_t idx, u32_t min_sev, u32_t offs_lo = 0, u32_t offs_hi = DIAG_OFFS_NA);
+
+      //"@offset: " + source location + formatted message
+      void   Render  (u32_t idx, wxString& str);
+
+      inline void   SetCtxOffs(u32_t offs) {ctx_offs = offs;};
+
+      static inline diag_list_cl* Active   () {return active;};
+      static inline diag_list_cl* SetActive(diag_list_cl *plist) {
+         diag_list_cl *prev = active;
+         active = plist;
+         return prev;
+      };
+
+      diag_list_cl() : ent_ar(NULL), nent(0), ent_max(0), ndrop(0), ctx_offs(DIAG_OFFS_NA) {};
+      ~diag_list_cl() {if (ent_ar != NULL) delete [] ent_ar;};
+};
+
+//attaches the list to the current thread, the previous one is restored on scope exit
+class diag_scope_cl {
+   protected:
+      diag_list_cl *prev;
+
+   public:
+      diag_scope_cl(diag_list_cl *plist) {prev = diag_list_cl::SetActive(plist);};
+      ~diag_scope_cl() {diag_list_cl::SetActive(prev);};
+};
+
+//same as wxedid_RCD_SET_FAULT_VMSG(), but with an active diagnostics list the message is
+//not formatted: the fault is recorded with the offset and the arguments.
+//NOTE: the rcode is RCD_FVMSG in both cases, the recorded message isn't available to PrintRcode().
+#define DIAG_SET_FAULT_VMSG( _rcd, _offs, _fmt, ... ) \
+   { \
+      diag_list_cl *_pdiag = diag_list_cl::Active(); \
+      if (_pdiag != NULL) { \
+         _rcd = RCD_SET_VAL( RCD_UNIT, RCD_FVMSG, __LINE__ ); \
+         _pdiag->Add(_rcd, (_offs), _fmt, ##__VA_ARGS__); \
+      } else { \
+         wxedid_RCD_SET_FAULT_VMSG(_rcd, _fmt, ##__VA_ARGS__); \
+      } \
+   }
+
+#endif /* DIAG_H */
@@ -0,0 +1,495 @@
+/***************************************************************
+ * Name:      dmt.cpp
+ * Purpose:   VESA DMT timings database, ETM/STI/DTD lookups
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idDMT
+   #error "dmt.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idDMT
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "dmt.h"
+#include "EDID.h"
+
+#include <string.h>
+
+//STD 2-byte code for the mode, 0 if the mode can't be described by STI
+static constexpr u32_t std_code(u32_t h, u32_t v, u32_t refr, u32_t flags) {
+   return
+      ((flags & VTF_ILACE) != 0) ? 0 :
+      ((h & 7) != 0)            ? 0 :
+      ((h < 256) || (h > 2288)) ? 0 :
+      ((refr < 60) || (refr > 123)) ? 0 :
+      ((v * 16) == (h * 10)) ? ((((h >> 3) - 31) << 8) | (0 << 6) | (refr - 60)) :
+      ((v *  4) == (h *  3)) ? ((((h >> 3) - 31) << 8) | (1 << 6) | (refr - 60)) :
+      ((v *  5) == (h *  4)) ? ((((h >> 3) - 31) << 8) | (2 << 6) | (refr - 60)) :
+      ((v * 16) == (h *  9)) ? ((((h >> 3) - 31) << 8) | (3 << 6) | (refr - 60)) : 0;
+}
+
+#define NH  0
+#define PH  VTF_HSPOS
+#define NV  0
+#define PV  VTF_VSPOS
+#define RB  VTF_RB
+#define IL  VTF_ILACE
+
+//X-server/drm style: display, sync start, sync end, total
+#define DMT_MODE(_id, _name, _clk, _ha, _hss, _hse, _ht, _va, _vss, _vse, _vt, _flg, _refr ) \
+   { {_clk, _ha, (_ht - _ha), (_hss - _ha), (_hse - _hss), \
+      _va, (_vt - _va), (_vss - _va), (_vse - _vss), (_flg), _refr }, \
+     _id, std_code(_ha, _va, _refr, _flg), _name }
+
+//VESA DMT v1.0 r13, ordered by DMT ID: dmt_tbl[id -1]
+static const dmt_mode_t dmt_tbl[DMT_ID_MAX] = {
+DMT_MODE(0x01, "640x350@85"      ,  31500,  640,  672,  736,  832,  350,  382,  385,  445, PH|NV   , 85),
+DMT_MODE(0x02, "640x400@85"      ,  31500,  640,  672,  736,  832,  400,  401,  404,  445, NH|PV   , 85),
+DMT_MODE(0x03, "720x400@85"      ,  35500,  720,  756,  828,  936,  400,  401,  404,  446, NH|PV   , 85),
+DMT_MODE(0x04, "640x480@60"      ,  25175,  640,  656,  752,  800,  480,  490,  492,  525, NH|NV   , 60),
+DMT_MODE(0x05, "640x480@72"      ,  31500,  640,  664,  704,  832,  480,  489,  492,  520, NH|NV   , 72),
+DMT_MODE(0x06, "640x480@75"      ,  31500,  640,  656,  720,  840,  480,  481,  484,  500, NH|NV   , 75),
+DMT_MODE(0x07, "640x480@85"      ,  36000,  640,  696,  752,  832,  480,  481,  484,  509, NH|NV   , 85),
+DMT_MODE(0x08, "800x600@56"      ,  36000,  800,  824,  896, 1024,  600,  601,  603,  625, PH|PV   , 56),
+DMT_MODE(0x09, "800x600@60"      ,  40000,  800,  840,  968, 1056,  600,  601,  605,  628, PH|PV   , 60),
+DMT_MODE(0x0A, "800x600@72"      ,  50000,  800,  856,  976, 1040,  600,  637,  643,  666, PH|PV   , 72),
+DMT_MODE(0x0B, "800x600@75"      ,  49500,  800,  816,  896, 1056,  600,  601,  604,  625, PH|PV   , 75),
+DMT_MODE(0x0C, "800x600@85"      ,  56250,  800,  832,  896, 1048,  600,  601,  604,  631, PH|PV   , 85),
+DMT_MODE(0x0D, "800x600@120 RB"  ,  73250,  800,  848,  880,  960,  600,  603,  607,  636, PH|NV|RB, 120),
+DMT_MODE(0x0E, "848x480@60"      ,  33750,  848,  864,  976, 1088,  480,  486,  494,  517, PH|PV   , 60),
+DMT_MODE(0x0F, "1024x768@87i"    ,  44900, 1024, 1032, 1208, 1264,  768,  768,  776,  817, PH|PV|IL, 87),
+DMT_MODE(0x10, "1024x768@60"     ,  65000, 1024, 1048, 1184, 1344,  768,  771,  777,  806, NH|NV   , 60),
+DMT_MODE(0x11, "1024x768@70"     ,  75000, 1024, 1048, 1184, 1328,  768,  771,  777,  806, NH|NV   , 70),
+DMT_MODE(0x12, "1024x768@75"     ,  78750, 1024, 1040, 1136, 1312,  768,  769,  772,  800, PH|PV   , 75),
+DMT_MODE(0x13, "1024x768@85"     ,  94500, 1024, 1072, 1168, 1376,  768,  769,  772,  808, PH|PV   , 85),
+DMT_MODE(0x14, "1024x768@120 RB" , 115500, 1024, 1072, 1104, 1184,  768,  771,  775,  813, PH|NV|RB, 120),
+DMT_MODE(0x15, "1152x864@75"     , 108000, 1152, 1216, 1344, 1600,  864,  865,  868,  900, PH|PV   , 75),
+DMT_MODE(0x16, "1280x768@60 RB"  ,  68250, 1280, 1328, 1360, 1440,  768,  771,  778,  790, PH|NV|RB, 60),
+DMT_MODE(0x17, "1280x768@60"     ,  79500, 1280, 1344, 1472, 1664,  768,  771,  778,  798, NH|PV   , 60),
+DMT_MODE(0x18, "1280x768@75"     , 102250, 1280, 1360, 1488, 1696,  768,  771,  778,  805, NH|PV   , 75),
+DMT_MODE(0x19, "1280x768@85"     , 117500, 1280, 1360, 1496, 1712,  768,  771,  778,  809, NH|PV   , 85),
+DMT_MODE(0x1A, "1280x768@120 RB" , 140250, 1280, 1328, 1360, 1440,  768,  771,  778,  813, PH|NV|RB, 120),
+DMT_MODE(0x1B, "1280x800@60 RB"  ,  71000, 1280, 1328, 1360, 1440,  800,  803,  809,  823, PH|NV|RB, 60),
+DMT_MODE(0x1C, "1280x800@60"     ,  83500, 1280, 1352, 1480, 1680,  800,  803,  809,  831, NH|PV   , 60),
+DMT_MODE(0x1D, "1280x800@75"     , 106500, 1280, 1360, 1488, 1696,  800,  803,  809,  838, NH|PV   , 75),
+DMT_MODE(0x1E, "1280x800@85"     , 122500, 1280, 1360, 1496, 1712,  800,  803,  809,  843, NH|PV   , 85),
+DMT_MODE(0x1F, "1280x800@120 RB" , 146250, 1280, 1328, 1360, 1440,  800,  803,  809,  847, PH|NV|RB, 120),
+DMT_MODE(0x20, "1280x960@60"     , 108000, 1280, 1376, 1488, 1800,  960,  961,  964, 1000, PH|PV   , 60),
+DMT_MODE(0x21, "1280x960@85"     , 148500, 1280, 1344, 1504, 1728,  960,  961,  964, 1011, PH|PV   , 85),
+DMT_MODE(0x22, "1280x960@120 RB" , 175500, 1280, 1328, 1360, 1440,  960,  963,  967, 1017, PH|NV|RB, 120),
+DMT_MODE(0x23, "1280x1024@60"    , 108000, 1280, 1328, 1440, 1688, 1024, 1025, 1028, 1066, PH|PV   , 60),
+DMT_MODE(0x24, "1280x1024@75"    , 135000, 1280, 1296, 1440, 1688, 1024, 1025, 1028, 1066, PH|PV   , 75),
+DMT_MODE(0x25, "1280x1024@85"    , 157500, 1280, 1344, 1504, 1728, 1024, 1025, 1028, 1072, PH|PV   , 85),
+DMT_MODE(0x26, "1280x1024@120 RB", 187250, 1280, 1328, 1360, 1440, 1024, 1027, 1034, 1084, PH|NV|RB, 120),
+DMT_MODE(0x27, "1360x768@60"     ,  85500, 1360, 1424, 1536, 1792,  768,  771,  777,  795, PH|PV   , 60),
+DMT_MODE(0x28, "1360x768@120 RB" , 148250, 1360, 1408, 1440, 1520,  768,  771,  776,  813, PH|NV|RB, 120),
+DMT_MODE(0x29, "1400x1050@60 RB" , 101000, 1400, 1448, 1480, 1560, 1050, 1053, 1057, 1080, PH|NV|RB, 60),
+DMT_MODE(0x2A, "1400x1050@60"    , 121750, 1400, 1488, 1632, 1864, 1050, 1053, 1057, 1089, NH|PV   , 60),
+DMT_MODE(0x2B, "1400x1050@75"    , 156000, 1400, 1504, 1648, 1896, 1050, 1053, 1057, 1099, NH|PV   , 75),
+DMT_MODE(0x2C, "1400x1050@85"    , 179500, 1400, 1504, 1656, 1912, 1050, 1053, 1057, 1105, NH|PV   , 85),
+DMT_MODE(0x2D, "1400x1050@120 RB", 208000, 1400, 1448, 1480, 1560, 1050, 1053, 1057, 1112, PH|NV|RB, 120),
+DMT_MODE(0x2E, "1440x900@60 RB"  ,  88750, 1440, 1488, 1520, 1600,  900,  903,  909,  926, PH|NV|RB, 60),
+DMT_MODE(0x2F, "1440x900@60"     , 106500, 1440, 1520, 1672, 1904,  900,  903,  909,  934, NH|PV   , 60),
+DMT_MODE(0x30, "1440x900@75"     , 136750, 1440, 1536, 1688, 1936,  900,  903,  909,  942, NH|PV   , 75),
+DMT_MODE(0x31, "1440x900@85"     , 157000, 1440, 1544, 1696, 1952,  900,  903,  909,  948, NH|PV   , 85),
+DMT_MODE(0x32, "1440x900@120 RB" , 182750, 1440, 1488, 1520, 1600,  900,  903,  909,  953, PH|NV|RB, 120),
+DMT_MODE(0x33, "1600x1200@60"    , 162000, 1600, 1664, 1856, 2160, 1200, 1201, 1204, 1250, PH|PV   , 60),
+DMT_MODE(0x34, "1600x1200@65"    , 175500, 1600, 1664, 1856, 2160, 1200, 1201, 1204, 1250, PH|PV   , 65),
+DMT_MODE(0x35, "1600x1200@70"    , 189000, 1600, 1664, 1856, 2160, 1200, 1201, 1204, 1250, PH|PV   , 70),
+DMT_MODE(0x36, "1600x1200@75"    , 202500, 1600, 1664, 1856, 2160, 1200, 1201, 1204, 1250, PH|PV   , 75),
+DMT_MODE(0x37, "1600x1200@85"    , 229500, 1600, 1664, 1856, 2160, 1200, 1201, 1204, 1250, PH|PV   , 85),
+DMT_MODE(0x38, "1600x1200@120 RB", 268250, 1600, 1648, 1680, 1760, 1200, 1203, 1207, 1271, PH|NV|RB, 120),
+DMT_MODE(0x39, "1680x1050@60 RB" , 119000, 1680, 1728, 1760, 1840, 1050, 1053, 1059, 1080, PH|NV|RB, 60),
+DMT_MODE(0x3A, "1680x1050@60"    , 146250, 1680, 1784, 1960, 2240, 1050, 1053, 1059, 1089, NH|PV   , 60),
+DMT_MODE(0x3B, "1680x1050@75"    , 187000, 1680, 1800, 1976, 2272, 1050, 1053, 1059, 1099, NH|PV   , 75),
+DMT_MODE(0x3C, "1680x1050@85"    , 214750, 1680, 1808, 1984, 2288, 1050, 1053, 1059, 1105, NH|PV   , 85),
+DMT_MODE(0x3D, "1680x1050@120 RB", 245500, 1680, 1728, 1760, 1840, 1050, 1053, 1059, 1112, PH|NV|RB, 120),
+DMT_MODE(0x3E, "1792x1344@60"    , 204750, 1792, 1920, 2120, 2448, 1344, 1345, 1348, 1394, NH|PV   , 60),
+DMT_MODE(0x3F, "1792x1344@75"    , 261000, 1792, 1888, 2104, 2456, 1344, 1345, 1348, 1417, NH|PV   , 75),
+DMT_MODE(0x40, "1792x1344@120 RB", 333250, 1792, 1840, 1872, 1952, 1344, 1347, 1351, 1423, PH|NV|RB, 120),
+DMT_MODE(0x41, "1856x1392@60"    , 218250, 1856, 1952, 2176, 2528, 1392, 1393, 1396, 1439, NH|PV   , 60),
+DMT_MODE(0x42, "1856x1392@75"    , 288000, 1856, 1984, 2208, 2560, 1392, 1393, 1396, 1500, NH|PV   , 75),
+DMT_MODE(0x43, "1856x1392@120 RB", 356500, 1856, 1904, 1936, 2016, 1392, 1395, 1399, 1474, PH|NV|RB, 120),
+DMT_MODE(0x44, "1920x1200@60 RB" , 154000, 1920, 1968, 2000, 2080, 1200, 1203, 1209, 1235, PH|NV|RB, 60),
+DMT_MODE(0x45, "1920x1200@60"    , 193250, 1920, 2056, 2256, 2592, 1200, 1203, 1209, 1245, NH|PV   , 60),
+DMT_MODE(0x46, "1920x1200@75"    , 245250, 1920, 2056, 2264, 2608, 1200, 1203, 1209, 1255, NH|PV   , 75),
+DMT_MODE(0x47, "1920x1200@85"    , 281250, 1920, 2064, 2272, 2624, 1200, 1203, 1209, 1262, NH|PV   , 85),
+DMT_MODE(0x48, "1920x1200@120 RB", 317000, 1920, 1968, 2000, 2080, 1200, 1203, 1209, 1271, PH|NV|RB, 120),
+DMT_MODE(0x49, "1920x1440@60"    , 234000, 1920, 2048, 2256, 2600, 1440, 1441, 1444, 1500, NH|PV   , 60),
+DMT_MODE(0x4A, "1920x1440@75"    , 297000, 1920, 2064, 2288, 2640, 1440, 1441, 1444, 1500, NH|PV   , 75),
+DMT_MODE(0x4B, "1920x1440@120 RB", 380500, 1920, 1968, 2000, 2080, 1440, 1443, 1447, 1525, PH|NV|RB, 120),
+DMT_MODE(0x4C, "2560x1600@60 RB" , 268500, 2560, 2608, 2640, 2720, 1600, 1603, 1609, 1646, PH|NV|RB, 60),
+DMT_MODE(0x4D, "2560x1600@60"    , 348500, 2560, 2752, 3032, 3504, 1600, 1603, 1609, 1658, NH|PV   , 60),
+DMT_MODE(0x4E, "2560x1600@75"    , 443250, 2560, 2768, 3048, 3536, 1600, 1603, 1609, 1672, NH|PV   , 75),
+DMT_MODE(0x4F, "2560x1600@85"    , 505250, 2560, 2768, 3048, 3536, 1600, 1603, 1609, 1682, NH|PV   , 85),
+DMT_MODE(0x50, "2560x1600@120 RB", 552750, 2560, 2608, 2640, 2720, 1600, 1603, 1609, 1694, PH|NV|RB, 120),
+DMT_MODE(0x51, "1366x768@60"     ,  85500, 1366, 1436, 1579, 1792,  768,  771,  774,  798, PH|PV   , 60),
+DMT_MODE(0x52, "1920x1080@60"    , 148500, 1920, 2008, 2052, 2200, 1080, 1084, 1089, 1125, PH|PV   , 60),
+DMT_MODE(0x53, "1600x900@60 RB"  , 108000, 1600, 1624, 1704, 1800,  900,  901,  904, 1000, PH|PV|RB, 60),
+DMT_MODE(0x54, "2048x1152@60 RB" , 162000, 2048, 2074, 2154, 2250, 1152, 1153, 1156, 1200, PH|PV|RB, 60),
+DMT_MODE(0x55, "1280x720@60"     ,  74250, 1280, 1390, 1430, 1650,  720,  725,  730,  750, PH|PV   , 60),
+DMT_MODE(0x56, "1366x768@60 RB"  ,  72000, 1366, 1380, 1436, 1500,  768,  769,  772,  800, PH|PV|RB, 60),
+DMT_MODE(0x57, "4096x2160@60 RB" , 556744, 4096, 4104, 4136, 4176, 2160, 2208, 2216, 2222, PH|NV|RB, 60),
+DMT_MODE(0x58, "4096x2160@59.94 RB", 556188, 4096, 4104, 4136, 4176, 2160, 2208, 2216, 2222, PH|NV|RB, 59)
+};
+
+//ETM modes which are not in the DMT list
+static const dmt_mode_t etm_tbl[] = {
+DMT_MODE(0, "640x480@67 (Apple Mac II)" ,  30240,  640,  704,  768,  864,  480,  483,  486,  525, NH|NV, 67),
+DMT_MODE(0, "720x400@88 (IBM VGA)"      ,  28320,  720,  738,  846,  900,  400,  421,  423,  449, NH|NV, 88),
+DMT_MODE(0, "720x400@70 (IBM VGA)"      ,  28320,  720,  738,  846,  900,  400,  412,  414,  449, NH|PV, 70),
+DMT_MODE(0, "832x624@75 (Apple Mac II)" ,  57284,  832,  864,  928, 1152,  624,  625,  628,  667, NH|NV, 75),
+DMT_MODE(0, "1152x870@75 (Apple Mac II)", 100000, 1152, 1216, 1344, 1456,  870,  871,  874,  915, PH|PV, 75)
+};
+
+#undef NH
+#undef PH
+#undef NV
+#undef PV
+#undef RB
+#undef IL
+#undef DMT_MODE
+
+#define DMT(_id) &dmt_tbl[(_id) -1]
+
+//ETM bit index -> mode. NOTE: the "1024x768x72" bit is the DMT 1024x768@70 mode.
+static const dmt_mode_t* const etm_map[DMT_ETM_BITS] = {
+   //byte 35
+   DMT(0x09), DMT(0x08), DMT(0x06), DMT(0x05), &etm_tbl[0], DMT(0x04), &etm_tbl[1], &etm_tbl[2],
+   //byte 36
+   DMT(0x24), DMT(0x12), DMT(0x11), DMT(0x10), DMT(0x0F), &etm_tbl[3], DMT(0x0B), DMT(0x0A),
+   //byte 37: bits 0-6 are manufacturer-specific
+   NULL, NULL, NULL, NULL, NULL, NULL, NULL, &etm_tbl[4]
+};
+
+#undef DMT
+
+//Hash indexes: open addressing, linear probing, slot value = table index +1, 0 = empty.
+class dmt_index_cl {
+   public:
+      enum {
+         dmt_count = DMT_ID_MAX,
+         etm_count = (sizeof(etm_tbl) / sizeof(dmt_mode_t)),
+         tbl_count = (dmt_count + etm_count),
+         idx_sz    = 256, //power of 2, > 2 * tbl_count
+         idx_mask  = (idx_sz -1)
+      };
+
+      u8_t  std_idx[idx_sz];
+      u8_t  res_idx[idx_sz];
+      u8_t  tmg_idx[idx_sz];
+
+      static inline const dmt_mode_t* Mode(u32_t slot) {
+         slot -- ;
+         return (slot < dmt_count) ? &dmt_tbl[slot] : &etm_tbl[slot - dmt_count];
+      };
+
+      static inline u32_t HashSTD(u32_t code) {
+         return ((code * 0x9E3779B1) >> 24);
+      };
+      static inline u32_t HashRes(u32_t h, u32_t v, u32_t refr, u32_t flags) {
+         u32_t  key;
+         key  = (h << 16) ^ v;
+         key ^= ((refr << 2) | (flags & VTF_KEY)) * 0x85EBCA6B;
+         return ((key * 0x9E3779B1) >> 24);
+      };
+      static void Insert(u8_t *idx, u32_t hash, u32_t slot) {
+         while (idx[hash] != 0) hash = ((hash +1) & idx_mask);
+         idx[hash] = slot;
+      };
+
+      dmt_index_cl();
+};
+
+dmt_index_cl::dmt_index_cl() {
+   memset(std_idx, 0, idx_sz);
+   memset(res_idx, 0, idx_sz);
+   memset(tmg_idx, 0, idx_sz);
+
+   //STD: normal blanking modes take precedence over RB modes with the same code
+   for (u32_t pass=0; pass<2; pass++) {
+      for (u32_t slot=1; slot<=dmt_count; slot++) {
+         const dmt_mode_t *pmode = Mode(slot);
+
+         if (pmode->std == 0) continue;
+         if (((pmode->tmg.flags & VTF_RB) != 0) != (pass != 0)) continue;
+         if (dmt_cl::BySTD(pmode->std) != NULL) continue;
+
+         Insert(std_idx, HashSTD(pmode->std), slot);
+      }
+   }
+
+   for (u32_t slot=1; slot<=tbl_count; slot++) {
+      const dmt_mode_t *pmode = Mode(slot);
+      const vtiming_t  &tmg   = pmode->tmg;
+
+      //duplicate keys: the first mode wins
+      if (dmt_cl::Find(tmg.h_act, tmg.v_act, tmg.vrefr, tmg.flags) == NULL) {
+         Insert(res_idx, HashRes(tmg.h_act, tmg.v_act, tmg.vrefr, tmg.flags), slot);
+      }
+      Insert(tmg_idx, (dmt_cl::HashTiming(tmg) >> 24), slot);
+   }
+}
+
+static dmt_index_cl dmt_index;
+
+const dmt_mode_t* dmt_cl::ByID(u32_t id) {
+   if ((id == 0) || (id > DMT_ID_MAX)) return NULL;
+   return &dmt_tbl[id -1];
+}
+
+const dmt_mode_t* dmt_cl::ByETM(u32_t bit) {
+   if (bit >= DMT_ETM_BITS) return NULL;
+   return etm_map[bit];
+}
+
+const dmt_mode_t* dmt_cl::BySTD(u32_t std_code) {
+   u32_t  hash;
+   u32_t  slot;
+
+   hash = dmt_index_cl::HashSTD(std_code);
+
+   while ((slot = dmt_index.std_idx[hash]) != 0) {
+      const dmt_mode_t *pmode = dmt_index_cl::Mode(slot);
+      if (pmode->std == std_code) return pmode;
+      hash = ((hash +1) & dmt_index_cl::idx_mask);
+   }
+   return NULL;
+}
+
+const dmt_mode_t* dmt_cl::Find(u32_t h_act, u32_t v_act, u32_t vrefr, u32_t flags) {
+   u32_t  hash;
+   u32_t  slot;
+
+   flags &= VTF_KEY;
+   hash   = dmt_index_cl::HashRes(h_act, v_act, vrefr, flags);
+
+   while ((slot = dmt_index.res_idx[hash]) != 0) {
+      const vtiming_t *ptmg = &dmt_index_cl::Mode(slot)->tmg;
+
+      if ((ptmg->h_act == h_act) && (ptmg->v_act == v_act) &&
+          (ptmg->vrefr == vrefr) && ((ptmg->flags & VTF_KEY) == flags) ) {
+         return dmt_index_cl::Mode(slot);
+      }
+      hash = ((hash +1) & dmt_index_cl::idx_mask);
+   }
+   return NULL;
+}
+
+const dmt_mode_t* dmt_cl::MatchDTD(const vtiming_t& tmg) {
+   u32_t  hash;
+   u32_t  slot;
+
+   hash = (HashTiming(tmg) >> 24);
+
+   while ((slot = dmt_index.tmg_idx[hash]) != 0) {
+      const dmt_mode_t *pmode = dmt_index_cl::Mode(slot);
+
+      if (SameTiming(pmode->tmg, tmg)) return pmode;
+      hash = ((hash +1) & dmt_index_cl::idx_mask);
+   }
+   return NULL;
+}
+
+u32_t dmt_cl::HashTiming(const vtiming_t& tmg) {
+   u32_t  key;
+
+   key  = (tmg.h_act  << 16) ^ tmg.v_act;
+   key  = (key * 0x9E3779B1) ^ ((tmg.h_bl << 16) ^ tmg.v_bl);
+   key  = (key * 0x9E3779B1) ^ ((tmg.h_fp << 16) ^ tmg.v_fp);
+   key  = (key * 0x9E3779B1) ^ ((tmg.h_sw << 16) ^ tmg.v_sw);
+   key  = (key * 0x9E3779B1) ^ (tmg.flags & VTF_ILACE);
+   return (key * 0x9E3779B1);
+}
+
+bool dmt_cl::SameTiming(const vtiming_t& tmg_a, const vtiming_t& tmg_b) {
+   i32_t  dclk;
+
+   if (tmg_a.h_act != tmg_b.h_act) return false;
+   if (tmg_a.h_bl  != tmg_b.h_bl ) return false;
+   if (tmg_a.h_fp  != tmg_b.h_fp ) return false;
+   if (tmg_a.h_sw  != tmg_b.h_sw ) return false;
+   if (tmg_a.v_act != tmg_b.v_act) return false;
+   if (tmg_a.v_bl  != tmg_b.v_bl ) return false;
+   if (tmg_a.v_fp  != tmg_b.v_fp ) return false;
+   if (tmg_a.v_sw  != tmg_b.v_sw ) return false;
+   if (((tmg_a.flags ^ tmg_b.flags) & VTF_ILACE) != 0) return false;
+
+   dclk = (i32_t) tmg_a.pixclk - (i32_t) tmg_b.pixclk;
+   return ((dclk > -10) && (dclk < 10));
+}
+
+rcode dmt_cl::DecodeSTD(u32_t std_code, u32_t& h_act, u32_t& v_act, u32_t& vrefr, bool edid_ver13) {
+   rcode  retU;
+   u32_t  x_res8;
+
+   x_res8 = ((std_code >> 8) & 0xFF);
+   //0x0101: unused, 0x00: reserved
+   if ((std_code == 0x0101) || (x_res8 == 0)) RCD_RETURN_FAULT(retU);
+
+   h_act = ((x_res8 + 31) << 3);
+   vrefr = ((std_code & 0x3F) + 60);
+
+   switch ((std_code >> 6) & 0x03) {
+      case 0:
+         v_act = edid_ver13 ? ((h_act * 10) / 16) : h_act;
+         break;
+      case 1:
+         v_act = ((h_act * 3) / 4);
+         break;
+      case 2:
+         v_act = ((h_act * 4) / 5);
+         break;
+      default:
+         v_act = ((h_act * 9) / 16);
+         break;
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+rcode dmt_cl::CVT(u32_t h_act, u32_t v_act, u32_t vrefr, vtiming_t& tmg) {
+   static const double  min_vsync_bp = 550.0; //us
+   static const u32_t   min_v_porch  = 3;
+   static const u32_t   min_v_bporch = 6;
+   static const double  c_prime      = 30.0;
+   static const double  m_prime      = 300.0;
+
+   rcode   retU;
+   double  h_period;
+   double  duty;
+   u32_t   h_blank;
+   u32_t   h_total;
+   u32_t   v_sync;
+   u32_t   v_sync_bp;
+
+   h_act -= (h_act % 8);
+   if ((h_act == 0) || (v_act == 0) || (vrefr == 0)) RCD_RETURN_FAULT(retU);
+
+   //V-sync width encodes the aspect ratio
+   if ((v_act *  4) == (h_act * 3)) {
+      v_sync = 4;
+   } else if ((v_act * 16) == (h_act *  9)) {
+      v_sync = 5;
+   } else if ((v_act * 16) == (h_act * 10)) {
+      v_sync = 6;
+   } else if (((v_act * 5) == (h_act * 4)) || ((v_act * 15) == (h_act * 9))) {
+      v_sync = 7;
+   } else {
+      v_sync = 10;
+   }
+
+   h_period  = ((1000000.0 / vrefr) - min_vsync_bp) / (v_act + min_v_porch); //us
+   if (h_period <= 0.0) RCD_RETURN_FAULT(retU);
+
+   v_sync_bp = (u32_t) (min_vsync_bp / h_period) +1;
+   if (v_sync_bp < (v_sync + min_v_bporch)) v_sync_bp = (v_sync + min_v_bporch);
+
+   duty = c_prime - ((m_prime * h_period) / 1000.0);
+   if (duty < 20.0) duty = 20.0;
+
+   h_blank = ((u32_t) ((h_act * duty) / (100.0 - duty) / 16.0)) * 16;
+   h_total = h_act + h_blank;
+
+   tmg.pixclk = ((u32_t) ((h_total / h_period) * 4.0)) * 250; //250kHz steps
+   tmg.h_act  = h_act;
+   tmg.h_bl   = h_blank;
+   tmg.h_sw   = ((u32_t) ((h_total * 0.08) / 8.0)) * 8;
+   tmg.h_fp   = (h_blank / 2) - tmg.h_sw;
+   tmg.v_act  = v_act;
+   tmg.v_bl   = v_sync_bp + min_v_porch;
+   tmg.v_fp   = min_v_porch;
+   tmg.v_sw   = v_sync;
+   tmg.flags  = VTF_VSPOS;
+   tmg.vrefr  = vrefr;
+
+   RCD_RETURN_OK(retU);
+}
+
+rcode dmt_cl::FromDTD(const u8_t* pdtd, vtiming_t& tmg) {
+   rcode         retU;
+   const dtd_t  *pdsc;
+
+   if (pdtd == NULL) RCD_RETURN_FAULT(retU);
+   pdsc = reinterpret_cast <const dtd_t*> (pdtd);
+   if (pdsc->pix_clk == 0) RCD_RETURN_FAULT(retU); //not a DTD
+
+   tmg.pixclk = pdsc->pix_clk * 10;
+   tmg.h_act  = pdsc->HApix_8lsb  | (pdsc->HApix_4msb  << 8);
+   tmg.h_bl   = pdsc->HBpix_8lsb  | (pdsc->HBpix_4msb  << 8);
+   tmg.h_fp   = pdsc->HOsync_8lsb | (pdsc->HOsync_2msb << 8);
+   tmg.h_sw   = pdsc->HsyncW_8lsb | (pdsc->HsyncW_2msb << 8);
+   tmg.v_act  = pdsc->VAlin_8lsb  | (pdsc->VAlin_4msb  << 8);
+   tmg.v_bl   = pdsc->VBlin_8lsb  | (pdsc->VBlin_4msb  << 8);
+   tmg.v_fp   = pdsc->VOsync_4lsb | (pdsc->VOsync_2msb << 4);
+   tmg.v_sw   = pdsc->VsyncW_4lsb | (pdsc->VsyncW_2msb << 4);
+   tmg.flags  = 0;
+
+   //polarity bits are valid only for digital separate sync
+   if (pdsc->features.sync_type == 3) {
+      if (pdsc->features.Hsync_type != 0) tmg.flags |= VTF_HSPOS;
+      if (pdsc->features.Vsync_type != 0) tmg.flags |= VTF_VSPOS;
+   }
+   //interlaced: the DTD describes a field
+   if (pdsc->features.interlaced != 0) {
+      tmg.flags |= VTF_ILACE;
+      tmg.v_act *= 2;
+      tmg.v_bl   = (tmg.v_bl * 2) +1;
+      tmg.v_fp  *= 2;
+      tmg.v_sw  *= 2;
+   }
+
+   tmg.vrefr = ((Refresh(tmg) + 500) / 1000);
+
+   RCD_RETURN_OK(retU);
+}
+
+u32_t dmt_cl::Refresh(const vtiming_t& tmg) {
+   u64_t  tot;
+   u64_t  clk;
+
+   tot = (u64_t) (tmg.h_act + tmg.h_bl) * (tmg.v_act + tmg.v_bl);
+   if (tot == 0) return 0;
+
+   clk = (u64_t) tmg.pixclk * 1000000;
+   if ((tmg.flags & VTF_ILACE) != 0) clk *= 2; //field rate
+
+   return ((clk + (tot >> 1)) / tot);
+}
+
+void dmt_cl::Print(const dmt_mode_t* pmode, wxString& str) {
+   const vtiming_t *ptmg;
+   u32_t            mhz;
+
+   if (pmode == NULL) return;
+   ptmg = &pmode->tmg;
+   mhz  = Refresh(*ptmg);
+
+   if (pmode->id != 0) {
+      str.Printf("DMT 0x%02X: %s", pmode->id, pmode->name);
+   } else {
+      str.Printf("%s (not a DMT mode)", pmode->name);
+   }
+   if (pmode->std != 0) {
+      str << wxString::Format(", STD code: 0x%04X", pmode->std);
+   }
+
+   str << wxString::Format(
+      "\nPixel clock: %u.%03u MHz, V-refresh: %u.%03u Hz%s%s\n"
+      "H: active %u, blanking %u, sync offset %u, sync width %u, %csync\n"
+      "V: active %u, blanking %u, sync offset %u, sync width %u, %csync",
+      ptmg->pixclk / 1000, ptmg->pixclk % 1000, mhz / 1000, mhz % 1000,
+      (ptmg->flags & VTF_ILACE) ? ", interlaced" : "",
+      (ptmg->flags & VTF_RB   ) ? ", reduced blanking" : "",
+      ptmg->h_act, ptmg->h_bl, ptmg->h_fp, ptmg->h_sw, (ptmg->flags & VTF_HSPOS) ? '+' : '-',
+      ptmg->v_act, ptmg->v_bl, ptmg->v_fp, ptmg->v_sw, (ptmg->flags & VTF_VSPOS) ? '+' : '-');
+}
@@ -0,0 +1,82 @@
+/***************************************************************
+ * Name:      dmt.h
+ * Purpose:   VESA DMT timings database, ETM/STI/DTD lookups
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef DMT_H
+#define DMT_H 1
+
+#include <wx/string.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+
+enum { //vtiming_t.flags
+   VTF_ILACE = 0x0001, //interlaced: v_* values are for the frame, not the field
+   VTF_HSPOS = 0x0002, //positive H-sync
+   VTF_VSPOS = 0x0004, //positive V-sync
+   VTF_RB    = 0x0008, //reduced blanking
+   VTF_KEY   = (VTF_ILACE | VTF_RB) //flags used by dmt_cl::Find()
+};
+
+//full timing, DTD-style layout: active, blanking, sync offset (front porch), sync width
+typedef struct {
+   u32_t  pixclk;  //kHz
+   u16_t  h_act;
+   u16_t  h_bl;
+   u16_t  h_fp;
+   u16_t  h_sw;
+   u16_t  v_act;
+   u16_t  v_bl;
+   u16_t  v_fp;
+   u16_t  v_sw;
+   u16_t  flags;
+   u16_t  vrefr;   //nominal V-refresh, Hz: field rate for interlaced modes
+} vtiming_t;
+
+typedef struct {
+   vtiming_t    tmg;
+   u16_t        id;   //DMT ID, 0: not a DMT mode (legacy ETM modes)
+   u16_t        std;  //STD 2-byte code: byte0 << 8 | byte1, 0: none
+   const char  *name;
+} dmt_mode_t;
+
+enum {
+   DMT_ID_MAX   = 0x58,
+   DMT_ETM_BITS = 24
+};
+
+//Compile-time tables, the hash indexes are built once, at startup.
+class dmt_cl {
+   public:
+      //O(1) lookups: NULL if not found
+      static const dmt_mode_t*  ByID    (u32_t id);
+      static const dmt_mode_t*  BySTD   (u32_t std_code);
+      //ETM bit index: byte35.bit0 = 0 ... byte37.bit7 = 23
+      static const dmt_mode_t*  ByETM   (u32_t bit);
+      static const dmt_mode_t*  Find    (u32_t h_act, u32_t v_act, u32_t vrefr, u32_t flags = 0);
+      //exact match of the timing, the pixel clock is compared with 10kHz tolerance (DTD resolution)
+      static const dmt_mode_t*  MatchDTD(const vtiming_t& tmg);
+
+      //STI bytes -> resolution & refresh, edid_ver13: pix_ratio 00 = 16:10, 1:1 otherwise.
+      static rcode  DecodeSTD(u32_t std_code, u32_t& h_act, u32_t& v_act, u32_t& vrefr, bool edid_ver13 = true);
+      //CVT 1.2 normal blanking timing (progressive, no margins): STI modes without DMT entry
+      static rcode  CVT      (u32_t h_act, u32_t v_act, u32_t vrefr, vtiming_t& tmg);
+      //DTD (18 bytes) -> vtiming_t, vrefr is rounded from the pixel clock
+      static rcode  FromDTD  (const u8_t* pdtd, vtiming_t& tmg);
+      //refresh rate in mHz, field rate for interlaced modes
+      static u32_t  Refresh  (const vtiming_t& tmg);
+
+      //hash of the timing geometry: the pixel clock and the sync polarity are not included
+      static u32_t  HashTiming(const vtiming_t& tmg);
+      //same geometry, pixel clock within 10kHz (DTD resolution)
+      static bool   SameTiming(const vtiming_t& tmg_a, const vtiming_t& tmg_b);
+
+      static void   Print    (const dmt_mode_t* pmode, wxString& str);
+};
+
+#endif /* DMT_H */
@@ -0,0 +1,575 @@
+/***************************************************************
+ * Name:      drm_mon.cpp
+ * Purpose:   Live monitor of DRM connectors in sysfs
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-18
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idDRM_MON
+   #error "drm_mon.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idDRM_MON
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "drm_mon.h"
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filefn.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#ifdef __linux__
+   #include <unistd.h>
+   #include <fcntl.h>
+   #include <poll.h>
+   #include <sys/inotify.h>
+   #include <sys/socket.h>
+   #include <linux/netlink.h>
+#endif
+
+drm_mon_thr_cl::drm_mon_thr_cl(wxEvtHandler *dst, int evtid, const wxString& sysfs_root, u32_t mon_gen) :
+   wxThread(wxTHREAD_JOINABLE),
+   evt_dst(dst), evt_id(evtid), gen(mon_gen), root(sysfs_root),
+   ino_fd(-1), root_wd(-1), uev_fd(-1), nconn(0)
+{
+   stop_fd[0] = -1;
+   stop_fd[1] = -1;
+
+   for (u32_t itc=0; itc<DRM_MON_MAX_CONN; itc++) {
+      conn_ar[itc].wd      = -1;
+      conn_ar[itc].conn_id =  0;
+      conn_ar[itc].datsz   =  0;
+      conn_ar[itc].EDID    = NULL;
+   }
+}
+
+drm_mon_thr_cl::~drm_mon_thr_cl() {
+#ifdef __linux__
+   if (ino_fd     >= 0) close(ino_fd);
+   if (uev_fd     >= 0) close(uev_fd);
+   if (stop_fd[0] >= 0) close(stop_fd[0]);
+   if (stop_fd[1] >= 0) close(stop_fd[1]);
+#endif
+
+   for (u32_t itc=0; itc<nconn; itc++) {
+      if (conn_ar[itc].EDID == NULL) continue;
+
+      conn_ar[itc].EDID->DeleteGroups();
+      delete conn_ar[itc].EDID;
+   }
+}
+
+void drm_mon_thr_cl::post_evt(u32_t type, long idx, const wxString& msg) {
+   wxThreadEvent *evt;
+
+   evt = new wxThreadEvent(wxEVT_THREAD, evt_id);
+   if (evt == NULL) return;
+
+   evt->SetInt      (type);
+   evt->SetExtraLong(idx );
+   evt->SetString   (msg ); //deep copy
+   evt->SetPayload<u32_t>(gen);
+
+   wxQueueEvent(evt_dst, evt);
+}
+
+#ifdef __linux__
+
+rcode drm_mon_thr_cl::Init() {
+   rcode    retU;
+   wxDir    dir;
+   wxString name;
+   bool     b_cont;
+   u32_t    idx;
+
+   ino_fd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+   if (ino_fd < 0) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] inotify_init1(): %s", strerror(errno));
+   }
+   if (pipe2(stop_fd, O_NONBLOCK|O_CLOEXEC) != 0) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] pipe2(): %s", strerror(errno));
+   }
+
+   //connectors added/removed
+   root_wd = inotify_add_watch(ino_fd, root.fn_str(),
+                               IN_CREATE|IN_DELETE|IN_MOVED_TO|IN_MOVED_FROM|IN_ONLYDIR);
+   if (root_wd < 0) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Can't watch '%s': %s",
+                                   (const char*) root.ToUTF8(), strerror(errno));
+   }
+
+   if (! dir.Open(root)) RCD_RETURN_FAULT(retU);
+
+   b_cont = dir.GetFirst(&name, "card*-*", wxDIR_DIRS);
+   while (b_cont) {
+      add_conn(name, idx);
+      b_cont = dir.GetNext(&name);
+   }
+
+   //kernel hotplug events: sysfs attributes changed by the kernel don't generate inotify events
+   uev_fd = socket(AF_NETLINK, SOCK_DGRAM|SOCK_NONBLOCK|SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+   if (uev_fd >= 0) {
+      struct sockaddr_nl snl;
+
+      memset(&snl, 0, sizeof(snl));
+      snl.nl_family = AF_NETLINK;
+      snl.nl_groups = 1; //kernel uevents
+
+      if (bind(uev_fd, (struct sockaddr*) &snl, sizeof(snl)) != 0) {
+         close(uev_fd);
+         uev_fd = -1;
+      }
+   }
+
+   slog.Printf("DRM monitor: %u connector(s) in '%s'", nconn, root);
+   if (uev_fd < 0) slog << ", uevents not available: inotify only";
+   post_evt(DRMEV_LOG, -1, slog);
+
+   RCD_RETURN_OK(retU);
+}
+
+void drm_mon_thr_cl::Stop() {
+   char stop = 1;
+
+   if (stop_fd[1] < 0) return;
+   if (write(stop_fd[1], &stop, 1) != 1) return;
+}
+
+wxThread::ExitCode drm_mon_thr_cl::Entry() {
+   struct pollfd pfd[3];
+   u32_t         pend;
+   int           nfd;
+
+   //initial state, no diff
+   for (u32_t itc=0; itc<nconn; itc++) update_conn(itc, true);
+
+   pfd[0].fd     = stop_fd[0];
+   pfd[0].events = POLLIN;
+   pfd[1].fd     = ino_fd;
+   pfd[1].events = POLLIN;
+   pfd[2].fd     = uev_fd;
+   pfd[2].events = POLLIN;
+   nfd = (uev_fd < 0) ? 2 : 3;
+
+   for (;;) {
+      if (poll(pfd, nfd, -1) < 0) {
+         if (errno == EINTR) continue;
+
+         slog.Printf("poll(): %s", strerror(errno));
+         post_evt(DRMEV_STOP, -1, slog);
+         break;
+      }
+
+      if (pfd[0].revents != 0) break; //stop request
+
+      //coalesce the events: each changed connector is read only once
+      pend = 0;
+      if (pfd[1].revents != 0) pend |= read_inotify();
+      if ((nfd > 2) && (pfd[2].revents != 0)) pend |= read_uevent();
+
+      for (u32_t itc=0; pend != 0; itc++, pend >>= 1) {
+         if ((pend & 1) == 0) continue;
+         update_conn(itc, false);
+      }
+   }
+   return 0;
+}
+
+rcode drm_mon_thr_cl::add_conn(const wxString& name, u32_t& idx) {
+   rcode       retU;
+   drm_conn_t *pconn;
+   wxString    dpath;
+   wxString    sval;
+   wxFile      file;
+   int         wd;
+
+   dpath  = root;
+   dpath << "/" << name;
+
+   wd = inotify_add_watch(ino_fd, dpath.fn_str(), IN_CLOSE_WRITE|IN_MOVED_TO|IN_ONLYDIR);
+   if (wd < 0) RCD_RETURN_FAULT(retU);
+
+   //re-created connector keeps its slot
+   for (idx=0; idx<nconn; idx++) {
+      if (conn_ar[idx].name == name) break;
+   }
+   if (idx >= DRM_MON_MAX_CONN) {
+      inotify_rm_watch(ino_fd, wd);
+      RCD_RETURN_FAULT(retU);
+   }
+
+   mtx.Lock();
+   if (idx == nconn) nconn ++ ;
+
+   pconn        = &conn_ar[idx];
+   pconn->name  = name;
+   pconn->fpath = dpath;
+   pconn->fpath << "/edid";
+   pconn->wd    = wd;
+   mtx.Unlock();
+
+   //connector_id: CONNECTOR=id in hotplug uevents (kernel >= 5.x)
+   pconn->conn_id = 0;
+   dpath << "/connector_id";
+   if (file.Open(dpath, wxFile::read)) {
+      unsigned long cid;
+
+      if (file.ReadAll(&sval) && sval.Trim().ToULong(&cid)) pconn->conn_id = cid;
+      file.Close();
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+void drm_mon_thr_cl::del_conn(u32_t idx) {
+   drm_conn_t *pconn;
+
+   pconn = &conn_ar[idx];
+
+   //the kernel removes the watch with the directory
+   pconn->wd = -1;
+
+   slog.Printf("%s: connector removed", pconn->name);
+   post_evt(DRMEV_LOG, idx, slog);
+
+   mtx.Lock();
+   pconn->datsz = 0;
+   mtx.Unlock();
+
+   if (pconn->EDID != NULL) {
+      pconn->EDID->DeleteGroups();
+      delete pconn->EDID;
+      pconn->EDID = NULL;
+   }
+}
+
+u32_t drm_mon_thr_cl::read_inotify() {
+   char   evbuf[DRM_MON_EVBUF_SZ] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+   u32_t  pend = 0;
+   ssize_t len;
+
+   for (;;) {
+      len = read(ino_fd, evbuf, sizeof(evbuf));
+      if (len <= 0) break; //EAGAIN: queue empty
+
+      for (char *pev = evbuf; pev < (evbuf + len); ) {
+         struct inotify_event *ino_ev;
+         wxString  name;
+         u32_t     idx;
+
+         ino_ev = (struct inotify_event*) pev;
+         pev   += sizeof(struct inotify_event) + ino_ev->len;
+
+         if (0 != (ino_ev->mask & IN_Q_OVERFLOW)) {
+            //events lost: check all, unchanged data is not parsed
+            for (idx=0; idx<nconn; idx++) {
+               if (conn_ar[idx].wd >= 0) pend |= (1u << idx);
+            }
+            continue;
+         }
+         if (ino_ev->len > 0) name = wxString::FromUTF8(ino_ev->name);
+
+         if (ino_ev->wd == root_wd) {
+            if (! wxMatchWild("card*-*", name)) continue;
+
+            if (0 != (ino_ev->mask & (IN_CREATE|IN_MOVED_TO))) {
+               if (! RCD_IS_OK(add_conn(name, idx))) continue;
+
+               slog.Printf("%s: connector added", name);
+               post_evt(DRMEV_LOG, idx, slog);
+               pend |= (1u << idx);
+               continue;
+            }
+            for (idx=0; idx<nconn; idx++) {
+               if (conn_ar[idx].name != name) continue;
+               if (conn_ar[idx].wd   <  0   ) break;
+
+               del_conn(idx);
+               pend &= ~(1u << idx);
+               break;
+            }
+            continue;
+         }
+
+         //connector dir: only the EDID file is of interest
+         if (name != "edid") continue;
+
+         for (idx=0; idx<nconn; idx++) {
+            if (conn_ar[idx].wd != ino_ev->wd) continue;
+
+            pend |= (1u << idx);
+            break;
+         }
+      }
+   }
+   return pend;
+}
+
+u32_t drm_mon_thr_cl::read_uevent() {
+   char    evbuf[DRM_MON_EVBUF_SZ];
+   u32_t   pend = 0;
+   ssize_t len;
+
+   for (;;) {
+      bool  b_drm     = false;
+      bool  b_hotplug = false;
+      u32_t conn_id   = 0;
+
+      len = recv(uev_fd, evbuf, sizeof(evbuf) -1, 0);
+      if (len <= 0) break; //EAGAIN: queue empty
+      evbuf[len] = 0;
+
+      //"ACTION@devpath\0KEY=VAL\0KEY=VAL\0..."
+      for (char *pkey = evbuf; pkey < (evbuf + len); pkey += strlen(pkey) +1) {
+         if (0 == strcmp (pkey, "SUBSYSTEM=drm")) b_drm     = true;
+         if (0 == strcmp (pkey, "HOTPLUG=1"    )) b_hotplug = true;
+         if (0 == strncmp(pkey, "CONNECTOR=", 10)) conn_id   = strtoul(pkey +10, NULL, 10);
+      }
+      if (! (b_drm && b_hotplug)) continue;
+
+      //no connector id: check all, unchanged data is not parsed
+      for (u32_t itc=0; itc<nconn; itc++) {
+         if (conn_ar[itc].wd < 0) continue;
+         if ((conn_id != 0) && (conn_ar[itc].conn_id != conn_id)) continue;
+
+         pend |= (1u << itc);
+      }
+   }
+   return pend;
+}
+
+#else //__linux__
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+rcode drm_mon_thr_cl::Init() {
+   rcode retU;
+
+   wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] DRM monitor: inotify not supported on this platform");
+}
+
+void drm_mon_thr_cl::Stop() {
+   return;
+}
+
+wxThread::ExitCode drm_mon_thr_cl::Entry() {
+   return 0;
+}
+
+rcode drm_mon_thr_cl::add_conn(const wxString& name, u32_t& idx) {
+   rcode retU;
+   RCD_RETURN_FAULT(retU);
+}
+
+void drm_mon_thr_cl::del_conn(u32_t idx) {
+   return;
+}
+
+u32_t drm_mon_thr_cl::read_inotify() {
+   return 0;
+}
+
+u32_t drm_mon_thr_cl::read_uevent() {
+   return 0;
+}
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+#endif //__linux__
+
+void drm_mon_thr_cl::update_conn(u32_t idx, bool b_initial) {
+   drm_conn_t *pconn;
+   EDID_cl    *pEDID;
+   edi_buf_t   ebuf;
+   wxFile      file;
+   ssize_t     len = 0;
+   u32_t       n_extblk = 0;
+
+   pconn = &conn_ar[idx];
+   if (pconn->wd < 0) return;
+
+   memset(&ebuf, 0, sizeof(edi_buf_t));
+
+   //sysfs: empty file for disconnected connector
+   if (file.Open(pconn->fpath, wxFile::read)) {
+      len = file.Read(ebuf.buff, sizeof(edi_buf_t));
+      file.Close();
+      if (len < 0) len = 0;
+   }
+
+   if ((! b_initial) && ((u32_t) len == pconn->datsz)) {
+      if (0 == memcmp(ebuf.buff, pconn->raw.buff, len)) return; //unchanged
+   }
+
+   mtx.Lock();
+   memcpy(&pconn->raw, &ebuf, sizeof(edi_buf_t));
+   pconn->datsz = len;
+   mtx.Unlock();
+
+   if (len < EDI_BLK_SIZE) {
+      if (len == 0) {
+         slog.Printf("%s: disconnected", pconn->name);
+      } else {
+         slog.Printf("%s: short EDID: %d bytes", pconn->name, (int) len);
+      }
+      post_evt(DRMEV_LOG, idx, slog);
+
+      if (pconn->EDID != NULL) {
+         pconn->EDID->DeleteGroups();
+         delete pconn->EDID;
+         pconn->EDID = NULL;
+      }
+      if (! b_initial) post_evt(DRMEV_CHANGE, idx, pconn->fpath);
+      return;
+   }
+
+   pEDID = new EDID_cl;
+   if (pEDID == NULL) return;
+
+   pEDID->Set_ERR_Ignore(true);
+   pEDID->SetGuiLogPtr(&tlog);
+   pEDID->Clear();
+   memcpy(pEDID->getEDID()->buff, ebuf.buff, sizeof(edi_buf_t));
+
+   slog.Printf("%s: ", pconn->name);
+   if (! pEDID->VerifyChksum(EDI_BASE_IDX)) slog << "bad checksum, ";
+
+   if (! RCD_IS_OK(pEDID->ParseEDID_Base(n_extblk))) slog << "base block errors, ";
+   if ((n_extblk > 0) && (len >= (2 * EDI_BLK_SIZE))) {
+      if (! RCD_IS_OK(pEDID->ParseEDID_CEA())) slog << "CTA-861 errors, ";
+   }
+
+   if (b_initial || (pconn->EDID == NULL)) {
+      slog << (b_initial ? "EDID loaded" : "connected");
+      post_evt(DRMEV_LOG, idx, slog);
+   } else {
+      slog << "EDID changed:";
+      diff_edid(*pconn->EDID, *pEDID);
+      post_evt(DRMEV_LOG, idx, slog);
+
+      pconn->EDID->DeleteGroups();
+      delete pconn->EDID;
+   }
+   pconn->EDID = pEDID;
+
+   if (! b_initial) post_evt(DRMEV_CHANGE, idx, pconn->fpath);
+}
+
+void drm_mon_thr_cl::diff_edid(EDID_cl& prev, EDID_cl& cur) {
+   GroupAr_cl *p_par;
+   GroupAr_cl *p_car;
+   edi_grp_cl *pgrp;
+   edi_grp_cl *cgrp;
+   wxString    path;
+   u32_t       ngrp;
+
+   for (u32_t itb=0; itb<4; itb++) {
+      p_par = prev.BlkGroupsAr[itb];
+      p_car = cur .BlkGroupsAr[itb];
+
+      ngrp = p_par->GetCount();
+      if (ngrp < p_car->GetCount()) ngrp = p_car->GetCount();
+
+      for (u32_t itg=0; itg<ngrp; itg++) {
+         pgrp = (itg < p_par->GetCount()) ? p_par->Item(itg) : NULL;
+         cgrp = (itg < p_car->GetCount()) ? p_car->Item(itg) : NULL;
+
+         path.Printf("\n blk%u.", itb);
+         diff_group(prev, pgrp, cgrp, path);
+      }
+   }
+}
+
+void drm_mon_thr_cl::diff_group(EDID_cl& prev, edi_grp_cl *pgrp, edi_grp_cl *cgrp, const wxString& path) {
+   edi_dynfld_t *p_pfld;
+   edi_dynfld_t *p_cfld;
+   wxString      pval;
+   wxString      cval;
+   wxString      gpath;
+   u32_t         ival;
+   u32_t         nfld;
+   u32_t         nsub;
+   rcode         retU;
+
+   if (pgrp == NULL) {
+      slog << path << "+ " << cgrp->CodeName;
+      return;
+   }
+   if (cgrp == NULL) {
+      slog << path << "- " << pgrp->CodeName;
+      return;
+   }
+   if (pgrp->CodeName != cgrp->CodeName) {
+      slog << path << pgrp->CodeName << " -> " << cgrp->CodeName;
+      return;
+   }
+   //same data: skip field compare
+   if ((pgrp->getTotalSize() == cgrp->getTotalSize()) &&
+       (0 == memcmp(pgrp->getInsPtr(), cgrp->getInsPtr(), pgrp->getTotalSize())) ) return;
+
+   gpath  = path;
+   gpath << pgrp->CodeName;
+
+   nfld = pgrp->FieldsAr.GetCount();
+   if (nfld > cgrp->FieldsAr.GetCount()) nfld = cgrp->FieldsAr.GetCount();
+
+   for (u32_t itf=0; itf<nfld; itf++) {
+      p_pfld = pgrp->FieldsAr.Item(itf);
+      p_cfld = cgrp->FieldsAr.Item(itf);
+
+      if (p_pfld->field.handlerfn == NULL) continue;
+
+      //some handlers append to the output string
+      pval.Empty();
+      cval.Empty();
+
+      //handlers read the group instance data: any EDID_cl instance can be used
+      retU = (prev.*p_pfld->field.handlerfn)(OP_READ, pval, ival, p_pfld);
+      if (! RCD_IS_OK(retU)) continue;
+      retU = (prev.*p_cfld->field.handlerfn)(OP_READ, cval, ival, p_cfld);
+      if (! RCD_IS_OK(retU)) continue;
+
+      if (pval == cval) continue;
+
+      slog << gpath << "." << p_pfld->field.name << ": '" << pval << "' -> '" << cval << "'";
+   }
+
+   nsub = pgrp->getSubGrpCount();
+   if (nsub < cgrp->getSubGrpCount()) nsub = cgrp->getSubGrpCount();
+
+   gpath << ".";
+   for (u32_t its=0; its<nsub; its++) {
+      edi_grp_cl *psub;
+      edi_grp_cl *csub;
+
+      psub = (its < pgrp->getSubGrpCount()) ? pgrp->getSubGroup(its) : NULL;
+      csub = (its < cgrp->getSubGrpCount()) ? cgrp->getSubGroup(its) : NULL;
+
+      diff_group(prev, psub, csub, gpath);
+   }
+}
+
+bool drm_mon_thr_cl::getConnData(u32_t idx, u8_t *pbuf, u32_t bsz, wxString& fpath) {
+   wxMutexLocker lock(mtx);
+   u32_t         dsz;
+
+   if (idx >= nconn) return false;
+
+   fpath = conn_ar[idx].fpath.Clone();
+   dsz   = conn_ar[idx].datsz;
+   if (dsz == 0) return false;
+   if (dsz > bsz) dsz = bsz;
+
+   memset(pbuf, 0, bsz);
+   memcpy(pbuf, conn_ar[idx].raw.buff, dsz);
+   return true;
+}
@@ -0,0 +1,91 @@
+/***************************************************************
+ * Name:      drm_mon.h
+ * Purpose:   Live monitor of DRM connectors in sysfs
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-18
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef DRM_MON_H
+#define DRM_MON_H 1
+
+#include <wx/thread.h>
+#include <wx/event.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+
+#define DRM_SYSFS_ROOT "/sys/class/drm"
+
+enum {
+   DRM_MON_MAX_CONN = 32,  //bit mask of pending updates: u32_t
+   DRM_MON_EVBUF_SZ = 4096 //inotify/uevent read buffer
+};
+
+//wxThreadEvent::GetPayload<u32_t>(): mon_gen of the monitor which posted the event
+enum { //monitor event type: wxThreadEvent::GetInt()
+   DRMEV_LOG    = 0, //GetString(): log message
+   DRMEV_CHANGE = 1, //GetExtraLong(): connector idx, EDID data changed
+   DRMEV_STOP   = 2  //monitor stopped on error, GetString(): reason
+};
+
+typedef struct {
+   wxString   name;  //connector dir name, f.e. "card0-HDMI-A-1"
+   wxString   fpath; //connector EDID file
+   int        wd;    //inotify watch descriptor, -1: connector removed
+   u32_t      conn_id; //DRM connector id, for uevent CONNECTOR=id, 0: unknown
+   u32_t      datsz;   //0: disconnected
+   edi_buf_t  raw;     //last read data: unchanged data is not parsed again
+   EDID_cl   *EDID;    //last parse, NULL: nothing to compare with
+} drm_conn_t;
+
+//Connectors (<root>/card*-*) are watched with inotify, the kernel hotplug
+//uevents are received from the netlink socket: the thread sleeps in poll()
+//until one of them (or the stop request) arrives.
+//Only the connectors with changed EDID data are parsed again, the changes
+//are reported as a field-by-field diff against the previous parse.
+class drm_mon_thr_cl : public wxThread {
+   protected:
+      wxEvtHandler *evt_dst;
+      int           evt_id;
+      u32_t         gen;        //events are tagged: the GUI drops the ones from stopped monitors
+      wxString      root;
+
+      int           ino_fd;
+      int           root_wd;
+      int           uev_fd;     //-1: no uevents (not permitted)
+      int           stop_fd[2]; //pipe: stop request
+
+      wxMutex       mtx;        //conn_ar access from the GUI thread
+      drm_conn_t    conn_ar[DRM_MON_MAX_CONN];
+      u32_t         nconn;
+
+      guilog_cl     tlog;
+      wxString      slog;
+
+      ExitCode Entry();
+
+      void  post_evt    (u32_t type, long idx, const wxString& msg);
+      rcode add_conn    (const wxString& name, u32_t& idx);
+      void  del_conn    (u32_t idx);
+      void  update_conn (u32_t idx, bool b_initial);
+      u32_t read_inotify();
+      u32_t read_uevent ();
+
+      void  diff_edid   (EDID_cl& prev, EDID_cl& cur);
+      void  diff_group  (EDID_cl& prev, edi_grp_cl *pgrp, edi_grp_cl *cgrp, const wxString& path);
+
+   public:
+      rcode Init(); //watch the connectors: called before Run()
+      void  Stop(); //GUI thread: request stop, then Wait()
+
+      bool  getConnData(u32_t idx, u8_t *pbuf, u32_t bsz, wxString& fpath);
+
+      drm_mon_thr_cl(wxEvtHandler *dst, int evtid, const wxString& sysfs_root, u32_t mon_gen);
+      ~drm_mon_thr_cl();
+};
+
+#endif /* DRM_MON_H */
@@ -0,0 +1,291 @@
+/***************************************************************
+ * Name:      fw_scan.cpp
+ * Purpose:   Firmware/VBIOS image scanner: embedded EDIDs
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-16
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idFW_SCAN
+   #error "fw_scan.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idFW_SCAN
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "fw_scan.h"
+#include "corpus.h"
+
+#include <wx/file.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+//GCC vector extensions: SSE2/NEON/etc. code, depending on the target
+typedef u8_t v16u8_t __attribute__ ((vector_size(16)));
+
+static const u8_t edid_hdr[FWS_HDR_LEN] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+
+static const v16u8_t v16_00 = {0};
+static const v16u8_t v16_FF = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                               0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static inline bool fws_chksum(const u8_t *pblk) {
+   u32_t csum = 0;
+
+   for (u32_t itb=0; itb<EDI_BLK_SIZE; itb++) {
+      csum += pblk[itb];
+   }
+   return ((csum & 0xFF) == 0);
+}
+
+fw_scan_cl::fw_scan_cl() :
+   buf(NULL), prev_off(0), prev_end(0), b_prev(false), nbytes(0), nhits(0)
+{}
+
+fw_scan_cl::~fw_scan_cl() {
+   if (buf != NULL) delete [] buf;
+}
+
+//first header in [pos, end), the header must fit in (len) bytes
+u32_t fw_scan_cl::find_hdr(const u8_t *pbuf, u32_t pos, u32_t end, u32_t len) {
+   v16u8_t  b0, b1, b4, b7, msk;
+   u64_t    mq[2];
+
+   //16 positions per step: header bytes 0, 1, 4 & 7 compared in parallel
+   while ((pos < end) && ((pos + 16 + FWS_HDR_LEN -1) <= len)) {
+      memcpy(&b0, pbuf + pos    , 16);
+      memcpy(&b1, pbuf + pos + 1, 16);
+      memcpy(&b4, pbuf + pos + 4, 16);
+      memcpy(&b7, pbuf + pos + 7, 16);
+
+      msk = (v16u8_t) ((b0 == v16_00) & (b1 == v16_FF) & (b4 == v16_FF) & (b7 == v16_00));
+      memcpy(mq, &msk, 16);
+
+      if ((mq[0] | mq[1]) != 0) {
+         for (u32_t itb=0; itb<16; itb++) {
+            if (msk[itb] == 0) continue;
+            if ((pos + itb) >= end) return end;
+            if (memcmp(pbuf + pos + itb, edid_hdr, FWS_HDR_LEN) == 0) return (pos + itb);
+         }
+      }
+      pos += 16;
+   }
+
+   //buffer tail
+   for (; pos < end; pos++) {
+      if ((pos + FWS_HDR_LEN) > len) break;
+      if (pbuf[pos] != 0) continue;
+      if (memcmp(pbuf + pos, edid_hdr, FWS_HDR_LEN) == 0) return pos;
+   }
+   return end;
+}
+
+bool fw_scan_cl::check_hit(u64_t foff, const u8_t *pdata, u32_t avail, fw_scan_sink_cl& sink) {
+   fw_hit_t  hit;
+   u32_t     n_use;
+
+   memset(&hit, 0, sizeof(fw_hit_t));
+   hit.offset = foff;
+   hit.n_blk  = avail / EDI_BLK_SIZE;
+
+   if (hit.n_blk > 0) {
+      hit.n_ext = pdata[offsetof(edid_t, num_extblk)];
+      if (! fws_chksum(pdata)) hit.flags |= FWS_F_CSUM;
+   }
+
+   n_use = hit.n_ext;
+   if (n_use > EDI_EXT2_IDX) {
+      n_use      = EDI_EXT2_IDX;
+      hit.flags |= FWS_F_NEXT;
+   }
+
+   if (hit.n_blk < (n_use +1)) {
+      hit.flags |= FWS_F_PARTIAL;
+      hit.datsz  = avail;
+   } else {
+      hit.n_blk  = (n_use +1);
+      hit.datsz  = hit.n_blk * EDI_BLK_SIZE;
+   }
+
+   for (u32_t itb=1; itb<hit.n_blk; itb++) {
+      if (! fws_chksum(pdata + itb * EDI_BLK_SIZE)) hit.flags |= FWS_F_EXT_CSUM;
+   }
+
+   //f.e. a header pattern in the extension data of the previous hit
+   if (b_prev && (foff < prev_end)) {
+      hit.flags    |= FWS_F_OVERLAP;
+      hit.ovl_prev  = prev_off;
+   }
+   prev_off = foff;
+   if ((foff + hit.datsz) > prev_end) prev_end = (foff + hit.datsz);
+   b_prev   = true;
+
+   nhits ++ ;
+   return sink.OnHit(hit, pdata);
+}
+
+rcode fw_scan_cl::Scan(const wxString& path, fw_scan_sink_cl& sink) {
+   rcode    retU;
+   wxFile   file;
+   ssize_t  rdsz;
+   u64_t    boff; //file offset of buf[0]
+   u32_t    len;  //bytes in buf
+   u32_t    rqsz;
+   u32_t    pos;
+   u32_t    end;  //scan limit: data of the hits found before (end) is complete in the buffer
+   u32_t    avail;
+   bool     b_eof = false;
+
+   nbytes   = 0;
+   nhits    = 0;
+   prev_off = 0;
+   prev_end = 0;
+   b_prev   = false;
+
+   if (! file.Open(path, wxFile::read) ) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Can't open the image: %s", (const char*) path.ToUTF8());
+   }
+
+   if (buf == NULL) {
+      buf = new u8_t[FWS_CHUNK + FWS_MAX_DATA];
+      if (buf == NULL) RCD_RETURN_FAULT(retU);
+   }
+
+   boff = 0;
+   len  = 0;
+
+   while (! b_eof) {
+      rqsz = (FWS_CHUNK + FWS_MAX_DATA - len);
+      rdsz = file.Read(buf + len, rqsz);
+      if (rdsz == wxInvalidOffset) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Image read error @0x%llX", (unsigned long long) (boff + len));
+      }
+      b_eof = ((u32_t) rdsz < rqsz);
+      len  += rdsz;
+
+      end = b_eof ? len : (len - FWS_MAX_DATA);
+      pos = 0;
+
+      for (;;) {
+         pos = find_hdr(buf, pos, end, len);
+         if (pos >= end) break;
+
+         avail = len - pos;
+         if (avail > FWS_MAX_DATA) avail = FWS_MAX_DATA;
+
+         if (! check_hit(boff + pos, buf + pos, avail, sink)) {
+            nbytes = boff + pos;
+            RCD_RETURN_OK(retU);
+         }
+         pos ++ ;
+      }
+
+      //the unscanned tail goes to the buffer start
+      memmove(buf, buf + end, len - end);
+      boff += end;
+      len  -= end;
+   }
+
+   nbytes = boff;
+   RCD_RETURN_OK(retU);
+}
+
+void fw_scan_cl::FlagsToStr(const fw_hit_t& hit, char *str, u32_t len) {
+   u32_t  slen = 0;
+
+   str[0] = 0;
+
+   if (hit.flags & FWS_F_PARTIAL) {
+      slen += snprintf(str + slen, len - slen, "partial: %u B, ", hit.datsz);
+   }
+   if ((slen < len) && (hit.flags & FWS_F_OVERLAP)) {
+      slen += snprintf(str + slen, len - slen, "overlap @0x%llX, ", (unsigned long long) hit.ovl_prev);
+   }
+   if ((slen < len) && (hit.flags & FWS_F_CSUM)) {
+      slen += snprintf(str + slen, len - slen, "bad checksum, ");
+   }
+   if ((slen < len) && (hit.flags & FWS_F_EXT_CSUM)) {
+      slen += snprintf(str + slen, len - slen, "bad ext. checksum, ");
+   }
+   if ((slen < len) && (hit.flags & FWS_F_NEXT)) {
+      slen += snprintf(str + slen, len - slen, "ext. count: %u, ", hit.n_ext);
+   }
+
+   if (slen == 0) {
+      snprintf(str, len, "OK");
+      return;
+   }
+   //trailing ", "
+   if (slen < len) str[slen -2] = 0;
+}
+
+//batch mode: hits parsed like the corpus rows
+class fw_print_sink_cl : public fw_scan_sink_cl {
+   protected:
+      EDID_cl       EDID;
+      guilog_cl     tlog;
+      diag_list_cl  diag;
+      FILE         *fout;
+
+   public:
+      bool OnHit(const fw_hit_t& hit, const u8_t *pdata);
+
+      fw_print_sink_cl(FILE *out) : fout(out) {
+         EDID.Set_ERR_Ignore(true);
+         EDID.SetGuiLogPtr(&tlog);
+         EDID.SetDiagPtr(&diag);
+      };
+};
+
+bool fw_print_sink_cl::OnHit(const fw_hit_t& hit, const u8_t *pdata) {
+   corpus_row_t  row;
+   char          status[64];
+
+   memset(&row, 0, sizeof(corpus_row_t));
+   fw_scan_cl::FlagsToStr(hit, status, sizeof(status));
+
+   if (hit.datsz >= EDI_BLK_SIZE) {
+      EDID.Clear();
+      memcpy(EDID.getEDID()->buff, pdata, hit.datsz);
+      row.datsz = hit.datsz;
+
+      corpus_cl::DecodeRow(EDID, row);
+   }
+
+   fprintf(fout, "0x%08llX\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+           (unsigned long long) hit.offset, status,
+           row.mfc, corpus_cl::GetVendor(row), row.prod, row.name, row.mode, row.valid);
+
+   return true;
+}
+
+rcode fw_scan_cl::PrintHits(const wxString& path, FILE *out) {
+   rcode             retU;
+   fw_scan_cl        scanner;
+   fw_print_sink_cl  sink(out);
+   struct timespec   ts0;
+   struct timespec   ts1;
+   double            secs;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts0);
+   retU = scanner.Scan(path, sink);
+   clock_gettime(CLOCK_MONOTONIC, &ts1);
+   if (! RCD_IS_OK(retU)) return retU;
+
+   secs  = (ts1.tv_sec - ts0.tv_sec);
+   secs += (ts1.tv_nsec - ts0.tv_nsec) / 1e9;
+
+   fprintf(stderr, "%u hit(s), %.1f MiB scanned in %.3f s",
+           scanner.nhits, scanner.nbytes / 1048576.0, secs);
+   if (secs > 0.0) fprintf(stderr, ", %.1f MiB/s", (scanner.nbytes / 1048576.0) / secs);
+   fprintf(stderr, "\n");
+
+   return retU;
+}
@@ -0,0 +1,77 @@
+/***************************************************************
+ * Name:      fw_scan.h
+ * Purpose:   Firmware/VBIOS image scanner: embedded EDIDs
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-16
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef FW_SCAN_H
+#define FW_SCAN_H 1
+
+#include <wx/string.h>
+#include <stdio.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_shared.h"
+
+enum {
+   FWS_CHUNK    = (4 << 20),      //image read size
+   FWS_MAX_DATA = sizeof(edi_t),  //base + 3 extension blocks
+   FWS_HDR_LEN  = 8
+};
+
+enum { //hit flags
+   FWS_F_CSUM    = (1 << 0), //bad base block checksum
+   FWS_F_EXT_CSUM= (1 << 1), //bad extension block checksum
+   FWS_F_NEXT    = (1 << 2), //extension count > 3: only 3 blocks are used
+   FWS_F_PARTIAL = (1 << 3), //image ends before the last extension block
+   FWS_F_OVERLAP = (1 << 4)  //starts inside the data of the previous hit
+};
+
+typedef struct {
+   u64_t  offset;    //file offset of the header
+   u64_t  ovl_prev;  //FWS_F_OVERLAP: offset of the previous hit
+   u32_t  datsz;     //bytes available: FWS_MAX_DATA max
+   u32_t  n_ext;     //extension count from the base block
+   u32_t  n_blk;     //complete blocks available
+   u32_t  flags;
+} fw_hit_t;
+
+//Receives the hits in the file order, pdata: (hit.datsz) bytes, valid during the call.
+//OnHit() returns false to stop the scan.
+class fw_scan_sink_cl {
+   public:
+      virtual bool OnHit(const fw_hit_t& hit, const u8_t *pdata) = 0;
+      virtual ~fw_scan_sink_cl() {};
+};
+
+class fw_scan_cl {
+   protected:
+      u8_t    *buf;
+      u64_t    prev_off;
+      u64_t    prev_end;
+      bool     b_prev;
+
+      static u32_t  find_hdr  (const u8_t *pbuf, u32_t pos, u32_t end, u32_t len);
+             bool   check_hit (u64_t foff, const u8_t *pdata, u32_t avail, fw_scan_sink_cl& sink);
+
+   public:
+      u64_t    nbytes;  //bytes scanned
+      u32_t    nhits;
+
+      rcode Scan(const wxString& path, fw_scan_sink_cl& sink);
+
+      //hit status as text, f.e. "partial: 256 B, bad ext. checksum", "OK" if no flags are set
+      static void FlagsToStr(const fw_hit_t& hit, char *str, u32_t len);
+
+      //batch mode: hits decoded & written to out, one line per hit
+      static rcode PrintHits(const wxString& path, FILE *out);
+
+      fw_scan_cl();
+      ~fw_scan_cl();
+};
+
+#endif /* FW_SCAN_H */
@@ -10,6 +10,129 @@
 
 #include "guilog.h"
 
+#include <string.h>
+
+typedef struct {
+   u32_t  seq;  //atomic
+   u32_t  len;
+   char   msg[log_slot_sz];
+} log_slot_t;
+
+//Bounded lock-free queue (D.Vyukov), multiple producers, single consumer: Flush().
+//slot.seq == pos: free for the producer at pos, slot.seq == (pos +1): ready for the consumer.
+class log_ring_cl {
+   public:
+      log_slot_t  slot[log_ring_sz];
+      u32_t       wr;    //atomic
+      u32_t       rd;    //Flush() only
+      u32_t       ndrop; //atomic: messages dropped on overflow
+
+      log_ring_cl() : wr(0), rd(0), ndrop(0) {
+         for (u32_t its=0; its<log_ring_sz; its++) slot[its].seq = its;
+      };
+};
+
+static log_ring_cl  log_ring;
+
+bool guilog_cl::b_async = false;
+
+void guilog_cl::push(const char *msg, u32_t len) {
+   log_slot_t *pslot;
+   u32_t       pos;
+   i32_t       dif;
+
+   pos = __atomic_load_n(&log_ring.wr, __ATOMIC_RELAXED);
+   for (;;) {
+      pslot = &log_ring.slot[pos & (log_ring_sz -1)];
+      dif   = (i32_t) (__atomic_load_n(&pslot->seq, __ATOMIC_ACQUIRE) - pos);
+
+      if (dif == 0) {
+         //failed CAS updates pos
+         if (__atomic_compare_exchange_n(&log_ring.wr, &pos, (pos +1), true,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+      } else if (dif < 0) {
+         //ring full: reported by Flush()
+         __atomic_add_fetch(&log_ring.ndrop, 1, __ATOMIC_RELAXED);
+         return;
+      } else {
+         pos = __atomic_load_n(&log_ring.wr, __ATOMIC_RELAXED);
+      }
+   }
+
+   if (len > (log_slot_sz -1)) len = (log_slot_sz -1);
+   memcpy(pslot->msg, msg, len);
+   pslot->msg[len] = 0;
+   pslot->len      = len;
+
+   __atomic_store_n(&pslot->seq, (pos +1), __ATOMIC_RELEASE);
+}
+
+//message + repeat count, trailing new lines are dropped
+static void log_append(wxString& out, const char *msg, u32_t len, u32_t nrep) {
+
+   while ((len > 0) && (msg[len -1] == '\n')) len -- ;
+
+   if (! out.IsEmpty()) out << '\n';
+   out << wxString::FromUTF8(msg, len);
+   if (nrep > 1) out << " [x" << nrep << "]";
+}
+
+u32_t guilog_cl::Flush() {
+   wxString     out;
+   log_slot_t  *pslot;
+   char         last[log_slot_sz];
+   u32_t        llen;
+   u32_t        nrep;
+   u32_t        nmsg;
+   u32_t        ndrop;
+
+   llen = 0;
+   nrep = 0;
+
+   //repeated messages are coalesced
+   for (nmsg=0; nmsg<log_flush_max; nmsg++) {
+      u32_t  pos;
+
+      pos   = log_ring.rd;
+      pslot = &log_ring.slot[pos & (log_ring_sz -1)];
+      if (__atomic_load_n(&pslot->seq, __ATOMIC_ACQUIRE) != (pos +1)) break; //empty
+
+      if ((nrep > 0) && (pslot->len == llen) && (0 == memcmp(pslot->msg, last, llen))) {
+         nrep ++ ;
+      } else {
+         if (nrep > 0) log_append(out, last, llen, nrep);
+         llen = pslot->len;
+         nrep = 1;
+         memcpy(last, pslot->msg, llen);
+      }
+
+      //the slot is free for the producers: next round
+      __atomic_store_n(&pslot->seq, (pos + log_ring_sz), __ATOMIC_RELEASE);
+      log_ring.rd = (pos +1);
+   }
+   if (nrep > 0) log_append(out, last, llen, nrep);
+
+   ndrop = __atomic_exchange_n(&log_ring.ndrop, 0, __ATOMIC_RELAXED);
+   if (ndrop > 0) {
+      if (! out.IsEmpty()) out << '\n';
+      out << "LOG: " << ndrop << " messages dropped.";
+   }
+
+   //single wxLog call per batch
+   if (! out.IsEmpty()) wxLogStatus("%s", out);
+
+   return nmsg;
+}
+
+void guilog_cl::SetAsync(bool async) {
+
+   __atomic_store_n(&b_async, async, __ATOMIC_RELEASE);
+   if (async) return;
+
+   //write the queued messages
+   while (Flush() > 0) ;
+}
+
 
 void guilog_cl::RcodeToString(rcode retU, wxString& str) {
    //assemble the message
@@ -20,15 +143,27 @@ void guilog_cl::RcodeToString(rcode retU, wxString& str) {
 
 void guilog_cl::PrintRcode(rcode retU) {
    wxedid_RCD_GET_MSG(retU, rcd_msg_buff, msg_buf_sz);
+
+   if (__atomic_load_n(&b_async, __ATOMIC_ACQUIRE)) {
+      push(rcd_msg_buff, strlen(rcd_msg_buff));
+      return;
+   }
    wxLogStatus(rcd_msg_buff);
 }
 
 void guilog_cl::DoLog() {
-   wxLogStatus(slog.GetData());
+   DoLog(slog);
    slog.Empty();
 };
 
 void guilog_cl::DoLog(const wxString& msg) {
+
+   if (__atomic_load_n(&b_async, __ATOMIC_ACQUIRE)) {
+      wxCharBuffer  utf8 = msg.ToUTF8();
+
+      push(utf8.data(), utf8.length());
+      return;
+   }
    wxLogStatus(msg.GetData());
 };
 
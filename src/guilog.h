@@ -1,24 +1,36 @@
 #ifndef GUI_LOG_H
 #define GUI_LOG_H 1
 
-/* guilog.h v0.2
+/* guilog.h v0.3
    Copyright: Tomasz Pawlak (C) 2014-2022
    License:   GPLv3+
 */
 
 #include <wx/log.h>
 #include <wx/frame.h>
+#include "def_types.h"
 #include "rcode/rcode.h"
 
 enum {
    msg_buf_sz = 4096
 };
 
+enum { //async mode: messages are queued in a ring buffer, Flush() writes them in batches
+   log_slot_sz   = 512,  //max message length, longer messages are truncated
+   log_ring_sz   = 256,  //power of 2
+   log_flush_max = 128,  //messages per Flush()
+   log_flush_ms  = 100   //flush timer period
+};
+
 class guilog_cl {
    protected:
       int          status;
       wxLogWindow *logwin;
 
+      static bool  b_async;
+
+      static void  push(const char *msg, u32_t len);
+
    public:
       wxString     slog;
       char         rcd_msg_buff[msg_buf_sz];
@@ -31,6 +43,11 @@ class guilog_cl {
       void DoLog();
       void DoLog(const wxString& msg);
 
+      //async mode: the messages from all the instances/threads are queued, and written
+      //to wxLog only by Flush(), called from the main thread.
+      static void  SetAsync(bool async);
+      static u32_t Flush();
+
       rcode Create(wxWindow *parent, int w=640, int h=400);
       rcode Destroy();
 
@@ -0,0 +1,613 @@
+/***************************************************************
+ * Name:      hexview.cpp
+ * Purpose:   Hex view of the EDID blocks, byte offset -> field index
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idHEXVIEW
+   #error "hexview.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idHEXVIEW
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "hexview.h"
+
+#include <wx/dcclient.h>
+#include <wx/settings.h>
+#include <stdlib.h>
+
+wxDEFINE_EVENT(wxEVT_HEXVIEW_SEL, wxCommandEvent);
+
+fld_index_cl::~fld_index_cl() {
+   free(span_ar);
+   free(fld_ar);
+}
+
+void fld_index_cl::Clear() {
+   nspan   = 0;
+   nfld    = 0;
+   max_gsz = 0;
+   buf_sz  = 0;
+}
+
+u32_t fld_index_cl::FieldLen(const edi_field_t& field) {
+   if ((field.flags & (EF_BIT | EF_BFLD)) != 0) {
+      return ((field.shift + field.fldsize + 7) >> 3);
+   }
+   return field.fldsize;
+}
+
+//The field offset is relative to the edi_dynfld_t.base, which points to the group data, to the
+//parent group data (some sub-groups) or to the EDID buffer: the data pointer tells which one.
+u8_t* fld_index_cl::field_ptr(edi_grp_cl *pgrp, edi_dynfld_t *pfld, u32_t& abs) {
+   u8_t       *ptr;
+   edi_grp_cl *owner;
+
+   if (pfld->base == NULL) goto unresolved;
+
+   ptr = pfld->base + pfld->field.offs;
+
+   for (owner = pgrp; owner != NULL; owner = owner->getParentGrp()) {
+      u8_t *pins = owner->getInsPtr();
+
+      if ((ptr >= pins) && (ptr < (pins + owner->getTotalSize()))) {
+         abs = owner->getAbsOffs() + (ptr - pins);
+         return ptr;
+      }
+   }
+
+   if ((ptr >= pbuf) && (ptr < (pbuf + buf_sz))) {
+      abs = (ptr - pbuf);
+      return ptr;
+   }
+
+unresolved:
+   abs = pgrp->getAbsOffs() + pfld->field.offs;
+   return NULL;
+}
+
+bool fld_index_cl::FieldBytes(edi_grp_cl *pgrp, u32_t fidx, u32_t& abs, u32_t& len) {
+   edi_dynfld_t *pfld;
+
+   if (fidx >= pgrp->FieldsAr.GetCount()) return false;
+
+   pfld = pgrp->FieldsAr.Item(fidx);
+   len  = FieldLen(pfld->field);
+   if (len == 0) return false;
+
+   field_ptr(pgrp, pfld, abs);
+   return true;
+}
+
+//(re)calculate the field positions of a span, sort the slice by offset
+void fld_index_cl::fill_slice(span_t& span) {
+   fspan_t *pfs;
+
+   pfs           = &fld_ar[span.fld_first];
+   span.max_flen = 0;
+
+   for (u32_t itf=0; itf<span.fld_cnt; itf++) {
+      edi_dynfld_t *pfld;
+      u32_t         abs;
+
+      pfld         = span.grp->FieldsAr.Item(pfs[itf].fidx);
+      pfs[itf].ptr = field_ptr(span.grp, pfld, abs);
+      pfs[itf].rel = (i32_t) abs - (i32_t) span.abs;
+      pfs[itf].len = FieldLen(pfld->field);
+
+      if (pfs[itf].len > span.max_flen) span.max_flen = pfs[itf].len;
+   }
+
+   //fields are declared in data order: the slice is nearly sorted
+   for (u32_t itf=1; itf<span.fld_cnt; itf++) {
+      fspan_t  fs = pfs[itf];
+      u32_t    itp;
+
+      for (itp=itf; itp>0; itp--) {
+         if (pfs[itp-1].rel < fs.rel) break;
+         if ((pfs[itp-1].rel == fs.rel) && (pfs[itp-1].fidx < fs.fidx)) break;
+         pfs[itp] = pfs[itp-1];
+      }
+      pfs[itp] = fs;
+   }
+}
+
+//spans are appended in tree order and a move swaps only the neighbouring groups:
+//insertion sort is linear for the nearly sorted array
+void fld_index_cl::sort_spans() {
+   for (u32_t its=1; its<nspan; its++) {
+      span_t  span = span_ar[its];
+      u32_t   itp;
+
+      for (itp=its; itp>0; itp--) {
+         if (span_ar[itp-1].abs < span.abs) break;
+         if ((span_ar[itp-1].abs == span.abs) && (span_ar[itp-1].depth <= span.depth)) break;
+         span_ar[itp] = span_ar[itp-1];
+      }
+      span_ar[itp] = span;
+   }
+}
+
+rcode fld_index_cl::add_group(edi_grp_cl *pgrp, u32_t depth) {
+   rcode   retU;
+   span_t *pspan;
+   u32_t   fcnt;
+
+   if (nspan >= span_max) {
+      span_t *new_ar;
+      u32_t   new_max;
+
+      new_max = (span_max == 0) ? (u32_t) HXV_SPAN_INIT : (span_max * 2);
+      new_ar  = (span_t*) realloc(span_ar, new_max * sizeof(span_t));
+      if (new_ar == NULL) RCD_RETURN_FAULT(retU);
+
+      span_ar  = new_ar;
+      span_max = new_max;
+   }
+
+   fcnt = pgrp->FieldsAr.GetCount();
+
+   if ((nfld + fcnt) > fld_max) {
+      fspan_t *new_ar;
+      u32_t    new_max;
+
+      new_max = (fld_max == 0) ? (u32_t) HXV_FLD_INIT : (fld_max * 2);
+      if (new_max < (nfld + fcnt)) new_max = (nfld + fcnt);
+
+      new_ar  = (fspan_t*) realloc(fld_ar, new_max * sizeof(fspan_t));
+      if (new_ar == NULL) RCD_RETURN_FAULT(retU);
+
+      fld_ar  = new_ar;
+      fld_max = new_max;
+   }
+
+   pspan            = &span_ar[nspan];
+   pspan->abs       = pgrp->getAbsOffs();
+   pspan->size      = pgrp->getTotalSize();
+   pspan->depth     = depth;
+   pspan->grp       = pgrp;
+   pspan->fld_first = nfld;
+   pspan->fld_cnt   = 0;
+   nspan ++ ;
+
+   //fields without data bytes are not indexed
+   for (u32_t itf=0; itf<fcnt; itf++) {
+      if (FieldLen(pgrp->FieldsAr.Item(itf)->field) == 0) continue;
+
+      fld_ar[nfld].fidx = itf;
+      pspan->fld_cnt ++ ;
+      nfld           ++ ;
+   }
+   fill_slice(*pspan);
+
+   if (pspan->size > max_gsz) max_gsz = pspan->size;
+
+   RCD_SET_OK(retU);
+
+   if (pgrp->getSubGrpCount() > 0) {
+      retU = add_grp_ar(pgrp->getSubArray(), (depth +1));
+   }
+   return retU;
+}
+
+rcode fld_index_cl::add_grp_ar(GroupAr_cl *grp_ar, u32_t depth) {
+   rcode retU;
+
+   RCD_SET_OK(retU);
+
+   for (u32_t itg=0; itg<grp_ar->GetCount(); itg++) {
+      retU = add_group(grp_ar->Item(itg), depth);
+      if (! RCD_IS_OK(retU)) break;
+   }
+   return retU;
+}
+
+rcode fld_index_cl::Build(EDID_cl& EDID) {
+   rcode retU;
+   u32_t nblk;
+
+   Clear();
+
+   nblk = EDID.getNumValidBlocks();
+   if (nblk > (sizeof(edi_t) / sizeof(edid_t))) nblk = (sizeof(edi_t) / sizeof(edid_t));
+
+   pbuf   = EDID.getEDID()->buff;
+   buf_sz = nblk * sizeof(edid_t);
+
+   RCD_SET_OK(retU);
+
+   for (u32_t itb=0; itb<nblk; itb++) {
+      retU = add_grp_ar(EDID.BlkGroupsAr[itb], 0);
+      if (! RCD_IS_OK(retU)) {
+         Clear();
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] fld_index_cl::Build(): out of memory, block %u", itb);
+      }
+   }
+
+   sort_spans();
+   return retU;
+}
+
+//The moved groups keep their fields, only the absolute offsets have changed.
+void fld_index_cl::Sync(GroupAr_cl *grp_ar) {
+
+   for (u32_t its=0; its<nspan; its++) {
+      span_t     &span = span_ar[its];
+      edi_grp_cl *pgrp;
+
+      for (pgrp = span.grp; pgrp != NULL; pgrp = pgrp->getParentGrp()) {
+         if (pgrp->getParentAr() == grp_ar) break;
+      }
+      if (pgrp == NULL) continue;
+      if (span.abs == span.grp->getAbsOffs()) continue;
+
+      span.abs = span.grp->getAbsOffs();
+      //sub-group fields can point to the parent group data
+      fill_slice(span);
+   }
+
+   sort_spans();
+}
+
+//fld_ar index of the field containing the offset, -1: none
+i32_t fld_index_cl::find_field(const span_t& span, u32_t offs) {
+   fspan_t *pfs;
+   i32_t    rel;
+   i32_t    ifound;
+   u32_t    lo;
+   u32_t    hi;
+
+   pfs    = &fld_ar[span.fld_first];
+   rel    = (i32_t) offs - (i32_t) span.abs;
+   ifound = -1;
+   lo     = 0;
+   hi     = span.fld_cnt;
+
+   //1st field starting after the offset
+   while (lo < hi) {
+      u32_t mid = (lo + hi) >> 1;
+      if (pfs[mid].rel <= rel) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+
+   while (lo-- > 0) {
+      if ((pfs[lo].rel + (i32_t) span.max_flen) <= rel) break;
+      if ((pfs[lo].rel + (i32_t) pfs[lo].len)   <= rel) continue;
+      //bit fields sharing the same byte: the first one
+      if ((ifound >= 0) && (pfs[lo].rel != pfs[ifound].rel)) break;
+      ifound = lo;
+   }
+
+   return (ifound < 0) ? -1 : (i32_t) (span.fld_first + ifound);
+}
+
+bool fld_index_cl::Lookup(u32_t offs, hxv_hit_t& hit) {
+   i32_t  grp_sp = -1;
+   i32_t  fld_sp = -1;
+   i32_t  fld_fs = -1;
+   u32_t  lo;
+   u32_t  hi;
+
+   hit.grp  = NULL;
+   hit.fidx = -1;
+   hit.pval = (offs < buf_sz) ? &pbuf[offs] : NULL;
+
+   //1st span starting after the offset
+   lo = 0;
+   hi = nspan;
+   while (lo < hi) {
+      u32_t mid = (lo + hi) >> 1;
+      if (span_ar[mid].abs <= offs) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+
+   //spans containing the offset: the deepest one with a field at the offset
+   while (lo-- > 0) {
+      span_t& span = span_ar[lo];
+      i32_t   ifs;
+
+      if ((span.abs + max_gsz) <= offs) break;
+      if ((span.abs + span.size) <= offs) continue;
+
+      if ((grp_sp < 0) || (span.depth > span_ar[grp_sp].depth)) grp_sp = lo;
+
+      ifs = find_field(span, offs);
+      if (ifs < 0) continue;
+      if ((fld_sp < 0) || (span.depth > span_ar[fld_sp].depth)) {
+         fld_sp = lo;
+         fld_fs = ifs;
+      }
+   }
+
+   if (fld_sp >= 0) {
+      span_t&  span = span_ar[fld_sp];
+      fspan_t& fs   = fld_ar[fld_fs];
+
+      hit.grp  = span.grp;
+      hit.fidx = fs.fidx;
+      if (fs.ptr != NULL) hit.pval = fs.ptr + ((i32_t) offs - ((i32_t) span.abs + fs.rel));
+      return true;
+   }
+
+   if (grp_sp < 0) return false;
+
+   hit.grp  = span_ar[grp_sp].grp;
+   hit.pval = hit.grp->getInsPtr() + (offs - span_ar[grp_sp].abs);
+   return true;
+}
+
+//hexview_cl
+wxBEGIN_EVENT_TABLE(hexview_cl, wxScrolledWindow)
+   EVT_PAINT       (hexview_cl::evt_paint )
+   EVT_MOTION      (hexview_cl::evt_motion)
+   EVT_LEAVE_WINDOW(hexview_cl::evt_leave )
+   EVT_LEFT_DOWN   (hexview_cl::evt_click )
+wxEND_EVENT_TABLE()
+
+hexview_cl::hexview_cl(wxWindow *parent, wxWindowID id, EDID_cl *pedid) :
+   wxScrolledWindow(parent, id, wxDefaultPosition, wxDefaultSize, wxVSCROLL|wxHSCROLL|wxFULL_REPAINT_ON_RESIZE),
+   pEDID(pedid), b_stale(false), nbytes(0), hl_abs(0), hl_len(0), hover(-1)
+{
+   tip_hit.grp  = NULL;
+   tip_hit.fidx = -1;
+
+   font = wxFont(wxFontInfo(GetFont().GetPointSize()).Family(wxFONTFAMILY_TELETYPE));
+   SetFont(font);
+   chsz.x = GetCharWidth();
+   chsz.y = GetCharHeight();
+
+   SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
+   SetScrollRate(chsz.x, chsz.y);
+   SetVirtualSize((HXV_OFFS_CHRS + HXV_ROW_BYTES * 3) * chsz.x, chsz.y);
+}
+
+void hexview_cl::update_index() {
+   rcode retU;
+
+   if (! b_stale) return;
+   b_stale = false;
+
+   retU   = index.Build(*pEDID);
+   nbytes = RCD_IS_OK(retU) ? (pEDID->getNumValidBlocks() * sizeof(edid_t)) : 0;
+   if (nbytes > sizeof(edi_t)) nbytes = sizeof(edi_t);
+
+   //the old groups can be deleted
+   hover        = -1;
+   tip_hit.grp  = NULL;
+   tip_hit.fidx = -1;
+   UnsetToolTip();
+
+   SetVirtualSize((HXV_OFFS_CHRS + HXV_ROW_BYTES * 3) * chsz.x,
+                  ((nbytes + HXV_ROW_BYTES -1) / HXV_ROW_BYTES) * chsz.y);
+}
+
+void hexview_cl::Build() {
+   b_stale = true;
+   update_index();
+   Refresh();
+}
+
+//groups added/deleted/replaced: the index is rebuilt on the next paint or mouse event,
+//after all the changes are done.
+void hexview_cl::Invalidate() {
+   b_stale = true;
+   Refresh();
+}
+
+void hexview_cl::Sync(GroupAr_cl *grp_ar) {
+   if (! b_stale) index.Sync(grp_ar);
+   Refresh();
+}
+
+void hexview_cl::Clear() {
+   index.Clear();
+   b_stale      = false;
+   nbytes       = 0;
+   hl_len       = 0;
+   hover        = -1;
+   tip_hit.grp  = NULL;
+   tip_hit.fidx = -1;
+   UnsetToolTip();
+   SetVirtualSize((HXV_OFFS_CHRS + HXV_ROW_BYTES * 3) * chsz.x, chsz.y);
+   Refresh();
+}
+
+void hexview_cl::Highlight(edi_grp_cl *pgrp, i32_t fidx) {
+   hl_len = 0;
+
+   if (pgrp != NULL) {
+      update_index();
+
+      if (fidx < 0) {
+         hl_abs = pgrp->getAbsOffs();
+         hl_len = pgrp->getTotalSize();
+      } else if (! index.FieldBytes(pgrp, fidx, hl_abs, hl_len)) {
+         hl_len = 0;
+      }
+   }
+
+   if (hl_len > 0) { //scroll to the 1st highlighted byte
+      int  vx, vy;
+      int  row;
+      int  nrows;
+
+      GetViewStart(&vx, &vy);
+      row   = hl_abs / HXV_ROW_BYTES;
+      nrows = GetClientSize().y / chsz.y;
+      if ((row < vy) || (row >= (vy + nrows))) Scroll(-1, row);
+   }
+
+   Refresh();
+}
+
+i32_t hexview_cl::hit_test(const wxPoint& pos) {
+   wxPoint vpos;
+   i32_t   col;
+   i32_t   offs;
+
+   vpos = CalcUnscrolledPosition(pos);
+   if ((vpos.x < 0) || (vpos.y < 0)) return -1;
+
+   col = (vpos.x / chsz.x) - HXV_OFFS_CHRS;
+   if (col < 0) return -1;
+   col /= 3;
+   if (col >= HXV_ROW_BYTES) return -1;
+
+   offs = (vpos.y / chsz.y) * HXV_ROW_BYTES + col;
+   if (offs >= (i32_t) nbytes) return -1;
+
+   return offs;
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void hexview_cl::evt_paint(wxPaintEvent& evt) {
+   wxPaintDC   dc(this);
+   wxString    tmps;
+   hxv_hit_t   hit;
+   edi_grp_cl *prev_grp = NULL;
+   bool        b_tint   = false;
+   wxColour    cBg      = GetBackgroundColour();
+   wxColour    cTint    = cBg.ChangeLightness(90);
+   wxColour    cText    = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT);
+   wxColour    cGrey    = wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT);
+   wxColour    cHl      = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT);
+   wxColour    cHlText  = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHTTEXT);
+
+   DoPrepareDC(dc);
+   update_index();
+
+   dc.SetFont(font);
+   dc.SetBackgroundMode(wxTRANSPARENT);
+
+   for (u32_t offs=0; offs<nbytes; offs++) {
+      u32_t col = offs % HXV_ROW_BYTES;
+      int   y   = (offs / HXV_ROW_BYTES) * chsz.y;
+      int   x   = (HXV_OFFS_CHRS + col * 3) * chsz.x;
+      bool  b_hl;
+
+      if (col == 0) {
+         tmps.Printf("%03X:", offs);
+         dc.SetTextForeground(cGrey);
+         dc.DrawText(tmps, 0, y);
+
+         if ((offs > 0) && ((offs % sizeof(edid_t)) == 0)) { //block boundary
+            dc.SetPen(wxPen(cGrey));
+            dc.DrawLine(0, y, (HXV_OFFS_CHRS + HXV_ROW_BYTES * 3) * chsz.x, y);
+         }
+      }
+
+      index.Lookup(offs, hit);
+      //group boundaries: alternating background
+      if (hit.grp != prev_grp) {
+         prev_grp = hit.grp;
+         b_tint   = ! b_tint;
+      }
+      b_hl = ((offs - hl_abs) < hl_len);
+
+      if (b_hl || ((hit.grp != NULL) && b_tint)) {
+         dc.SetPen  (*wxTRANSPARENT_PEN);
+         dc.SetBrush(wxBrush(b_hl ? cHl : cTint));
+         dc.DrawRectangle(x, y, chsz.x * 3, chsz.y);
+      }
+
+      if (hit.pval != NULL) {
+         tmps.Printf("%02X", *hit.pval);
+      } else {
+         tmps = "??";
+      }
+      dc.SetTextForeground(b_hl ? cHlText : ((hit.grp != NULL) ? cText : cGrey));
+      dc.DrawText(tmps, x + (chsz.x >> 1), y);
+
+      if ((i32_t) offs == hover) {
+         dc.SetPen  (wxPen(cText));
+         dc.SetBrush(*wxTRANSPARENT_BRUSH);
+         dc.DrawRectangle(x, y, chsz.x * 3, chsz.y);
+      }
+   }
+}
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+void hexview_cl::evt_motion(wxMouseEvent& evt) {
+   hxv_hit_t  hit;
+   i32_t      offs;
+
+   update_index();
+
+   offs = hit_test(evt.GetPosition());
+   if (offs == hover) return;
+
+   hover = offs;
+   Refresh();
+
+   hit.grp  = NULL;
+   hit.fidx = -1;
+   if (offs >= 0) index.Lookup(offs, hit);
+
+   //the tooltip is replaced only when the field changes
+   if ((hit.grp == tip_hit.grp) && (hit.fidx == tip_hit.fidx)) return;
+   tip_hit = hit;
+
+   if (hit.grp == NULL) {
+      UnsetToolTip();
+      return;
+   }
+
+   {
+      wxString tip;
+
+      if (hit.grp->getParentGrp() != NULL) {
+         tip << hit.grp->getParentGrp()->CodeName << ".";
+      }
+      tip << hit.grp->CodeName;
+      if (hit.fidx >= 0) {
+         tip << "." << wxString::FromAscii(hit.grp->FieldsAr.Item(hit.fidx)->field.name);
+      }
+      SetToolTip(tip);
+   }
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void hexview_cl::evt_leave(wxMouseEvent& evt) {
+   if (hover < 0) return;
+   hover = -1;
+   Refresh();
+}
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+void hexview_cl::evt_click(wxMouseEvent& evt) {
+   hxv_hit_t  hit;
+   i32_t      offs;
+
+   evt.Skip(true);
+
+   update_index();
+
+   offs = hit_test(evt.GetPosition());
+   if (offs < 0) return;
+   if (! index.Lookup(offs, hit)) return;
+
+   {
+      wxCommandEvent sel_evt(wxEVT_HEXVIEW_SEL, GetId());
+
+      sel_evt.SetEventObject(this);
+      sel_evt.SetClientData (hit.grp);
+      sel_evt.SetInt        (hit.fidx);
+      sel_evt.SetExtraLong  (offs);
+      ProcessWindowEvent(sel_evt);
+   }
+}
@@ -0,0 +1,130 @@
+/***************************************************************
+ * Name:      hexview.h
+ * Purpose:   Hex view of the EDID blocks, byte offset -> field index
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef HEXVIEW_H
+#define HEXVIEW_H 1
+
+#include <wx/scrolwin.h>
+#include <wx/event.h>
+#include <wx/font.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+
+enum {
+   HXV_ROW_BYTES = 16,
+   HXV_OFFS_CHRS = 5,   //"1F0: "
+   HXV_SPAN_INIT = 128, //initial size of the span array
+   HXV_FLD_INIT  = 1024 //initial size of the field pool
+};
+
+//byte offset lookup result
+typedef struct {
+   edi_grp_cl *grp;  //deepest group containing the byte, NULL: no group
+   i32_t       fidx; //grp->FieldsAr index, -1: no field at the offset
+   u8_t       *pval; //live byte value: group data or EDID buffer, NULL: unknown
+} hxv_hit_t;
+
+//Two-level interval index: group spans sorted by absolute offset (groups are at most 32 bytes
+//long, so a byte is covered only by the spans starting within the max group size before it),
+//then the group fields sorted by their offset relative to the group. Both levels are searched
+//with bisection. Moving a group doesn't change its fields: the spans are re-keyed & re-sorted.
+class fld_index_cl {
+   protected:
+      typedef struct {
+         u32_t       abs;
+         u32_t       size;
+         u32_t       depth;     //0: block group, 1: sub-group, ...
+         u32_t       fld_first; //fld_ar slice
+         u32_t       fld_cnt;
+         u32_t       max_flen;  //longest field in the slice
+         edi_grp_cl *grp;
+      } span_t;
+
+      typedef struct {
+         i32_t       rel;  //relative to the group abs offset, can be < 0 for sub-group fields
+         u32_t       len;  //bytes
+         u32_t       fidx; //FieldsAr index
+         u8_t       *ptr;  //field data, NULL: not resolved
+      } fspan_t;
+
+      span_t    *span_ar;
+      u32_t      nspan;
+      u32_t      span_max;
+      fspan_t   *fld_ar;
+      u32_t      nfld;
+      u32_t      fld_max;
+      u32_t      max_gsz; //longest group span
+      u8_t      *pbuf;    //EDID buffer
+      u32_t      buf_sz;
+
+      rcode  add_group  (edi_grp_cl *pgrp, u32_t depth);
+      rcode  add_grp_ar (GroupAr_cl *grp_ar, u32_t depth);
+      void   fill_slice (span_t& span);
+      void   sort_spans ();
+      i32_t  find_field (const span_t& span, u32_t offs);
+      u8_t*  field_ptr  (edi_grp_cl *pgrp, edi_dynfld_t *pfld, u32_t& abs);
+
+   public:
+      void   Clear();
+      rcode  Build(EDID_cl& EDID);
+      //group move: update the spans of the groups in grp_ar, including sub-groups
+      void   Sync (GroupAr_cl *grp_ar);
+      bool   Lookup(u32_t offs, hxv_hit_t& hit);
+
+      //bytes occupied by a field: [abs, abs+len)
+      static u32_t  FieldLen(const edi_field_t& field);
+             bool   FieldBytes(edi_grp_cl *pgrp, u32_t fidx, u32_t& abs, u32_t& len);
+
+      inline u32_t  getSpanCount() {return nspan;};
+
+      fld_index_cl() : span_ar(NULL), nspan(0), span_max(0), fld_ar(NULL), nfld(0), fld_max(0),
+                       max_gsz(0), pbuf(NULL), buf_sz(0) {};
+      ~fld_index_cl();
+};
+
+//hexview_cl: click on a byte; GetClientData(): edi_grp_cl*, GetInt(): field index or -1,
+//GetExtraLong(): byte offset.
+wxDECLARE_EVENT(wxEVT_HEXVIEW_SEL, wxCommandEvent);
+
+class hexview_cl : public wxScrolledWindow {
+   protected:
+      EDID_cl      *pEDID;
+      fld_index_cl  index;
+      bool          b_stale; //groups changed: the index is rebuilt on the next use
+      u32_t         nbytes;
+      wxFont        font;
+      wxSize        chsz;
+      u32_t         hl_abs;  //highlighted bytes
+      u32_t         hl_len;
+      i32_t         hover;   //byte under the mouse pointer, -1: none
+      hxv_hit_t     tip_hit; //tooltip shown for
+
+      void   update_index();
+      i32_t  hit_test  (const wxPoint& pos);
+      void   evt_paint (wxPaintEvent& evt);
+      void   evt_motion(wxMouseEvent& evt);
+      void   evt_leave (wxMouseEvent& evt);
+      void   evt_click (wxMouseEvent& evt);
+
+   public:
+      void   Build     ();
+      void   Invalidate();
+      void   Sync      (GroupAr_cl *grp_ar);
+      void   Clear     ();
+      //fidx < 0: all the group bytes
+      void   Highlight (edi_grp_cl *pgrp, i32_t fidx);
+
+      hexview_cl(wxWindow *parent, wxWindowID id, EDID_cl *pedid);
+
+   wxDECLARE_EVENT_TABLE();
+};
+
+#endif /* HEXVIEW_H */
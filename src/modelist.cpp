@@ -0,0 +1,566 @@
+/***************************************************************
+ * Name:      modelist.cpp
+ * Purpose:   Mode list: all timing sources merged into one table
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idMODELIST
+   #error "modelist.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idMODELIST
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "modelist.h"
+#include "EDID_class.h"
+#include "CEA_class.h"
+#include "CEA_EXT_class.h"
+
+#include <stdlib.h>
+
+#define NH  0
+#define PH  VTF_HSPOS
+#define NV  0
+#define PV  VTF_VSPOS
+#define IL  VTF_ILACE
+
+//X-server/drm style: display, sync start, sync end, total. Interlaced: frame lines, field rate.
+#define VIC_MODE(_clk, _ha, _hss, _hse, _ht, _va, _vss, _vse, _vt, _flg, _refr ) \
+   {_clk, _ha, (_ht - _ha), (_hss - _ha), (_hse - _hss), \
+    _va, (_vt - _va), (_vss - _va), (_vse - _vss), (_flg), _refr }
+
+//CTA-861-G Table 3: VIC 1..127
+static const vtiming_t vic_tbl1[] = {
+/*  1*/ VIC_MODE(  25175,   640,   656,   752,   800,   480,   490,   492,   525, NH|NV   ,  60),
+/*  2*/ VIC_MODE(  27000,   720,   736,   798,   858,   480,   489,   495,   525, NH|NV   ,  60),
+/*  3*/ VIC_MODE(  27000,   720,   736,   798,   858,   480,   489,   495,   525, NH|NV   ,  60),
+/*  4*/ VIC_MODE(  74250,  1280,  1390,  1430,  1650,   720,   725,   730,   750, PH|PV   ,  60),
+/*  5*/ VIC_MODE(  74250,  1920,  2008,  2052,  2200,  1080,  1084,  1094,  1125, PH|PV|IL,  60),
+/*  6*/ VIC_MODE(  27000,  1440,  1478,  1602,  1716,   480,   488,   494,   525, NH|NV|IL,  60),
+/*  7*/ VIC_MODE(  27000,  1440,  1478,  1602,  1716,   480,   488,   494,   525, NH|NV|IL,  60),
+/*  8*/ VIC_MODE(  27000,  1440,  1478,  1602,  1716,   240,   244,   247,   262, NH|NV   ,  60),
+/*  9*/ VIC_MODE(  27000,  1440,  1478,  1602,  1716,   240,   244,   247,   262, NH|NV   ,  60),
+/* 10*/ VIC_MODE(  54000,  2880,  2956,  3204,  3432,   480,   488,   494,   525, NH|NV|IL,  60),
+/* 11*/ VIC_MODE(  54000,  2880,  2956,  3204,  3432,   480,   488,   494,   525, NH|NV|IL,  60),
+/* 12*/ VIC_MODE(  54000,  2880,  2956,  3204,  3432,   240,   244,   247,   262, NH|NV   ,  60),
+/* 13*/ VIC_MODE(  54000,  2880,  2956,  3204,  3432,   240,   244,   247,   262, NH|NV   ,  60),
+/* 14*/ VIC_MODE(  54000,  1440,  1472,  1596,  1716,   480,   489,   495,   525, NH|NV   ,  60),
+/* 15*/ VIC_MODE(  54000,  1440,  1472,  1596,  1716,   480,   489,   495,   525, NH|NV   ,  60),
+/* 16*/ VIC_MODE( 148500,  1920,  2008,  2052,  2200,  1080,  1084,  1089,  1125, PH|PV   ,  60),
+/* 17*/ VIC_MODE(  27000,   720,   732,   796,   864,   576,   581,   586,   625, NH|NV   ,  50),
+/* 18*/ VIC_MODE(  27000,   720,   732,   796,   864,   576,   581,   586,   625, NH|NV   ,  50),
+/* 19*/ VIC_MODE(  74250,  1280,  1720,  1760,  1980,   720,   725,   730,   750, PH|PV   ,  50),
+/* 20*/ VIC_MODE(  74250,  1920,  2448,  2492,  2640,  1080,  1084,  1094,  1125, PH|PV|IL,  50),
+/* 21*/ VIC_MODE(  27000,  1440,  1464,  1590,  1728,   576,   580,   586,   625, NH|NV|IL,  50),
+/* 22*/ VIC_MODE(  27000,  1440,  1464,  1590,  1728,   576,   580,   586,   625, NH|NV|IL,  50),
+/* 23*/ VIC_MODE(  27000,  1440,  1464,  1590,  1728,   288,   290,   293,   312, NH|NV   ,  50),
+/* 24*/ VIC_MODE(  27000,  1440,  1464,  1590,  1728,   288,   290,   293,   312, NH|NV   ,  50),
+/* 25*/ VIC_MODE(  54000,  2880,  2928,  3180,  3456,   576,   580,   586,   625, NH|NV|IL,  50),
+/* 26*/ VIC_MODE(  54000,  2880,  2928,  3180,  3456,   576,   580,   586,   625, NH|NV|IL,  50),
+/* 27*/ VIC_MODE(  54000,  2880,  2928,  3180,  3456,   288,   290,   293,   312, NH|NV   ,  50),
+/* 28*/ VIC_MODE(  54000,  2880,  2928,  3180,  3456,   288,   290,   293,   312, NH|NV   ,  50),
+/* 29*/ VIC_MODE(  54000,  1440,  1464,  1592,  1728,   576,   581,   586,   625, NH|NV   ,  50),
+/* 30*/ VIC_MODE(  54000,  1440,  1464,  1592,  1728,   576,   581,   586,   625, NH|NV   ,  50),
+/* 31*/ VIC_MODE( 148500,  1920,  2448,  2492,  2640,  1080,  1084,  1089,  1125, PH|PV   ,  50),
+/* 32*/ VIC_MODE(  74250,  1920,  2558,  2602,  2750,  1080,  1084,  1089,  1125, PH|PV   ,  24),
+/* 33*/ VIC_MODE(  74250,  1920,  2448,  2492,  2640,  1080,  1084,  1089,  1125, PH|PV   ,  25),
+/* 34*/ VIC_MODE(  74250,  1920,  2008,  2052,  2200,  1080,  1084,  1089,  1125, PH|PV   ,  30),
+/* 35*/ VIC_MODE( 108000,  2880,  2944,  3192,  3432,   480,   489,   495,   525, NH|NV   ,  60),
+/* 36*/ VIC_MODE( 108000,  2880,  2944,  3192,  3432,   480,   489,   495,   525, NH|NV   ,  60),
+/* 37*/ VIC_MODE( 108000,  2880,  2928,  3184,  3456,   576,   581,   586,   625, NH|NV   ,  50),
+/* 38*/ VIC_MODE( 108000,  2880,  2928,  3184,  3456,   576,   581,   586,   625, NH|NV   ,  50),
+/* 39*/ VIC_MODE(  72000,  1920,  1952,  2120,  2304,  1080,  1126,  1136,  1250, PH|NV|IL,  50),
+/* 40*/ VIC_MODE( 148500,  1920,  2448,  2492,  2640,  1080,  1084,  1094,  1125, PH|PV|IL, 100),
+/* 41*/ VIC_MODE( 148500,  1280,  1720,  1760,  1980,   720,   725,   730,   750, PH|PV   , 100),
+/* 42*/ VIC_MODE(  54000,   720,   732,   796,   864,   576,   581,   586,   625, NH|NV   , 100),
+/* 43*/ VIC_MODE(  54000,   720,   732,   796,   864,   576,   581,   586,   625, NH|NV   , 100),
+/* 44*/ VIC_MODE(  54000,  1440,  1464,  1590,  1728,   576,   580,   586,   625, NH|NV|IL, 100),
+/* 45*/ VIC_MODE(  54000,  1440,  1464,  1590,  1728,   576,   580,   586,   625, NH|NV|IL, 100),
+/* 46*/ VIC_MODE( 148500,  1920,  2008,  2052,  2200,  1080,  1084,  1094,  1125, PH|PV|IL, 120),
+/* 47*/ VIC_MODE( 148500,  1280,  1390,  1430,  1650,   720,   725,   730,   750, PH|PV   , 120),
+/* 48*/ VIC_MODE(  54000,   720,   736,   798,   858,   480,   489,   495,   525, NH|NV   , 120),
+/* 49*/ VIC_MODE(  54000,   720,   736,   798,   858,   480,   489,   495,   525, NH|NV   , 120),
+/* 50*/ VIC_MODE(  54000,  1440,  1478,  1602,  1716,   480,   488,   494,   525, NH|NV|IL, 120),
+/* 51*/ VIC_MODE(  54000,  1440,  1478,  1602,  1716,   480,   488,   494,   525, NH|NV|IL, 120),
+/* 52*/ VIC_MODE( 108000,   720,   732,   796,   864,   576,   581,   586,   625, NH|NV   , 200),
+/* 53*/ VIC_MODE( 108000,   720,   732,   796,   864,   576,   581,   586,   625, NH|NV   , 200),
+/* 54*/ VIC_MODE( 108000,  1440,  1464,  1590,  1728,   576,   580,   586,   625, NH|NV|IL, 200),
+/* 55*/ VIC_MODE( 108000,  1440,  1464,  1590,  1728,   576,   580,   586,   625, NH|NV|IL, 200),
+/* 56*/ VIC_MODE( 108000,   720,   736,   798,   858,   480,   489,   495,   525, NH|NV   , 240),
+/* 57*/ VIC_MODE( 108000,   720,   736,   798,   858,   480,   489,   495,   525, NH|NV   , 240),
+/* 58*/ VIC_MODE( 108000,  1440,  1478,  1602,  1716,   480,   488,   494,   525, NH|NV|IL, 240),
+/* 59*/ VIC_MODE( 108000,  1440,  1478,  1602,  1716,   480,   488,   494,   525, NH|NV|IL, 240),
+/* 60*/ VIC_MODE(  59400,  1280,  3040,  3080,  3300,   720,   725,   730,   750, PH|PV   ,  24),
+/* 61*/ VIC_MODE(  74250,  1280,  3700,  3740,  3960,   720,   725,   730,   750, PH|PV   ,  25),
+/* 62*/ VIC_MODE(  74250,  1280,  3040,  3080,  3300,   720,   725,   730,   750, PH|PV   ,  30),
+/* 63*/ VIC_MODE( 297000,  1920,  2008,  2052,  2200,  1080,  1084,  1089,  1125, PH|PV   , 120),
+/* 64*/ VIC_MODE( 297000,  1920,  2448,  2492,  2640,  1080,  1084,  1089,  1125, PH|PV   , 100),
+/* 65*/ VIC_MODE(  59400,  1280,  3040,  3080,  3300,   720,   725,   730,   750, PH|PV   ,  24),
+/* 66*/ VIC_MODE(  74250,  1280,  3700,  3740,  3960,   720,   725,   730,   750, PH|PV   ,  25),
+/* 67*/ VIC_MODE(  74250,  1280,  3040,  3080,  3300,   720,   725,   730,   750, PH|PV   ,  30),
+/* 68*/ VIC_MODE(  74250,  1280,  1720,  1760,  1980,   720,   725,   730,   750, PH|PV   ,  50),
+/* 69*/ VIC_MODE(  74250,  1280,  1390,  1430,  1650,   720,   725,   730,   750, PH|PV   ,  60),
+/* 70*/ VIC_MODE( 148500,  1280,  1720,  1760,  1980,   720,   725,   730,   750, PH|PV   , 100),
+/* 71*/ VIC_MODE( 148500,  1280,  1390,  1430,  1650,   720,   725,   730,   750, PH|PV   , 120),
+/* 72*/ VIC_MODE(  74250,  1920,  2558,  2602,  2750,  1080,  1084,  1089,  1125, PH|PV   ,  24),
+/* 73*/ VIC_MODE(  74250,  1920,  2448,  2492,  2640,  1080,  1084,  1089,  1125, PH|PV   ,  25),
+/* 74*/ VIC_MODE(  74250,  1920,  2008,  2052,  2200,  1080,  1084,  1089,  1125, PH|PV   ,  30),
+/* 75*/ VIC_MODE( 148500,  1920,  2448,  2492,  2640,  1080,  1084,  1089,  1125, PH|PV   ,  50),
+/* 76*/ VIC_MODE( 148500,  1920,  2008,  2052,  2200,  1080,  1084,  1089,  1125, PH|PV   ,  60),
+/* 77*/ VIC_MODE( 297000,  1920,  2448,  2492,  2640,  1080,  1084,  1089,  1125, PH|PV   , 100),
+/* 78*/ VIC_MODE( 297000,  1920,  2008,  2052,  2200,  1080,  1084,  1089,  1125, PH|PV   , 120),
+/* 79*/ VIC_MODE(  59400,  1680,  3040,  3080,  3300,   720,   725,   730,   750, PH|PV   ,  24),
+/* 80*/ VIC_MODE(  59400,  1680,  2908,  2948,  3168,   720,   725,   730,   750, PH|PV   ,  25),
+/* 81*/ VIC_MODE(  59400,  1680,  2380,  2420,  2640,   720,   725,   730,   750, PH|PV   ,  30),
+/* 82*/ VIC_MODE(  82500,  1680,  1940,  1980,  2200,   720,   725,   730,   750, PH|PV   ,  50),
+/* 83*/ VIC_MODE(  99000,  1680,  1940,  1980,  2200,   720,   725,   730,   750, PH|PV   ,  60),
+/* 84*/ VIC_MODE( 165000,  1680,  1740,  1780,  2000,   720,   725,   730,   825, PH|PV   , 100),
+/* 85*/ VIC_MODE( 198000,  1680,  1740,  1780,  2000,   720,   725,   730,   825, PH|PV   , 120),
+/* 86*/ VIC_MODE(  99000,  2560,  3558,  3602,  3750,  1080,  1084,  1089,  1100, PH|PV   ,  24),
+/* 87*/ VIC_MODE(  90000,  2560,  3008,  3052,  3200,  1080,  1084,  1089,  1125, PH|PV   ,  25),
+/* 88*/ VIC_MODE( 118800,  2560,  3328,  3372,  3520,  1080,  1084,  1089,  1125, PH|PV   ,  30),
+/* 89*/ VIC_MODE( 185625,  2560,  3108,  3152,  3300,  1080,  1084,  1089,  1125, PH|PV   ,  50),
+/* 90*/ VIC_MODE( 198000,  2560,  2808,  2852,  3000,  1080,  1084,  1089,  1100, PH|PV   ,  60),
+/* 91*/ VIC_MODE( 371250,  2560,  2778,  2822,  2970,  1080,  1084,  1089,  1250, PH|PV   , 100),
+/* 92*/ VIC_MODE( 495000,  2560,  3108,  3152,  3300,  1080,  1084,  1089,  1250, PH|PV   , 120),
+/* 93*/ VIC_MODE( 297000,  3840,  5116,  5204,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  24),
+/* 94*/ VIC_MODE( 297000,  3840,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   ,  25),
+/* 95*/ VIC_MODE( 297000,  3840,  4016,  4104,  4400,  2160,  2168,  2178,  2250, PH|PV   ,  30),
+/* 96*/ VIC_MODE( 594000,  3840,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   ,  50),
+/* 97*/ VIC_MODE( 594000,  3840,  4016,  4104,  4400,  2160,  2168,  2178,  2250, PH|PV   ,  60),
+/* 98*/ VIC_MODE( 297000,  4096,  5116,  5204,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  24),
+/* 99*/ VIC_MODE( 297000,  4096,  5064,  5152,  5280,  2160,  2168,  2178,  2250, PH|PV   ,  25),
+/*100*/ VIC_MODE( 297000,  4096,  4184,  4272,  4400,  2160,  2168,  2178,  2250, PH|PV   ,  30),
+/*101*/ VIC_MODE( 594000,  4096,  5064,  5152,  5280,  2160,  2168,  2178,  2250, PH|PV   ,  50),
+/*102*/ VIC_MODE( 594000,  4096,  4184,  4272,  4400,  2160,  2168,  2178,  2250, PH|PV   ,  60),
+/*103*/ VIC_MODE( 297000,  3840,  5116,  5204,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  24),
+/*104*/ VIC_MODE( 297000,  3840,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   ,  25),
+/*105*/ VIC_MODE( 297000,  3840,  4016,  4104,  4400,  2160,  2168,  2178,  2250, PH|PV   ,  30),
+/*106*/ VIC_MODE( 594000,  3840,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   ,  50),
+/*107*/ VIC_MODE( 594000,  3840,  4016,  4104,  4400,  2160,  2168,  2178,  2250, PH|PV   ,  60),
+/*108*/ VIC_MODE(  90000,  1280,  2240,  2280,  2500,   720,   725,   730,   750, PH|PV   ,  48),
+/*109*/ VIC_MODE(  90000,  1280,  2240,  2280,  2500,   720,   725,   730,   750, PH|PV   ,  48),
+/*110*/ VIC_MODE(  99000,  1680,  2490,  2530,  2750,   720,   725,   730,   750, PH|PV   ,  48),
+/*111*/ VIC_MODE( 148500,  1920,  2558,  2602,  2750,  1080,  1084,  1089,  1125, PH|PV   ,  48),
+/*112*/ VIC_MODE( 148500,  1920,  2558,  2602,  2750,  1080,  1084,  1089,  1125, PH|PV   ,  48),
+/*113*/ VIC_MODE( 198000,  2560,  3558,  3602,  3750,  1080,  1084,  1089,  1100, PH|PV   ,  48),
+/*114*/ VIC_MODE( 594000,  3840,  5116,  5204,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  48),
+/*115*/ VIC_MODE( 594000,  4096,  5116,  5204,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  48),
+/*116*/ VIC_MODE( 594000,  3840,  5116,  5204,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  48),
+/*117*/ VIC_MODE(1188000,  3840,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   , 100),
+/*118*/ VIC_MODE(1188000,  3840,  4016,  4104,  4400,  2160,  2168,  2178,  2250, PH|PV   , 120),
+/*119*/ VIC_MODE(1188000,  3840,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   , 100),
+/*120*/ VIC_MODE(1188000,  3840,  4016,  4104,  4400,  2160,  2168,  2178,  2250, PH|PV   , 120),
+/*121*/ VIC_MODE( 396000,  5120,  7116,  7204,  7500,  2160,  2168,  2178,  2200, PH|PV   ,  24),
+/*122*/ VIC_MODE( 396000,  5120,  6816,  6904,  7200,  2160,  2168,  2178,  2200, PH|PV   ,  25),
+/*123*/ VIC_MODE( 396000,  5120,  5784,  5872,  6000,  2160,  2168,  2178,  2200, PH|PV   ,  30),
+/*124*/ VIC_MODE( 742500,  5120,  5866,  5954,  6250,  2160,  2168,  2178,  2475, PH|PV   ,  48),
+/*125*/ VIC_MODE( 742500,  5120,  6216,  6304,  6600,  2160,  2168,  2178,  2250, PH|PV   ,  50),
+/*126*/ VIC_MODE( 742500,  5120,  5284,  5372,  5500,  2160,  2168,  2178,  2250, PH|PV   ,  60),
+/*127*/ VIC_MODE(1485000,  5120,  6216,  6304,  6600,  2160,  2168,  2178,  2250, PH|PV   , 100)
+};
+
+//CTA-861-G Table 3: VIC 193..219
+static const vtiming_t vic_tbl193[] = {
+/*193*/ VIC_MODE(1485000,  5120,  5284,  5372,  5500,  2160,  2168,  2178,  2250, PH|PV   , 120),
+/*194*/ VIC_MODE(1188000,  7680, 10232, 10408, 11000,  4320,  4336,  4356,  4500, PH|PV   ,  24),
+/*195*/ VIC_MODE(1188000,  7680, 10032, 10208, 10800,  4320,  4336,  4356,  4400, PH|PV   ,  25),
+/*196*/ VIC_MODE(1188000,  7680,  8232,  8408,  9000,  4320,  4336,  4356,  4400, PH|PV   ,  30),
+/*197*/ VIC_MODE(2376000,  7680, 10232, 10408, 11000,  4320,  4336,  4356,  4500, PH|PV   ,  48),
+/*198*/ VIC_MODE(2376000,  7680, 10032, 10208, 10800,  4320,  4336,  4356,  4400, PH|PV   ,  50),
+/*199*/ VIC_MODE(2376000,  7680,  8232,  8408,  9000,  4320,  4336,  4356,  4400, PH|PV   ,  60),
+/*200*/ VIC_MODE(4752000,  7680,  9792,  9968, 10560,  4320,  4336,  4356,  4500, PH|PV   , 100),
+/*201*/ VIC_MODE(4752000,  7680,  8032,  8208,  8800,  4320,  4336,  4356,  4500, PH|PV   , 120),
+/*202*/ VIC_MODE(1188000,  7680, 10232, 10408, 11000,  4320,  4336,  4356,  4500, PH|PV   ,  24),
+/*203*/ VIC_MODE(1188000,  7680, 10032, 10208, 10800,  4320,  4336,  4356,  4400, PH|PV   ,  25),
+/*204*/ VIC_MODE(1188000,  7680,  8232,  8408,  9000,  4320,  4336,  4356,  4400, PH|PV   ,  30),
+/*205*/ VIC_MODE(2376000,  7680, 10232, 10408, 11000,  4320,  4336,  4356,  4500, PH|PV   ,  48),
+/*206*/ VIC_MODE(2376000,  7680, 10032, 10208, 10800,  4320,  4336,  4356,  4400, PH|PV   ,  50),
+/*207*/ VIC_MODE(2376000,  7680,  8232,  8408,  9000,  4320,  4336,  4356,  4400, PH|PV   ,  60),
+/*208*/ VIC_MODE(4752000,  7680,  9792,  9968, 10560,  4320,  4336,  4356,  4500, PH|PV   , 100),
+/*209*/ VIC_MODE(4752000,  7680,  8032,  8208,  8800,  4320,  4336,  4356,  4500, PH|PV   , 120),
+/*210*/ VIC_MODE(1485000, 10240, 11732, 11908, 12500,  4320,  4336,  4356,  4950, PH|PV   ,  24),
+/*211*/ VIC_MODE(1485000, 10240, 12732, 12908, 13500,  4320,  4336,  4356,  4400, PH|PV   ,  25),
+/*212*/ VIC_MODE(1485000, 10240, 10528, 10704, 11000,  4320,  4336,  4356,  4500, PH|PV   ,  30),
+/*213*/ VIC_MODE(2970000, 10240, 11732, 11908, 12500,  4320,  4336,  4356,  4950, PH|PV   ,  48),
+/*214*/ VIC_MODE(2970000, 10240, 12732, 12908, 13500,  4320,  4336,  4356,  4400, PH|PV   ,  50),
+/*215*/ VIC_MODE(2970000, 10240, 10528, 10704, 11000,  4320,  4336,  4356,  4500, PH|PV   ,  60),
+/*216*/ VIC_MODE(5940000, 10240, 12432, 12608, 13200,  4320,  4336,  4356,  4500, PH|PV   , 100),
+/*217*/ VIC_MODE(5940000, 10240, 10528, 10704, 11000,  4320,  4336,  4356,  4500, PH|PV   , 120),
+/*218*/ VIC_MODE(1188000,  4096,  4896,  4984,  5280,  2160,  2168,  2178,  2250, PH|PV   , 100),
+/*219*/ VIC_MODE(1188000,  4096,  4184,  4272,  4400,  2160,  2168,  2178,  2250, PH|PV   , 120)
+};
+
+#undef NH
+#undef PH
+#undef NV
+#undef PV
+#undef IL
+#undef VIC_MODE
+
+static_assert((sizeof(vic_tbl1  ) / sizeof(vtiming_t)) == 127, "vic_tbl1: VIC 1..127");
+static_assert((sizeof(vic_tbl193) / sizeof(vtiming_t)) ==  27, "vic_tbl193: VIC 193..219");
+
+const vtiming_t* modelist_cl::ByVIC(u32_t vic) {
+   if ((vic >= 1) && (vic <= 127)) return &vic_tbl1[vic - 1];
+   if ((vic >= 193) && (vic <= 219)) return &vic_tbl193[vic - 193];
+   return NULL;
+}
+
+void modelist_cl::Clear() {
+   nmodes = 0;
+   ndrop  = 0;
+   nsvd   = 0;
+   ndtd   = 0;
+   memset(hash_ar, 0, sizeof(hash_ar));
+}
+
+//returns mode_ar index, -1 if the table is full
+i32_t modelist_cl::add(const vtiming_t& tmg, u32_t src, u32_t flags) {
+   modeline_t *pml;
+   u32_t       hash;
+   u32_t       slot;
+
+   hash = (dmt_cl::HashTiming(tmg) >> 23); //ML_HASH_SZ = 2^9
+
+   while ((slot = hash_ar[hash]) != 0) {
+      pml = &mode_ar[slot -1];
+      if (dmt_cl::SameTiming(pml->tmg, tmg)) {
+         pml->src   |= src;
+         pml->flags |= flags;
+         return (slot -1);
+      }
+      hash = ((hash +1) & (ML_HASH_SZ -1));
+   }
+
+   if (nmodes >= ML_MAX_MODES) {
+      ndrop ++ ;
+      return -1;
+   }
+
+   pml = &mode_ar[nmodes];
+   pml->tmg      = tmg;
+   pml->src      = src;
+   pml->flags    = flags;
+   pml->dmt_id   = 0;
+   pml->vic      = 0;
+   pml->svr_rank = 0;
+
+   nmodes ++ ;
+   hash_ar[hash] = nmodes;
+
+   return (nmodes -1);
+}
+
+i32_t modelist_cl::add_dmt(const dmt_mode_t* pmode, u32_t src) {
+   i32_t  idx;
+
+   idx = add(pmode->tmg, src, 0);
+   if ((idx >= 0) && (mode_ar[idx].dmt_id == 0)) mode_ar[idx].dmt_id = pmode->id;
+   return idx;
+}
+
+//DMT, if the code (or the resolution & refresh) is listed, CVT otherwise
+i32_t modelist_cl::add_std(u32_t std_code, u32_t src, bool edid_ver13) {
+   const dmt_mode_t *pmode;
+   vtiming_t         tmg;
+   rcode             retU;
+   u32_t             h_act;
+   u32_t             v_act;
+   u32_t             vrefr;
+
+   pmode = dmt_cl::BySTD(std_code);
+   if (pmode != NULL) return add_dmt(pmode, src);
+
+   retU = dmt_cl::DecodeSTD(std_code, h_act, v_act, vrefr, edid_ver13);
+   if (! RCD_IS_OK(retU)) return -1; //unused
+
+   pmode = dmt_cl::Find(h_act, v_act, vrefr);
+   if (pmode != NULL) return add_dmt(pmode, src);
+
+   retU = dmt_cl::CVT(h_act, v_act, vrefr, tmg);
+   if (! RCD_IS_OK(retU)) return -1;
+
+   return add(tmg, src, MLF_CVT);
+}
+
+i32_t modelist_cl::add_dtd(const u8_t* pinst, u32_t src, u32_t flags) {
+   const dmt_mode_t *pmode;
+   vtiming_t         tmg;
+   rcode             retU;
+   i32_t             idx;
+
+   retU = dmt_cl::FromDTD(pinst, tmg);
+   if (! RCD_IS_OK(retU)) return -1;
+
+   idx = add(tmg, src, flags);
+   if (ndtd < ML_MAX_DTD) {
+      dtd_idx[ndtd] = idx;
+      ndtd ++ ;
+   }
+   if (idx < 0) return idx;
+
+   if (mode_ar[idx].dmt_id == 0) {
+      pmode = dmt_cl::MatchDTD(tmg);
+      if (pmode != NULL) mode_ar[idx].dmt_id = pmode->id;
+   }
+   return idx;
+}
+
+i32_t modelist_cl::add_vic(u32_t vic, u32_t src, u32_t flags) {
+   const vtiming_t *ptmg;
+   i32_t            idx;
+
+   ptmg = ByVIC(vic);
+   if (ptmg == NULL) return -1;
+
+   idx = add(*ptmg, src, flags);
+   if ((idx >= 0) && (mode_ar[idx].vic == 0)) mode_ar[idx].vic = vic;
+   return idx;
+}
+
+rcode modelist_cl::Build(EDID_cl& EDID) {
+   rcode         retU;
+   GroupAr_cl   *p_grp_ar;
+   edi_grp_cl   *pgrp;
+   edi_grp_cl   *pgrp_y42c;
+   const edid_t *pbase;
+   const u8_t   *pinst;
+   u8_t          svr_ar[ML_MAX_SVR];
+   u32_t         nsvr;
+   u32_t         tid;
+   u32_t         pref_flg;
+   bool          b_ver13;
+
+   Clear();
+
+   pgrp_y42c = NULL;
+   nsvr      = 0;
+   pbase     = &EDID.getEDID()->edi.base;
+   b_ver13   = ((pbase->edid_ver > 1) || (pbase->edid_rev >= 3));
+   //EDID 1.4: the 1st DTD is always the preferred timing mode
+   pref_flg  = 0;
+   if ((pbase->edid_ver > 1) || (pbase->edid_rev >= 4) || (pbase->features.db1_fnative != 0)) {
+      pref_flg = MLF_PREFERRED;
+   }
+
+   //EDID base block
+   p_grp_ar = &EDID.EDI_BaseGrpAr;
+   if (p_grp_ar->GetCount() == 0) RCD_RETURN_FAULT(retU);
+
+   for (u32_t itg=0; itg<p_grp_ar->GetCount(); itg++) {
+      pgrp  = p_grp_ar->Item(itg);
+      pinst = pgrp->getInsPtr();
+      tid   = pgrp->getTypeID() & ID_EDID_MASK;
+
+      switch (tid) {
+         case ID_ETM:
+            for (u32_t bit=0; bit<DMT_ETM_BITS; bit++) {
+               const dmt_mode_t *pmode;
+
+               if (0 == (pinst[bit >> 3] & (1 << (bit & 7)))) continue;
+               pmode = dmt_cl::ByETM(bit);
+               if (pmode == NULL) continue; //manufacturer-specific
+               add_dmt(pmode, MLS_ETM);
+            }
+            break;
+         case ID_STI:
+            add_std(((pinst[0] << 8) | pinst[1]), MLS_STI, b_ver13);
+            break;
+         case ID_AST:
+            pinst += offsetof(ast_t, x0_res8);
+            for (u32_t its=0; its<6; its++) {
+               add_std(((pinst[0] << 8) | pinst[1]), MLS_AST, b_ver13);
+               pinst += sizeof(std_timg_t);
+            }
+            break;
+         case ID_DTD:
+            add_dtd(pinst, MLS_DTD, (ndtd == 0) ? pref_flg : 0);
+            break;
+         default:
+            break;
+      }
+   }
+
+   //CTA-861 extension
+   p_grp_ar = &EDID.EDI_Ext0GrpAr;
+
+   for (u32_t itg=0; itg<p_grp_ar->GetCount(); itg++) {
+      u32_t  nsub;
+
+      pgrp  = p_grp_ar->Item(itg);
+      pinst = pgrp->getInsPtr();
+      tid   = pgrp->getTypeID();
+      nsub  = pgrp->getSubGrpCount();
+
+      if ((tid & ID_EDID_MASK) == ID_DTD) {
+         add_dtd(pinst, MLS_CTA_DTD, 0);
+         continue;
+      }
+
+      if ((tid & ID_CEA_EXT_MASK) == 0) {
+         if ((tid & ID_CEA_MASK) != ID_VDB) continue;
+
+         for (u32_t its=0; its<nsub; its++) {
+            u32_t  vic;
+            u32_t  natv;
+            i32_t  idx;
+
+            vic = EDID.CEA_VDB_SVD_decode(pgrp->getSubGroup(its)->getInsPtr()[0], natv);
+            idx = add_vic(vic, MLS_SVD, (natv != 0) ? MLF_NATIVE : 0);
+
+            if (nsvd < ML_MAX_SVD) {
+               svd_idx[nsvd] = idx;
+               nsvd ++ ;
+            }
+         }
+         continue;
+      }
+
+      switch (tid & ID_CEA_EXT_MASK) {
+         case ID_Y42V:
+            for (u32_t its=0; its<nsub; its++) {
+               u32_t  vic;
+               u32_t  natv;
+
+               vic = EDID.CEA_VDB_SVD_decode(pgrp->getSubGroup(its)->getInsPtr()[0], natv);
+               add_vic(vic, MLS_Y42V, MLF_Y420_ONLY);
+            }
+            break;
+         case ID_Y42C:
+            pgrp_y42c = pgrp;
+            break;
+         case ID_VFPD:
+            for (u32_t its=0; (its<nsub) && (nsvr<ML_MAX_SVR); its++) {
+               svr_ar[nsvr] = pgrp->getSubGroup(its)->getInsPtr()[0];
+               nsvr ++ ;
+            }
+            break;
+         default:
+            break;
+      }
+   }
+
+   //Y42C: bit N refers to Nth SVD in VDB, no bitmap bytes: all the SVDs
+   if (pgrp_y42c != NULL) {
+      u32_t  nbits;
+      bool   b_all;
+
+      pinst = pgrp_y42c->getInsPtr();
+      nbits = reinterpret_cast <const ethdr_t*> (pinst)->ehdr.hdr.tag.blk_len;
+      b_all = (nbits <= 1);
+      nbits = b_all ? nsvd : ((nbits -1) << 3);
+      pinst += sizeof(ethdr_t);
+
+      for (u32_t its=0; (its<nsvd) && (its<nbits); its++) {
+         if (svd_idx[its] < 0) continue;
+         if (!b_all && (0 == (pinst[its >> 3] & (1 << (its & 7))))) continue;
+         mode_ar[svd_idx[its]].flags |= MLF_Y420;
+      }
+   }
+
+   //VFPD: the SVRs reference VICs or DTDs
+   for (u32_t its=0; its<nsvr; its++) {
+      u32_t  code;
+      u32_t  ndtd_ref;
+      i32_t  idx = -1;
+
+      code = EDID.CEA_VFPD_SVR_decode(svr_ar[its], ndtd_ref);
+      if (ndtd_ref != 0) {
+         if (ndtd_ref <= ndtd) {
+            idx = dtd_idx[ndtd_ref -1];
+            if (idx >= 0) mode_ar[idx].src |= MLS_SVR;
+         }
+      } else {
+         idx = add_vic(code, MLS_SVR, 0);
+      }
+      if ((idx >= 0) && (mode_ar[idx].svr_rank == 0)) mode_ar[idx].svr_rank = (its +1);
+   }
+
+   sort();
+
+   RCD_RETURN_OK(retU);
+}
+
+//preferred first, then VFPD order, then largest/fastest first
+static int mode_cmp(const void *pa, const void *pb) {
+   const modeline_t *pml_a = reinterpret_cast <const modeline_t*> (pa);
+   const modeline_t *pml_b = reinterpret_cast <const modeline_t*> (pb);
+   u32_t  val_a;
+   u32_t  val_b;
+
+   val_a = (pml_a->flags & MLF_PREFERRED);
+   val_b = (pml_b->flags & MLF_PREFERRED);
+   if (val_a != val_b) return (val_a != 0) ? -1 : 1;
+
+   //rank 0 -> not referenced: last
+   val_a = (u8_t) (pml_a->svr_rank -1);
+   val_b = (u8_t) (pml_b->svr_rank -1);
+   if (val_a != val_b) return (val_a < val_b) ? -1 : 1;
+
+   val_a = (pml_a->tmg.h_act * pml_a->tmg.v_act);
+   val_b = (pml_b->tmg.h_act * pml_b->tmg.v_act);
+   if (val_a != val_b) return (val_a > val_b) ? -1 : 1;
+
+   if (pml_a->tmg.h_act != pml_b->tmg.h_act) return (pml_a->tmg.h_act > pml_b->tmg.h_act) ? -1 : 1;
+
+   val_a = dmt_cl::Refresh(pml_a->tmg);
+   val_b = dmt_cl::Refresh(pml_b->tmg);
+   if (val_a != val_b) return (val_a > val_b) ? -1 : 1;
+
+   if (pml_a->tmg.pixclk != pml_b->tmg.pixclk) return (pml_a->tmg.pixclk > pml_b->tmg.pixclk) ? -1 : 1;
+   return 0;
+}
+
+//NOTE: hash_ar, svd_idx and dtd_idx are not valid after sorting
+void modelist_cl::sort() {
+   qsort(mode_ar, nmodes, sizeof(modeline_t), mode_cmp);
+}
+
+void modelist_cl::Print(u32_t idx, wxString& str) {
+   static const char *src_name[MLS_COUNT] = {
+      "ETM", "STI", "DTD", "AST", "CTA-DTD", "SVD", "SVR", "Y42V"
+   };
+
+   const modeline_t *pml;
+   const vtiming_t  *ptmg;
+   const char       *psep;
+
+   str.Empty();
+   if (idx >= nmodes) return;
+
+   pml  = &mode_ar[idx];
+   ptmg = &pml->tmg;
+
+   str.Printf("%ux%u%s@%u %u.%03u %u %u %u %u %u %u %u %u %chsync %cvsync",
+      ptmg->h_act, ptmg->v_act, (ptmg->flags & VTF_ILACE) ? "i" : "", ptmg->vrefr,
+      ptmg->pixclk / 1000, ptmg->pixclk % 1000,
+      ptmg->h_act, (ptmg->h_act + ptmg->h_fp), (ptmg->h_act + ptmg->h_fp + ptmg->h_sw), (ptmg->h_act + ptmg->h_bl),
+      ptmg->v_act, (ptmg->v_act + ptmg->v_fp), (ptmg->v_act + ptmg->v_fp + ptmg->v_sw), (ptmg->v_act + ptmg->v_bl),
+      (ptmg->flags & VTF_HSPOS) ? '+' : '-', (ptmg->flags & VTF_VSPOS) ? '+' : '-');
+
+   if (pml->flags & MLF_PREFERRED) str << " preferred";
+   if (pml->flags & MLF_NATIVE   ) str << " native";
+   if (pml->flags & MLF_Y420     ) str << " Y420";
+   if (pml->flags & MLF_Y420_ONLY) str << " Y420-only";
+   if (pml->flags & MLF_CVT      ) str << " CVT";
+   if (pml->svr_rank != 0) str << wxString::Format(" VFPD#%u", pml->svr_rank);
+   if (pml->dmt_id   != 0) str << wxString::Format(" DMT 0x%02X", pml->dmt_id);
+   if (pml->vic      != 0) str << wxString::Format(" VIC %u", pml->vic);
+
+   psep = " [";
+   for (u32_t its=0; its<MLS_COUNT; its++) {
+      if (0 == (pml->src & (1 << its))) continue;
+      str << psep << src_name[its];
+      psep = ",";
+   }
+   str << "]";
+}
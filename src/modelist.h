@@ -0,0 +1,100 @@
+/***************************************************************
+ * Name:      modelist.h
+ * Purpose:   Mode list: all timing sources merged into one table
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef MODELIST_H
+#define MODELIST_H 1
+
+#include <wx/string.h>
+#include <string.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "dmt.h"
+
+class EDID_cl;
+
+enum { //modeline_t.src: timing sources
+   MLS_ETM     = 0x0001,
+   MLS_STI     = 0x0002,
+   MLS_DTD     = 0x0004, //base block DTD
+   MLS_AST     = 0x0008,
+   MLS_CTA_DTD = 0x0010,
+   MLS_SVD     = 0x0020, //VDB
+   MLS_SVR     = 0x0040, //VFPD
+   MLS_Y42V    = 0x0080,
+   MLS_COUNT   = 8
+};
+
+enum { //modeline_t.flags
+   MLF_PREFERRED = 0x0001, //1st DTD: EDID 1.4 or "preferred timing mode" feature bit
+   MLF_NATIVE    = 0x0002, //SVD "native" flag
+   MLF_Y420      = 0x0004, //Y42C: YCbCr 4:2:0 supported in addition to other modes
+   MLF_Y420_ONLY = 0x0008, //Y42V: YCbCr 4:2:0 only
+   MLF_CVT       = 0x0010  //STI without DMT equivalent: CVT timing
+};
+
+enum {
+   ML_MAX_MODES = 256,
+   ML_HASH_SZ   = 512,  //power of 2, > 2 * ML_MAX_MODES
+   ML_MAX_SVD   = 128,  //VDB SVDs: Y42C bitmap index
+   ML_MAX_DTD   = 16,   //VFPD SVR: DTD 1..16
+   ML_MAX_SVR   = 32
+};
+
+typedef struct {
+   vtiming_t  tmg;
+   u16_t      src;      //MLS_*: all sources declaring the mode
+   u16_t      flags;    //MLF_*
+   u16_t      dmt_id;   //0: not a DMT mode
+   u8_t       vic;      //0: not a CTA-861 mode
+   u8_t       svr_rank; //VFPD position (1 = most preferred), 0: not referenced
+} modeline_t;
+
+//The mode table is rebuilt from the group arrays: no allocations, the timings are
+//deduplicated with a hash on the timing geometry.
+class modelist_cl {
+   protected:
+      modeline_t  mode_ar[ML_MAX_MODES];
+      u16_t       hash_ar[ML_HASH_SZ]; //mode_ar index +1, 0 = empty
+      u32_t       nmodes;
+      u32_t       ndrop;
+
+      i16_t       svd_idx[ML_MAX_SVD]; //VDB SVDs, in order: mode_ar index, -1: unknown VIC
+      u32_t       nsvd;
+      i16_t       dtd_idx[ML_MAX_DTD]; //base + CTA DTDs, in order
+      u32_t       ndtd;
+
+      i32_t  add    (const vtiming_t& tmg, u32_t src, u32_t flags);
+      i32_t  add_dmt(const dmt_mode_t* pmode, u32_t src);
+      i32_t  add_std(u32_t std_code, u32_t src, bool edid_ver13);
+      i32_t  add_dtd(const u8_t* pinst, u32_t src, u32_t flags);
+      i32_t  add_vic(u32_t vic, u32_t src, u32_t flags);
+
+      void   sort();
+
+   public:
+      void   Clear();
+      rcode  Build(EDID_cl& EDID);
+
+      inline u32_t              Count  () {return nmodes;};
+      inline u32_t              Dropped() {return ndrop;};
+      inline const modeline_t&  Item   (u32_t idx) {return mode_ar[idx];};
+
+      //"1920x1080@60 148.500 1920 2008 2052 2200 1080 1084 1089 1125 +hsync +vsync" + flags & sources
+      void   Print(u32_t idx, wxString& str);
+
+      //CTA-861 VIC timing, NULL for reserved codes
+      static const vtiming_t* ByVIC(u32_t vic);
+
+      modelist_cl() : nmodes(0), ndrop(0), nsvd(0), ndtd(0) {
+         memset(hash_ar, 0, sizeof(hash_ar));
+      };
+};
+
+#endif /* MODELIST_H */
@@ -0,0 +1,74 @@
+/***************************************************************
+ * Name:      oui.cpp
+ * Purpose:   IEEE OUI registry: vendor-specific CTA-861 blocks
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "oui.h"
+
+#include <stddef.h>
+
+static constexpr oui_entry_t oui_tbl[] = {
+   //OUI     , name                       ,  VSD          , VSVD           , VSAD
+   {0x000C03, "HDMI Licensing, LLC"       , {VSDEC_HDMI14 , VSDEC_RAW      , VSDEC_RAW}},
+   {0xC45DD8, "HDMI Forum"                , {VSDEC_HF     , VSDEC_RAW      , VSDEC_RAW}},
+   {0x00001A, "Advanced Micro Devices"    , {VSDEC_AMD    , VSDEC_RAW      , VSDEC_RAW}},
+   {0x00D046, "Dolby Laboratories, Inc."  , {VSDEC_RAW    , VSDEC_DOVI     , VSDEC_RAW}},
+   {0x90848B, "HDR10+ Technologies, LLC"  , {VSDEC_RAW    , VSDEC_HDR10P   , VSDEC_RAW}}
+};
+
+enum {
+   OUI_HASH_BITS = 5,
+   OUI_HASH_SZ   = (1 << OUI_HASH_BITS)
+};
+
+static_assert((sizeof(oui_tbl) / sizeof(oui_entry_t)) < (OUI_HASH_SZ / 2), "oui_tbl: OUI_HASH_SZ too small");
+
+static constexpr u32_t oui_hash(u32_t oui) {
+   return ((oui * 0x9E3779B1u) >> (32 - OUI_HASH_BITS));
+}
+
+typedef struct {
+   u8_t  slot[OUI_HASH_SZ]; //oui_tbl index +1, 0: empty
+} oui_index_t;
+
+static constexpr oui_index_t oui_index_gen() {
+   oui_index_t  idx = {};
+
+   for (u32_t itt=0; itt<(sizeof(oui_tbl) / sizeof(oui_entry_t)); itt++) {
+      u32_t  hash = oui_hash(oui_tbl[itt].oui);
+
+      while (idx.slot[hash] != 0) hash = ((hash +1) & (OUI_HASH_SZ -1));
+      idx.slot[hash] = (itt +1);
+   }
+   return idx;
+}
+
+static constexpr oui_index_t oui_index = oui_index_gen();
+
+const oui_entry_t* oui_cl::Lookup(u32_t oui) {
+   u32_t  hash;
+   u32_t  slot;
+
+   hash = oui_hash(oui);
+
+   while ((slot = oui_index.slot[hash]) != 0) {
+      if (oui_tbl[slot -1].oui == oui) return &oui_tbl[slot -1];
+      hash = ((hash +1) & (OUI_HASH_SZ -1));
+   }
+   return NULL;
+}
+
+u32_t oui_cl::Decoder(u32_t oui, u32_t blk_type) {
+   const oui_entry_t *pent;
+
+   if (blk_type >= OUI_NBLK) return VSDEC_RAW;
+
+   pent = Lookup(oui);
+   if (pent == NULL) return VSDEC_RAW;
+
+   return pent->dec[blk_type];
+}
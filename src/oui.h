@@ -0,0 +1,51 @@
+/***************************************************************
+ * Name:      oui.h
+ * Purpose:   IEEE OUI registry: vendor-specific CTA-861 blocks
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef OUI_H
+#define OUI_H 1
+
+#include "def_types.h"
+
+enum { //vendor-specific block payload decoders
+   VSDEC_RAW     = 0, //unknown OUI: payload shown as unknown bytes
+   VSDEC_HDMI14,      //VSD : HDMI Licensing, LLC
+   VSDEC_HF,          //VSD : HDMI Forum: HF-VSDB
+   VSDEC_AMD,         //VSD : AMD FreeSync
+   VSDEC_DOVI,        //VSVD: Dolby Vision
+   VSDEC_HDR10P,      //VSVD: HDR10+
+   VSDEC_COUNT
+};
+
+enum { //vendor-specific block types
+   OUI_BLK_VSD  = 0, //Tag Code 3
+   OUI_BLK_VSVD = 1, //Extended Tag Code 1
+   OUI_BLK_VSAD = 2, //Extended Tag Code 17
+   OUI_NBLK     = 3
+};
+
+typedef struct {
+   u32_t        oui;           //24-bit, as written: 00-0C-03 -> 0x000C03
+   const char  *name;
+   u8_t         dec[OUI_NBLK]; //VSDEC_* per block type
+} oui_entry_t;
+
+//Compile-time open-addressing hash: O(1), no allocations.
+class oui_cl {
+   public:
+      //NULL if the OUI is not registered
+      static const oui_entry_t*  Lookup (u32_t oui);
+      //VSDEC_RAW for unknown OUIs
+      static u32_t               Decoder(u32_t oui, u32_t blk_type);
+      //3 bytes, little endian (as stored in the data blocks)
+      static inline u32_t        FromLE (const u8_t* poui) {
+         return ((poui[2] << 16) | (poui[1] << 8) | poui[0]);
+      };
+};
+
+#endif /* OUI_H */
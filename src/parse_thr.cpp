@@ -0,0 +1,315 @@
+/***************************************************************
+ * Name:      parse_thr.cpp
+ * Purpose:   EDID background parser thread
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-04
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idPARSE_THR
+   #error "parse_thr.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idPARSE_THR
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "parse_thr.h"
+
+#include <wx/file.h>
+#include <string.h>
+
+edid_parser_thr_cl::edid_parser_thr_cl(wxEvtHandler *dst, int evtid, long id, u32_t type, EDID_cl& src, const u8_t *pbuf) :
+   wxThread(wxTHREAD_JOINABLE),
+   evt_dst(dst), evt_id(evtid), job_id(id), job_type(type),
+   b_loaded(false), b_parsed(false), b_canceled(false)
+{
+   b_err_ignore = src.Get_ERR_Ignore();
+
+   EDID.Set_ERR_Ignore(b_err_ignore);
+   EDID.Set_RD_Ignore (src.Get_RD_Ignore());
+   EDID.SetGuiLogPtr  (&tlog);
+   EDID.SetDiagPtr    (&diag);
+   EDID.Clear();
+
+   //reparse a copy of the current buffer: the frame keeps its data until the job is done
+   if (job_type == PJOB_REPARSE) pbuf = src.getEDID()->buff;
+
+   if (pbuf != NULL) {
+      memcpy(EDID.getEDID()->buff, pbuf, sizeof(edi_buf_t));
+      b_loaded = true;
+   }
+
+   RCD_SET_OK(job_rcd);
+}
+
+edid_parser_thr_cl::~edid_parser_thr_cl() {
+   //results not taken over by the frame
+   EDID.DeleteGroups();
+}
+
+void edid_parser_thr_cl::post_stage(u32_t stage) {
+   wxThreadEvent *evt;
+
+   evt = new wxThreadEvent(wxEVT_THREAD, evt_id);
+   if (evt == NULL) return;
+
+   evt->SetInt      (stage);
+   evt->SetExtraLong(job_id);
+
+   wxQueueEvent(evt_dst, evt);
+}
+
+wxThread::ExitCode edid_parser_thr_cl::Entry() {
+
+   post_stage(PSTAGE_READ);
+
+   switch (job_type) {
+      case PJOB_OPEN_BIN:
+         job_rcd = read_bin();
+         break;
+      case PJOB_IMPORT_HEX:
+         job_rcd = read_hex();
+         break;
+      default:
+         RCD_SET_OK(job_rcd);
+         break;
+   }
+
+   if (! RCD_IS_OK(job_rcd)) {
+      if (! b_loaded) goto done;
+      if (! b_err_ignore) goto done;
+   }
+
+   if (TestDestroy()) {
+      b_canceled = true;
+      goto done;
+   }
+
+   job_rcd = parse();
+
+done:
+   post_stage(PSTAGE_DONE);
+   return 0;
+}
+
+rcode edid_parser_thr_cl::read_bin() {
+   rcode     retU;
+   wxFile    file;
+   u32_t     idx;
+   u32_t     idxmax;
+   ediblk_t *pblk;
+
+   if (! file.Open(fpath, wxFile::read) ) RCD_RETURN_FAULT(retU);
+
+   tlog.slog = "File opened:\n ";
+   tlog.slog << fpath;
+   tlog.DoLog();
+
+   RCD_SET_OK(retU);
+
+   idx    = EDI_BASE_IDX;
+   idxmax = 0;
+   pblk   = EDID.getEDID()->blk;
+   do {
+      if ( EDI_BLK_SIZE != file.Read(&pblk[idx], EDI_BLK_SIZE) ) {
+         RCD_SET_FAULT(retU);
+         tlog.slog.Printf("Failed to load EDID block[%d]: incorrect size.", idx);
+         tlog.DoLog();
+      } else if (! EDID.VerifyChksum(idx)) {
+         RCD_SET_FAULT(retU);
+      }
+      if (idx == 0) {
+         //only 1 extension block is currently supported (CEA)
+         idxmax = EDID.getEDID()->edi.base.num_extblk;
+         if (idxmax > EDI_EXT1_IDX) idxmax = EDI_EXT1_IDX;
+      }
+      idx++ ;
+   } while (idx <= idxmax);
+
+   b_loaded = true;
+
+   file.Close();
+   if (!RCD_IS_OK(retU)) {
+      tlog.DoLog("OpenEDID() FAILED.");
+
+      if (! b_err_ignore) {
+         return retU;
+      } else {
+         tlog.DoLog("Error ignored: trying to Reparse().");
+      }
+   }
+
+   tlog.slog.Printf("Loaded %u EDID block(s)\n", idx);
+   tlog.DoLog();
+
+   return retU;
+}
+
+rcode edid_parser_thr_cl::read_hex() {
+   rcode    retU;
+   char    *buff8 = NULL;
+   u8_t    *edi;
+   u32_t    itb;
+   ssize_t  itc, len;
+   wxFile   file;
+   wxString tmps;
+
+   RCD_SET_OK(retU);
+
+   if (! file.Open(fpath, wxFile::read) ) RCD_RETURN_FAULT(retU);
+
+   len = file.Length();
+   if ( (len < (128*2)) || (len > (1024*4)) ) {
+      /* reject files which are too small
+         but also prevent importing essays :)
+      */
+      tlog.DoLog("[E!] Bad file. Allowed size is 256...4096 bytes.");
+      file.Close();
+      RCD_RETURN_FAULT(retU);
+   }
+
+   buff8 = new char[len+1];
+   if (buff8 == NULL) {
+      file.Close();
+      RCD_RETURN_FAULT(retU);
+   }
+   //read text
+   if ( len != file.Read(buff8, len) ) {
+      RCD_SET_FAULT(retU);
+   }
+
+   b_loaded = true; //allows parsing partially loaded data
+
+   file.Close();
+   if (!RCD_IS_OK(retU)) {
+      delete [] buff8;
+      return retU;
+   }
+
+   tlog.slog = "File imported:\n ";
+   tlog.slog << fpath;
+   tlog.DoLog();
+
+   //hex to bin
+   itb = 0;
+   edi = EDID.getEDID()->buff;
+   for (itc=0; itc<len; itc++) {
+      bool conv_ok;
+      ulong chr = buff8[itc];
+      if ( (chr < '0') || ((chr > '9') && (chr < 'A')) || \
+          ((chr > 'F') && (chr < 'a')) || (chr > 'f') ) continue;
+      //Not UTF8, just take 2 chars in one call;
+      tmps    = wxString::FromUTF8(&buff8[itc], 2); itc++;
+      conv_ok = tmps.ToULong(&chr, 16);
+
+      if (! conv_ok) {
+         static const char msg[] = "[E!] ImportEDID_hex() parsing file content failed @offs=%d";
+         wxedid_RCD_SET_FAULT_VMSG(retU, msg, (int) itc);
+         if (! b_err_ignore) {
+            delete [] buff8;
+            return retU;
+         } else {
+            tlog.PrintRcode(retU);
+            tlog.DoLog("Error ignored: trying to Reparse().");
+            break;
+         }
+      }
+
+      edi[itb] = static_cast <u8_t> (chr);
+
+      if (itb == offsetof(edid_t, num_extblk)) {
+         /*don't read extensions if they are not claimed,
+           otherwise read until end of the buffer or file */
+         if (chr == 0) len = (itc+1);
+      }
+      if (itb > sizeof(edi_buf_t)) break;
+      itb++ ;
+   }
+
+   delete [] buff8;
+
+   return retU;
+}
+
+rcode edid_parser_thr_cl::chksum_blk(u32_t block) {
+   rcode retU;
+
+   tlog.slog.Printf("EDID block %u checksum= 0x%02X", block,
+                    EDID.getEDID()->blk[block][offsetof(edid_t, chksum)]);
+
+   if (EDID.VerifyChksum(block)) {
+      tlog.slog << " OK";
+      RCD_SET_OK(retU);
+   } else {
+      tlog.slog << " BAD!";
+      RCD_SET_FAULT(retU);
+   }
+   tlog.DoLog();
+   return retU;
+}
+
+rcode edid_parser_thr_cl::parse() {
+   rcode retU;
+   rcode retU2;
+   u32_t n_extblk = 0;
+
+   tlog.DoLog("Reparse()");
+
+   RCD_SET_OK(retU2);
+
+   post_stage(PSTAGE_CHKSUM);
+
+   retU = chksum_blk(EDI_BASE_IDX);
+   if (!RCD_IS_OK(retU)) {
+      if (! b_err_ignore) return retU;
+      tlog.PrintRcode(retU);
+      retU2 = retU;
+   }
+
+   if (TestDestroy()) goto cancel;
+   post_stage(PSTAGE_BASE);
+
+   retU = EDID.ParseEDID_Base(n_extblk);
+   if (!RCD_IS_OK(retU)) {
+      if (! b_err_ignore) return retU;
+      tlog.PrintRcode(retU);
+      retU2 = retU;
+   }
+
+   if (n_extblk > 0) {
+      if (TestDestroy()) goto cancel;
+      post_stage(PSTAGE_CEA);
+
+      retU = chksum_blk(EDI_EXT0_IDX);
+      if (!RCD_IS_OK(retU)) {
+         if (! b_err_ignore) return retU;
+         tlog.PrintRcode(retU);
+         retU2 = retU;
+      }
+
+      retU = EDID.ParseEDID_CEA();
+      if (!RCD_IS_OK(retU)) {
+         if (b_err_ignore) {
+            EDID.ForceNumValidBlocks(2);
+            tlog.PrintRcode(retU);
+            retU2 = retU;
+         } else
+         return retU;
+      }
+   }
+
+   b_parsed = true;
+
+   if (!RCD_IS_OK(retU2)) return retU2;
+   RCD_RETURN_OK(retU);
+
+cancel:
+   b_canceled = true;
+   RCD_RETURN_OK(retU);
+}
@@ -0,0 +1,75 @@
+/***************************************************************
+ * Name:      parse_thr.h
+ * Purpose:   EDID background parser thread
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-04
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef PARSE_THR_H
+#define PARSE_THR_H 1
+
+#include <wx/thread.h>
+#include <wx/event.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+#include "diag.h"
+
+enum { //parser job type
+   PJOB_OPEN_BIN   = 0,
+   PJOB_IMPORT_HEX = 1,
+   PJOB_REPARSE    = 2,
+   PJOB_LOAD_BUF   = 3  //data already in memory (corpus browser)
+};
+
+enum { //parser job stage: reported with wxEVT_THREAD, wxThreadEvent::GetInt()
+   PSTAGE_READ   = 0,
+   PSTAGE_CHKSUM = 1,
+   PSTAGE_BASE   = 2,
+   PSTAGE_CEA    = 3,
+   PSTAGE_DONE   = 4  //last event for the job: the thread can be joined
+};
+
+//File read, pre-validation and parsing are done on a private EDID_cl instance,
+//the frame takes over the results with EDID_cl::MoveFrom() on PSTAGE_DONE.
+//Progress events carry the job id (wxThreadEvent::GetExtraLong()), so events
+//from a canceled job can be identified and dropped.
+class edid_parser_thr_cl : public wxThread {
+   protected:
+      wxEvtHandler *evt_dst;
+      int           evt_id;
+      long          job_id;
+      u32_t         job_type;
+      bool          b_err_ignore;
+
+      guilog_cl     tlog; //no log window: messages from secondary threads are buffered by wxLog
+
+      ExitCode Entry();
+
+      void  post_stage(u32_t stage);
+      rcode read_bin();
+      rcode read_hex();
+      rcode chksum_blk(u32_t block);
+      rcode parse();
+
+   public:
+      EDID_cl   EDID;       //parsed data
+      diag_list_cl diag;    //faults ignored by the parser
+      wxString  fpath;
+      rcode     job_rcd;    //job result
+      bool      b_loaded;   //data loaded: buffer can be parsed again with errors ignored
+      bool      b_parsed;   //group arrays are complete: ready to be taken over
+      bool      b_canceled;
+
+      inline long  getJobID  () {return job_id;};
+      inline u32_t getJobType() {return job_type;};
+
+      edid_parser_thr_cl(wxEvtHandler *dst, int evtid, long id, u32_t type, EDID_cl& src, const u8_t *pbuf = NULL);
+      ~edid_parser_thr_cl();
+};
+
+#endif /* PARSE_THR_H */
@@ -0,0 +1,439 @@
+/***************************************************************
+ * Name:      patch.cpp
+ * Purpose:   Batch field patch: edits applied to all EDIDs in a directory
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-30
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idPATCH
+   #error "patch.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idPATCH
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "patch.h"
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+#include <string.h>
+#include <time.h>
+
+//patch_thr_cl
+wxThread::ExitCode patch_thr_cl::Entry() {
+   u32_t  idx;
+
+   for (;;) {
+      idx = __atomic_fetch_add(&engine->next_file, 1, __ATOMIC_RELAXED);
+      if (idx >= engine->nfiles) break;
+
+      engine->run_file(idx, this);
+   }
+   return 0;
+}
+
+//patch_engine_cl
+patch_engine_cl::patch_engine_cl() :
+   edits(NULL), nedits(0), b_rd_ignore(false), b_err_ignore(false),
+   nfiles(0), next_file(0), nthr(0)
+{
+   memset(thr_ar, 0, sizeof(thr_ar));
+}
+
+patch_engine_cl::~patch_engine_cl() {
+   for (u32_t itt=0; itt<nthr; itt++) {
+      if (thr_ar[itt] != NULL) delete thr_ar[itt];
+   }
+   if (edits != NULL) delete [] edits;
+}
+
+rcode patch_engine_cl::LoadPatch(const wxString& path) {
+   rcode     retU;
+   wxFile    file;
+   wxString  text;
+   wxString  line;
+   u32_t     nline = 0;
+
+   if (! file.Open(path, wxFile::read) ) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Can't open the patch file: %s", (const char*) path.ToUTF8());
+   }
+   if (! file.ReadAll(&text)) RCD_RETURN_FAULT(retU);
+   file.Close();
+
+   if (edits == NULL) edits = new patch_edit_cl[PATCH_MAX_EDITS];
+   if (edits == NULL) RCD_RETURN_FAULT(retU);
+   nedits = 0;
+
+   wxStringTokenizer tokenz(text, "\n", wxTOKEN_RET_EMPTY_ALL);
+
+   while (tokenz.HasMoreTokens()) {
+      line = tokenz.GetNextToken();
+      nline ++ ;
+
+      line.Trim(true).Trim(false);
+      if (line.IsEmpty()) continue;
+      if (line[0] == '#') continue;
+
+      if (nedits >= PATCH_MAX_EDITS) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Patch file: too many edits, max %u", (u32_t) PATCH_MAX_EDITS);
+      }
+
+      retU = parse_line(nline, line, edits[nedits]);
+      if (! RCD_IS_OK(retU)) return retU;
+      nedits ++ ;
+   }
+
+   if (nedits == 0) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Patch file: no edits: %s", (const char*) path.ToUTF8());
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+rcode patch_engine_cl::parse_line(u32_t line, const wxString& text, patch_edit_cl& edit) {
+   rcode          retU;
+   wxString       lhs;
+   wxString       fld;
+   wxString       elem;
+   wxString       code;
+   unsigned long  val;
+   int            eq;
+
+   eq = text.Find('=');
+   if (eq == wxNOT_FOUND) goto err;
+
+   lhs       = text.Left(eq);
+   edit.sval = text.Mid(eq +1);
+   edit.op   = OP_WRSTR;
+
+   //":=" integer value
+   if (lhs.EndsWith(":")) {
+      edit.op = OP_WRINT;
+      lhs.RemoveLast();
+   }
+   lhs.Trim(true).Trim(false);
+   edit.sval.Trim(true).Trim(false);
+
+   edit.path = lhs.BeforeFirst('.');
+   fld       = lhs.AfterFirst ('.');
+   edit.path.Trim(true);
+   fld.Trim(false);
+   if (edit.path.IsEmpty() || fld.IsEmpty()) goto err;
+
+   edit.fname = fld.ToAscii();
+
+   if (edit.op == OP_WRINT) {
+      if (! edit.sval.ToULong(&val, 0)) goto err;
+      if (val > 0xFFFFFFFFUL) goto err;
+      edit.ival = val;
+   }
+
+   {
+      wxStringTokenizer tokenz(edit.path, "/");
+
+      edit.depth = 0;
+      while (tokenz.HasMoreTokens()) {
+         if (edit.depth >= PATCH_MAX_DEPTH) goto err;
+
+         elem = tokenz.GetNextToken();
+         code = elem.BeforeFirst('[');
+         val  = 0;
+
+         if (elem.Find('[') != wxNOT_FOUND) {
+            if (! elem.EndsWith("]")) goto err;
+            if (! elem.AfterFirst('[').BeforeLast(']').ToULong(&val)) goto err;
+         }
+         if (code.IsEmpty() || (code.Len() >= PATCH_CODN_LEN)) goto err;
+
+         strcpy(edit.codn[edit.depth], code.ToAscii());
+         edit.gidx[edit.depth] = val;
+         edit.depth ++ ;
+      }
+      if (edit.depth == 0) goto err;
+   }
+
+   edit.fld_idx = -1;
+   RCD_RETURN_OK(retU);
+
+err:
+   wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Patch file, line %u: expected GRP[n][/SUB[m]].field = value", line);
+}
+
+edi_grp_cl* patch_engine_cl::find_group(EDID_cl& EDID, const patch_edit_cl& edit) {
+   GroupAr_cl  *p_grp_ar;
+   edi_grp_cl  *pgrp = NULL;
+   u32_t        cnt  = 0;
+
+   //n-th group with the code name, in all parsed blocks
+   for (u32_t itb=0; (itb<EDID.getNumValidBlocks()) && (pgrp == NULL); itb++) {
+      p_grp_ar = EDID.BlkGroupsAr[itb];
+
+      for (u32_t itg=0; itg<p_grp_ar->GetCount(); itg++) {
+         edi_grp_cl *ptmp = p_grp_ar->Item(itg);
+
+         if (ptmp->CodeName != edit.codn[0]) continue;
+         if (cnt == edit.gidx[0]) {
+            pgrp = ptmp;
+            break;
+         }
+         cnt ++ ;
+      }
+   }
+   if ((pgrp == NULL) || (edit.depth < 2)) return pgrp;
+
+   //sub-group: n-th with the code name in the parent group
+   cnt = 0;
+   for (u32_t its=0; its<pgrp->getSubGrpCount(); its++) {
+      edi_grp_cl *psub = pgrp->getSubGroup(its);
+
+      if (psub->CodeName != edit.codn[1]) continue;
+      if (cnt == edit.gidx[1]) return psub;
+      cnt ++ ;
+   }
+   return NULL;
+}
+
+rcode patch_engine_cl::prepare(u32_t ) {
+   rcode  retU;
+
+   if ((edits == NULL) || (nedits == 0)) RCD_RETURN_FAULT(retU);
+   RCD_RETURN_OK(retU);
+}
+
+bool patch_engine_cl::apply(patch_thr_cl *thr, wxString& emsg) {
+   rcode          retU;
+   EDID_cl&       EDID = thr->EDID;
+   edi_grp_cl    *pgrp;
+   edi_dynfld_t  *p_fld;
+   wxString       sval;
+   u32_t          ival;
+   u32_t          nfld;
+   i32_t          idx;
+
+   for (u32_t ite=0; ite<nedits; ite++) {
+      patch_edit_cl& edit = edits[ite];
+
+      pgrp = find_group(EDID, edit);
+      if (pgrp == NULL) {
+         emsg.Printf("%s: group not found", edit.path);
+         return false;
+      }
+
+      //the field index is resolved once, then only verified: the dynamic layouts can differ
+      nfld = pgrp->FieldsAr.GetCount();
+      idx  = __atomic_load_n(&edit.fld_idx, __ATOMIC_RELAXED);
+
+      if ((idx < 0) || (idx >= (i32_t) nfld) ||
+          (strcmp(pgrp->FieldsAr.Item(idx)->field.name, edit.fname.data()) != 0) ) {
+
+         for (idx=0; idx<(i32_t) nfld; idx++) {
+            if (strcmp(pgrp->FieldsAr.Item(idx)->field.name, edit.fname.data()) == 0) break;
+         }
+         if (idx >= (i32_t) nfld) {
+            emsg.Printf("%s: field '%s' not found", edit.path, edit.fname.data());
+            return false;
+         }
+         __atomic_store_n(&edit.fld_idx, idx, __ATOMIC_RELAXED);
+      }
+
+      p_fld = pgrp->FieldsAr.Item(idx);
+
+      if (((p_fld->field.flags & EF_RD) != 0) && ! b_rd_ignore) {
+         emsg.Printf("%s.%s: read-only field", edit.path, edit.fname.data());
+         return false;
+      }
+      //group layout changes: not supported
+      if ( ((p_fld->field.flags & EF_INIT) != 0) ||
+           (p_fld->field.handlerfn == &EDID_cl::CEA_DBC_Tag  ) ||
+           (p_fld->field.handlerfn == &EDID_cl::CEA_DBC_ExTag) ||
+           (p_fld->field.handlerfn == &EDID_cl::CEA_DBC_Len  ) ) {
+         emsg.Printf("%s.%s: field changes the group layout", edit.path, edit.fname.data());
+         return false;
+      }
+
+      sval = edit.sval;
+      ival = edit.ival;
+
+      retU = (EDID.*p_fld->field.handlerfn)(edit.op, sval, ival, p_fld);
+      if (! RCD_IS_OK(retU)) {
+         emsg.Printf("%s.%s: invalid value '%s'", edit.path, edit.fname.data(), edit.sval);
+         return false;
+      }
+
+      //EF_FGR: re-parse group data
+      if ((p_fld->field.flags & EF_FGR) != 0) {
+         retU = pgrp->ForcedGroupRefresh();
+         if (! RCD_IS_OK(retU)) {
+            emsg.Printf("%s.%s: group refresh failed", edit.path, edit.fname.data());
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+void patch_engine_cl::run_file(u32_t idx, patch_thr_cl *thr) {
+   rcode       retU;
+   EDID_cl&    EDID = thr->EDID;
+   wxFile      file;
+   wxFileName  fn;
+   wxString    emsg;
+   wxString    dpath;
+   ssize_t     len;
+   u32_t       n_extblk = 0;
+
+   EDID.Clear();
+
+   if (! file.Open(fnames[idx], wxFile::read)) {
+      emsg = "can't open the file";
+      goto out;
+   }
+   //the blocks past sizeof(edi_t) would be lost on write-back
+   if (file.Length() > (wxFileOffset) sizeof(edi_t)) {
+      emsg.Printf("file too long: %lld bytes, max %u", (long long) file.Length(), (u32_t) sizeof(edi_t));
+      file.Close();
+      goto out;
+   }
+   len = file.Read(EDID.getEDID()->buff, sizeof(edi_t));
+   file.Close();
+
+   if ((len < EDI_BLK_SIZE) || ((len % EDI_BLK_SIZE) != 0)) {
+      emsg.Printf("invalid file size: %d", (int) len);
+      goto out;
+   }
+
+   EDID.Set_ERR_Ignore(b_err_ignore);
+
+   retU = EDID.ParseEDID_Base(n_extblk);
+   if (RCD_IS_OK(retU) && (n_extblk > 0) && (len >= (2 * EDI_BLK_SIZE))) {
+      retU = EDID.ParseEDID_CEA();
+   }
+   if (! RCD_IS_OK(retU)) {
+      thr->tlog.RcodeToString(retU, emsg);
+      emsg.Prepend("parser error: ");
+      goto out;
+   }
+
+   if (! apply(thr, emsg)) goto out;
+
+   retU = EDID.AssembleEDID();
+   if (! RCD_IS_OK(retU)) {
+      thr->tlog.RcodeToString(retU, emsg);
+      emsg.Prepend("assembly error: ");
+      goto out;
+   }
+   for (u32_t itb=0; itb<EDID.getNumValidBlocks(); itb++) {
+      EDID.genChksum(itb);
+   }
+
+   //same relative path in the output dir
+   fn.Assign(fnames[idx]);
+   fn.MakeRelativeTo(src_dir);
+   dpath = dst_dir + wxFILE_SEP_PATH + fn.GetFullPath();
+   fn.Assign(dpath);
+
+   if (! wxDirExists(fn.GetPath())) {
+      //another worker can create the dir at the same time
+      if (! wxFileName::Mkdir(fn.GetPath(), 0755, wxPATH_MKDIR_FULL) && ! wxDirExists(fn.GetPath())) {
+         emsg = "can't create the output directory";
+         goto out;
+      }
+   }
+   if (! file.Create(dpath, true) || (file.Write(EDID.getEDID()->buff, len) != (size_t) len)) {
+      emsg.Printf("can't write: %s", dpath);
+      goto out;
+   }
+   file.Close();
+
+out:
+   release(thr);
+   EDID.DeleteGroups();
+   fstatus[idx] = emsg;
+}
+
+rcode patch_engine_cl::Run(const wxString& dir, const wxString& outdir, u32_t threads, FILE *out) {
+   rcode            retU;
+   u32_t            nrun;
+   u32_t            nfail = 0;
+   struct timespec  ts0;
+   struct timespec  ts1;
+   double           secs;
+
+   if (nthr != 0) RCD_RETURN_FAULT(retU); //single use
+
+   if (! wxDir::Exists(dir)) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Directory not found: '%s'",
+                                   (const char*) dir.ToUTF8());
+   }
+   if (outdir.IsEmpty()) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Batch patch: output directory (-o) not specified");
+   }
+
+   src_dir = dir;
+   dst_dir = outdir;
+
+   wxDir::GetAllFiles(dir, &fnames, "*.bin");
+   fnames.Sort();
+   nfiles = fnames.GetCount();
+   fstatus.Add(wxEmptyString, nfiles);
+
+   if (nfiles == 0) RCD_RETURN_OK(retU);
+
+   if (! wxDirExists(outdir)) {
+      if (! wxFileName::Mkdir(outdir, 0755, wxPATH_MKDIR_FULL)) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Can't create the output directory: %s", (const char*) outdir.ToUTF8());
+      }
+   }
+
+   if (threads == 0) threads = wxThread::GetCPUCount();
+   if (threads <  1) threads = 1;
+   if (threads > PATCH_MAX_THR) threads = PATCH_MAX_THR;
+   if (threads > nfiles) threads = nfiles;
+
+   retU = prepare(threads);
+   if (! RCD_IS_OK(retU)) return retU;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts0);
+
+   for (nthr=0; nthr<threads; nthr++) {
+      thr_ar[nthr] = new patch_thr_cl(this, nthr);
+      if (thr_ar[nthr] == NULL) break;
+   }
+   for (nrun=0; nrun<nthr; nrun++) {
+      if (thr_ar[nrun]->Run() != wxTHREAD_NO_ERROR) break;
+   }
+   if (nrun == 0) RCD_RETURN_FAULT(retU);
+
+   for (u32_t itt=0; itt<nrun; itt++) {
+      thr_ar[itt]->Wait();
+   }
+
+   clock_gettime(CLOCK_MONOTONIC, &ts1);
+   secs  = (ts1.tv_sec - ts0.tv_sec);
+   secs += (ts1.tv_nsec - ts0.tv_nsec) / 1e9;
+
+   //per-file report, in input order
+   for (u32_t itf=0; itf<nfiles; itf++) {
+      if (fstatus[itf].IsEmpty()) continue;
+
+      fprintf(out, "FAIL %s: %s\n", (const char*) fnames[itf].ToUTF8(), (const char*) fstatus[itf].ToUTF8());
+      nfail ++ ;
+   }
+   fflush(out);
+
+   fprintf(stderr, "%u file(s): %u patched, %u failed, %u thread(s), %.3f s\n",
+           nfiles, (nfiles - nfail), nfail, nrun, secs);
+
+   if (nfail > 0) RCD_RETURN_FAULT(retU);
+   RCD_RETURN_OK(retU);
+}
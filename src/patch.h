@@ -0,0 +1,105 @@
+/***************************************************************
+ * Name:      patch.h
+ * Purpose:   Batch field patch: edits applied to all EDIDs in a directory
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-30
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef PATCH_H
+#define PATCH_H 1
+
+#include <wx/thread.h>
+#include <wx/arrstr.h>
+#include <stdio.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+
+enum {
+   PATCH_MAX_EDITS = 64,
+   PATCH_MAX_DEPTH = 2,  //group path: group[/sub-group]
+   PATCH_CODN_LEN  = 16,
+   PATCH_MAX_THR   = 64
+};
+
+//Single edit: "GRP[n][/SUB[m]].field name = value" -> OP_WRSTR,
+//             "GRP[n][/SUB[m]].field name := value" -> OP_WRINT
+class patch_edit_cl {
+   public:
+      wxString      path;      //group path, for messages
+      u32_t         depth;
+      char          codn[PATCH_MAX_DEPTH][PATCH_CODN_LEN];
+      u32_t         gidx[PATCH_MAX_DEPTH]; //n-th group with the code name
+      wxCharBuffer  fname;     //field name
+      wxString      sval;
+      u32_t         ival;
+      u32_t         op;        //OP_WRSTR | OP_WRINT
+      i32_t         fld_idx;   //resolved index in FieldsAr: atomic, -1: not resolved yet
+
+      patch_edit_cl() : depth(0), ival(0), op(OP_WRSTR), fld_idx(-1) {};
+};
+
+class patch_engine_cl;
+
+class patch_thr_cl : public wxThread {
+   protected:
+      patch_engine_cl *engine;
+
+      ExitCode Entry();
+
+   public:
+      u32_t      wid;
+      EDID_cl    EDID;
+      guilog_cl  tlog;
+
+      patch_thr_cl(patch_engine_cl *eng, u32_t id) : wxThread(wxTHREAD_JOINABLE), engine(eng), wid(id) {
+         EDID.SetGuiLogPtr(&tlog);
+      };
+};
+
+class patch_engine_cl {
+   friend class patch_thr_cl;
+
+   protected:
+      patch_edit_cl *edits;
+      u32_t          nedits;
+      bool           b_rd_ignore;  //-w: EF_RD fields are writeable
+      bool           b_err_ignore; //-e: parser errors
+
+      wxString       src_dir;
+      wxString       dst_dir;
+      wxArrayString  fnames;
+      wxArrayString  fstatus;      //per file: empty == OK, error message otherwise
+      u32_t          nfiles;
+      u32_t          next_file;    //atomic
+
+      patch_thr_cl  *thr_ar[PATCH_MAX_THR];
+      u32_t          nthr;
+
+      rcode  parse_line   (u32_t line, const wxString& text, patch_edit_cl& edit);
+      void   run_file     (u32_t idx, patch_thr_cl *thr);
+
+      static edi_grp_cl* find_group(EDID_cl& EDID, const patch_edit_cl& edit);
+
+      //called once before the workers are started
+      virtual rcode prepare(u32_t threads);
+      //the file edit: called from the worker threads, thr->EDID is parsed on entry, assembled on exit.
+      virtual bool  apply  (patch_thr_cl *thr, wxString& emsg);
+      //called before the groups are deleted, also if apply() failed
+      virtual void  release(patch_thr_cl *) {return;};
+
+   public:
+      rcode  LoadPatch(const wxString& path);
+      rcode  Run      (const wxString& dir, const wxString& outdir, u32_t threads, FILE *out);
+
+      inline void  SetFlags(bool rd_ignore, bool err_ignore) {b_rd_ignore = rd_ignore; b_err_ignore = err_ignore;};
+
+      patch_engine_cl();
+      virtual ~patch_engine_cl();
+};
+
+#endif /* PATCH_H */
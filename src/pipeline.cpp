@@ -0,0 +1,601 @@
+/***************************************************************
+ * Name:      pipeline.cpp
+ * Purpose:   Batch EDID decoder: staged, work-stealing pipeline
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-25
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idPIPELINE
+   #error "pipeline.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idPIPELINE
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "pipeline.h"
+
+#include <wx/dir.h>
+#include <string.h>
+#include <time.h>
+
+static const char *ppl_stage_name[PPL_NSTAGE] = {
+   "read",
+   "preval",
+   "parse",
+   "analyse",
+   "emit"
+};
+
+static const char *ppl_rule_name[PPL_R_COUNT] = {
+   "size",
+   "header",
+   "checksum",
+   "version",
+   "ext_block",
+   "parse",
+   "no_dtd",
+   "no_name",
+   "no_range"
+};
+
+static const u8_t edid_hdr[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+
+static inline u64_t ppl_time_ns() {
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((u64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+//ppl_worker_cl
+ppl_worker_cl::ppl_worker_cl(ppl_engine_cl *eng, u32_t id, u32_t dqsize) :
+   wxThread(wxTHREAD_JOINABLE),
+   engine(eng), wid(id), dq_head(0), dq_tail(0), steals(0)
+{
+   u32_t size = 1;
+   //power of 2: indexes are masked
+   while (size < dqsize) size <<= 1;
+
+   dq_ring = new ppl_item_cl*[size];
+   dq_mask = (dq_ring != NULL) ? (size -1) : 0;
+
+   memset(stat, 0, sizeof(stat));
+
+   //io_uring if available, otherwise pread(): the pipeline workers are the thread pool
+   reader.Init(0);
+}
+
+ppl_worker_cl::~ppl_worker_cl() {
+   if (dq_ring != NULL) delete [] dq_ring;
+}
+
+bool ppl_worker_cl::push(ppl_item_cl *item) {
+   wxMutexLocker lock(dq_mtx);
+
+   if ((dq_tail - dq_head) > dq_mask) return false;
+
+   dq_ring[dq_tail & dq_mask] = item;
+   dq_tail ++ ;
+   return true;
+}
+
+ppl_item_cl* ppl_worker_cl::pop() {
+   wxMutexLocker lock(dq_mtx);
+
+   if (dq_tail == dq_head) return NULL;
+
+   dq_tail -- ;
+   return dq_ring[dq_tail & dq_mask];
+}
+
+ppl_item_cl* ppl_worker_cl::steal() {
+   wxMutexLocker  lock(dq_mtx);
+   ppl_item_cl   *item;
+
+   if (dq_tail == dq_head) return NULL;
+
+   item = dq_ring[dq_head & dq_mask];
+   dq_head ++ ;
+   return item;
+}
+
+wxThread::ExitCode ppl_worker_cl::Entry() {
+   ppl_item_cl *item;
+   u32_t        gen;
+
+   for (;;) {
+      gen  = engine->get_gen();
+      item = pop();
+
+      if (item == NULL) {
+         for (u32_t itv=1; itv<engine->nthr; itv++) {
+            item = engine->thr_ar[(wid + itv) % engine->nthr]->steal();
+            if (item != NULL) {
+               steals ++ ;
+               break;
+            }
+         }
+      }
+      if (item != NULL) {
+         run_item(item, true);
+         continue;
+      }
+      //pending work first: new files are read only by otherwise idle workers
+      if (read_batch()) continue;
+
+      if (__atomic_load_n(&engine->b_done, __ATOMIC_ACQUIRE)) break;
+      engine->wait_work(gen);
+   }
+   return 0;
+}
+
+bool ppl_worker_cl::read_batch() {
+   ppl_item_cl   *item;
+   ppl_item_cl   *batch[PPL_RD_BATCH];
+   bulk_rd_req_t  reqs [PPL_RD_BATCH];
+   u64_t          t_start;
+   u32_t          nitems;
+   u32_t          occ;
+
+   //each admitted file holds a slot in the read queue
+   for (nitems=0; nitems<PPL_RD_BATCH; nitems++) {
+      item = engine->admit();
+      if (item == NULL) break;
+
+      batch  [nitems] = item;
+      rd_path[nitems] = engine->fnames[item->seq].fn_str();
+
+      reqs[nitems].fpath = rd_path[nitems].data();
+      reqs[nitems].buf   = rd_buf[nitems];
+      reqs[nitems].bsz   = sizeof(rd_buf[nitems]);
+      reqs[nitems].len   = 0;
+   }
+   if (nitems == 0) return false;
+
+   t_start = ppl_time_ns();
+   reader.Read(reqs, nitems);
+
+   for (u32_t iti=0; iti<nitems; iti++) {
+      engine->stg_read(batch[iti], rd_buf[iti], reqs[iti].len);
+      engine->release(PPL_STG_READ);
+   }
+   stat[PPL_STG_READ].time_ns += (ppl_time_ns() - t_start);
+   stat[PPL_STG_READ].nitems  += nitems;
+
+   //hand over the batch: idle workers steal from the front of the deque
+   for (u32_t iti=0; iti<nitems; iti++) {
+      item = batch[iti];
+      item->stage = PPL_STG_PREVAL;
+
+      occ = engine->reserve(PPL_STG_PREVAL);
+      if ((occ > 0) && push(item)) {
+         if (occ > stat[PPL_STG_PREVAL].max_occ) stat[PPL_STG_PREVAL].max_occ = occ;
+         engine->notify();
+         continue;
+      }
+      if (occ > 0) engine->release(PPL_STG_PREVAL);
+
+      stat[PPL_STG_PREVAL].stalls ++ ;
+      run_item(item, false);
+   }
+   return true;
+}
+
+void ppl_worker_cl::run_item(ppl_item_cl *item, bool b_occ) {
+   u64_t  t_start;
+   u32_t  stage;
+   u32_t  occ;
+
+   //b_occ: item holds a queue slot
+   for (;;) {
+      stage   = item->stage;
+      t_start = ppl_time_ns();
+
+      switch (stage) {
+         case PPL_STG_PREVAL:
+            engine->stg_preval(item);
+            break;
+         case PPL_STG_PARSE:
+            engine->stg_parse(item, this);
+            break;
+         case PPL_STG_ANALYSE:
+            engine->stg_analyse(item);
+            break;
+         default:
+            engine->stg_emit(item);
+            break;
+      }
+
+      stat[stage].time_ns += (ppl_time_ns() - t_start);
+      stat[stage].nitems  ++ ;
+
+      if (b_occ) engine->release(stage);
+      //emitted or waiting for output: the item can't be touched anymore
+      if (stage == PPL_STG_EMIT) return;
+
+      stage ++ ;
+      item->stage = stage;
+
+      occ = engine->reserve(stage);
+      if (occ == 0) {
+         //back-pressure: queue full, process the item inline
+         stat[stage].stalls ++ ;
+         b_occ = false;
+         continue;
+      }
+      if (occ > stat[stage].max_occ) stat[stage].max_occ = occ;
+
+      if (! push(item)) {
+         //never happens: deque size >= window
+         engine->release(stage);
+         b_occ = false;
+         continue;
+      }
+      engine->notify();
+      return;
+   }
+}
+
+//ppl_engine_cl
+ppl_engine_cl::ppl_engine_cl() :
+   nfiles(0), fout(NULL), nthr(0), qdepth(PPL_DEF_QDEPTH), window(0), items(NULL),
+   next_seq(0), emit_next(0), idle_cond(idle_mtx), work_gen(0), nidle(0), b_done(false),
+   window_waits(0)
+{
+   memset(thr_ar   , 0, sizeof(thr_ar   ));
+   memset(occ      , 0, sizeof(occ      ));
+   memset(rules_cnt, 0, sizeof(rules_cnt));
+}
+
+ppl_engine_cl::~ppl_engine_cl() {
+   for (u32_t itt=0; itt<nthr; itt++) {
+      if (thr_ar[itt] != NULL) delete thr_ar[itt];
+   }
+   if (items != NULL) delete [] items;
+}
+
+rcode ppl_engine_cl::Run(const wxString& dir, FILE *out, u32_t threads, u32_t depth) {
+   rcode  retU;
+   u32_t  nrun;
+
+   if (items != NULL) RCD_RETURN_FAULT(retU); //single use
+
+   if (! wxDir::Exists(dir)) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Directory not found: '%s'",
+                                   (const char*) dir.ToUTF8());
+   }
+
+   //sorted input: the output order doesn't depend on the thread count
+   wxDir::GetAllFiles(dir, &fnames, "*.bin");
+   fnames.Sort();
+
+   nfiles = fnames.GetCount();
+   fout   = out;
+
+   if (nfiles == 0) RCD_RETURN_OK(retU);
+
+   if (threads == 0) threads = wxThread::GetCPUCount();
+   if (threads <  1) threads = 1;
+   if (threads > PPL_MAX_THR) threads = PPL_MAX_THR;
+
+   if (depth != 0) qdepth = depth;
+   window = (qdepth * PPL_NSTAGE);
+
+   items = new ppl_item_cl[window];
+   if (items == NULL) RCD_RETURN_FAULT(retU);
+
+   for (u32_t iti=0; iti<window; iti++) {
+      //the rules are evaluated on partially valid data
+      items[iti].EDID.Set_ERR_Ignore(true);
+   }
+
+   for (nthr=0; nthr<threads; nthr++) {
+      thr_ar[nthr] = new ppl_worker_cl(this, nthr, window);
+      if (thr_ar[nthr] == NULL) RCD_RETURN_FAULT(retU);
+   }
+
+   for (nrun=0; nrun<nthr; nrun++) {
+      if (thr_ar[nrun]->Run() != wxTHREAD_NO_ERROR) break;
+   }
+   if (nrun < nthr) {
+      //stop the running workers
+      __atomic_store_n(&b_done, true, __ATOMIC_RELEASE);
+      notify();
+      RCD_SET_FAULT(retU);
+   } else {
+      RCD_SET_OK(retU);
+   }
+
+   for (u32_t itt=0; itt<nrun; itt++) {
+      thr_ar[itt]->Wait();
+   }
+
+   fflush(fout);
+   return retU;
+}
+
+ppl_item_cl* ppl_engine_cl::admit() {
+   ppl_item_cl *item;
+   u32_t        seq;
+
+   if (0 == reserve(PPL_STG_READ)) return NULL;
+
+   seq = __atomic_load_n(&next_seq, __ATOMIC_RELAXED);
+   for (;;) {
+      if (seq >= nfiles) goto none;
+      //slot (seq % window) is free when the file (seq - window) was written
+      if (seq >= (__atomic_load_n(&emit_next, __ATOMIC_ACQUIRE) + window)) {
+         __atomic_add_fetch(&window_waits, 1, __ATOMIC_RELAXED);
+         goto none;
+      }
+      if (__atomic_compare_exchange_n(&next_seq, &seq, seq +1, false,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) break;
+   }
+
+   item = &items[seq % window];
+
+   item->seq      = seq;
+   item->stage    = PPL_STG_READ;
+   item->datsz    = 0;
+   item->rules    = 0;
+   item->n_extblk = 0;
+   memset(&item->row, 0, sizeof(corpus_row_t));
+
+   return item;
+
+none:
+   release(PPL_STG_READ);
+   return NULL;
+}
+
+u32_t ppl_engine_cl::reserve(u32_t stage) {
+   u32_t nocc;
+
+   nocc = __atomic_add_fetch(&occ[stage], 1, __ATOMIC_RELAXED);
+   if (nocc > qdepth) {
+      __atomic_sub_fetch(&occ[stage], 1, __ATOMIC_RELAXED);
+      return 0;
+   }
+   return nocc;
+}
+
+u32_t ppl_engine_cl::get_gen() {
+   return __atomic_load_n(&work_gen, __ATOMIC_SEQ_CST);
+}
+
+void ppl_engine_cl::notify() {
+   __atomic_add_fetch(&work_gen, 1, __ATOMIC_SEQ_CST);
+
+   if (0 == __atomic_load_n(&nidle, __ATOMIC_SEQ_CST)) return;
+
+   wxMutexLocker lock(idle_mtx);
+   idle_cond.Broadcast();
+}
+
+void ppl_engine_cl::wait_work(u32_t gen) {
+   wxMutexLocker lock(idle_mtx);
+
+   __atomic_add_fetch(&nidle, 1, __ATOMIC_SEQ_CST);
+
+   while ((gen == get_gen()) && (! __atomic_load_n(&b_done, __ATOMIC_ACQUIRE))) {
+      idle_cond.Wait();
+   }
+
+   __atomic_sub_fetch(&nidle, 1, __ATOMIC_SEQ_CST);
+}
+
+void ppl_engine_cl::stg_read(ppl_item_cl *item, const u8_t *pbuf, i32_t len) {
+   u8_t *pedi;
+
+   pedi = item->EDID.getEDID()->buff;
+   memset(pedi, 0, sizeof(edi_buf_t));
+
+   //read error
+   if (len < 0) {
+      item->rules |= PPL_R_SIZE;
+      return;
+   }
+   //file longer than the EDID buffer: the extra byte was read
+   if ((u32_t) len > sizeof(edi_buf_t)) {
+      item->rules |= PPL_R_SIZE;
+      len = sizeof(edi_buf_t);
+   }
+
+   memcpy(pedi, pbuf, len);
+   item->datsz = len;
+}
+
+void ppl_engine_cl::stg_preval(ppl_item_cl *item) {
+   edi_buf_t *pedi;
+   u32_t      nblk;
+
+   pedi = item->EDID.getEDID();
+
+   if ((item->datsz < EDI_BLK_SIZE) || ((item->datsz % EDI_BLK_SIZE) != 0)) {
+      item->rules |= PPL_R_SIZE;
+      if (item->datsz < EDI_BLK_SIZE) return;
+   }
+   if (0 != memcmp(pedi->buff, edid_hdr, sizeof(edid_hdr))) {
+      item->rules |= PPL_R_HDR;
+      return;
+   }
+   if (pedi->edi.base.edid_ver != 1) item->rules |= PPL_R_VER;
+
+   item->n_extblk = pedi->edi.base.num_extblk;
+
+   nblk = (item->datsz / EDI_BLK_SIZE);
+   if (nblk < (item->n_extblk +1)) item->rules |= PPL_R_NEXT;
+   //only the base & first extension are parsed
+   if (nblk > 2) nblk = 2;
+
+   for (u32_t itb=0; itb<nblk; itb++) {
+      if (! item->EDID.VerifyChksum(itb)) item->rules |= PPL_R_CSUM;
+   }
+}
+
+void ppl_engine_cl::stg_parse(ppl_item_cl *item, ppl_worker_cl *wrk) {
+   rcode  retU;
+   u32_t  n_extblk = 0;
+
+   //no EDID data: nothing to parse
+   if (item->datsz < EDI_BLK_SIZE   ) return;
+   if (0 != (item->rules & PPL_R_HDR)) return;
+
+   item->EDID.SetGuiLogPtr(&wrk->tlog);
+
+   retU = item->EDID.ParseEDID_Base(n_extblk);
+   if (! RCD_IS_OK(retU)) item->rules |= PPL_R_PARSE;
+
+   if ((n_extblk > 0) && (item->datsz >= (2 * EDI_BLK_SIZE))) {
+      retU = item->EDID.ParseEDID_CEA();
+      if (! RCD_IS_OK(retU)) item->rules |= PPL_R_PARSE;
+   }
+}
+
+void ppl_engine_cl::stg_analyse(ppl_item_cl *item) {
+   GroupAr_cl *p_grp_ar;
+   u32_t       tid;
+   u32_t       found = 0;
+
+   p_grp_ar = &item->EDID.EDI_BaseGrpAr;
+
+   if (p_grp_ar->GetCount() > 0) {
+      corpus_cl::GetRowInfo(item->EDID, item->row);
+
+      for (u32_t itg=0; itg<p_grp_ar->GetCount(); itg++) {
+         tid = p_grp_ar->Item(itg)->getTypeID() & ID_EDID_MASK;
+
+         switch (tid) {
+            case ID_DTD:
+               found |= PPL_R_DTD;
+               break;
+            case ID_MND:
+               found |= PPL_R_MND;
+               break;
+            case ID_MRL:
+               found |= PPL_R_MRL;
+               break;
+            default:
+               break;
+         }
+      }
+      item->rules |= ((PPL_R_DTD|PPL_R_MND|PPL_R_MRL) & ~found);
+   }
+   //the groups are not needed for the output
+   item->EDID.DeleteGroups();
+
+   for (u32_t itr=0; itr<PPL_R_COUNT; itr++) {
+      if (0 == (item->rules & (1 << itr))) continue;
+      __atomic_add_fetch(&rules_cnt[itr], 1, __ATOMIC_RELAXED);
+   }
+}
+
+void ppl_engine_cl::stg_emit(ppl_item_cl *item) {
+   wxMutexLocker  lock(emit_mtx);
+   ppl_item_cl   *pitem;
+   u32_t          next;
+
+   //reorder: the items are written in the input order
+   item->b_ready = true;
+
+   next = emit_next;
+   while (next < nfiles) {
+      pitem = &items[next % window];
+      if (! pitem->b_ready) break;
+
+      write_item(pitem);
+
+      pitem->b_ready = false;
+      pitem->stage   = PPL_STG_FREE;
+      next ++ ;
+   }
+   if (next == emit_next) return;
+
+   __atomic_store_n(&emit_next, next, __ATOMIC_RELEASE);
+
+   if (next >= nfiles) __atomic_store_n(&b_done, true, __ATOMIC_RELEASE);
+   //free slots: new files can be admitted
+   notify();
+}
+
+void ppl_engine_cl::write_item(ppl_item_cl *item) {
+   corpus_row_t *prow;
+   char          status[128];
+   u32_t         len = 0;
+
+   prow = &item->row;
+
+   if (item->rules == 0) {
+      strcpy(status, "OK");
+   } else {
+      status[0] = 0;
+      for (u32_t itr=0; itr<PPL_R_COUNT; itr++) {
+         if (0 == (item->rules & (1 << itr))) continue;
+         len += snprintf(status + len, sizeof(status) - len, "%s%s",
+                         (len > 0) ? "," : "", ppl_rule_name[itr]);
+      }
+   }
+
+   fprintf(fout, "%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+           (const char*) fnames[item->seq].ToUTF8(),
+           prow->mfc, corpus_cl::GetVendor(*prow), prow->prod, prow->name, prow->mode, status);
+}
+
+void ppl_engine_cl::PrintStats(FILE *out, double secs) {
+   ppl_stat_t  stat;
+   u64_t       steals = 0;
+   u64_t       nitems;
+
+   fprintf(out, "files: %u, threads: %u, queue depth: %u, time: %.3f s",
+           nfiles, nthr, qdepth, secs);
+   if (secs > 0.0) fprintf(out, ", %.0f files/s", nfiles / secs);
+   fprintf(out, "\n");
+
+   //read stage alone: the workers read in parallel, the stage time is summed over all of them
+   memset(&stat, 0, sizeof(stat));
+   for (u32_t itt=0; itt<nthr; itt++) stat.time_ns += thr_ar[itt]->stat[PPL_STG_READ].time_ns;
+   if ((nthr > 0) && (stat.time_ns > 0)) {
+      fprintf(out, "reader: %s, read stage: %.0f files/s\n", thr_ar[0]->getReaderName(),
+              (nfiles * 1e9 * nthr) / stat.time_ns);
+   }
+
+   fprintf(out, "%-8s %10s %12s %10s %8s %10s\n",
+           "stage", "items", "time[ms]", "avg[us]", "max_occ", "stalls");
+
+   for (u32_t its=0; its<PPL_NSTAGE; its++) {
+      memset(&stat, 0, sizeof(stat));
+
+      for (u32_t itt=0; itt<nthr; itt++) {
+         ppl_stat_t *pstat = &thr_ar[itt]->stat[its];
+
+         stat.nitems  += pstat->nitems;
+         stat.time_ns += pstat->time_ns;
+         stat.stalls  += pstat->stalls;
+         if (pstat->max_occ > stat.max_occ) stat.max_occ = pstat->max_occ;
+      }
+      nitems = (stat.nitems > 0) ? stat.nitems : 1;
+
+      fprintf(out, "%-8s %10llu %12.1f %10.2f %8u %10llu\n",
+              ppl_stage_name[its], (unsigned long long) stat.nitems,
+              stat.time_ns / 1e6, (stat.time_ns / 1e3) / nitems,
+              stat.max_occ, (unsigned long long) stat.stalls);
+   }
+
+   for (u32_t itt=0; itt<nthr; itt++) steals += thr_ar[itt]->steals;
+
+   fprintf(out, "steals: %llu, window waits: %llu\n",
+           (unsigned long long) steals, (unsigned long long) window_waits);
+
+   fprintf(out, "rules:");
+   for (u32_t itr=0; itr<PPL_R_COUNT; itr++) {
+      fprintf(out, " %s=%llu", ppl_rule_name[itr], (unsigned long long) rules_cnt[itr]);
+   }
+   fprintf(out, "\n");
+}
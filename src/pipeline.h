@@ -0,0 +1,169 @@
+/***************************************************************
+ * Name:      pipeline.h
+ * Purpose:   Batch EDID decoder: staged, work-stealing pipeline
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-06-25
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H 1
+
+#include <wx/thread.h>
+#include <wx/arrstr.h>
+#include <stdio.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+#include "corpus.h"
+#include "bulk_rd.h"
+
+enum { //pipeline stages
+   PPL_STG_READ    = 0,
+   PPL_STG_PREVAL  = 1, //header & checksum pre-validation
+   PPL_STG_PARSE   = 2, //ParseEDID_Base(), ParseEDID_CEA()
+   PPL_STG_ANALYSE = 3, //rule evaluation, row info
+   PPL_STG_EMIT    = 4, //output in input order
+   PPL_NSTAGE      = 5,
+   PPL_STG_FREE    = PPL_NSTAGE //slot not used
+};
+
+enum {
+   PPL_MAX_THR    = 64,
+   PPL_DEF_QDEPTH = 64, //default queue depth for each stage
+   PPL_RD_BATCH   = 32  //max files read with a single bulk_reader_cl::Read()
+};
+
+enum { //rule flags: ppl_item_cl::rules
+   PPL_R_SIZE   = (1 << 0), //file too short or too long
+   PPL_R_HDR    = (1 << 1), //bad header pattern
+   PPL_R_CSUM   = (1 << 2), //bad checksum
+   PPL_R_VER    = (1 << 3), //EDID version != 1.x
+   PPL_R_NEXT   = (1 << 4), //missing extension block
+   PPL_R_PARSE  = (1 << 5), //parser errors
+   PPL_R_DTD    = (1 << 6), //no preferred timing
+   PPL_R_MND    = (1 << 7), //no monitor name
+   PPL_R_MRL    = (1 << 8), //no range limits
+   PPL_R_COUNT  = 9
+};
+
+//File being processed: the items are pre-allocated in a ring of
+//(window) slots, the slot of file (seq) is (seq % window).
+class ppl_item_cl {
+   public:
+      u32_t         seq;
+      u32_t         stage;    //next stage to run, PPL_STG_FREE: slot not used
+      u32_t         datsz;
+      u32_t         rules;    //failed rules
+      u32_t         n_extblk;
+      bool          b_ready;  //waiting for output: emit_mtx
+      EDID_cl       EDID;
+      corpus_row_t  row;
+
+      ppl_item_cl() : seq(0), stage(PPL_STG_FREE), datsz(0), rules(0), n_extblk(0), b_ready(false) {};
+};
+
+//per-stage statistics
+typedef struct {
+   u64_t  nitems;
+   u64_t  time_ns;  //sum of stage run times
+   u64_t  stalls;   //back-pressure: queue full, the item was processed inline
+   u32_t  max_occ;  //max queue occupancy
+} ppl_stat_t;
+
+class ppl_engine_cl;
+
+//Worker deque: the owner pushes & pops at the back (LIFO, cache-hot items),
+//the thieves take the oldest items from the front.
+class ppl_worker_cl : public wxThread {
+   protected:
+      ppl_engine_cl *engine;
+      u32_t          wid;
+
+      wxMutex        dq_mtx;
+      ppl_item_cl  **dq_ring;
+      u32_t          dq_mask;
+      u32_t          dq_head;
+      u32_t          dq_tail;
+
+      bulk_reader_cl reader;
+      wxCharBuffer   rd_path[PPL_RD_BATCH];
+      //one byte more than edi_buf_t: a file which fills the EDID buffer is told apart from a longer one
+      u8_t           rd_buf [PPL_RD_BATCH][sizeof(edi_buf_t) +1];
+
+      ExitCode Entry();
+
+      bool  read_batch();
+      void  run_item  (ppl_item_cl *item, bool b_occ);
+
+   public:
+      ppl_stat_t     stat[PPL_NSTAGE];
+      u64_t          steals;
+      guilog_cl      tlog;
+
+      bool          push     (ppl_item_cl *item);
+      ppl_item_cl*  pop      ();
+      ppl_item_cl*  steal    ();
+
+      const char*   getReaderName() {return reader.getModeName();};
+
+      ppl_worker_cl(ppl_engine_cl *eng, u32_t id, u32_t dqsize);
+      ~ppl_worker_cl();
+};
+
+class ppl_engine_cl {
+   friend class ppl_worker_cl;
+
+   protected:
+      wxArrayString  fnames;    //input files, full paths
+      u32_t          nfiles;
+      FILE          *fout;
+
+      u32_t          nthr;
+      u32_t          qdepth;
+      u32_t          window;    //max files in flight: sum of queue depths
+      ppl_item_cl   *items;
+      ppl_worker_cl *thr_ar[PPL_MAX_THR];
+
+      u32_t          occ[PPL_NSTAGE]; //queue occupancy (atomic)
+      u32_t          next_seq;        //next file to read (atomic)
+      u32_t          emit_next;       //next file to emit
+      wxMutex        emit_mtx;
+
+      wxMutex        idle_mtx;       //waiting for work
+      wxCondition    idle_cond;
+      u32_t          work_gen;       //incremented on each new task
+      u32_t          nidle;
+      bool           b_done;
+
+      u64_t          window_waits;   //admission blocked by the output order
+      u64_t          rules_cnt[PPL_R_COUNT];
+
+      ppl_item_cl*  admit      ();
+      u32_t         reserve    (u32_t stage);
+      inline void   release    (u32_t stage) {__atomic_sub_fetch(&occ[stage], 1, __ATOMIC_RELAXED);};
+      void          notify     ();
+      void          wait_work  (u32_t gen);
+      u32_t         get_gen    ();
+
+      void  stg_read   (ppl_item_cl *item, const u8_t *pbuf, i32_t len);
+      void  stg_preval (ppl_item_cl *item);
+      void  stg_parse  (ppl_item_cl *item, ppl_worker_cl *wrk);
+      void  stg_analyse(ppl_item_cl *item);
+      void  stg_emit   (ppl_item_cl *item);
+      void  write_item (ppl_item_cl *item);
+
+   public:
+      rcode Run(const wxString& dir, FILE *out, u32_t threads, u32_t depth);
+      void  PrintStats(FILE *out, double secs);
+
+      inline u32_t getFileCount() {return nfiles;};
+
+      ppl_engine_cl();
+      ~ppl_engine_cl();
+};
+
+#endif /* PIPELINE_H */
@@ -0,0 +1,59 @@
+/***************************************************************
+ * Name:      pnp_id.cpp
+ * Purpose:   PNP manufacturer ID registry: vendor names
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "pnp_id.h"
+
+#include <stddef.h>
+
+//Refresh: src/pnp_gen <pnp.ids> pnp_id_tbl.h
+#include "pnp_id_tbl.h"
+
+static_assert(PNP_TBL_SZ <= 0x10000, "pnp_disp: u16_t overflow");
+
+const char* pnp_id_cl::Vendor(u32_t pnp_id) {
+   u32_t  slot;
+
+   pnp_id &= 0x7FFF;
+   if (pnp_id == 0) return NULL;
+
+   slot = pnp_disp[pnp_id >> 5] + (pnp_id & 0x1F);
+   if (slot >= PNP_TBL_SZ) return NULL;
+   if (pnp_tbl[slot].id != pnp_id) return NULL;
+
+   return pnp_tbl[slot].name;
+}
+
+const char* pnp_id_cl::Vendor(const u8_t* pmfc) {
+   return Vendor((pmfc[0] << 8) | pmfc[1]);
+}
+
+const char* pnp_id_cl::Vendor(const char* code) {
+   return Vendor(Pack(code));
+}
+
+u32_t pnp_id_cl::Pack(const char* code) {
+   u32_t  pnp_id = 0;
+
+   for (u32_t itc=0; itc<3; itc++) {
+      u32_t  ltr = (u8_t) code[itc];
+
+      if ((ltr < 'A') || (ltr > 'Z')) return 0;
+      pnp_id = ((pnp_id << 5) | (ltr - 0x40));
+   }
+   return pnp_id;
+}
+
+u32_t pnp_id_cl::Count() {
+   u32_t  cnt = 0;
+
+   for (u32_t its=0; its<PNP_TBL_SZ; its++) {
+      if (pnp_tbl[its].id != 0) cnt ++ ;
+   }
+   return cnt;
+}
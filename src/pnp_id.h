@@ -0,0 +1,41 @@
+/***************************************************************
+ * Name:      pnp_id.h
+ * Purpose:   PNP manufacturer ID registry: vendor names
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef PNP_ID_H
+#define PNP_ID_H 1
+
+#include "def_types.h"
+
+enum {
+   PNP_ROWS = 1024 //packed ID >> 5: letters 1 & 2
+};
+
+typedef struct {
+   u16_t        id;   //15-bit packed ID (mfc_id_t), 0: empty slot
+   const char  *name;
+} pnp_vendor_t;
+
+//Compile-time perfect-hash table (pnp_id_tbl.h, generated by pnp_gen, see the table header
+//for the registry subset it was generated from):
+//lookups are O(1), no allocations, safe to call from worker threads.
+class pnp_id_cl {
+   public:
+      //15-bit packed ID, host byte order. NULL if the ID is not in the registry.
+      static const char*  Vendor(u32_t pnp_id);
+      //EDID bytes 8-9 (big endian)
+      static const char*  Vendor(const u8_t* pmfc);
+      //3-letter code "ABC"
+      static const char*  Vendor(const char* code);
+
+      //"ABC" -> packed ID, 0 if the code is invalid
+      static u32_t  Pack(const char* code);
+      static u32_t  Count();
+};
+
+#endif /* PNP_ID_H */
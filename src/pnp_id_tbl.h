@@ -0,0 +1,161 @@
+//Generated by pnp_gen from "pnp.ids": 83 IDs. Do not edit.
+//SUBSET of the PNP ID registry: 83 common display vendors only, other
+//manufacturer IDs have no vendor name. Regenerate from the full registry:
+//  src/pnp_gen /usr/share/hwdata/pnp.ids src/pnp_id_tbl.h
+
+#define PNP_TBL_SZ  85
+
+static const u16_t pnp_disp[PNP_ROWS] = {
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    60,     0,     1,    48,     0,     0,     0,     0,    46,     0,     0,     0,     0,     0,    79,
+       0,     0,     0,     0,     0,     2,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,    18,    55,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     4,     0,     0,     0,     0,     0,     0,     0,
+      10,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    24,     0,     0,     0,     0,     0,     0,     0,     0,     0,    31,
+       0,     0,     0,     0,     0,     0,     0,     2,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    32,     0,     0,     0,     0,     0,    40,     0,     0,    65,     0,    58,     0,
+      24,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    71,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    22,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    48,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    13,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     2,     0,     0,     0,    12,     0,     0,     0,     0,     0,     0,
+      45,     0,    72,     0,    40,     0,     0,    53,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    45,    61,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,    27,     0,
+       0,    59,     0,     0,     0,     0,     5,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    39,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    33,     0,    47,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    34,     0,    70,     0,     0,     0,     0,     0,     0,    32,     0,
+      43,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    68,     0,     0,     0,    17,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    14,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     3,     0,     0,     0,     0,     0,     0,     0,     0,     0,    65,
+       0,     0,     0,     0,     0,     0,    60,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,    60,     0,
+       0,    45,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    19,    32,     0,     0,     0,     0,    26,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    64,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    45,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    11,     0,     0,    69,     0,     0,     0,    65,    31,     0,     0,     0,     0,    42,     0,
+       0,     0,     0,     0,    39,     0,     0,     0,     0,    20,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,    27,
+       0,     0,     0,    76,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     2,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    67,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,    54,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    24,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0
+};
+
+static const pnp_vendor_t pnp_tbl[PNP_TBL_SZ] = {
+   {0x0000, NULL},
+   {0x0000, NULL},
+   {0x4162, "Packard Bell Electronics"}, //PKB
+   {0x4CA3, "Seiko Epson Corporation"}, //SEC
+   {0x2264, "HannStar Display Corp"}, //HSD
+   {0x20A3, "Hisense Electric Co., Ltd."}, //HEC
+   {0x38A3, "NEC Corporation"}, //NEC
+   {0x12E5, "Daewoo Electronics Company Ltd"}, //DWE
+   {0x0D04, "ChangHong Electric Co.,Ltd"}, //CHD
+   {0x0609, "A Plus Info Corporation"}, //API
+   {0x0469, "Ancor Communications Inc"}, //ACI
+   {0x20A9, "Hyundai Electronics Industries Co., Ltd."}, //HEI
+   {0x226C, "Hansol Electronics"}, //HSL
+   {0x1E6D, "Goldstar Company Ltd"}, //GSM
+   {0x0DAE, "Chimei Innolux Corporation"}, //CMN
+   {0x0DAF, "Chi Mei Optoelectronics corp."}, //CMO
+   {0x0610, "Apple Computer Inc"}, //APP
+   {0x06AF, "AU Optronics"}, //AUO
+   {0x26CD, "Iiyama North America"}, //IVM
+   {0x0472, "Acer Technologies"}, //ACR
+   {0x26CF, "InfoVision Optoelectronics"}, //IVO
+   {0x06B3, "ASUS Computer Inc"}, //AUS
+   {0x3668, "Microsoft"}, //MSH
+   {0x3669, "Microstep"}, //MSI
+   {0x4C2D, "Samsung Electric Company"}, //SAM
+   {0x4C2E, "Sanyo Electric Co.,Ltd."}, //SAN
+   {0x34A9, "Panasonic Industry Company"}, //MEI
+   {0x0E11, "Compaq Computer Company"}, //CPQ
+   {0x593A, "VIZIO, Inc"}, //VIZ
+   {0x34AC, "Mitsubishi Electric Corporation"}, //MEL
+   {0x0E14, "Chunghwa Picture Tubes, LTD."}, //CPT
+   {0x410C, "Philips Consumer Electronics Company"}, //PHL
+   {0x2134, "Hitachi America Ltd"}, //HIT
+   {0x1609, "Envision Peripherals, Inc"}, //EPI
+   {0x4F2E, "Synaptics Inc"}, //SYN
+   {0x09D1, "BenQ Corporation"}, //BNQ
+   {0x10AC, "Dell Inc."}, //DEL
+   {0x686D, "Zenith Data Systems"}, //ZCM
+   {0x1EF9, "Gateway 2000"}, //GWY
+   {0x25CC, "InnoLux Display Corporation"}, //INL
+   {0x4D29, "Silicon Image, Inc."}, //SII
+   {0x1AB3, "Fujitsu Siemens Computers GmbH"}, //FUS
+   {0x2AC3, "JVC"}, //JVC
+   {0x2283, "Hitachi Ltd"}, //HTC
+   {0x41D2, "Planar Systems, Inc."}, //PNR
+   {0x11EE, "DENON, Ltd."}, //DON
+   {0x51F3, "Toshiba Corporation"}, //TOS
+   {0x412F, "Pioneer Electronic Corporation"}, //PIO
+   {0x30AE, "Lenovo Group Limited"}, //LEN
+   {0x0523, "Arnos Instruments Ltd"}, //AIC
+   {0x2CC3, "KFC Computek"}, //KFC
+   {0x1473, "Elitegroup Computer Systems Company Ltd"}, //ECS
+   {0x2C93, "KDS USA"}, //KDS
+   {0x4E8E, "Samtron"}, //STN
+   {0x3E29, "Optiquest"}, //OQI
+   {0x320C, "LG Philips"}, //LPL
+   {0x31D8, "The Linux Foundation"}, //LNX
+   {0x0489, "ADI Systems Inc"}, //ADI
+   {0x244D, "IBM France"}, //IBM
+   {0x220E, "HP Inc."}, //HPN
+   {0x09E5, "BOE"}, //BOE
+   {0x15C3, "Eizo Nanao Corporation"}, //ENC
+   {0x65A8, "Yamaha Corporation"}, //YMH
+   {0x0423, "AcerView"}, //AAC
+   {0x3AC4, "Nvidia"}, //NVD
+   {0x4914, "Red Hat, Inc."}, //RHT
+   {0x153A, "Eizo Nanao Corporation"}, //EIZ
+   {0x4DD9, "Sony"}, //SNY
+   {0x1C54, "GIGA-BYTE TECHNOLOGY CO., LTD."}, //GBT
+   {0x22F0, "Hewlett Packard"}, //HWP
+   {0x5A63, "ViewSonic Corporation"}, //VSC
+   {0x3DCB, "ONKYO Corporation"}, //ONK
+   {0x4C83, "Samsung Display Corp"}, //SDC
+   {0x246C, "Fujitsu ICL"}, //ICL
+   {0x30E4, "LG Display"}, //LGD
+   {0x3427, "MAG InnoVision"}, //MAG
+   {0x39EB, "Nokia Display Products"}, //NOK
+   {0x2245, "Qingdao Haier Electronics Co., Ltd."}, //HRE
+   {0x5262, "Toshiba America Info Systems Inc"}, //TSB
+   {0x2634, "IMAGEQUEST Co., Ltd"}, //IQT
+   {0x158F, "Elo TouchSystems Inc"}, //ELO
+   {0x4D10, "Sharp Corporation"}, //SHP
+   {0x05E3, "AOC"}, //AOC
+   {0x4493, "Quanta Display Inc."}, //QDS
+   {0x186D, "Funai Electric Company of Taiwan"} //FCM
+};
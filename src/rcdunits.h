@@ -8,6 +8,23 @@
 #define idCEA       3
 #define idCEA_EXT   4
 #define idGRP_AR    5
+#define idPARSE_THR 6
+#define idCORPUS    7
+#define idDRM_MON   8
+#define idPIPELINE  9
 #define idGUI_LOG   10
+#define idBULK_RD   11
+#define idTAR_SRC   12
+#define idFW_SCAN   13
+#define idSYNTH     14
+#define idPATCH     15
+#define idSPLICE    16
+#define idUNDO      17
+#define idDIAG      18
+#define idDMT       19
+#define idMODELIST  20
+#define idCOLORIM   21
+#define idHEXVIEW   22
+#define idSEARCH    23
 
 #endif /* RCD_UNITS_H */
@@ -0,0 +1,635 @@
+/***************************************************************
+ * Name:      search.cpp
+ * Purpose:   Incremental search: inverted index of group names, field names & values
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idSEARCH
+   #error "search.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idSEARCH
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "search.h"
+
+#include <wx/sizer.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+srch_index_cl::srch_index_cl(EDID_cl *pedid) :
+   pEDID(pedid), tok_ar(NULL), ntok(0), tok_max(0), doc_ar(NULL), mark(NULL), ndoc(0), nfree(0),
+   doc_max(0), res_ar(NULL), nres(0), res_max(0), nqtok(0), b_built(false)
+{
+}
+
+srch_index_cl::~srch_index_cl() {
+   Clear();
+   free(tok_ar);
+   free(doc_ar);
+   free(mark);
+   free(res_ar);
+}
+
+void srch_index_cl::Clear() {
+   for (u32_t itt=0; itt<ntok; itt++) {
+      free(tok_ar[itt]->post);
+      free(tok_ar[itt]);
+   }
+   for (u32_t itd=0; itd<ndoc; itd++) {
+      delete doc_ar[itd];
+   }
+   if (mark != NULL) memset(mark, 0, doc_max);
+
+   ntok    = 0;
+   ndoc    = 0;
+   nfree   = 0;
+   nres    = 0;
+   nqtok   = 0;
+   b_built = false;
+   query.Empty();
+}
+
+//lowercase alphanumeric words appended to tok[ntok..max-1], duplicates are skipped
+u32_t srch_index_cl::tokenize(const wxString& str, char (*tok)[SRCH_TOK_LEN], u32_t ntok, u32_t max) {
+   char   word[SRCH_TOK_LEN];
+   u32_t  len = 0;
+
+   for (wxString::const_iterator it = str.begin(); ; ++it) {
+      bool  b_end = (it == str.end());
+      int   chr   = 0;
+
+      if (! b_end) {
+         wxUniChar uchr = *it;
+         if (uchr.IsAscii()) chr = tolower((unsigned char) uchr.GetValue());
+      }
+      if ((! b_end) && isalnum(chr)) {
+         if (len < (SRCH_TOK_LEN -1)) word[len++] = (char) chr;
+         continue;
+      }
+
+      if (len > 0) {
+         u32_t itt;
+
+         word[len] = 0;
+         len       = 0;
+
+         for (itt=0; itt<ntok; itt++) {
+            if (strcmp(tok[itt], word) == 0) break;
+         }
+         if (itt == ntok) {
+            if (ntok >= max) break;
+            strcpy(tok[ntok], word);
+            ntok ++ ;
+         }
+      }
+      if (b_end) break;
+   }
+
+   return ntok;
+}
+
+//index of the 1st token >= txt
+u32_t srch_index_cl::tok_lbound(const char *txt) {
+   u32_t lo = 0;
+   u32_t hi = ntok;
+
+   while (lo < hi) {
+      u32_t mid = (lo + hi) >> 1;
+      if (strcmp(tok_ar[mid]->txt, txt) < 0) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   return lo;
+}
+
+rcode srch_index_cl::tok_link(const char *txt, u32_t doc_id, srch_tok_t **pptok) {
+   rcode       retU;
+   srch_tok_t *ptok;
+   u32_t       idx;
+   u32_t       lo;
+   u32_t       hi;
+
+   idx = tok_lbound(txt);
+
+   if ((idx < ntok) && (strcmp(tok_ar[idx]->txt, txt) == 0)) {
+      ptok = tok_ar[idx];
+   } else {
+      if (ntok >= tok_max) {
+         srch_tok_t **new_ar;
+         u32_t        new_max;
+
+         new_max = (tok_max == 0) ? (u32_t) SRCH_AR_INIT : (tok_max * 2);
+         new_ar  = (srch_tok_t**) realloc(tok_ar, new_max * sizeof(srch_tok_t*));
+         if (new_ar == NULL) RCD_RETURN_FAULT(retU);
+
+         tok_ar  = new_ar;
+         tok_max = new_max;
+      }
+
+      ptok = (srch_tok_t*) malloc(sizeof(srch_tok_t));
+      if (ptok == NULL) RCD_RETURN_FAULT(retU);
+
+      ptok->post    = (u32_t*) malloc(4 * sizeof(u32_t));
+      ptok->npost   = 0;
+      ptok->maxpost = 4;
+      if (ptok->post == NULL) {
+         free(ptok);
+         RCD_RETURN_FAULT(retU);
+      }
+      strcpy(ptok->txt, txt);
+
+      memmove(&tok_ar[idx +1], &tok_ar[idx], (ntok - idx) * sizeof(srch_tok_t*));
+      tok_ar[idx] = ptok;
+      ntok ++ ;
+   }
+
+   if (ptok->npost >= ptok->maxpost) {
+      u32_t *new_post;
+
+      new_post = (u32_t*) realloc(ptok->post, (ptok->maxpost * 2) * sizeof(u32_t));
+      if (new_post == NULL) RCD_RETURN_FAULT(retU);
+
+      ptok->post     = new_post;
+      ptok->maxpost *= 2;
+   }
+
+   //freed doc ids are reused: keep the posting list sorted
+   lo = 0;
+   hi = ptok->npost;
+   while (lo < hi) {
+      u32_t mid = (lo + hi) >> 1;
+      if (ptok->post[mid] < doc_id) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   memmove(&ptok->post[lo +1], &ptok->post[lo], (ptok->npost - lo) * sizeof(u32_t));
+   ptok->post[lo] = doc_id;
+   ptok->npost ++ ;
+
+   *pptok = ptok;
+   RCD_RETURN_OK(retU);
+}
+
+void srch_index_cl::tok_unlink(srch_tok_t *ptok, u32_t doc_id) {
+   u32_t lo = 0;
+   u32_t hi = ptok->npost;
+
+   while (lo < hi) {
+      u32_t mid = (lo + hi) >> 1;
+      if (ptok->post[mid] < doc_id) {
+         lo = mid + 1;
+      } else {
+         hi = mid;
+      }
+   }
+   if ((lo < ptok->npost) && (ptok->post[lo] == doc_id)) {
+      ptok->npost -- ;
+      memmove(&ptok->post[lo], &ptok->post[lo +1], (ptok->npost - lo) * sizeof(u32_t));
+   }
+
+   if (ptok->npost > 0) return;
+
+   //no more documents: remove the token
+   lo = tok_lbound(ptok->txt);
+   if ((lo < ntok) && (tok_ar[lo] == ptok)) {
+      ntok -- ;
+      memmove(&tok_ar[lo], &tok_ar[lo +1], (ntok - lo) * sizeof(srch_tok_t*));
+   }
+   free(ptok->post);
+   free(ptok);
+}
+
+//all the query words are prefixes of the document tokens
+bool srch_index_cl::doc_match(const srch_doc_t *pdoc) {
+   for (u32_t itq=0; itq<nqtok; itq++) {
+      u32_t qlen = strlen(qtok[itq]);
+      u32_t itt;
+
+      for (itt=0; itt<pdoc->ntok; itt++) {
+         if (strncmp(pdoc->tok[itt]->txt, qtok[itq], qlen) == 0) break;
+      }
+      if (itt == pdoc->ntok) return false;
+   }
+   return true;
+}
+
+rcode srch_index_cl::add_result(srch_doc_t *pdoc) {
+   rcode retU;
+
+   if (nres >= res_max) {
+      srch_doc_t **new_ar;
+      u32_t        new_max;
+
+      new_max = (res_max == 0) ? (u32_t) SRCH_AR_INIT : (res_max * 2);
+      new_ar  = (srch_doc_t**) realloc(res_ar, new_max * sizeof(srch_doc_t*));
+      if (new_ar == NULL) RCD_RETURN_FAULT(retU);
+
+      res_ar  = new_ar;
+      res_max = new_max;
+   }
+
+   res_ar[nres] = pdoc;
+   nres ++ ;
+   RCD_RETURN_OK(retU);
+}
+
+//EDID order: offset, parent group before sub-groups, group name before its fields
+static int res_cmp(const void *pa, const void *pb) {
+   const srch_doc_t *pda = *(const srch_doc_t* const*) pa;
+   const srch_doc_t *pdb = *(const srch_doc_t* const*) pb;
+   u32_t             offa;
+   u32_t             offb;
+
+   offa = pda->grp->getAbsOffs();
+   offb = pdb->grp->getAbsOffs();
+   if (offa != offb) return (offa < offb) ? -1 : 1;
+
+   if ((pda->parent == NULL) != (pdb->parent == NULL)) {
+      return (pda->parent == NULL) ? -1 : 1;
+   }
+   if (pda->grp != pdb->grp) {
+      u32_t sza = pda->grp->getTotalSize();
+      u32_t szb = pdb->grp->getTotalSize();
+
+      if (sza != szb) return (sza > szb) ? -1 : 1;
+      return (pda->grp < pdb->grp) ? -1 : 1;
+   }
+   return (pda->fidx - pdb->fidx);
+}
+
+void srch_index_cl::sort_results() {
+   if (nres > 1) qsort(res_ar, nres, sizeof(srch_doc_t*), res_cmp);
+}
+
+rcode srch_index_cl::add_doc(edi_grp_cl *pgrp, i32_t fidx) {
+   rcode       retU;
+   srch_doc_t *pdoc;
+   char        words[SRCH_DOC_TOKS][SRCH_TOK_LEN];
+   u32_t       nword;
+   u32_t       doc_id;
+
+   pdoc = new srch_doc_t;
+   if (pdoc == NULL) RCD_RETURN_FAULT(retU);
+
+   pdoc->grp    = pgrp;
+   pdoc->parent = pgrp->getParentGrp();
+   pdoc->fidx   = fidx;
+   pdoc->ntok   = 0;
+
+   //field documents carry the group name tokens: "hdmi tmds" finds the field
+   nword = 0;
+   if (pdoc->parent != NULL) {
+      nword = tokenize(pdoc->parent->CodeName, words, nword, SRCH_DOC_TOKS);
+   }
+   nword = tokenize(pgrp->CodeName , words, nword, SRCH_DOC_TOKS);
+   nword = tokenize(pgrp->GroupName, words, nword, SRCH_DOC_TOKS);
+
+   if (fidx >= 0) {
+      edi_dynfld_t *pfld;
+      wxString      unit;
+      u32_t         ival;
+
+      pfld  = pgrp->FieldsAr.Item(fidx);
+      nword = tokenize(wxString::FromAscii(pfld->field.name), words, nword, SRCH_DOC_TOKS);
+
+      //the only handler call for this field until the group is changed
+      if (pfld->field.handlerfn != NULL) {
+         retU = (pEDID->*pfld->field.handlerfn)(OP_READ, pdoc->value, ival, pfld);
+         if (! RCD_IS_OK(retU)) pdoc->value.Empty();
+      }
+      retU = pEDID->getValUnitName(unit, pfld->field.flags);
+      if (RCD_IS_OK(retU) && (! unit.IsEmpty())) pdoc->value << " " << unit;
+
+      nword = tokenize(pdoc->value, words, nword, SRCH_DOC_TOKS);
+   }
+
+   if (nfree > 0) {
+      for (doc_id=0; doc_ar[doc_id] != NULL; doc_id++) ;
+      nfree -- ;
+   } else {
+      if (ndoc >= doc_max) {
+         srch_doc_t **new_ar;
+         u8_t        *new_mark;
+         u32_t        new_max;
+
+         new_max = (doc_max == 0) ? (u32_t) SRCH_AR_INIT : (doc_max * 2);
+
+         new_ar = (srch_doc_t**) realloc(doc_ar, new_max * sizeof(srch_doc_t*));
+         if (new_ar == NULL) {
+            delete pdoc;
+            RCD_RETURN_FAULT(retU);
+         }
+         doc_ar = new_ar;
+
+         new_mark = (u8_t*) realloc(mark, new_max);
+         if (new_mark == NULL) {
+            delete pdoc;
+            RCD_RETURN_FAULT(retU);
+         }
+         memset(&new_mark[doc_max], 0, (new_max - doc_max));
+         mark    = new_mark;
+         doc_max = new_max;
+      }
+      doc_id = ndoc;
+      ndoc  ++ ;
+   }
+   doc_ar[doc_id] = pdoc;
+
+   for (u32_t itw=0; itw<nword; itw++) {
+      retU = tok_link(words[itw], doc_id, &pdoc->tok[pdoc->ntok]);
+      if (! RCD_IS_OK(retU)) {
+         del_doc(doc_id);
+         return retU;
+      }
+      pdoc->ntok ++ ;
+   }
+
+   //the current results are kept up to date
+   if ((nqtok > 0) && doc_match(pdoc)) return add_result(pdoc);
+
+   RCD_RETURN_OK(retU);
+}
+
+void srch_index_cl::del_doc(u32_t doc_id) {
+   srch_doc_t *pdoc;
+
+   pdoc = doc_ar[doc_id];
+
+   for (u32_t itt=0; itt<pdoc->ntok; itt++) {
+      tok_unlink(pdoc->tok[itt], doc_id);
+   }
+   for (u32_t itr=0; itr<nres; itr++) {
+      if (res_ar[itr] != pdoc) continue;
+      nres -- ;
+      memmove(&res_ar[itr], &res_ar[itr +1], (nres - itr) * sizeof(srch_doc_t*));
+      break;
+   }
+
+   delete pdoc;
+   doc_ar[doc_id] = NULL;
+   nfree ++ ;
+}
+
+rcode srch_index_cl::add_group(edi_grp_cl *pgrp) {
+   rcode retU;
+
+   retU = add_doc(pgrp, -1);
+   if (! RCD_IS_OK(retU)) return retU;
+
+   for (u32_t itf=0; itf<pgrp->FieldsAr.GetCount(); itf++) {
+      retU = add_doc(pgrp, itf);
+      if (! RCD_IS_OK(retU)) return retU;
+   }
+
+   for (u32_t its=0; its<pgrp->getSubGrpCount(); its++) {
+      retU = add_group(pgrp->getSubGroup(its));
+      if (! RCD_IS_OK(retU)) return retU;
+   }
+   return retU;
+}
+
+rcode srch_index_cl::build() {
+   rcode retU;
+   u32_t nblk;
+
+   Clear();
+
+   nblk = pEDID->getNumValidBlocks();
+   if (nblk > (sizeof(edi_t) / sizeof(edid_t))) nblk = (sizeof(edi_t) / sizeof(edid_t));
+
+   RCD_SET_OK(retU);
+
+   for (u32_t itb=0; itb<nblk; itb++) {
+      GroupAr_cl *grp_ar = pEDID->BlkGroupsAr[itb];
+
+      for (u32_t itg=0; itg<grp_ar->GetCount(); itg++) {
+         retU = add_group(grp_ar->Item(itg));
+         if (! RCD_IS_OK(retU)) {
+            Clear();
+            wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] srch_index_cl: out of memory, block %u", itb);
+         }
+      }
+   }
+
+   b_built = true;
+   return retU;
+}
+
+rcode srch_index_cl::Add(edi_grp_cl *pgrp) {
+   rcode retU;
+
+   if (! b_built) RCD_RETURN_OK(retU);
+
+   retU = add_group(pgrp);
+   sort_results();
+   return retU;
+}
+
+void srch_index_cl::Remove(edi_grp_cl *pgrp) {
+   if (! b_built) return;
+
+   for (u32_t itd=0; itd<ndoc; itd++) {
+      srch_doc_t *pdoc = doc_ar[itd];
+
+      if (pdoc == NULL) continue;
+      if ((pdoc->grp != pgrp) && (pdoc->parent != pgrp)) continue;
+
+      del_doc(itd);
+   }
+}
+
+rcode srch_index_cl::Update(edi_grp_cl *pgrp) {
+   Remove(pgrp);
+   return Add(pgrp);
+}
+
+rcode srch_index_cl::Search(const wxString& qstr) {
+   rcode retU;
+   bool  b_narrow;
+
+   RCD_SET_OK(retU);
+
+   if (! b_built) {
+      retU = build();
+      if (! RCD_IS_OK(retU)) return retU;
+   }
+
+   //the query was only extended: the results can only shrink
+   b_narrow = (nqtok > 0) && qstr.StartsWith(query);
+   query    = qstr;
+   nqtok    = tokenize(qstr, qtok, 0, SRCH_QRY_TOKS);
+
+   if (nqtok == 0) {
+      nres = 0;
+      return retU;
+   }
+
+   if (b_narrow) {
+      u32_t nkeep = 0;
+
+      for (u32_t itr=0; itr<nres; itr++) {
+         if (doc_match(res_ar[itr])) res_ar[nkeep++] = res_ar[itr];
+      }
+      nres = nkeep;
+      return retU;
+   }
+
+   //prefix match: the tokens starting with a query word are adjacent in tok_ar
+   for (u32_t itq=0; itq<nqtok; itq++) {
+      u32_t qlen = strlen(qtok[itq]);
+
+      for (u32_t itt=tok_lbound(qtok[itq]); itt<ntok; itt++) {
+         srch_tok_t *ptok = tok_ar[itt];
+
+         if (strncmp(ptok->txt, qtok[itq], qlen) != 0) break;
+
+         for (u32_t itp=0; itp<ptok->npost; itp++) {
+            u32_t doc_id = ptok->post[itp];
+            if (mark[doc_id] == itq) mark[doc_id] = (itq +1);
+         }
+      }
+   }
+
+   nres = 0;
+   for (u32_t itd=0; itd<ndoc; itd++) {
+      if (mark[itd] == nqtok) {
+         rcode retU2 = add_result(doc_ar[itd]);
+         if (! RCD_IS_OK(retU2)) retU = retU2;
+      }
+      mark[itd] = 0;
+   }
+
+   sort_results();
+   return retU;
+}
+
+//srch_list_cl: virtual list control
+srch_list_cl::srch_list_cl(wxWindow *parent, wxWindowID id, srch_index_cl *pidx) :
+   wxListCtrl(parent, id, wxDefaultPosition, wxDefaultSize, wxLC_REPORT|wxLC_VIRTUAL|wxLC_SINGLE_SEL|wxLC_HRULES),
+   pindex(pidx)
+{
+   InsertColumn(SRCH_COL_GRP, "Group", wxLIST_FORMAT_LEFT,  90);
+   InsertColumn(SRCH_COL_FLD, "Field", wxLIST_FORMAT_LEFT, 110);
+   InsertColumn(SRCH_COL_VAL, "Value", wxLIST_FORMAT_LEFT, 140);
+}
+
+wxString srch_list_cl::OnGetItemText(long item, long column) const {
+   const srch_doc_t *pdoc;
+   wxString          str;
+
+   if ((item < 0) || ((u32_t) item >= pindex->Count())) return str;
+
+   pdoc = pindex->Result(item);
+
+   switch (column) {
+      case SRCH_COL_GRP:
+         if (pdoc->parent != NULL) str << pdoc->parent->CodeName << ".";
+         str << pdoc->grp->CodeName;
+         break;
+      case SRCH_COL_FLD:
+         if (pdoc->fidx < 0) {
+            str = pdoc->grp->GroupName;
+         } else {
+            str = wxString::FromAscii(pdoc->grp->FieldsAr.Item(pdoc->fidx)->field.name);
+         }
+         break;
+      case SRCH_COL_VAL:
+         str = pdoc->value;
+         break;
+      default:
+         break;
+   }
+   return str;
+}
+
+//srch_pane_cl
+wxBEGIN_EVENT_TABLE(srch_pane_cl, wxPanel)
+   EVT_TEXT                 (wxID_ANY, srch_pane_cl::evt_query )
+   EVT_SEARCHCTRL_CANCEL_BTN(wxID_ANY, srch_pane_cl::evt_cancel)
+wxEND_EVENT_TABLE()
+
+srch_pane_cl::srch_pane_cl(wxWindow *parent, wxWindowID id, wxWindowID list_id, EDID_cl *pedid, guilog_cl *pglog) :
+   wxPanel(parent, id), index(pedid), plog(pglog)
+{
+   wxBoxSizer *bs_main;
+
+   txc_query = new wxSearchCtrl(this, wxID_ANY);
+   txc_query->ShowCancelButton(true);
+   txc_query->SetDescriptiveText("Group, field or value");
+
+   lst_result = new srch_list_cl(this, list_id, &index);
+
+   bs_main = new wxBoxSizer(wxVERTICAL);
+   bs_main->Add(txc_query , 0, wxEXPAND|wxALL, 2);
+   bs_main->Add(lst_result, 1, wxEXPAND|wxLEFT|wxRIGHT|wxBOTTOM, 2);
+   SetSizer(bs_main);
+}
+
+void srch_pane_cl::update_list() {
+   lst_result->SetItemCount(index.Count());
+   lst_result->Refresh();
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void srch_pane_cl::evt_query(wxCommandEvent& evt) {
+   rcode retU;
+
+   retU = index.Search(txc_query->GetValue());
+   if (! RCD_IS_OK(retU)) plog->PrintRcode(retU);
+
+   update_list();
+}
+
+void srch_pane_cl::evt_cancel(wxCommandEvent& evt) {
+   txc_query->Clear(); //evt_query()
+}
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+//new document: the old query & results are dropped
+void srch_pane_cl::IndexClear() {
+   index.Clear();
+   txc_query->ChangeValue(wxEmptyString);
+   update_list();
+}
+
+void srch_pane_cl::IndexAdd(edi_grp_cl *pgrp) {
+   rcode retU;
+
+   retU = index.Add(pgrp);
+   if (! RCD_IS_OK(retU)) plog->PrintRcode(retU);
+
+   update_list();
+}
+
+void srch_pane_cl::IndexRemove(edi_grp_cl *pgrp) {
+   index.Remove(pgrp);
+   update_list();
+}
+
+void srch_pane_cl::IndexUpdate(edi_grp_cl *pgrp) {
+   rcode retU;
+
+   retU = index.Update(pgrp);
+   if (! RCD_IS_OK(retU)) plog->PrintRcode(retU);
+
+   update_list();
+}
+
+void srch_pane_cl::FocusQuery() {
+   txc_query->SetFocus();
+   txc_query->SelectAll();
+}
@@ -0,0 +1,143 @@
+/***************************************************************
+ * Name:      search.h
+ * Purpose:   Incremental search: inverted index of group names, field names & values
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-07
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef SEARCH_H
+#define SEARCH_H 1
+
+#include <wx/panel.h>
+#include <wx/srchctrl.h>
+#include <wx/listctrl.h>
+#include <wx/event.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+
+enum {
+   SRCH_TOK_LEN  = 24,  //max token length + 1, longer words are truncated
+   SRCH_DOC_TOKS = 32,  //max tokens per document
+   SRCH_QRY_TOKS = 8,   //max query words
+   SRCH_AR_INIT  = 512  //initial size of the token/document/result arrays
+};
+
+enum { //srch_list_cl columns
+   SRCH_COL_GRP  = 0,
+   SRCH_COL_FLD  = 1,
+   SRCH_COL_VAL  = 2
+};
+
+//lowercase alphanumeric word, the posting list: document ids, ascending
+typedef struct {
+   char    txt[SRCH_TOK_LEN];
+   u32_t  *post;
+   u32_t   npost;
+   u32_t   maxpost;
+} srch_tok_t;
+
+//document: a group (fidx < 0) or a single field with its group name tokens
+typedef struct {
+   edi_grp_cl  *grp;
+   edi_grp_cl  *parent; //sub-group: parent group, NULL otherwise
+   i32_t        fidx;
+   wxString     value;  //formatted field value + unit
+   srch_tok_t  *tok[SRCH_DOC_TOKS];
+   u32_t        ntok;
+} srch_doc_t;
+
+//The index is built on the first search, then updated per group: the field handlers are
+//called only for the groups added or changed since. Each keystroke re-runs the query on the
+//posting lists, or narrows the previous results when the query was only extended.
+class srch_index_cl {
+   protected:
+      EDID_cl      *pEDID;
+      srch_tok_t  **tok_ar;  //sorted by text: prefix search
+      u32_t         ntok;
+      u32_t         tok_max;
+      srch_doc_t  **doc_ar;  //doc id -> document, NULL: free slot
+      u8_t         *mark;    //query: number of matched words per doc id
+      u32_t         ndoc;    //used slots
+      u32_t         nfree;
+      u32_t         doc_max;
+      srch_doc_t  **res_ar;  //current results, in EDID order
+      u32_t         nres;
+      u32_t         res_max;
+      char          qtok[SRCH_QRY_TOKS][SRCH_TOK_LEN];
+      u32_t         nqtok;
+      wxString      query;
+      bool          b_built;
+
+      static u32_t  tokenize (const wxString& str, char (*tok)[SRCH_TOK_LEN], u32_t ntok, u32_t max);
+
+      u32_t  tok_lbound(const char *txt);
+      rcode  tok_link  (const char *txt, u32_t doc_id, srch_tok_t **pptok);
+      void   tok_unlink(srch_tok_t *ptok, u32_t doc_id);
+
+      bool   doc_match (const srch_doc_t *pdoc);
+      rcode  add_doc   (edi_grp_cl *pgrp, i32_t fidx);
+      void   del_doc   (u32_t doc_id);
+      rcode  add_group (edi_grp_cl *pgrp);
+      rcode  add_result(srch_doc_t *pdoc);
+      void   sort_results();
+      rcode  build     ();
+
+   public:
+      void   Clear ();
+      //group changes: no-op until the index is built
+      rcode  Add   (edi_grp_cl *pgrp); //including sub-groups
+      void   Remove(edi_grp_cl *pgrp); //including sub-groups
+      rcode  Update(edi_grp_cl *pgrp);
+
+      rcode  Search(const wxString& qstr);
+
+      inline u32_t              Count () {return nres;};
+      inline const srch_doc_t*  Result(u32_t idx) {return res_ar[idx];};
+
+      srch_index_cl(EDID_cl *pedid);
+      ~srch_index_cl();
+};
+
+class srch_list_cl : public wxListCtrl {
+   protected:
+      srch_index_cl  *pindex;
+
+      wxString  OnGetItemText(long item, long column) const;
+
+   public:
+      srch_list_cl(wxWindow *parent, wxWindowID id, srch_index_cl *pidx);
+};
+
+//search box + results list; wxEVT_LIST_ITEM_SELECTED is passed to the parent window
+class srch_pane_cl : public wxPanel {
+   protected:
+      srch_index_cl  index;
+      guilog_cl     *plog;
+      wxSearchCtrl  *txc_query;
+      srch_list_cl  *lst_result;
+
+      void  update_list();
+      void  evt_query (wxCommandEvent& evt);
+      void  evt_cancel(wxCommandEvent& evt);
+
+   public:
+      //index changes: wxWindow::Update() is already taken
+      void  IndexClear ();
+      void  IndexAdd   (edi_grp_cl *pgrp);
+      void  IndexRemove(edi_grp_cl *pgrp);
+      void  IndexUpdate(edi_grp_cl *pgrp);
+      void  FocusQuery ();
+
+      inline srch_index_cl&  getIndex() {return index;};
+
+      srch_pane_cl(wxWindow *parent, wxWindowID id, wxWindowID list_id, EDID_cl *pedid, guilog_cl *pglog);
+
+   wxDECLARE_EVENT_TABLE();
+};
+
+#endif /* SEARCH_H */
@@ -0,0 +1,242 @@
+/***************************************************************
+ * Name:      splice.cpp
+ * Purpose:   Batch group splicing: template groups inserted into many EDIDs
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-02
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idSPLICE
+   #error "splice.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idSPLICE
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "splice.h"
+
+#include <wx/file.h>
+#include <wx/tokenzr.h>
+#include <string.h>
+
+splice_engine_cl::splice_engine_cl() : ntgrp(0), clones(NULL), nclones(0) {
+   memset(tgrp_ar, 0, sizeof(tgrp_ar));
+   tmpl.SetGuiLogPtr(&tlog);
+}
+
+splice_engine_cl::~splice_engine_cl() {
+   if (clones != NULL) {
+      for (u32_t itc=0; itc<nclones; itc++) {
+         if (clones[itc] != NULL) delete_group(clones[itc]);
+      }
+      delete [] clones;
+   }
+   tmpl.DeleteGroups();
+}
+
+void splice_engine_cl::delete_group(edi_grp_cl *pgrp) {
+   //sub-groups are not owned by the parent group
+   for (u32_t its=0; its<pgrp->getSubGrpCount(); its++) {
+      delete pgrp->getSubGroup(its);
+   }
+   delete pgrp;
+}
+
+bool splice_engine_cl::same_group(edi_grp_cl *pdst, edi_grp_cl *psrc) {
+   u32_t  tid;
+
+   tid = psrc->getTypeID();
+   if (pdst->getTypeID() != tid) return false;
+
+   //vendor-specific blocks: the IEEE OUI identifies the block
+   tid &= (ID_CEA_MASK | ID_CEA_EXT_MASK);
+   if (tid == ID_VSD) {
+      return (0 == memcmp(pdst->getInsPtr() +1, psrc->getInsPtr() +1, 3));
+   }
+   if ((tid == ID_VSVD) || (tid == ID_VSAD)) {
+      return (0 == memcmp(pdst->getInsPtr() +2, psrc->getInsPtr() +2, 3));
+   }
+   return true;
+}
+
+rcode splice_engine_cl::LoadTemplate(const wxString& path, const wxString& codes) {
+   rcode          retU;
+   wxFile         file;
+   wxArrayString  code_ar;
+   ssize_t        len;
+   u32_t          n_extblk = 0;
+   CEA_GrpAr_cl  *p_grp_ar;
+
+   if (! file.Open(path, wxFile::read) ) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Can't open the template EDID: %s", (const char*) path.ToUTF8());
+   }
+   tmpl.Clear();
+   len = file.Read(tmpl.getEDID()->buff, sizeof(edi_t));
+   file.Close();
+
+   if ((len < (2 * EDI_BLK_SIZE)) || ((len % EDI_BLK_SIZE) != 0)) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Template EDID: no CTA-861 block, file size %d", (int) len);
+   }
+
+   tmpl.Set_ERR_Ignore(false);
+
+   retU = tmpl.ParseEDID_Base(n_extblk);
+   if (! RCD_IS_OK(retU)) return retU;
+   if (n_extblk == 0) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Template EDID: no CTA-861 block");
+   }
+   retU = tmpl.ParseEDID_CEA();
+   if (! RCD_IS_OK(retU)) return retU;
+
+   {
+      wxStringTokenizer tokenz(codes, ",");
+
+      while (tokenz.HasMoreTokens()) {
+         wxString code = tokenz.GetNextToken();
+
+         code.Trim(true).Trim(false);
+         if (! code.IsEmpty()) code_ar.Add(code);
+      }
+   }
+
+   //selected data blocks: the CTA-861 header and the DTDs are not spliced
+   p_grp_ar = &tmpl.EDI_Ext0GrpAr;
+   ntgrp    = 0;
+
+   for (u32_t itg=0; itg<p_grp_ar->GetCount(); itg++) {
+      edi_grp_cl *pgrp;
+      u32_t       tid;
+
+      pgrp = p_grp_ar->Item(itg);
+      tid  = pgrp->getTypeID();
+
+      if ((tid & ID_EDID_MASK) == ID_DTD) continue;
+      if ((tid & ID_CEA_MASK ) == ID_CHD) continue;
+
+      if ((code_ar.GetCount() > 0) && (code_ar.Index(pgrp->CodeName) == wxNOT_FOUND)) continue;
+
+      if (ntgrp >= SPLICE_MAX_GRP) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Template EDID: too many groups, max %u", (u32_t) SPLICE_MAX_GRP);
+      }
+      tgrp_ar[ntgrp] = pgrp;
+      ntgrp ++ ;
+   }
+
+   for (u32_t itc=0; itc<code_ar.GetCount(); itc++) {
+      u32_t  itg;
+
+      for (itg=0; itg<ntgrp; itg++) {
+         if (tgrp_ar[itg]->CodeName == code_ar[itc]) break;
+      }
+      if (itg >= ntgrp) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Template EDID: group not found: %s", (const char*) code_ar[itc].ToUTF8());
+      }
+   }
+   if (ntgrp == 0) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Template EDID: no CTA-861 data blocks");
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+rcode splice_engine_cl::prepare(u32_t threads) {
+   rcode  retU;
+
+   if ((ntgrp == 0) || (clones != NULL)) RCD_RETURN_FAULT(retU);
+
+   nclones = (threads * ntgrp);
+   clones  = new edi_grp_cl*[nclones];
+   if (clones == NULL) RCD_RETURN_FAULT(retU);
+   memset(clones, 0, nclones * sizeof(edi_grp_cl*));
+
+   //one set of groups per worker: the groups are initialized only here
+   for (u32_t itc=0; itc<nclones; itc++) {
+      edi_grp_cl *psrc = tgrp_ar[itc % ntgrp];
+
+      clones[itc] = psrc->Clone(retU, 0);
+      if (clones[itc] == NULL) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Template EDID: can't clone the group %s",
+                                      (const char*) psrc->CodeName.ToUTF8());
+      }
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+bool splice_engine_cl::apply(patch_thr_cl *thr, wxString& emsg) {
+   CEA_GrpAr_cl  *p_grp_ar;
+   edi_grp_cl   **pclone;
+   edi_grp_cl    *pgrp;
+   edi_grp_cl    *pold;
+   u32_t          idx;
+
+   p_grp_ar = &thr->EDID.EDI_Ext0GrpAr;
+   pclone   = &clones[thr->wid * ntgrp];
+
+   if ((thr->EDID.getNumValidBlocks() < 2) || (p_grp_ar->GetCount() == 0)) {
+      emsg = "no CTA-861 block";
+      return false;
+   }
+
+   for (u32_t itg=0; itg<ntgrp; itg++) {
+      pgrp = pclone[itg];
+
+      //replace: group of the same type
+      for (idx=0; idx<p_grp_ar->GetCount(); idx++) {
+         if (same_group(p_grp_ar->Item(idx), pgrp)) break;
+      }
+
+      if (idx < p_grp_ar->GetCount()) {
+         if (! p_grp_ar->CanPaste(idx, pgrp)) goto no_space;
+
+         //sub-groups of the replaced group: Paste() deletes only the group
+         pold = p_grp_ar->Item(idx);
+         for (u32_t its=0; its<pold->getSubGrpCount(); its++) {
+            delete pold->getSubGroup(its);
+         }
+
+         p_grp_ar->Paste(idx, pgrp);
+         continue;
+      }
+
+      //insert after the last data block: CTA-861 header @idx=0
+      for (idx=p_grp_ar->GetCount(); idx>1; idx--) {
+         if ((p_grp_ar->Item(idx-1)->getTypeID() & ID_EDID_MASK) != ID_DTD) break;
+      }
+      idx -- ;
+
+      if (! p_grp_ar->CanInsertDn(idx, pgrp)) goto no_space;
+
+      p_grp_ar->InsertDn(idx, pgrp);
+   }
+
+   return true;
+
+no_space:
+   emsg.Printf("%s: %u bytes, free space: %d bytes", pgrp->CodeName, pgrp->getTotalSize(), p_grp_ar->getFreeSpace());
+   return false;
+}
+
+void splice_engine_cl::release(patch_thr_cl *thr) {
+   CEA_GrpAr_cl  *p_grp_ar;
+   edi_grp_cl   **pclone;
+
+   p_grp_ar = &thr->EDID.EDI_Ext0GrpAr;
+   pclone   = &clones[thr->wid * ntgrp];
+
+   //detach the spliced groups: reused for the next target
+   for (u32_t itg=0; itg<ntgrp; itg++) {
+      for (u32_t idx=0; idx<p_grp_ar->GetCount(); idx++) {
+         if (p_grp_ar->Item(idx) != pclone[itg]) continue;
+
+         delete p_grp_ar->Detach(idx);
+         break;
+      }
+   }
+}
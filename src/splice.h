@@ -0,0 +1,46 @@
+/***************************************************************
+ * Name:      splice.h
+ * Purpose:   Batch group splicing: template groups inserted into many EDIDs
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-02
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef SPLICE_H
+#define SPLICE_H 1
+
+#include "patch.h"
+
+enum {
+   SPLICE_MAX_GRP = 16
+};
+
+//CTA-861 groups from the template EDID replace the groups of the same type in the target,
+//or they are inserted after the last data block. The template groups are cloned once per
+//worker thread, then inserted/pasted into each target and detached after assembly.
+class splice_engine_cl : public patch_engine_cl {
+   protected:
+      EDID_cl      tmpl;
+      guilog_cl    tlog;
+      edi_grp_cl  *tgrp_ar[SPLICE_MAX_GRP];
+      u32_t        ntgrp;
+      edi_grp_cl **clones;  //[thread][group]
+      u32_t        nclones;
+
+      static bool  same_group(edi_grp_cl *pdst, edi_grp_cl *psrc);
+      static void  delete_group(edi_grp_cl *pgrp);
+
+      rcode  prepare(u32_t threads);
+      bool   apply  (patch_thr_cl *thr, wxString& emsg);
+      void   release(patch_thr_cl *thr);
+
+   public:
+      //codes: comma-separated group code names, empty: all CTA-861 data blocks
+      rcode  LoadTemplate(const wxString& path, const wxString& codes);
+
+      splice_engine_cl();
+      ~splice_engine_cl();
+};
+
+#endif /* SPLICE_H */
@@ -0,0 +1,730 @@
+/***************************************************************
+ * Name:      synth.cpp
+ * Purpose:   EDID synthesizer: spec-driven, randomized variants
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-23
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idSYNTH
+   #error "synth.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idSYNTH
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "synth.h"
+#include "CEA.h"
+#include "CEA_EXT.h"
+
+#include <wx/file.h>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+static const char *syn_dbc_name[SYN_DBC_NTYPES] = {
+   "vdb", "adb", "sab", "hdmi", "vcdb", "hdr", "ifdb"
+};
+
+//VDB: common VICs, most popular first
+static const u8_t syn_vic_pool[] = {
+    16,   4,  31,  19,   3,   2,  97,  96,  95,  93,  94,  98,   5,  20,
+    34,  32,  33,   1,  17,  18,  63,  64,  39,  60,  61,  62,  99, 100,
+   101, 102, 103, 104, 105, 106, 107, 108, 117, 118,   6,   7,  21,  22
+};
+
+//ADB: Short Audio Descriptors
+static const u8_t syn_sad_pool[][3] = {
+   {0x09, 0x07, 0x07}, //LPCM, 2ch, 32-48kHz, 16-24bit
+   {0x0F, 0x7F, 0x07}, //LPCM, 8ch, 32-192kHz
+   {0x15, 0x07, 0x50}, //AC-3, 6ch, 640kbps
+   {0x3D, 0x06, 0xC0}, //DTS, 6ch, 1536kbps
+   {0x57, 0x06, 0x03}, //E-AC-3, 8ch
+   {0x5F, 0x7E, 0x01}, //DTS-HD, 8ch
+   {0x67, 0x54, 0x00}, //MAT (TrueHD), 8ch
+   {0x35, 0x07, 0x50}  //AAC, 6ch
+};
+
+static const u32_t syn_vic_cnt = sizeof(syn_vic_pool);
+static const u32_t syn_sad_cnt = sizeof(syn_sad_pool) / 3;
+
+//sRGB primaries & D65
+static const u8_t syn_chromxy[10] = {0xEE, 0x91, 0xA3, 0x54, 0x4C, 0x99, 0x26, 0x0F, 0x50, 0x54};
+
+edid_synth_cl::edid_synth_cl() :
+   prod(1), serial(1), week(1), year(2022), hsize(60), vsize(34), ndtd(0), ndbc(0),
+   b_shuffle(false), rnd_st(0), nseq(0)
+{
+   static const u32_t def_range[5] = {48, 75, 30, 83, 170};
+
+   strcpy(mfc , "WXE");
+   strcpy(name, "wxEDID SYNTH");
+   memcpy(range, def_range, sizeof(range));
+
+   memset(dtd_ar, 0, sizeof(dtd_ar));
+   memset(dbc_ar, 0, sizeof(dbc_ar));
+
+   EDID.SetGuiLogPtr(&tlog);
+   SetSeed(0);
+}
+
+void edid_synth_cl::SetSeed(u64_t seed) {
+   //xorshift64*: the state must not be zero
+   rnd_st  = seed ^ 0x9E3779B97F4A7C15ULL;
+   if (rnd_st == 0) rnd_st = 1;
+   nseq    = 0;
+}
+
+u32_t edid_synth_cl::rnd(u32_t range) {
+   rnd_st ^= rnd_st >> 12;
+   rnd_st ^= rnd_st << 25;
+   rnd_st ^= rnd_st >> 27;
+
+   return (u32_t) (((rnd_st * 0x2545F4914F6CDD1DULL) >> 32) % range);
+}
+
+rcode edid_synth_cl::LoadSpec(const wxString& path) {
+   rcode     retU;
+   wxFile    file;
+   wxString  spec;
+   wxString  line;
+   wxString  key;
+   wxString  val;
+   u32_t     nline = 0;
+
+   if (! file.Open(path, wxFile::read) ) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Can't open the spec file: %s", (const char*) path.ToUTF8());
+   }
+   if (! file.ReadAll(&spec)) RCD_RETURN_FAULT(retU);
+   file.Close();
+
+   ndtd = 0;
+   ndbc = 0;
+
+   wxStringTokenizer tokenz(spec, "\n", wxTOKEN_RET_EMPTY_ALL);
+
+   while (tokenz.HasMoreTokens()) {
+      line = tokenz.GetNextToken();
+      nline ++ ;
+
+      line = line.BeforeFirst('#');
+      line.Trim(true).Trim(false);
+      if (line.IsEmpty()) continue;
+
+      key = line.BeforeFirst(':');
+      val = line.AfterFirst (':');
+      key.Trim(true).Trim(false);
+      val.Trim(true).Trim(false);
+
+      retU = parse_line(nline, key.Lower(), val);
+      if (! RCD_IS_OK(retU)) return retU;
+   }
+
+   if (ndtd == 0) {
+      //CTA-861 VIC 16: 1920x1080p60
+      static const syn_dtd_t def_dtd = {148500, 1920, 280, 1080, 45, 88, 44, 4, 5};
+      dtd_ar[0] = def_dtd;
+      ndtd      = 1;
+   }
+
+   RCD_RETURN_OK(retU);
+}
+
+rcode edid_synth_cl::parse_line(u32_t line, const wxString& key, const wxString& val) {
+   rcode          retU;
+   unsigned long  nval[9];
+   u32_t          nv = 0;
+   wxString       tok;
+
+   wxStringTokenizer tokenz(val, " \t");
+
+   if (key == "mfc") {
+      if (val.Len() != 3) goto err;
+      for (u32_t itc=0; itc<3; itc++) {
+         char  chr;
+
+         chr = val.Upper()[itc];
+         if ((chr < 'A') || (chr > 'Z')) goto err;
+         mfc[itc] = chr;
+      }
+      RCD_RETURN_OK(retU);
+   }
+   if (key == "name") {
+      memset(name, 0, sizeof(name));
+      strncpy(name, (const char*) val.ToAscii(), sizeof(name)-1);
+      RCD_RETURN_OK(retU);
+   }
+
+   if (key == "dbc") {
+      syn_dbc_t  *pdbc;
+      u32_t       type;
+
+      if (ndbc >= SYN_MAX_DBC) goto err;
+      pdbc = &dbc_ar[ndbc];
+      memset(pdbc, 0, sizeof(syn_dbc_t));
+
+      tok = tokenz.GetNextToken().Lower();
+      for (type=0; type<SYN_DBC_NTYPES; type++) {
+         if (tok == syn_dbc_name[type]) break;
+      }
+      if (type >= SYN_DBC_NTYPES) goto err;
+      pdbc->type = type;
+
+      while (tokenz.HasMoreTokens()) {
+         tok = tokenz.GetNextToken().Lower();
+
+         if (tok == "optional") {
+            pdbc->b_opt = true;
+            continue;
+         }
+         //count or count range: min-max
+         if (! tok.BeforeFirst('-').ToULong(&nval[0])) goto err;
+         nval[1] = nval[0];
+         if (tok.Find('-') != wxNOT_FOUND) {
+            if (! tok.AfterFirst('-').ToULong(&nval[1])) goto err;
+         }
+         if (nval[1] < nval[0]) goto err;
+
+         pdbc->min_cnt = nval[0];
+         pdbc->max_cnt = nval[1];
+      }
+
+      //count limits: pool sizes & 31 bytes max. block size
+      switch (type) {
+         case SYN_DBC_VDB:
+            if (pdbc->min_cnt == 0) pdbc->min_cnt = 1;
+            if (pdbc->max_cnt < pdbc->min_cnt) pdbc->max_cnt = pdbc->min_cnt;
+            if (pdbc->max_cnt > 31) goto err;
+            break;
+         case SYN_DBC_ADB:
+            if (pdbc->min_cnt == 0) pdbc->min_cnt = 1;
+            if (pdbc->max_cnt < pdbc->min_cnt) pdbc->max_cnt = pdbc->min_cnt;
+            if (pdbc->max_cnt > syn_sad_cnt) goto err;
+            break;
+         case SYN_DBC_HDR:
+            if (pdbc->max_cnt > 1) goto err;
+            break;
+         default:
+            pdbc->min_cnt = 0;
+            pdbc->max_cnt = 0;
+            break;
+      }
+
+      ndbc ++ ;
+      RCD_RETURN_OK(retU);
+   }
+
+   //numeric values
+   while (tokenz.HasMoreTokens()) {
+      if (nv >= 9) goto err;
+      tok = tokenz.GetNextToken();
+      if (! tok.ToULong(&nval[nv], 0)) goto err;
+      nv ++ ;
+   }
+
+   if (key == "product") {
+      if ((nv != 1) || (nval[0] > 0xFFFF)) goto err;
+      prod = nval[0];
+   } else if (key == "serial") {
+      if (nv != 1) goto err;
+      serial = nval[0];
+   } else if (key == "week") {
+      if ((nv != 1) || (nval[0] > 54)) goto err;
+      week = nval[0];
+   } else if (key == "year") {
+      if ((nv != 1) || (nval[0] < 1990) || (nval[0] > 2245)) goto err;
+      year = nval[0];
+   } else if (key == "size") {
+      if ((nv != 2) || (nval[0] > 255) || (nval[1] > 255)) goto err;
+      hsize = nval[0];
+      vsize = nval[1];
+   } else if (key == "range") {
+      if (nv != 5) goto err;
+      for (u32_t itv=0; itv<5; itv++) {
+         if ((nval[itv] == 0) || (nval[itv] > 2550)) goto err;
+         range[itv] = nval[itv];
+      }
+      if ((range[0] > 255) || (range[1] > 255) || (range[2] > 255) || (range[3] > 255)) goto err;
+   } else if (key == "dtd") {
+      syn_dtd_t *pdtd;
+
+      if ((nv != 9) || (ndtd >= SYN_MAX_DTD)) goto err;
+      //pixclk in kHz: stored in 10kHz units, 12-bit active/blank, 10-bit H-sync, 6-bit V-sync fields
+      if ((nval[0] < 10) || (nval[0] > 655350)) goto err;
+      if ((nval[1] > 4095) || (nval[2] > 4095) || (nval[3] > 4095) || (nval[4] > 4095)) goto err;
+      if ((nval[5] > 1023) || (nval[6] > 1023) || (nval[7] > 63) || (nval[8] > 63)) goto err;
+
+      pdtd = &dtd_ar[ndtd];
+      pdtd->pixclk = nval[0];
+      pdtd->hact   = nval[1];
+      pdtd->hbl    = nval[2];
+      pdtd->vact   = nval[3];
+      pdtd->vbl    = nval[4];
+      pdtd->hso    = nval[5];
+      pdtd->hsw    = nval[6];
+      pdtd->vso    = nval[7];
+      pdtd->vsw    = nval[8];
+      ndtd ++ ;
+   } else if (key == "shuffle") {
+      if (nv != 1) goto err;
+      b_shuffle = (nval[0] != 0);
+   } else {
+      goto err;
+   }
+
+   RCD_RETURN_OK(retU);
+
+err:
+   wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Synth spec, line %u: invalid '%s' entry", line, (const char*) key.ToUTF8());
+}
+
+u32_t edid_synth_cl::dbc_size(u32_t type, u32_t cnt) {
+   switch (type) {
+      case SYN_DBC_VDB:
+         return (1 + cnt);
+      case SYN_DBC_ADB:
+         return (1 + cnt * 3);
+      case SYN_DBC_SAB:
+         return 4;
+      case SYN_DBC_HDMI:
+         return 6;
+      case SYN_DBC_VCDB:
+         return 3;
+      case SYN_DBC_HDR:
+         return (cnt > 0) ? 7 : 4;
+      case SYN_DBC_IFDB:
+         return 5;
+      default:
+         return 0;
+   }
+}
+
+void edid_synth_cl::put_dtd(u8_t *pdst, const syn_dtd_t& dtd) {
+   dtd_t  *pdtd;
+   u32_t   hsz;
+   u32_t   vsz;
+
+   pdtd = reinterpret_cast <dtd_t*> (pdst);
+   memset(pdtd, 0, sizeof(dtd_t));
+
+   pdtd->pix_clk     = (dtd.pixclk / 10);
+   pdtd->HApix_8lsb  = (dtd.hact & 0xFF);
+   pdtd->HApix_4msb  = (dtd.hact >> 8);
+   pdtd->HBpix_8lsb  = (dtd.hbl  & 0xFF);
+   pdtd->HBpix_4msb  = (dtd.hbl  >> 8);
+   pdtd->VAlin_8lsb  = (dtd.vact & 0xFF);
+   pdtd->VAlin_4msb  = (dtd.vact >> 8);
+   pdtd->VBlin_8lsb  = (dtd.vbl  & 0xFF);
+   pdtd->VBlin_4msb  = (dtd.vbl  >> 8);
+   pdtd->HOsync_8lsb = (dtd.hso  & 0xFF);
+   pdtd->HOsync_2msb = (dtd.hso  >> 8);
+   pdtd->HsyncW_8lsb = (dtd.hsw  & 0xFF);
+   pdtd->HsyncW_2msb = (dtd.hsw  >> 8);
+   pdtd->VOsync_4lsb = (dtd.vso  & 0x0F);
+   pdtd->VOsync_2msb = (dtd.vso  >> 4);
+   pdtd->VsyncW_4lsb = (dtd.vsw  & 0x0F);
+   pdtd->VsyncW_2msb = (dtd.vsw  >> 4);
+
+   //image size in mm
+   hsz = hsize * 10;
+   vsz = vsize * 10;
+   pdtd->Hsize_8lsb  = (hsz & 0xFF);
+   pdtd->Hsize_4msb  = (hsz >> 8);
+   pdtd->Vsize_8lsb  = (vsz & 0xFF);
+   pdtd->Vsize_4msb  = (vsz >> 8);
+
+   //digital separate sync, +H +V
+   pdtd->features.sync_type  = 3;
+   pdtd->features.Hsync_type = 1;
+   pdtd->features.Vsync_type = 1;
+}
+
+void edid_synth_cl::put_text(u8_t *pdst, u32_t type, const char *text) {
+   mnd_t  *pmnd;
+   u32_t   itc;
+
+   pmnd = reinterpret_cast <mnd_t*> (pdst);
+   memset(pmnd, 0, sizeof(mnd_t));
+
+   pmnd->desc_type = type;
+
+   //padded with 0A 20 20 ...
+   for (itc=0; (itc<13) && (text[itc] != 0); itc++) {
+      pmnd->text[itc] = text[itc];
+   }
+   if (itc < 13) pmnd->text[itc++] = 0x0A;
+   for (; itc<13; itc++) {
+      pmnd->text[itc] = 0x20;
+   }
+}
+
+void edid_synth_cl::put_base(edid_t *pbase, u32_t n_ext) {
+   static const u8_t hdr[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+
+   u8_t     *pb8;
+   u32_t     mfc16;
+   u32_t     nd;
+   char      sn_str[14];
+   mrl_t    *pmrl;
+
+   pb8 = reinterpret_cast <u8_t*> (pbase);
+   memcpy(pb8, hdr, 8);
+
+   //PNP ID: big-endian
+   mfc16  = (mfc[0] - '@') << 10;
+   mfc16 |= (mfc[1] - '@') << 5;
+   mfc16 |= (mfc[2] - '@');
+   pbase->mfc_id.ar8[0] = (mfc16 >> 8);
+   pbase->mfc_id.ar8[1] = (mfc16 & 0xFF);
+
+   pbase->prod_id   = prod;
+   pbase->serial    = serial + nseq;
+   pbase->prodweek  = week;
+   pbase->year      = (year - 1990);
+   pbase->edid_ver  = 1;
+   pbase->edid_rev  = 3;
+
+   pbase->vinput_dsc.digital.input_type = 1;
+   pbase->bdd.max_hsize = hsize;
+   pbase->bdd.max_vsize = vsize;
+   pbase->bdd.gamma     = 120; //2.2
+
+   //RGB 4:4:4 + YCrCb 4:4:4, preferred timing in DTD1
+   pbase->features.vsig_format = 1;
+   pbase->features.db1_fnative = 1;
+
+   memcpy(&pbase->chromxy, syn_chromxy, sizeof(chromxy_t));
+
+   //640x480@60, 800x600@60, 1024x768@60
+   pb8[35] = 0x21;
+   pb8[36] = 0x08;
+   pb8[37] = 0x00;
+
+   //std timings: not used
+   for (u32_t its=0; its<8; its++) {
+      pb8[38 + its*2    ] = 0x01;
+      pb8[38 + its*2 + 1] = 0x01;
+   }
+
+   //descriptors: DTD, DTD|MSN, MRL, MND
+   put_dtd(pbase->descriptor0.bytes, dtd_ar[0]);
+   if (ndtd > 1) {
+      put_dtd(pbase->descriptor1.bytes, dtd_ar[1]);
+   } else {
+      snprintf(sn_str, sizeof(sn_str), "SN%08u", (serial + nseq));
+      put_text(pbase->descriptor1.bytes, 0xFF, sn_str);
+   }
+
+   pmrl = &pbase->descriptor2.mrl;
+   memset(pmrl, 0, sizeof(mrl_t));
+   pmrl->desc_type  = 0xFD;
+   pmrl->min_Vfreq  = range[0];
+   pmrl->max_Vfreq  = range[1];
+   pmrl->min_Hfreq  = range[2];
+   pmrl->max_Hfreq  = range[3];
+   pmrl->max_pixclk = ((range[4] + 9) / 10);
+   pmrl->extd_timg  = 0;
+   pb8  = reinterpret_cast <u8_t*> (pmrl);
+   pb8[11] = 0x0A;
+   for (nd=12; nd<18; nd++) pb8[nd] = 0x20;
+
+   put_text(pbase->descriptor3.bytes, 0xFC, name);
+
+   pbase->num_extblk = n_ext;
+}
+
+u32_t edid_synth_cl::put_dbc(u8_t *pdst, u32_t type, u32_t cnt) {
+   u32_t  dsz;
+   u32_t  pick[syn_vic_cnt];
+
+   dsz = dbc_size(type, cnt);
+
+   switch (type) {
+      case SYN_DBC_VDB:
+      case SYN_DBC_ADB:
+         {
+            u32_t  npool;
+
+            npool = (type == SYN_DBC_VDB) ? syn_vic_cnt : syn_sad_cnt;
+            //(cnt) distinct entries: partial Fisher-Yates, the most popular entries are picked first
+            for (u32_t itp=0; itp<npool; itp++) pick[itp] = itp;
+            for (u32_t itp=0; itp<cnt; itp++) {
+               u32_t  sel;
+               u32_t  tmp;
+
+               sel = itp;
+               if (rnd(4) == 0) sel += rnd(npool - itp);
+               tmp       = pick[itp];
+               pick[itp] = pick[sel];
+               pick[sel] = tmp;
+            }
+
+            if (type == SYN_DBC_VDB) {
+               pdst[0] = (DBC_T_VDB << 5) | cnt;
+               for (u32_t itp=0; itp<cnt; itp++) {
+                  pdst[1 + itp] = syn_vic_pool[pick[itp]];
+               }
+               //native flag: VIC 1-64 only
+               if (pdst[1] <= 64) pdst[1] |= 0x80;
+            } else {
+               pdst[0] = (DBC_T_ADB << 5) | (cnt * 3);
+               for (u32_t itp=0; itp<cnt; itp++) {
+                  memcpy(&pdst[1 + itp*3], syn_sad_pool[pick[itp]], 3);
+               }
+            }
+         }
+         break;
+      case SYN_DBC_SAB:
+         pdst[0] = (DBC_T_SAB << 5) | 3;
+         pdst[1] = 0x01; //FL/FR
+         pdst[2] = 0x00;
+         pdst[3] = 0x00;
+         break;
+      case SYN_DBC_HDMI:
+         pdst[0] = (DBC_T_VSD << 5) | 5;
+         pdst[1] = 0x03; //OUI 00-0C-03, LE
+         pdst[2] = 0x0C;
+         pdst[3] = 0x00;
+         pdst[4] = 0x10; //phys. address 1.0.0.0
+         pdst[5] = 0x00;
+         break;
+      case SYN_DBC_VCDB:
+         pdst[0] = (DBC_T_EXT << 5) | 2;
+         pdst[1] = DBC_EXT_VCDB;
+         pdst[2] = 0x40; //QS: selectable RGB quantization range
+         break;
+      case SYN_DBC_HDR:
+         pdst[0] = (DBC_T_EXT << 5) | (dsz -1);
+         pdst[1] = DBC_EXT_HDRS;
+         pdst[2] = 0x05; //EOTF: SDR, SMPTE ST 2084
+         pdst[3] = 0x01; //Static Metadata Type 1
+         if (cnt > 0) {
+            pdst[4] = 0x60 + rnd(0x20); //max. luminance
+            pdst[5] = 0x40 + rnd(0x20); //max. frame-average luminance
+            pdst[6] = rnd(0x40);        //min. luminance
+         }
+         break;
+      case SYN_DBC_IFDB:
+         pdst[0] = (DBC_T_EXT << 5) | 4;
+         pdst[1] = DBC_EXT_IFDB;
+         pdst[2] = 0x00; //IFPDH: no payload
+         pdst[3] = 0x00; //no additional VSIFs
+         pdst[4] = 0x02; //Short InfoFrame Descriptor: AVI
+         break;
+      default:
+         break;
+   }
+   return dsz;
+}
+
+rcode edid_synth_cl::Generate(u8_t *pbuf, u32_t& len) {
+   rcode   retU;
+   u32_t   order[SYN_MAX_DBC];
+   u32_t   cnt  [SYN_MAX_DBC];
+   u32_t   nsel = 0;
+   u32_t   n_cea_dtd;
+   u32_t   n_ext;
+   u32_t   n_ext_rd;
+   u32_t   dsz;
+   u8_t   *pext;
+   u8_t   *pdat;
+
+   len = 0;
+
+   //variant: optional blocks & counts
+   for (u32_t itd=0; itd<ndbc; itd++) {
+      if (dbc_ar[itd].b_opt && (rnd(2) == 0)) continue;
+
+      order[nsel] = itd;
+      cnt  [nsel] = dbc_ar[itd].min_cnt;
+      cnt  [nsel] += rnd(dbc_ar[itd].max_cnt - dbc_ar[itd].min_cnt +1);
+      nsel ++ ;
+   }
+   if (b_shuffle) {
+      for (u32_t itd=nsel; itd>1; itd--) {
+         u32_t  sel;
+         u32_t  tmp;
+
+         sel = rnd(itd);
+         tmp = order[itd-1]; order[itd-1] = order[sel]; order[sel] = tmp;
+         tmp = cnt  [itd-1]; cnt  [itd-1] = cnt  [sel]; cnt  [sel] = tmp;
+      }
+   }
+
+   //fit the DBCs & DTDs into the CTA-861 block:
+   //extra DTDs are dropped first, then optional blocks, then the VDB/ADB sizes are reduced.
+   n_cea_dtd = (ndtd > 2) ? (ndtd - 2) : 0;
+   for (;;) {
+      i32_t  idx_opt = -1;
+      i32_t  idx_big = -1;
+      u32_t  sz_big  =  0;
+
+      dsz = 0;
+      for (u32_t itd=0; itd<nsel; itd++) {
+         u32_t  type;
+         u32_t  bsz;
+
+         type = dbc_ar[order[itd]].type;
+         bsz  = dbc_size(type, cnt[itd]);
+         dsz += bsz;
+
+         if (dbc_ar[order[itd]].b_opt) idx_opt = itd;
+         if ((type == SYN_DBC_VDB) || (type == SYN_DBC_ADB)) {
+            if ((cnt[itd] > 1) && (bsz > sz_big)) {
+               idx_big = itd;
+               sz_big  = bsz;
+            }
+         }
+      }
+      if ((dsz + n_cea_dtd * sizeof(dtd_t)) <= SYN_CEA_DATA) break;
+
+      if (n_cea_dtd > 0) {
+         n_cea_dtd -- ;
+         continue;
+      }
+      if (idx_opt >= 0) {
+         nsel -- ;
+         for (u32_t itd=idx_opt; itd<nsel; itd++) {
+            order[itd] = order[itd+1];
+            cnt  [itd] = cnt  [itd+1];
+         }
+         continue;
+      }
+      if (idx_big < 0) {
+         wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Synth: DBCs don't fit in the CTA-861 block: %u bytes", dsz);
+      }
+      cnt[idx_big] -- ;
+   }
+
+   n_ext = ((nsel > 0) || (n_cea_dtd > 0)) ? 1 : 0;
+
+   EDID.Clear();
+   put_base(&EDID.getEDID()->edi.base, n_ext);
+
+   if (n_ext > 0) {
+      cea_hdr_t  *phdr;
+
+      pext = EDID.getEDID()->blk[EDI_EXT0_IDX];
+      phdr = reinterpret_cast <cea_hdr_t*> (pext);
+
+      phdr->ext_tag  = 0x02;
+      phdr->rev      = 0x03;
+      phdr->dtd_offs = offsetof(cea_hdr_t, dta_start) + dsz;
+      phdr->info_blk.basic_audio = 1;
+      phdr->info_blk.ycbcr444    = 1;
+      phdr->info_blk.ycbcr422    = 1;
+
+      pdat = pext + offsetof(cea_hdr_t, dta_start);
+      for (u32_t itd=0; itd<nsel; itd++) {
+         pdat += put_dbc(pdat, dbc_ar[order[itd]].type, cnt[itd]);
+      }
+      for (u32_t itd=0; itd<n_cea_dtd; itd++) {
+         put_dtd(pdat, dtd_ar[2 + itd]);
+         pdat += sizeof(dtd_t);
+      }
+   }
+
+   //through the group classes: errors are not ignored, the groups re-assemble the blocks
+   EDID.Set_ERR_Ignore(false);
+
+   retU = EDID.ParseEDID_Base(n_ext_rd);
+   if (! RCD_IS_OK(retU)) goto out;
+
+   if (n_ext > 0) {
+      retU = EDID.ParseEDID_CEA();
+      if (! RCD_IS_OK(retU)) goto out;
+   }
+
+   retU = EDID.AssembleEDID();
+   if (! RCD_IS_OK(retU)) goto out;
+
+   for (u32_t itb=0; itb<=n_ext; itb++) {
+      EDID.genChksum(itb);
+   }
+
+   len = (n_ext + 1) * EDI_BLK_SIZE;
+   memcpy(pbuf, EDID.getEDID()->buff, len);
+
+out:
+   EDID.DeleteGroups();
+   nseq ++ ;
+
+   return retU;
+}
+
+rcode edid_synth_cl::Run(const wxString& spec, u32_t count, u64_t seed, const wxString& outdir, FILE *out) {
+   rcode            retU;
+   edid_synth_cl   *synth;
+   edi_buf_t        ebuf;
+   wxString         fpath;
+   u32_t            len;
+   u32_t            nfail = 0;
+   struct timespec  ts0;
+   struct timespec  ts1;
+   double           secs  = 0.0;
+
+   //EDID_cl is too big for the stack
+   synth = new edid_synth_cl;
+   if (synth == NULL) RCD_RETURN_FAULT(retU);
+
+   retU = synth->LoadSpec(spec);
+   if (! RCD_IS_OK(retU)) goto exit;
+
+   synth->SetSeed(seed);
+
+   if (! outdir.IsEmpty() && ! wxDirExists(outdir)) {
+      if (! wxFileName::Mkdir(outdir, 0755, wxPATH_MKDIR_FULL)) {
+         wxedid_RCD_SET_FAULT_VMSG(retU, "[E!] Can't create the output directory: %s", (const char*) outdir.ToUTF8());
+         goto exit;
+      }
+   }
+
+   for (u32_t itn=0; itn<count; itn++) {
+      rcode  retU2;
+
+      clock_gettime(CLOCK_MONOTONIC, &ts0);
+      retU2 = synth->Generate(ebuf.buff, len);
+      clock_gettime(CLOCK_MONOTONIC, &ts1);
+
+      secs += (ts1.tv_sec - ts0.tv_sec);
+      secs += (ts1.tv_nsec - ts0.tv_nsec) / 1e9;
+
+      if (! RCD_IS_OK(retU2)) {
+         nfail ++ ;
+         continue;
+      }
+      if (outdir.IsEmpty()) continue;
+
+      {
+         wxFile  file;
+
+         fpath.Printf("%s/synth_%08u.bin", outdir, itn);
+         if (! file.Create(fpath, true)) {
+            wxedid_RCD_SET_FAULT_VMSG(retU, "[E!] Can't create file: %s", (const char*) fpath.ToUTF8());
+            goto exit;
+         }
+         if (file.Write(ebuf.buff, len) != (size_t) len) {
+            wxedid_RCD_SET_FAULT_VMSG(retU, "[E!] Can't write file: %s", (const char*) fpath.ToUTF8());
+            goto exit;
+         }
+      }
+   }
+
+   fprintf(out, "%u EDID(s), %u failed, seed %llu: generation %.3f s", count, nfail, (unsigned long long) seed, secs);
+   if (secs > 0.0) fprintf(out, ", %.0f EDIDs/s", count / secs);
+   fprintf(out, "\n");
+
+   if (nfail > 0) RCD_SET_FAULT(retU);
+
+exit:
+   delete synth;
+   return retU;
+}
@@ -0,0 +1,110 @@
+/***************************************************************
+ * Name:      synth.h
+ * Purpose:   EDID synthesizer: spec-driven, randomized variants
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-23
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef SYNTH_H
+#define SYNTH_H 1
+
+#include <wx/string.h>
+#include <stdio.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+#include "guilog.h"
+
+enum {
+   SYN_MAX_DTD  = 6,  //2 in the base block, the rest in the CTA-861 block
+   SYN_MAX_DBC  = 16,
+   SYN_CEA_DATA = (EDI_BLK_SIZE - 4 -1) //CTA-861 block: DBC + DTD space
+};
+
+enum { //DBC types
+   SYN_DBC_VDB  = 0, //count: SVDs
+   SYN_DBC_ADB  = 1, //count: SADs
+   SYN_DBC_SAB  = 2,
+   SYN_DBC_HDMI = 3, //HDMI VSD
+   SYN_DBC_VCDB = 4,
+   SYN_DBC_HDR  = 5, //count: 0/1: optional luminance bytes
+   SYN_DBC_IFDB = 6,
+   SYN_DBC_NTYPES
+};
+
+typedef struct {
+   u32_t  type;
+   u32_t  min_cnt;
+   u32_t  max_cnt;
+   bool   b_opt;    //included in ~50% of the variants
+} syn_dbc_t;
+
+typedef struct {
+   u32_t  pixclk;   //kHz
+   u32_t  hact;
+   u32_t  hbl;
+   u32_t  vact;
+   u32_t  vbl;
+   u32_t  hso;
+   u32_t  hsw;
+   u32_t  vso;
+   u32_t  vsw;
+} syn_dtd_t;
+
+//Spec: "key: values" lines, '#' comments:
+//   mfc: ABC / product: 0x1234 / serial: 1 / week: 1 / year: 2022 / name: TEXT / size: <h_cm> <v_cm>
+//   dtd: <pixclk_kHz> <hact> <hblank> <vact> <vblank> <hsync_offs> <hsync_w> <vsync_offs> <vsync_w>
+//   range: <vmin_Hz> <vmax_Hz> <hmin_kHz> <hmax_kHz> <pixclk_max_MHz>
+//   dbc: <vdb|adb|sab|hdmi|vcdb|hdr|ifdb> [<min>[-<max>]] [optional]
+//   shuffle: 0|1
+//The first DTD is the preferred timing.
+class edid_synth_cl {
+   protected:
+      char        mfc[4];
+      u32_t       prod;
+      u32_t       serial;
+      u32_t       week;
+      u32_t       year;
+      char        name[14];
+      u32_t       hsize;
+      u32_t       vsize;
+      u32_t       range[5];
+      syn_dtd_t   dtd_ar[SYN_MAX_DTD];
+      u32_t       ndtd;
+      syn_dbc_t   dbc_ar[SYN_MAX_DBC];
+      u32_t       ndbc;
+      bool        b_shuffle;
+
+      u64_t       rnd_st;
+      u32_t       nseq;   //variant number: serial number offset
+
+      EDID_cl     EDID;
+      guilog_cl   tlog;
+
+      u32_t  rnd     (u32_t range);
+      rcode  parse_line(u32_t line, const wxString& key, const wxString& val);
+
+      void   put_base(edid_t *pbase, u32_t n_ext);
+      void   put_dtd (u8_t *pdst, const syn_dtd_t& dtd);
+      void   put_text(u8_t *pdst, u32_t type, const char *text);
+      u32_t  put_dbc (u8_t *pdst, u32_t type, u32_t cnt);
+
+      static u32_t dbc_size(u32_t type, u32_t cnt);
+
+   public:
+      rcode LoadSpec(const wxString& path);
+      void  SetSeed (u64_t seed);
+
+      //next variant: (len) bytes written to pbuf, sizeof(edi_buf_t) min.
+      rcode Generate(u8_t *pbuf, u32_t& len);
+
+      //batch mode: (count) EDIDs written to (outdir), if not empty
+      static rcode Run(const wxString& spec, u32_t count, u64_t seed, const wxString& outdir, FILE *out);
+
+      edid_synth_cl();
+};
+
+#endif /* SYNTH_H */
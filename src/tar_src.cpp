@@ -0,0 +1,129 @@
+/***************************************************************
+ * Name:      tar_src.cpp
+ * Purpose:   EDID source: members of tar / tar.gz archives
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-09
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idTAR_SRC
+   #error "tar_src.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idTAR_SRC
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "tar_src.h"
+
+tar_src_cl::tar_src_cl() : fstrm(NULL), zstrm(NULL), tstrm(NULL) {}
+
+tar_src_cl::~tar_src_cl() {
+   Close();
+}
+
+bool tar_src_cl::IsArchive(const wxString& path) {
+   wxString  lpath;
+
+   lpath = path.Lower();
+   return (lpath.EndsWith(".tar") || lpath.EndsWith(".tar.gz") || lpath.EndsWith(".tgz"));
+}
+
+rcode tar_src_cl::Open(const wxString& path) {
+   rcode          retU;
+   u8_t           magic[2];
+   wxInputStream *src;
+
+   Close();
+
+   fstrm = new wxFFileInputStream(path);
+   if (fstrm == NULL) RCD_RETURN_FAULT(retU);
+   if (! fstrm->IsOk()) goto fail;
+
+   //gzip magic: 1F 8B
+   if (fstrm->Read(magic, 2).LastRead() != 2) goto fail;
+   if (fstrm->SeekI(0) == wxInvalidOffset) goto fail;
+
+   src = fstrm;
+   if ((magic[0] == 0x1F) && (magic[1] == 0x8B)) {
+      zstrm = new wxZlibInputStream(*fstrm, wxZLIB_GZIP);
+      if (zstrm == NULL) goto fail;
+      if (! zstrm->IsOk()) goto fail;
+      src = zstrm;
+   }
+
+   tstrm = new wxTarInputStream(*src);
+   if (tstrm == NULL) goto fail;
+   if (! tstrm->IsOk()) goto fail;
+
+   RCD_RETURN_OK(retU);
+
+fail:
+   Close();
+   wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Not a tar archive: %s", (const char*) path.ToUTF8());
+}
+
+void tar_src_cl::Close() {
+   //the streams are not owned by the filters: delete in reverse order
+   if (tstrm != NULL) {
+      delete tstrm;
+      tstrm = NULL;
+   }
+   if (zstrm != NULL) {
+      delete zstrm;
+      zstrm = NULL;
+   }
+   if (fstrm != NULL) {
+      delete fstrm;
+      fstrm = NULL;
+   }
+}
+
+rcode tar_src_cl::Next(wxString& name, u8_t *pbuf, u32_t bsz, u32_t& len, u64_t& size, bool& b_end) {
+   rcode        retU;
+   wxTarEntry  *entry;
+
+   len   = 0;
+   size  = 0;
+   b_end = true;
+   name.Empty();
+
+   if (tstrm == NULL) RCD_RETURN_FAULT(retU);
+
+   for (;;) {
+      //skips the unread data of the previous member
+      entry = tstrm->GetNextEntry();
+      if (entry == NULL) {
+         if (tstrm->Eof()) RCD_RETURN_OK(retU);
+         RCD_RETURN_FAULT(retU);
+      }
+
+      //regular files only: directories, links, devices, etc. are skipped
+      if (entry->IsDir() ||
+          ((entry->GetTypeFlag() != wxTAR_REGTYPE) &&
+           (entry->GetTypeFlag() != wxTAR_AREGTYPE)) ) {
+         delete entry;
+         continue;
+      }
+      break;
+   }
+
+   name  = entry->GetName(wxPATH_UNIX);
+   size  = entry->GetSize();
+   b_end = false;
+   delete entry;
+
+   tstrm->Read(pbuf, bsz);
+   len = tstrm->LastRead();
+
+   if ((len < size) && (len < bsz)) {
+      wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Archive member truncated: %s", (const char*) name.ToUTF8());
+   }
+
+   RCD_RETURN_OK(retU);
+}
@@ -0,0 +1,44 @@
+/***************************************************************
+ * Name:      tar_src.h
+ * Purpose:   EDID source: members of tar / tar.gz archives
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-07-09
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef TAR_SRC_H
+#define TAR_SRC_H 1
+
+#include <wx/wfstream.h>
+#include <wx/zstream.h>
+#include <wx/tarstrm.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+
+//Sequential reader: the archive is never extracted, only the data of the current
+//member is read, into the caller's buffer. gzip compression is detected from the
+//file contents.
+class tar_src_cl {
+   protected:
+      wxFFileInputStream  *fstrm;
+      wxZlibInputStream   *zstrm;
+      wxTarInputStream    *tstrm;
+
+   public:
+      rcode Open (const wxString& path);
+      void  Close();
+
+      //next regular file: name, data (max bsz bytes) & member size.
+      //b_end: no more members. The rest of a member longer than bsz is skipped.
+      rcode Next(wxString& name, u8_t *pbuf, u32_t bsz, u32_t& len, u64_t& size, bool& b_end);
+
+      //*.tar, *.tar.gz, *.tgz
+      static bool IsArchive(const wxString& path);
+
+      tar_src_cl();
+      ~tar_src_cl();
+};
+
+#endif /* TAR_SRC_H */
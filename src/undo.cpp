@@ -0,0 +1,349 @@
+/***************************************************************
+ * Name:      undo.cpp
+ * Purpose:   Edit history: undo/redo snapshots of the EDID groups
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-04
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#include "debug.h"
+#include "rcdunits.h"
+#ifndef idUNDO
+   #error "undo.cpp: missing unit ID"
+#endif
+#define RCD_UNIT idUNDO
+#include "rcode/rcode.h"
+
+#include "wxedid_rcd_scope.h"
+
+RCD_AUTOGEN_DEFINE_UNIT
+
+#include "undo.h"
+
+//header + sub-groups data, the same as written by EDID_cl::AssembleEDID()
+u32_t undo_stack_cl::GroupImage(edi_grp_cl *pgrp, u8_t *pimg) {
+   u32_t  offs;
+   u32_t  dsz;
+
+   offs = pgrp->getDataSize();
+   if (offs > UNDO_IMG_SZ) offs = UNDO_IMG_SZ;
+   memcpy(pimg, pgrp->getInsPtr(), offs);
+
+   for (u32_t its=0; its<pgrp->getSubGrpCount(); its++) {
+      edi_grp_cl *psubg;
+
+      psubg = pgrp->getSubGroup(its);
+      dsz   = psubg->getDataSize();
+      if ((offs + dsz) > UNDO_IMG_SZ) break;
+
+      memcpy(&pimg[offs], psubg->getInsPtr(), dsz);
+      offs += dsz;
+   }
+
+   return offs;
+}
+
+bool undo_stack_cl::Equal(edi_grp_cl *pgrp, undo_grp_t *pfrz) {
+   u8_t   img[UNDO_IMG_SZ];
+   u32_t  isz;
+
+   if (pgrp->getTypeID()      != pfrz->type_id) return false;
+   if (pgrp->getSubGrpCount() != pfrz->nsubg  ) return false;
+
+   isz = GroupImage(pgrp, img);
+   if (isz != pfrz->img_sz) return false;
+
+   return (0 == memcmp(img, pfrz->img, isz));
+}
+
+bool undo_stack_cl::CanCopyTo(edi_grp_cl *pgrp, undo_grp_t *pfrz) {
+
+   if (pgrp->getTypeID()      != pfrz->type_id) return false;
+   if (pgrp->getDataSize()    != pfrz->hdr_sz ) return false;
+   if (pgrp->getSubGrpCount() != pfrz->nsubg  ) return false;
+
+   for (u32_t its=0; its<pfrz->nsubg; its++) {
+      edi_grp_cl *psubg;
+
+      psubg = pgrp->getSubGroup(its);
+      if (psubg->getTypeID()   != pfrz->subg_tid[its]) return false;
+      if (psubg->getDataSize() != pfrz->subg_sz [its]) return false;
+   }
+   return true;
+}
+
+//the fields are re-read from the instance data, EF_FGR groups re-generate the field layout
+rcode undo_stack_cl::CopyTo(edi_grp_cl *pgrp, undo_grp_t *pfrz) {
+   rcode  retU;
+   rcode  retU2;
+   u32_t  offs;
+
+   memcpy(pgrp->getInsPtr(), pfrz->img, pfrz->img_sz);
+   retU = pgrp->ForcedGroupRefresh();
+
+   offs = pfrz->hdr_sz;
+
+   for (u32_t its=0; its<pfrz->nsubg; its++) {
+      edi_grp_cl *psubg;
+
+      psubg = pgrp->getSubGroup(its);
+      memcpy(psubg->getInsPtr(), &pfrz->img[offs], pfrz->subg_sz[its]);
+      offs += pfrz->subg_sz[its];
+
+      retU2 = psubg->ForcedGroupRefresh();
+      if (! RCD_IS_OK(retU2)) retU = retU2;
+   }
+
+   return retU;
+}
+
+void undo_stack_cl::Diff(GroupAr_cl *p_grp_ar, undo_grp_t **frz_ar, u32_t nfrz,
+                         u32_t& first, u32_t& last, u32_t& flast) {
+   u32_t  ngrp;
+
+   ngrp  = p_grp_ar->GetCount();
+   first = 0;
+
+   while ((first < ngrp) && (first < nfrz)) {
+      if (! Equal(p_grp_ar->Item(first), frz_ar[first])) break;
+      first ++ ;
+   }
+
+   last  = ngrp;
+   flast = nfrz;
+
+   while ((last > first) && (flast > first)) {
+      if (! Equal(p_grp_ar->Item(last -1), frz_ar[flast -1])) break;
+      last  -- ;
+      flast -- ;
+   }
+}
+
+undo_grp_t* undo_stack_cl::freeze(edi_grp_cl *pgrp) {
+   rcode        retU;
+   undo_grp_t  *pfrz;
+   u32_t        nsubg;
+
+   nsubg = pgrp->getSubGrpCount();
+   if (nsubg > UNDO_IMG_SZ) return NULL;
+
+   pfrz = new undo_grp_t;
+   if (pfrz == NULL) return NULL;
+
+   pfrz->type_id = pgrp->getTypeID();
+   pfrz->hdr_sz  = pgrp->getDataSize();
+   pfrz->nsubg   = nsubg;
+   pfrz->img_sz  = GroupImage(pgrp, pfrz->img);
+   pfrz->refcnt  = 1;
+
+   for (u32_t its=0; its<nsubg; its++) {
+      edi_grp_cl *psubg;
+
+      psubg = pgrp->getSubGroup(its);
+      pfrz->subg_sz [its] = psubg->getDataSize();
+      pfrz->subg_tid[its] = psubg->getTypeID();
+   }
+
+   //Clone() re-initializes the group from the local data buffer:
+   //sub-groups keep their own data copy, which can be changed in the meantime.
+   if (nsubg > 0) {
+      retU = pgrp->AssembleGroup();
+      if (! RCD_IS_OK(retU)) {
+         pfrz->proto = NULL;
+         return pfrz;
+      }
+   }
+
+   //NULL for the fixed groups
+   pfrz->proto = pgrp->Clone(retU, 0);
+
+   return pfrz;
+}
+
+void undo_stack_cl::unref(undo_grp_t *pfrz) {
+
+   pfrz->refcnt -- ;
+   if (pfrz->refcnt > 0) return;
+
+   if (pfrz->proto != NULL) {
+      edi_grp_cl *proto;
+
+      proto = pfrz->proto;
+      //sub-groups are not owned by the parent group
+      for (u32_t its=0; its<proto->getSubGrpCount(); its++) {
+         delete proto->getSubGroup(its);
+      }
+      delete proto;
+   }
+   delete pfrz;
+}
+
+void undo_stack_cl::release(undo_snap_cl *psnap) {
+
+   for (u32_t itb=0; itb<UNDO_NBLK; itb++) {
+      undo_blk_t *pblk;
+
+      pblk = psnap->blk[itb];
+      if (pblk != NULL) {
+         pblk->refcnt -- ;
+         if (pblk->refcnt == 0) delete pblk;
+      }
+
+      if (psnap->grp[itb] == NULL) continue;
+
+      for (u32_t itg=0; itg<psnap->ngrp[itb]; itg++) {
+         //NULL: incomplete snapshot, Push() failed
+         if (psnap->grp[itb][itg] != NULL) unref(psnap->grp[itb][itg]);
+      }
+      delete [] psnap->grp[itb];
+   }
+
+   delete psnap;
+}
+
+void undo_stack_cl::Clear() {
+
+   for (u32_t its=0; its<nsnap; its++) {
+      release(snap[its]);
+      snap[its] = NULL;
+   }
+   nsnap = 0;
+   pos   = 0;
+}
+
+rcode undo_stack_cl::Push(EDID_cl& EDID, const wxString& op) {
+   rcode         retU;
+   edi_buf_t     ebuf;
+   undo_snap_cl *prev;
+   undo_snap_cl *psnap;
+   bool          b_changed;
+
+   prev  = Current();
+   psnap = new undo_snap_cl;
+   if (psnap == NULL) RCD_RETURN_FAULT(retU);
+
+   psnap->op   = op;
+   psnap->nblk = EDID.getNumValidBlocks();
+   if (psnap->nblk > UNDO_NBLK) psnap->nblk = UNDO_NBLK;
+
+   b_changed = (prev == NULL) || (prev->nblk != psnap->nblk);
+
+   //block data: assembly errors are ignored, the block data is used only as a fallback
+   retU = EDID.AssembleEDID(ebuf);
+   if (! RCD_IS_OK(retU)) {
+      memcpy(ebuf.buff, EDID.getEDID()->buff, sizeof(edi_buf_t) );
+   }
+
+   for (u32_t itb=0; itb<psnap->nblk; itb++) {
+      GroupAr_cl  *p_grp_ar;
+      undo_grp_t **frz_ar;
+      undo_grp_t **pfrz_prev;
+      u32_t        ngrp;
+      u32_t        nprev;
+      u32_t        first;
+      u32_t        last;
+      u32_t        flast;
+
+      if ((prev != NULL) && (prev->blk[itb] != NULL) &&
+          (0 == memcmp(prev->blk[itb]->data, ebuf.blk[itb], EDI_BLK_SIZE)) ) {
+         psnap->blk[itb] = prev->blk[itb];
+         psnap->blk[itb]->refcnt ++ ;
+      } else {
+         psnap->blk[itb] = new undo_blk_t;
+         if (psnap->blk[itb] == NULL) goto fault;
+
+         memcpy(psnap->blk[itb]->data, ebuf.blk[itb], EDI_BLK_SIZE);
+         psnap->blk[itb]->refcnt = 1;
+      }
+
+      p_grp_ar = EDID.BlkGroupsAr[itb];
+      ngrp     = p_grp_ar->GetCount();
+      if (ngrp == 0) {
+         b_changed |= ((prev != NULL) && (prev->ngrp[itb] != 0));
+         continue;
+      }
+
+      frz_ar = new undo_grp_t*[ngrp];
+      if (frz_ar == NULL) goto fault;
+      memset(frz_ar, 0, ngrp * sizeof(undo_grp_t*));
+
+      psnap->grp [itb] = frz_ar;
+      psnap->ngrp[itb] = ngrp;
+
+      pfrz_prev = NULL;
+      nprev     = 0;
+      if (prev != NULL) {
+         pfrz_prev = prev->grp [itb];
+         nprev     = prev->ngrp[itb];
+      }
+
+      //unchanged groups are shared with the previous snapshot
+      if (pfrz_prev != NULL) {
+         Diff(p_grp_ar, pfrz_prev, nprev, first, last, flast);
+      } else {
+         first = 0;
+         last  = ngrp;
+         flast = 0;
+      }
+
+      for (u32_t itg=0; itg<first; itg++) {
+         frz_ar[itg] = pfrz_prev[itg];
+         frz_ar[itg]->refcnt ++ ;
+      }
+      for (u32_t itg=last; itg<ngrp; itg++) {
+         frz_ar[itg] = pfrz_prev[itg - last + flast];
+         frz_ar[itg]->refcnt ++ ;
+      }
+      for (u32_t itg=first; itg<last; itg++) {
+         frz_ar[itg] = freeze(p_grp_ar->Item(itg));
+         if (frz_ar[itg] == NULL) goto fault;
+      }
+
+      b_changed |= ((last != first) || (flast != first));
+   }
+
+   if (! b_changed) {
+      release(psnap);
+      RCD_RETURN_OK(retU);
+   }
+
+   //new edit: the redo states are dropped
+   while (nsnap > (pos +1)) {
+      nsnap -- ;
+      release(snap[nsnap]);
+      snap[nsnap] = NULL;
+   }
+
+   if (nsnap >= UNDO_MAX_DEPTH) {
+      release(snap[0]);
+      memmove(&snap[0], &snap[1], (UNDO_MAX_DEPTH -1) * sizeof(undo_snap_cl*));
+      nsnap -- ;
+   }
+
+   snap[nsnap] = psnap;
+   pos         = nsnap;
+   nsnap      ++ ;
+
+   RCD_RETURN_TRUE(retU);
+
+fault:
+   release(psnap);
+   wxedid_RCD_RETURN_FAULT_VMSG(retU, "[E!] Undo: can't record the state after: %s", (const char*) op.ToUTF8());
+}
+
+undo_snap_cl* undo_stack_cl::Undo() {
+
+   if (! CanUndo()) return NULL;
+
+   pos -- ;
+   return snap[pos];
+}
+
+undo_snap_cl* undo_stack_cl::Redo() {
+
+   if (! CanRedo()) return NULL;
+
+   pos ++ ;
+   return snap[pos];
+}
@@ -0,0 +1,101 @@
+/***************************************************************
+ * Name:      undo.h
+ * Purpose:   Edit history: undo/redo snapshots of the EDID groups
+ * Author:    Tomasz Pawlak (tomasz.pawlak@wp.eu)
+ * Created:   2022-08-04
+ * Copyright: Tomasz Pawlak (C) 2022
+ * License:   GPLv3+
+ **************************************************************/
+
+#ifndef UNDO_H
+#define UNDO_H 1
+
+#include <wx/string.h>
+#include <string.h>
+
+#include "def_types.h"
+#include "rcode/rcode.h"
+#include "EDID_class.h"
+
+enum {
+   UNDO_MAX_DEPTH = 64,
+   UNDO_NBLK      = 4,   //EDID_cl::BlkGroupsAr[]
+   UNDO_IMG_SZ    = 32   //sizeof(edi_grp_cl::inst_data)
+};
+
+//Frozen group: header + sub-groups data as written by AssembleEDID(), shared by the snapshots.
+//proto: clone of the group, used for re-inserting deleted/replaced groups. NULL for the
+//fixed groups (no Clone()), these can be restored only in-place.
+typedef struct {
+   u32_t        type_id;
+   u32_t        hdr_sz;   //getDataSize()
+   u32_t        img_sz;   //header + sub-groups
+   u32_t        nsubg;
+   u8_t         img[UNDO_IMG_SZ];
+   u8_t         subg_sz [UNDO_IMG_SZ];
+   u32_t        subg_tid[UNDO_IMG_SZ];
+   edi_grp_cl  *proto;
+   u32_t        refcnt;
+} undo_grp_t;
+
+//Block data, shared by the snapshots until changed. Used only if the groups can't be restored.
+typedef struct {
+   u8_t   data[EDI_BLK_SIZE];
+   u32_t  refcnt;
+} undo_blk_t;
+
+class undo_snap_cl {
+   public:
+      wxString      op;               //operation name, for log messages
+      u32_t         nblk;             //valid blocks
+      undo_blk_t   *blk [UNDO_NBLK];
+      undo_grp_t  **grp [UNDO_NBLK];  //group layout per block
+      u32_t         ngrp[UNDO_NBLK];
+
+      undo_snap_cl() : nblk(0) {
+         memset(blk , 0, sizeof(blk ));
+         memset(grp , 0, sizeof(grp ));
+         memset(ngrp, 0, sizeof(ngrp));
+      };
+};
+
+//Linear edit history: snap[pos] is the current state. Push() records the state after an edit,
+//unchanged groups and blocks are shared with the previous snapshot.
+class undo_stack_cl {
+   protected:
+      undo_snap_cl *snap[UNDO_MAX_DEPTH];
+      u32_t         nsnap;
+      u32_t         pos;
+
+      undo_grp_t*   freeze (edi_grp_cl *pgrp);
+      void          release(undo_snap_cl *psnap);
+
+      static void   unref  (undo_grp_t *pfrz);
+
+   public:
+      //changed groups: [first, last) in the live array <-> [first, flast) in the snapshot
+      static void   Diff      (GroupAr_cl *p_grp_ar, undo_grp_t **frz_ar, u32_t nfrz,
+                               u32_t& first, u32_t& last, u32_t& flast);
+      static u32_t  GroupImage(edi_grp_cl *pgrp, u8_t *pimg);
+      static bool   Equal     (edi_grp_cl *pgrp, undo_grp_t *pfrz);
+      //same type & data layout: the data can be copied to the group
+      static bool   CanCopyTo (edi_grp_cl *pgrp, undo_grp_t *pfrz);
+      static rcode  CopyTo    (edi_grp_cl *pgrp, undo_grp_t *pfrz);
+
+      //RCD_TRUE: new snapshot, RCD_OK: no changes
+      rcode         Push (EDID_cl& EDID, const wxString& op);
+      void          Clear();
+
+      undo_snap_cl* Undo ();
+      undo_snap_cl* Redo ();
+
+      inline bool          CanUndo () {return (pos > 0);};
+      inline bool          CanRedo () {return ((pos +1) < nsnap);};
+      inline undo_snap_cl* Current () {return (nsnap > 0) ? snap[pos] : NULL;};
+      inline undo_snap_cl* NextRedo() {return CanRedo() ? snap[pos +1] : NULL;};
+
+      undo_stack_cl() : nsnap(0), pos(0) {memset(snap, 0, sizeof(snap));};
+      ~undo_stack_cl() {Clear();};
+};
+
+#endif /* UNDO_H */
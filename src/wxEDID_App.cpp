@@ -25,20 +25,43 @@
 #include <wx/log.h>
 
 #include <wx/cmdline.h>
+#include <wx/time.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pipeline.h"
+#include "fw_scan.h"
+#include "synth.h"
+#include "patch.h"
+#include "splice.h"
+#include "colorim.h"
 
 extern config_t config;
 
-IMPLEMENT_APP(wxEDID_App);
+wxIMPLEMENT_APP_NO_MAIN(wxEDID_App);
+
+int main(int argc, char **argv) {
+   //wxEntry() takes over an existing instance: the GUI app isn't created
+   if (wxEDID_App::IsBatchCmd(argc, argv)) wxApp::SetInstance(new wxEDID_BatchApp());
+
+   return wxEntry(argc, argv);
+}
 
 static const wxString strFOpenErr = "[E!] Can't open file: '%s'\n";
 
 bool wxEDID_App::OnInit() {
    bool wxsOK;
 
-   wxsOK = CmdLineArgs();
+   wxsOK = CmdLineArgs(argc, argv);
 
    if (! wxsOK) return wxsOK;
 
+   if (config.b_batch) {
+      //no frame: OnRun() returns the result
+      batch_rc = RunBatch();
+      return true;
+   }
+
    LoadConfig();
 
    //(* AppInitialize
@@ -54,12 +77,250 @@ bool wxEDID_App::OnInit() {
    return wxsOK;
 }
 
+int wxEDID_App::OnRun() {
+
+   if (config.b_batch) return batch_rc;
+
+   return wxApp::OnRun();
+}
+
 int wxEDID_App::OnExit() {
 
-   SaveConfig();
+   if (! config.b_batch) SaveConfig();
    return true;
 }
 
+bool wxEDID_BatchApp::OnInit() {
+   if (! wxEDID_App::CmdLineArgs(argc, argv)) return false;
+
+   if (! config.b_batch) {
+      wxLogStderr ErrLog;
+      ErrLog.LogText("[E!] batch mode: no batch option found\n");
+      return false;
+   }
+   batch_rc = wxEDID_App::RunBatch();
+   return true;
+}
+
+int wxEDID_BatchApp::OnRun() {
+   return batch_rc;
+}
+
+//pre-scan of the command line, before wx is initialized: any of the batch options
+bool wxEDID_App::IsBatchCmd(int argc, char **argv) {
+   static const char *batch_opt[] = {
+      "-b", "--batch", "-s", "--scan-image", "--synth", "--patch", "--splice", NULL
+   };
+
+   for (int ita=1; ita<argc; ita++) {
+      const char *arg = argv[ita];
+
+      if (0 == strcmp(arg, "--")) break;
+
+      for (u32_t ito=0; batch_opt[ito] != NULL; ito++) {
+         size_t olen = strlen(batch_opt[ito]);
+
+         if (0 != strncmp(arg, batch_opt[ito], olen)) continue;
+         if ((arg[olen] == 0) || (arg[olen] == '=')) return true;
+      }
+   }
+   return false;
+}
+
+int wxEDID_App::RunScaling() {
+   rcode      retU;
+   FILE      *fnull;
+   u32_t      ncpu;
+   u32_t      nthr;
+   double     fps1 = 0.0;
+
+   //decoded rows are discarded: only the throughput is reported
+   fnull = fopen("/dev/null", "w");
+   if (fnull == NULL) return 1;
+
+   ncpu = (config.batch_threads > 0) ? config.batch_threads : wxThread::GetCPUCount();
+   if ((i32_t) ncpu < 1) ncpu = 1; //GetCPUCount(): -1 if unknown
+   if (ncpu > PPL_MAX_THR) ncpu = PPL_MAX_THR;
+
+   //nthr 0: all the workers, warms the page cache, not reported
+   nthr = 0;
+   for (;;) {
+      ppl_engine_cl  engine;
+      wxLongLong     t_start;
+      double         secs;
+      double         fps;
+
+      t_start = wxGetUTCTimeUSec();
+      retU    = engine.Run(config.batch_dir, fnull, (nthr == 0) ? ncpu : nthr, config.batch_qdepth);
+      secs    = (wxGetUTCTimeUSec() - t_start).ToDouble() / 1e6;
+
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "Batch decoding FAILED: %s\n", (const char*) tmps.ToUTF8());
+         fclose(fnull);
+         return 1;
+      }
+
+      if (nthr > 0) {
+         fps = (secs > 0.0) ? (engine.getFileCount() / secs) : 0.0;
+         if (nthr == 1) fps1 = fps;
+
+         fprintf(stdout, "threads: %2u, files: %u, time: %.3f s, %.0f files/s, speedup: %.2f\n",
+                 nthr, engine.getFileCount(), secs, fps, (fps1 > 0.0) ? (fps / fps1) : 0.0);
+      }
+
+      if (nthr >= ncpu) break;
+      nthr = (nthr == 0) ? 1 : (nthr * 2);
+      if (nthr > ncpu) nthr = ncpu;
+   }
+
+   fclose(fnull);
+   return 0;
+}
+
+int wxEDID_App::RunBatch() {
+   rcode          retU;
+   ppl_engine_cl  engine;
+   wxLongLong     t_start;
+   double         secs;
+   FILE          *fout = stdout;
+
+   //no log window: only warnings & errors go to stderr
+   wxLog::SetLogLevel(wxLOG_Warning);
+
+   if (config.b_read_bench) {
+      retU = bulk_reader_cl::Benchmark(config.batch_dir, config.batch_threads, stderr);
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "Read benchmark FAILED: %s\n", (const char*) tmps.ToUTF8());
+         return 1;
+      }
+      return 0;
+   }
+
+   if (config.b_scaling) return RunScaling();
+
+   if (config.b_synth) {
+      //-o: output directory
+      retU = edid_synth_cl::Run(config.synth_spec, config.synth_count, config.synth_seed, config.batch_out, stderr);
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "EDID synthesis FAILED: %s\n", (const char*) tmps.ToUTF8());
+         return 1;
+      }
+      return 0;
+   }
+
+   if (config.b_patch) {
+      patch_engine_cl  patcher;
+
+      //-o: output directory
+      patcher.SetFlags(config.b_cmd_ignore_rd, config.b_cmd_ignore_err);
+      retU = patcher.LoadPatch(config.patch_file);
+      if (RCD_IS_OK(retU)) {
+         retU = patcher.Run(config.batch_dir, config.batch_out, config.batch_threads, stdout);
+      }
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "Batch patch FAILED: %s\n", (const char*) tmps.ToUTF8());
+         return 1;
+      }
+      return 0;
+   }
+
+   if (config.b_splice) {
+      splice_engine_cl  splicer;
+
+      //-o: output directory
+      splicer.SetFlags(false, config.b_cmd_ignore_err);
+      retU = splicer.LoadTemplate(config.splice_tmpl, config.splice_groups);
+      if (RCD_IS_OK(retU)) {
+         retU = splicer.Run(config.batch_dir, config.batch_out, config.batch_threads, stdout);
+      }
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "Group splicing FAILED: %s\n", (const char*) tmps.ToUTF8());
+         return 1;
+      }
+      return 0;
+   }
+
+   if (! config.batch_out.IsEmpty()) {
+      fout = fopen(config.batch_out.fn_str(), "w");
+      if (fout == NULL) {
+         wxLogStderr ErrLog;
+         wxString    tmps;
+
+         tmps.Printf(strFOpenErr, config.batch_out);
+         ErrLog.LogText(tmps);
+         return 1;
+      }
+   }
+
+   if (config.b_color_rank) {
+      retU = colorim_cl::Rank(config.batch_dir, fout, config.batch_threads);
+      if (fout != stdout) fclose(fout);
+
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "Color ranking FAILED: %s\n", (const char*) tmps.ToUTF8());
+         return 1;
+      }
+      return 0;
+   }
+
+   if (config.b_scan_image) {
+      retU = fw_scan_cl::PrintHits(config.scan_image, fout);
+      if (fout != stdout) fclose(fout);
+
+      if (! RCD_IS_OK(retU)) {
+         guilog_cl  tlog;
+         wxString   tmps;
+
+         tlog.RcodeToString(retU, tmps);
+         fprintf(stderr, "Image scan FAILED: %s\n", (const char*) tmps.ToUTF8());
+         return 1;
+      }
+      return 0;
+   }
+
+   t_start = wxGetUTCTimeUSec();
+   retU    = engine.Run(config.batch_dir, fout, config.batch_threads, config.batch_qdepth);
+   secs    = (wxGetUTCTimeUSec() - t_start).ToDouble() / 1e6;
+
+   if (fout != stdout) fclose(fout);
+
+   if (! RCD_IS_OK(retU)) {
+      guilog_cl  tlog;
+      wxString   tmps;
+
+      tlog.RcodeToString(retU, tmps);
+      fprintf(stderr, "Batch decoding FAILED: %s\n", (const char*) tmps.ToUTF8());
+      return 1;
+   }
+
+   engine.PrintStats(stderr, secs);
+   return 0;
+}
+
 void wxEDID_App::SaveConfig() {
    static const wxString strCfgStruct =
    "dtd_keep_aspect: '%d'\n"
@@ -210,17 +471,32 @@ void wxEDID_App::LoadConfig() {
    return;
 }
 
-bool wxEDID_App::CmdLineArgs() {
+bool wxEDID_App::CmdLineArgs(int argc, wxChar **argv) {
 
   static const wxCmdLineEntryDesc sCmdLineArgs[] = {
        { wxCMD_LINE_SWITCH, "e" , "ignore-errors", NULL , wxCMD_LINE_VAL_NONE  , 0},
        { wxCMD_LINE_SWITCH, "w" , "all-writeable", NULL , wxCMD_LINE_VAL_NONE  , 0},
        { wxCMD_LINE_OPTION, "t" , "text"         , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, "d" , "drm-monitor"  , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, "b" , "batch"        , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, "o" , "output"       , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "threads"      , NULL , wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "queue-depth"  , NULL , wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_SWITCH, NULL, "read-bench"   , NULL , wxCMD_LINE_VAL_NONE  , 0},
+       { wxCMD_LINE_SWITCH, NULL, "scaling"      , NULL , wxCMD_LINE_VAL_NONE  , 0},
+       { wxCMD_LINE_SWITCH, NULL, "color-rank"   , NULL , wxCMD_LINE_VAL_NONE  , 0},
+       { wxCMD_LINE_OPTION, "s" , "scan-image"   , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "synth"        , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "count"        , NULL , wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "seed"         , NULL , wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "patch"        , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "splice"       , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
+       { wxCMD_LINE_OPTION, NULL, "groups"       , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_NEEDS_SEPARATOR},
        { wxCMD_LINE_PARAM , NULL, NULL           , NULL , wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
        wxCMD_LINE_DESC_END
    };
 
-   wxCmdLineParser cmd_parser(sCmdLineArgs, wxApp::argc, wxApp::argv);
+   wxCmdLineParser cmd_parser(sCmdLineArgs, argc, argv);
 
    cmd_parser.Parse();
 
@@ -228,6 +504,54 @@ bool wxEDID_App::CmdLineArgs() {
    config.b_cmd_ignore_err = cmd_parser.Found("e");
    config.b_cmd_ignore_rd  = cmd_parser.Found("w");
    config.b_cmd_txt_file   = cmd_parser.Found("t", &config.cmd_open_file_path);
+   config.b_cmd_drm_mon    = cmd_parser.Found("d", &config.drm_root);
+
+   if (! config.b_cmd_drm_mon) config.drm_root = DRM_SYSFS_ROOT;
+
+   config.batch_threads = 0;
+   config.batch_qdepth  = 0;
+   config.b_read_bench  = false;
+   config.b_scaling     = false;
+   config.b_color_rank  = false;
+   config.b_scan_image  = cmd_parser.Found("s", &config.scan_image);
+   config.b_batch       = cmd_parser.Found("b", &config.batch_dir);
+   config.b_synth       = cmd_parser.Found("synth", &config.synth_spec);
+   config.synth_count   = 1000;
+   config.synth_seed    = 0;
+   config.b_batch      |= config.b_scan_image;
+   config.b_batch      |= config.b_synth;
+   config.b_patch       = cmd_parser.Found("patch", &config.patch_file);
+   config.b_splice      = cmd_parser.Found("splice", &config.splice_tmpl);
+   config.b_batch      |= config.b_patch;
+   config.b_batch      |= config.b_splice;
+   if (config.b_batch) {
+      cmd_parser.Found("o"          , &config.batch_out    );
+      cmd_parser.Found("threads"    , &config.batch_threads);
+      cmd_parser.Found("queue-depth", &config.batch_qdepth );
+      cmd_parser.Found("count"      , &config.synth_count  );
+      cmd_parser.Found("seed"       , &config.synth_seed   );
+      cmd_parser.Found("groups"     , &config.splice_groups);
+      config.b_read_bench = cmd_parser.Found("read-bench");
+      config.b_scaling    = cmd_parser.Found("scaling");
+      config.b_color_rank = cmd_parser.Found("color-rank");
+
+      if ((config.batch_threads < 0) || (config.batch_qdepth < 0)) {
+         wxLogStderr ErrLog;
+         ErrLog.LogText("[E!] --threads, --queue-depth: value must be >= 0\n");
+         return false;
+      }
+      if ((config.b_patch || config.b_splice) && config.batch_dir.IsEmpty()) {
+         wxLogStderr ErrLog;
+         ErrLog.LogText("[E!] --patch, --splice: input directory (-b) not specified\n");
+         return false;
+      }
+      if ((config.synth_count < 0) || (config.synth_seed < 0)) {
+         wxLogStderr ErrLog;
+         ErrLog.LogText("[E!] --count, --seed: value must be >= 0\n");
+         return false;
+      }
+      return true;
+   }
 
    if (! config.b_cmd_txt_file) {
       int par_cnt = cmd_parser.GetParamCount();
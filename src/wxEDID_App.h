@@ -14,14 +14,32 @@
 #include <wx/cmdline.h>
 
 class wxEDID_App : public wxApp {
+   protected:
+      int   batch_rc;
+
    public:
       virtual bool OnInit();
       virtual int  OnExit();
+      virtual int  OnRun ();
 
-      bool  CmdLineArgs();
+      static bool  CmdLineArgs(int argc, wxChar **argv);
+      static bool  IsBatchCmd (int argc, char **argv);
+      static int   RunBatch();
+      static int   RunScaling();
 
       void  SaveConfig();
       void  LoadConfig();
 };
 
+//Batch modes: the GUI toolkit isn't initialized, no display is needed.
+//main() sets the instance before wxEntry() when IsBatchCmd().
+class wxEDID_BatchApp : public wxAppConsole {
+   protected:
+      int   batch_rc;
+
+   public:
+      virtual bool OnInit();
+      virtual int  OnRun ();
+};
+
 #endif // wxEDIDAPP_H
@@ -28,6 +28,8 @@ RCD_AUTOGEN_DEFINE_UNIT
 #include <wx/msgdlg.h>
 #include <wx/filedlg.h>
 #include <wx/file.h>
+#include <wx/dirdlg.h>
+#include <wx/filefn.h>
 #include <string.h>
 
 //(*InternalHeaders(wxEDID_Frame)
@@ -120,7 +122,11 @@ static const char AUI_DefLayout[] =
 "prop=62122;bestw=80;besth=100;minw=-1;minh=100;maxw=-1;maxh=-1;"
 "floatx=-1;floaty=-1;floatw=-1;floath=-1|"
 
-"dock_size(4,0,0)=215|dock_size(5,0,0)=10|";
+"name=HexCtl;caption=Hex View;state=5920;dir=3;layer=0;row=0;pos=0;"
+"prop=100000;bestw=-1;besth=160;minw=-1;minh=80;maxw=-1;maxh=-1;"
+"floatx=-1;floaty=-1;floatw=-1;floath=-1|"
+
+"dock_size(4,0,0)=215|dock_size(5,0,0)=10|dock_size(3,0,0)=160|";
 
 
 //(*IdInit(wxEDID_Frame)
@@ -211,10 +217,25 @@ const long wxEDID_Frame::id_mnu_flags = wxNewId();
 const long wxEDID_Frame::id_win_stat_bar = wxNewId();
 //*)
 const long wxEDID_Frame::id_app_layout = wxNewId();
+const long wxEDID_Frame::id_dtd_timer  = wxNewId();
+const long wxEDID_Frame::id_parse_thr  = wxNewId();
+const long wxEDID_Frame::id_parse_timer= wxNewId();
+const long wxEDID_Frame::id_log_timer  = wxNewId();
+const long wxEDID_Frame::id_mnu_opendir= wxNewId();
+const long wxEDID_Frame::id_mnu_openarch=wxNewId();
+const long wxEDID_Frame::id_mnu_fwscan = wxNewId();
+const long wxEDID_Frame::id_corpus_list= wxNewId();
+const long wxEDID_Frame::id_mnu_drm_mon= wxNewId();
+const long wxEDID_Frame::id_drm_mon    = wxNewId();
 const long wxEDID_Frame::id_mnu_info   = wxNewId();
 const long wxEDID_Frame::id_mnu_ins_up = wxNewId();
 const long wxEDID_Frame::id_mnu_ins_dn = wxNewId();
 const long wxEDID_Frame::id_mnu_ins_in = wxNewId();
+const long wxEDID_Frame::id_mnu_modes  = wxNewId();
+const long wxEDID_Frame::id_hex_view   = wxNewId();
+const long wxEDID_Frame::id_srch_pane  = wxNewId();
+const long wxEDID_Frame::id_srch_list  = wxNewId();
+const long wxEDID_Frame::id_mnu_find   = wxNewId();
 
 wxDECLARE_EVENT(wxEVT_DEFERRED, wxCommandEvent);
 wxDEFINE_EVENT (wxEVT_DEFERRED, wxCommandEvent);
@@ -232,10 +253,23 @@ wxBEGIN_EVENT_TABLE(wxEDID_Frame, wxFrame)
     EVT_TREE_KEY_DOWN          (id_block_tree  , wxEDID_Frame::evt_blktree_key       )
 
     EVT_COMMAND                (wxID_ANY       , wxEVT_DEFERRED, wxEDID_Frame::evt_Deferred)
+    EVT_COMMAND                (id_hex_view    , wxEVT_HEXVIEW_SEL, wxEDID_Frame::evt_hexview_sel)
     EVT_AUINOTEBOOK_PAGE_CHANGING(id_ntbook    , wxEDID_Frame::evt_ntbook_page       )
+    EVT_TIMER                  (id_dtd_timer   , wxEDID_Frame::evt_dtd_timer         )
+    EVT_THREAD                 (id_parse_thr   , wxEDID_Frame::evt_parse_thr         )
+    EVT_TIMER                  (id_parse_timer , wxEDID_Frame::evt_parse_timer       )
+    EVT_TIMER                  (id_log_timer   , wxEDID_Frame::evt_log_timer         )
 
     EVT_MENU                   (wxID_OPEN      , wxEDID_Frame::evt_open_edid_bin     )
     EVT_MENU                   (id_mnu_imphex  , wxEDID_Frame::evt_import_hex        )
+    EVT_MENU                   (id_mnu_opendir , wxEDID_Frame::evt_open_dir          )
+    EVT_MENU                   (id_mnu_openarch, wxEDID_Frame::evt_open_arch         )
+    EVT_MENU                   (id_mnu_fwscan  , wxEDID_Frame::evt_scan_image        )
+    EVT_LIST_ITEM_SELECTED     (id_corpus_list , wxEDID_Frame::evt_corpus_sel        )
+    EVT_MENU                   (id_mnu_drm_mon , wxEDID_Frame::evt_drm_mon_toggle    )
+    EVT_MENU                   (id_mnu_find    , wxEDID_Frame::evt_find              )
+    EVT_LIST_ITEM_SELECTED     (id_srch_list   , wxEDID_Frame::evt_srch_sel          )
+    EVT_THREAD                 (id_drm_mon     , wxEDID_Frame::evt_drm_mon           )
     EVT_MENU                   (wxID_SAVE      , wxEDID_Frame::evt_save_edid_bin     )
     EVT_MENU                   (wxID_SAVEAS    , wxEDID_Frame::evt_save_report       )
     EVT_MENU                   (id_mnu_exphex  , wxEDID_Frame::evt_export_hex        )
@@ -243,6 +277,7 @@ wxBEGIN_EVENT_TABLE(wxEDID_Frame, wxFrame)
     EVT_MENU                   (wxID_ABOUT     , wxEDID_Frame::evt_About             )
     EVT_MENU                   (id_mnu_flags   , wxEDID_Frame::evt_Flags             )
     EVT_MENU                   (id_mnu_logw    , wxEDID_Frame::evt_log_win           )
+    EVT_MENU                   (id_mnu_modes   , wxEDID_Frame::evt_mode_list         )
     EVT_MENU                   (id_mnu_allwr   , wxEDID_Frame::evt_ignore_rd         )
     EVT_MENU                   (id_mnu_ignerr  , wxEDID_Frame::evt_ignore_err        )
     EVT_MENU                   (id_mnu_parse   , wxEDID_Frame::evt_reparse           )
@@ -261,6 +296,8 @@ wxBEGIN_EVENT_TABLE(wxEDID_Frame, wxFrame)
     EVT_MENU                   (id_mnu_ins_dn  , wxEDID_Frame::evt_blktree_insert )
     EVT_MENU                   (wxID_UP        , wxEDID_Frame::evt_blktree_move   )
     EVT_MENU                   (wxID_DOWN      , wxEDID_Frame::evt_blktree_move   )
+    EVT_MENU                   (wxID_UNDO      , wxEDID_Frame::evt_undo           )
+    EVT_MENU                   (wxID_REDO      , wxEDID_Frame::evt_undo           )
 wxEND_EVENT_TABLE()
 
 #pragma GCC diagnostic ignored "-Wunused-parameter"
@@ -575,8 +612,53 @@ wxEDID_Frame::wxEDID_Frame(wxWindow* parent,wxWindowID id) :
     Connect(wxID_ANY, wxEVT_GRID_CELL_CHANGED,
             (wxObjectEventFunction) &wxEDID_Frame::evt_datagrid_write);
 
+    //replace the default grid table: cells are rendered on demand
+    grid_tbl = new fgrid_tbl_cl(this);
+    BlkDataGrid->SetTable(grid_tbl, true);
+
     InitBlkTreeMenu();
 
+    //edit history
+    mnu_edit = new wxMenu();
+    mnu_undo = mnu_edit->Append(wxID_UNDO, _("Undo\tctrl-Z"), _("Undo the last change"));
+    mnu_redo = mnu_edit->Append(wxID_REDO, _("Redo\tctrl-Y"), _("Redo the last undone change"));
+    MenuBar1->Insert(1, mnu_edit, _("&Edit"));
+
+    //corpus browser: hidden until a directory is opened
+    Menu1->Insert(1, id_mnu_opendir, _("Open EDID directory"), _("Browse a directory of EDID binaries"));
+    Menu1->Insert(2, id_mnu_openarch, _("Open EDID archive"), _("Browse EDID files in a tar / tar.gz archive, without extracting"));
+    Menu1->Insert(3, id_mnu_fwscan, _("Scan firmware image"), _("Find EDIDs embedded in a firmware/VBIOS image"));
+
+    corpus_list = new corpus_list_cl(this, id_corpus_list);
+    AuiMgrMain->AddPane(corpus_list, wxAuiPaneInfo().Name(_T("CorpusCtl")).Caption(_("EDID directory")).Left().BestSize(wxSize(400, -1)).Hide());
+    AuiMgrMain->Update();
+
+    //hex view: block bytes below the grid, hover/click resolves the field
+    hex_view = new hexview_cl(edid_panel, id_hex_view, &EDID);
+    AuiMgrEDID->AddPane(hex_view, wxAuiPaneInfo().Name(_T("HexCtl")).Caption(_("Hex View")).CloseButton(false).Bottom().TopDockable(false).LeftDockable(false).RightDockable(false).Floatable(false).Movable(false).MinSize(wxSize(-1,80)).BestSize(wxSize(-1,160)).DestroyOnClose());
+    AuiMgrEDID->Update();
+
+    //search: inverted index of the group/field names & values, built on the first query
+    srch_pane = new srch_pane_cl(this, id_srch_pane, id_srch_list, &EDID, &GLog);
+    AuiMgrMain->AddPane(srch_pane, wxAuiPaneInfo().Name(_T("SearchCtl")).Caption(_("Search")).Right().BestSize(wxSize(360, -1)).Hide());
+    AuiMgrMain->Update();
+    mnu_edit->AppendSeparator();
+    mnu_edit->Append(id_mnu_find, _("Find\tctrl-F"), _("Search group names, field names and values"));
+
+    //DRM monitor: connector EDID shown in the editor is reloaded on change
+    mnu_drm_mon = Menu1->InsertCheckItem(4, id_mnu_drm_mon, _("Monitor DRM connectors"),
+                                         _("Log EDID changes of the DRM connectors, reload the opened one"));
+
+    //mode list: all the timings declared by the EDID, written to the log window
+    Menu3->Append(id_mnu_modes, _("Mode list\tctrl-M"), _("List all supported video modes"));
+    drm_mon     = NULL;
+    drm_reload  = -1;
+    drm_gen     = 0;
+    drm_ask     = false;
+    drm_ok      = false;
+    drm_keep    = false;
+    corpus_pend = -1;
+
     row_sel    = -1;
     subg_idx   = -1;
     edigrp_sel = NULL;
@@ -584,6 +666,12 @@ wxEDID_Frame::wxEDID_Frame(wxWindow* parent,wxWindowID id) :
     b_srcgrp_orphaned = false;
 
     GLog.Create(this);
+    UndoUpdateUI();
+
+    //log messages from the GUI and the worker threads are queued, the UI isn't stalled
+    guilog_cl::SetAsync(true);
+    log_timer.SetOwner(this, id_log_timer);
+    log_timer.Start(log_flush_ms);
 
     EDID.SetGuiLogPtr(&GLog);
 
@@ -591,6 +679,15 @@ wxEDID_Frame::wxEDID_Frame(wxWindow* parent,wxWindowID id) :
     dtd_screen->Enable(false);
     dtd_screen->SetParentFrame(this); //needed to have a pointer to a DTD values
 
+    dtd_timer.SetOwner(this, id_dtd_timer);
+    dtd_sct_pend = wxID_NONE;
+
+    parse_timer.SetOwner(this, id_parse_timer);
+    parse_thr   = NULL;
+    parse_job   = 0;
+    parse_stage = PSTAGE_READ;
+    parse_dlg   = NULL;
+
     mnu_dtd_aspect->Check(b_dtd_keep_aspect );
     mnu_fdetails  ->Check(b_dta_grid_details);
 
@@ -638,6 +735,8 @@ wxEDID_Frame::wxEDID_Frame(wxWindow* parent,wxWindowID id) :
        tmps = wxString::FromAscii(AUI_DefLayout);
        AuiMgrEDID->LoadPerspective(tmps);
     }
+    if (config.b_cmd_drm_mon) DrmMonStart();
+
     //load/import file from cmd line arg?
     if (config.b_cmd_bin_file) {
        wxCommandEvent evt(wxEVT_DEFERRED, wxID_OPEN);
@@ -656,6 +755,25 @@ wxEDID_Frame::wxEDID_Frame(wxWindow* parent,wxWindowID id) :
 
 wxEDID_Frame::~wxEDID_Frame() {
 
+   dtd_timer.Stop();
+   parse_timer.Stop();
+   log_timer.Stop();
+
+   if (parse_thr != NULL) {
+      //joinable thread: Delete() waits for the job to stop
+      parse_thr->Delete();
+      delete parse_thr;
+   }
+   if (parse_dlg != NULL) delete parse_dlg;
+
+   DrmMonStop();
+
+   //stop the row decoders before the list is destroyed
+   corpus_list->Close();
+
+   //workers stopped: the queued messages are written synchronously
+   guilog_cl::SetAsync(false);
+
    config.aui_layout = AuiMgrEDID->SavePerspective();
    config.win_pos    = GetPosition();
    config.win_size   = GetSize();
@@ -698,9 +816,60 @@ void wxEDID_Frame::evt_datagrid_select(wxGridEvent& evt) {
    row_sel = evt.GetRow();
    BlkDataGrid->SelectRow(row_sel);
    retU = SetFieldDesc(row_sel);
+   hex_view->Highlight(edigrp_sel, row_sel);
    evt.Skip(true);
 }
 
+void wxEDID_Frame::SelectField(edi_grp_cl* pgrp, i32_t fidx) {
+   wxTreeItemId  trItemID;
+
+   if ((pgrp == NULL) || (! BlockTree->IsEnabled())) return;
+
+   if (pgrp != edigrp_sel) {
+      trItemID = pgrp->GetId();
+      if (! trItemID.IsOk()) return;
+
+      BlockTree->EnsureVisible(trItemID);
+      BlockTree->SelectItem   (trItemID); //triggers evt_blktree_sel()
+   }
+   if ((pgrp != edigrp_sel) || (fidx < 0)) return;
+
+   //triggers evt_datagrid_select()
+   BlkDataGrid->SetGridCursor(fidx, 0);
+   BlkDataGrid->MakeCellVisible(fidx, 0);
+}
+
+void wxEDID_Frame::evt_hexview_sel(wxCommandEvent& evt) {
+   edi_grp_cl *pgrp;
+
+   pgrp = reinterpret_cast <edi_grp_cl*> (evt.GetClientData());
+   SelectField(pgrp, evt.GetInt());
+}
+
+void wxEDID_Frame::evt_srch_sel(wxListEvent& evt) {
+   srch_index_cl&     index = srch_pane->getIndex();
+   const srch_doc_t  *pdoc;
+   long               idx;
+
+   idx = evt.GetIndex();
+   if ((idx < 0) || ((u32_t) idx >= index.Count())) return;
+
+   pdoc = index.Result(idx);
+   if (ntbook->GetSelection() != 0) ntbook->SetSelection(0); //go to tree view
+
+   SelectField(pdoc->grp, pdoc->fidx);
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void wxEDID_Frame::evt_find(wxCommandEvent& evt) {
+   if (! AuiMgrMain->GetPane(srch_pane).IsShown()) {
+      AuiMgrMain->GetPane(srch_pane).Show();
+      AuiMgrMain->Update();
+   }
+   srch_pane->FocusQuery();
+}
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 void wxEDID_Frame::evt_datagrid_vsel(wxGridEvent& evt) {
    //EVT_GRID_CMD_EDITOR_SHOWN: show value selector menu for fields with EF_VS
@@ -723,7 +892,8 @@ void wxEDID_Frame::evt_datagrid_vsel(wxGridEvent& evt) {
    }
 
    if ((p_field->field.flags & EF_VS) != 0) {
-      if(p_field->selector != NULL) BlkDataGrid->PopupMenu(p_field->selector);
+      wxMenu *selector = edigrp_sel->getSelector(p_field);
+      if (selector != NULL) BlkDataGrid->PopupMenu(selector);
    }
 }
 
@@ -744,9 +914,10 @@ void wxEDID_Frame::evt_datagrid_write(wxGridEvent& evt) {
    row_op = evt.GetRow();
    //Call field handler(write), then re-read the value to verify it
    retU = WriteField();
-   //refresh the cell value: (fn name is misleading, but it works)
-   BlkDataGrid->ShowCellEditControl();
-   BlkDataGrid->HideCellEditControl();
+   //drop the editor value, the field is re-read from the group data
+   grid_tbl->ClearEditVal();
+   //refresh the cell values: virtual table re-reads changed fields only
+   BlkDataGrid->ForceRefresh();
 
    if (!RCD_IS_OK(retU)) {
       GLog.DoLog(fmsgW);
@@ -774,6 +945,11 @@ void wxEDID_Frame::evt_datagrid_write(wxGridEvent& evt) {
       Connect(wxID_ANY, wxEVT_GRID_CELL_CHANGED,
               (wxObjectEventFunction) &wxEDID_Frame::evt_datagrid_write);
    }
+
+   if (edigrp_sel != NULL) {
+      srch_pane->IndexUpdate(edigrp_sel);
+      UndoPush("Write: " + edigrp_sel->CodeName);
+   }
 }
 
 void wxEDID_Frame::evt_blktree_sel(wxTreeEvent& evt) {
@@ -791,14 +967,17 @@ void wxEDID_Frame::evt_blktree_sel(wxTreeEvent& evt) {
 
    if ( (!BT_Item_sel.IsOk()) || (pgrp == NULL)) {
       txc_edid_info->Clear();
+      grid_tbl->SetGroup(NULL);
       BlkDataGrid->Enable(false);
       tmps.Empty();
       win_stat_bar->SetStatusText(tmps, SBAR_GRPOFFS);
       edigrp_sel = NULL;
+      hex_view->Highlight(NULL, -1);
       return;
    }
    BlkDataGrid->Enable(flags.bits.ctrl_enabled);
    edigrp_sel = pgrp;
+   hex_view->Highlight(pgrp, -1);
    SetOpFlags();
    //display group info
    txc_edid_info->SetValue(pgrp->GroupDesc);
@@ -868,6 +1047,7 @@ void wxEDID_Frame::BlkTreeUpdateGrp() {
    //delete edigrp_sel; edigrp_sel = NULL;
 
    trItemID = BlkTreeInsGrp (BT_Iparent, grp_copy, grp_idx);
+   hex_view->Invalidate();
 
    //prevent evt nesting
    //WriteField->BlkTreeUpdateGrp()->BlockTree->SelectItem
@@ -946,6 +1126,7 @@ rcode wxEDID_Frame::BlkTreeChangeGrpType() {
    //delete edigrp_sel; edigrp_sel = NULL;
 
    trItemID = BlkTreeInsGrp (BT_Iparent, grp_new, grp_idx);
+   hex_view->Invalidate();
 
    //prevent evt nesting
    Disconnect(wxID_ANY, wxEVT_GRID_CELL_CHANGED,
@@ -1195,7 +1376,10 @@ void wxEDID_Frame::evt_blktree_paste(wxCommandEvent& evt) {
 
    //OPTION: keep expanded state
    trItemID = BlkTreeInsGrp(BT_Iparent, grp_copy, grp_idx);
+   hex_view->Invalidate();
    BlockTree->SelectItem(trItemID);
+
+   UndoPush("Paste");
 }
 
 void wxEDID_Frame::evt_blktree_delete(wxCommandEvent& evt) {
@@ -1238,7 +1422,10 @@ void wxEDID_Frame::evt_blktree_delete(wxCommandEvent& evt) {
    trItemID = BT_Iparent;
 
 update:
+   hex_view->Invalidate();
    BlockTree->SelectItem(trItemID); //triggers evt_blktree_sel()
+
+   UndoPush("Delete");
 }
 
 void wxEDID_Frame::evt_blktree_cut(wxCommandEvent& evt) {
@@ -1272,7 +1459,10 @@ void wxEDID_Frame::evt_blktree_cut(wxCommandEvent& evt) {
    trItemID = BT_Iparent;
 
 update:
+   hex_view->Invalidate();
    BlockTree->SelectItem(trItemID); //triggers evt_blktree_sel()
+
+   UndoPush("Cut");
 }
 
 void wxEDID_Frame::evt_blktree_insert(wxCommandEvent& evt) {
@@ -1323,7 +1513,10 @@ void wxEDID_Frame::evt_blktree_insert(wxCommandEvent& evt) {
    trItemID  = BlkTreeInsGrp(BT_Iparent, grp_copy, grp_idx);
 
 select_item:
+   hex_view->Invalidate();
    BlockTree->SelectItem(trItemID);
+
+   UndoPush("Insert");
 }
 
 void wxEDID_Frame::evt_blktree_move(wxCommandEvent& evt) {
@@ -1361,8 +1554,12 @@ void wxEDID_Frame::evt_blktree_move(wxCommandEvent& evt) {
    trItemID  = BlkTreeInsGrp(BT_Iparent, edigrp_sel, grp_idx);
 
 update:
+   //the groups are only re-ordered: update the hex view index, don't rebuild it
+   hex_view->Sync(grp_ar);
    BlockTree->SelectItem(trItemID);
    if (b_Expanded) BlockTree->Expand(trItemID);
+
+   UndoPush("Move");
 }
 
 void wxEDID_Frame::evt_blktree_reparse(wxCommandEvent& evt) {
@@ -1375,24 +1572,50 @@ void wxEDID_Frame::evt_blktree_reparse(wxCommandEvent& evt) {
    }
 
    BlkTreeUpdateGrp();
+
+   UndoPush("Reparse group");
 }
 
+void wxEDID_Frame::evt_undo(wxCommandEvent& evt) {
+   rcode         retU;
+   undo_snap_cl *psnap;
 
-void wxEDID_Frame::evt_open_edid_bin(wxCommandEvent& evt) {
-   rcode retU;
-   retU = OpenEDID();
+   if (parse_thr != NULL) return; //parser busy
+   if (BlkDataGrid->IsCellEditControlShown()) return;
+
+   //pending DTD Constructor changes are recorded first
+   DTD_Ctor_Flush();
+
+   if (evt.GetId() == wxID_UNDO) {
+      if (! undo.CanUndo()) return;
+
+      GLog.slog.Printf("Undo: %s", undo.Current()->op);
+      psnap = undo.Undo();
+   } else {
+      psnap = undo.Redo();
+      if (psnap == NULL) return;
+
+      GLog.slog.Printf("Redo: %s", psnap->op);
+   }
+   GLog.DoLog();
+
+   retU = UndoRestore(psnap);
    if (!RCD_IS_OK(retU)) {
       GLog.PrintRcode(retU);
-
-      if (! EDID.Get_ERR_Ignore()) {
-         tmps = msgF_LOAD;
-         wxMessageBox(tmps, txt_REMARK, wxOK|wxCENTRE|wxICON_INFORMATION);
-      } else {
-         GLog.Show();
-      }
+      GLog.Show();
    }
-   mnu_reparse ->Enable(flags.bits.data_loadeed);
-   mnu_assemble->Enable(flags.bits.data_loadeed);
+
+   UndoUpdateUI();
+}
+
+void wxEDID_Frame::evt_open_edid_bin(wxCommandEvent& evt) {
+   rcode retU;
+
+   if (parse_thr != NULL) return; //parser busy
+
+   //job result is reported by ParseFinish()
+   retU = OpenEDID();
+   if (!RCD_IS_OK(retU)) ParseReport(PJOB_OPEN_BIN, retU);
 }
 
 void wxEDID_Frame::evt_save_edid_bin(wxCommandEvent& evt) {
@@ -1433,19 +1656,174 @@ void wxEDID_Frame::evt_export_hex(wxCommandEvent& evt) {
 void wxEDID_Frame::evt_import_hex(wxCommandEvent& evt) {
    rcode retU;
 
+   if (parse_thr != NULL) return; //parser busy
+
+   //job result is reported by ParseFinish()
    retU = ImportEDID_hex();
+   if (! RCD_IS_OK(retU)) ParseReport(PJOB_IMPORT_HEX, retU);
+}
+
+void wxEDID_Frame::evt_open_dir(wxCommandEvent& evt) {
+   rcode  retU;
+
+   wxDirDialog dlg_dir(this, "Open directory with EDID binaries", "",
+                       wxDD_DEFAULT_STYLE|wxDD_DIR_MUST_EXIST);
+   if (config.b_have_last_fpath) {
+      dlg_dir.SetPath(wxPathOnly(config.last_used_fpath));
+   }
+   if (dlg_dir.ShowModal() != wxID_OK) return;
+
+   corpus_pend = -1;
+   retU = corpus_list->Open(dlg_dir.GetPath());
    if (! RCD_IS_OK(retU)) {
+      GLog.DoLog("Open EDID directory FAILED.");
       GLog.PrintRcode(retU);
+      GLog.Show();
+      return;
+   }
 
-      if (! EDID.Get_ERR_Ignore()) {
-         tmps = msgF_LOAD;
-         wxMessageBox(tmps, txt_REMARK, wxOK|wxCENTRE|wxICON_INFORMATION);
-      } else {
+   tmps.Printf("EDID directory: %u file(s)", corpus_list->getCorpus()->getCount());
+   GLog.DoLog(tmps);
+
+   AuiMgrMain->GetPane(corpus_list).Caption("EDID directory").Show();
+   AuiMgrMain->Update();
+}
+
+void wxEDID_Frame::evt_open_arch(wxCommandEvent& evt) {
+   rcode  retU;
+
+   wxFileDialog dlg_open(this, "Open archive with EDID binaries", "", "",
+                         "tar archives (*.tar;*.tar.gz;*.tgz)|*.tar;*.tar.gz;*.tgz|All (*.*)|*.*",
+                         wxFD_OPEN|wxFD_FILE_MUST_EXIST);
+   if (config.b_have_last_fpath) {
+      dlg_open.SetDirectory(wxPathOnly(config.last_used_fpath));
+   }
+   if (dlg_open.ShowModal() != wxID_OK) return;
+
+   //the members are listed while the archive is being read
+   corpus_pend = -1;
+   retU = corpus_list->Open(dlg_open.GetPath(), CORP_SRC_ARCH);
+   if (! RCD_IS_OK(retU)) {
+      GLog.DoLog("Open EDID archive FAILED.");
+      GLog.PrintRcode(retU);
+      GLog.Show();
+      return;
+   }
+
+   tmps  = "EDID archive: ";
+   tmps << dlg_open.GetPath();
+   GLog.DoLog(tmps);
+
+   AuiMgrMain->GetPane(corpus_list).Caption("EDID archive").Show();
+   AuiMgrMain->Update();
+}
+
+void wxEDID_Frame::evt_scan_image(wxCommandEvent& evt) {
+   rcode  retU;
+
+   wxFileDialog dlg_open(this, "Scan firmware image for EDIDs", "", "",
+                         "All (*.*)|*.*", wxFD_OPEN|wxFD_FILE_MUST_EXIST);
+   if (config.b_have_last_fpath) {
+      dlg_open.SetDirectory(wxPathOnly(config.last_used_fpath));
+   }
+   if (dlg_open.ShowModal() != wxID_OK) return;
+
+   //the hits are listed while the image is being scanned
+   corpus_pend = -1;
+   retU = corpus_list->Open(dlg_open.GetPath(), CORP_SRC_IMAGE);
+   if (! RCD_IS_OK(retU)) {
+      GLog.DoLog("Scan firmware image FAILED.");
+      GLog.PrintRcode(retU);
+      GLog.Show();
+      return;
+   }
+
+   tmps  = "Firmware image: ";
+   tmps << dlg_open.GetPath();
+   GLog.DoLog(tmps);
+
+   AuiMgrMain->GetPane(corpus_list).Caption("EDIDs in firmware image").Show();
+   AuiMgrMain->Update();
+}
+
+void wxEDID_Frame::evt_corpus_sel(wxListEvent& evt) {
+   //only the latest selection is kept: loaded when the parser is idle
+   corpus_pend = evt.GetIndex();
+   CorpusLoad();
+}
+
+void wxEDID_Frame::CorpusLoad() {
+   rcode       retU;
+   u32_t       idx;
+   wxString    fpath;
+   edi_buf_t   ebuf;
+   corpus_cl  *corpus;
+
+   if (corpus_pend < 0  ) return;
+   if (parse_thr != NULL) return; //parser busy: retried by ParseFinish()
+
+   idx         = corpus_pend;
+   corpus_pend = -1;
+   corpus      = corpus_list->getCorpus();
+
+   if (idx >= corpus->getCount()) return;
+
+   corpus->getRowPath(idx, fpath);
+   corpus->getRowName(idx, edid_file_name);
+
+   //decoded rows keep the file data: no need to read the file again
+   if (corpus->getRowData(idx, ebuf.buff, sizeof(edi_buf_t))) {
+      retU = ParseStart(PJOB_LOAD_BUF, fpath, ebuf.buff);
+   } else if (corpus->getSource() != CORP_SRC_DIR) {
+      //archive members & image hits can't be opened as files
+      GLog.DoLog("No data: archive member or image hit not loaded.");
+      return;
+   } else {
+      //dir row still being decoded: the file is read by the parser
+      retU = ParseStart(PJOB_OPEN_BIN, fpath);
+   }
+   if (! RCD_IS_OK(retU)) ParseReport(PJOB_OPEN_BIN, retU);
+}
+
+void wxEDID_Frame::evt_drm_mon_toggle(wxCommandEvent& evt) {
+
+   if (mnu_drm_mon->IsChecked()) {
+      DrmMonStart();
+   } else {
+      DrmMonStop();
+   }
+}
+
+void wxEDID_Frame::evt_drm_mon(wxThreadEvent& evt) {
+   //drop events queued before the monitor was stopped: the thread may still be
+   //running when its DRMEV_STOP is handled, so the events are matched by generation
+   if (drm_mon == NULL) return;
+   if (evt.GetPayload<u32_t>() != drm_gen) return;
+
+   switch (evt.GetInt()) {
+      case DRMEV_LOG:
+         GLog.DoLog(evt.GetString());
+         break;
+
+      case DRMEV_STOP:
+         GLog.DoLog(evt.GetString());
+         GLog.DoLog("DRM monitor stopped.");
+         DrmMonStop();
          GLog.Show();
-      }
+         break;
+
+      case DRMEV_CHANGE:
+         //only the connector opened in the editor is reloaded
+         if (! config.b_have_last_fpath) break;
+         if (evt.GetString() != config.last_used_fpath) break;
+
+         drm_reload = evt.GetExtraLong();
+         DrmMonReload();
+         break;
+
+      default:
+         break;
    }
-   mnu_reparse->Enable(flags.bits.data_loadeed);
-   mnu_assemble ->Enable(flags.bits.data_loadeed);
 }
 
 void wxEDID_Frame::evt_ignore_rd(wxCommandEvent& evt) {
@@ -1481,12 +1859,58 @@ void wxEDID_Frame::evt_ignore_err(wxCommandEvent& evt) {
 }
 
 void wxEDID_Frame::evt_dtdctor_sct(wxSpinEvent& evt) {
+   int  evtid = evt.GetId();
+
+   //wxID_ANY: refresh all the controls immediately
+   if (evtid == wxID_ANY) {
+      DTD_Ctor_Cancel();
+      DTD_Ctor_Update(wxID_ANY);
+      return;
+   }
+
+   //another control changed within the same frame: apply the pending one first
+   if ((dtd_sct_pend != wxID_NONE) && (dtd_sct_pend != evtid)) {
+      DTD_Ctor_Flush();
+   }
+
+   //coalesce bursts of spin events: the spin control value is read on timer
+   dtd_sct_pend = evtid;
+   if (! dtd_timer.IsRunning()) {
+      dtd_timer.Start(DTD_FRAME_MS, wxTIMER_ONE_SHOT);
+   }
+}
+
+void wxEDID_Frame::evt_dtd_timer(wxTimerEvent& evt) {
+   DTD_Ctor_Flush();
+}
+
+void wxEDID_Frame::DTD_Ctor_Flush() {
+   int evtid;
+
+   dtd_timer.Stop();
+
+   evtid = dtd_sct_pend;
+   if (evtid == wxID_NONE) return;
+
+   dtd_sct_pend = wxID_NONE;
+   DTD_Ctor_Update(evtid);
+
+   if (edigrp_sel != NULL) srch_pane->IndexUpdate(edigrp_sel);
+   UndoPush("DTD Constructor");
+}
+
+void wxEDID_Frame::DTD_Ctor_Cancel() {
+   //the DTD group is about to be deleted: drop pending update
+   dtd_timer.Stop();
+   dtd_sct_pend = wxID_NONE;
+}
+
+void wxEDID_Frame::DTD_Ctor_Update(int evtid) {
    float  pixclk;
    int    limit, val;
    bool   brecalc     = true;
    bool   updt_htotal = false;
    bool   updt_vtotal = false;
-   int    evtid       = evt.GetId();
 
    //invalidate grid data -> refresh
    if (evtid != wxID_ANY) flags.bits.edigridblk_ok = 0;
@@ -1649,6 +2073,8 @@ void wxEDID_Frame::evt_ntbook_page(wxAuiNotebookEvent& evt) {
    int page = evt.GetSelection();
 
    if (page == 0) {
+      //apply pending DTD Ctor changes
+      DTD_Ctor_Flush();
       //update edi block data grid after switching from DTD Ctor panel
       if ( !flags.bits.edigridblk_ok && (edigrp_sel != NULL)) {
          retU = UpdateDataGrid(edigrp_sel);
@@ -1692,12 +2118,11 @@ void wxEDID_Frame::evt_ntbook_page(wxAuiNotebookEvent& evt) {
 void wxEDID_Frame::evt_reparse(wxCommandEvent& evt) {
    rcode retU;
 
+   if (parse_thr != NULL) return; //parser busy
+
+   //job result is reported by ParseFinish()
    retU = Reparse();
-   if (!RCD_IS_OK(retU)) {
-      GLog.DoLog("Reparse() FAILED.");
-      GLog.PrintRcode(retU);
-      GLog.Show();
-   }
+   if (!RCD_IS_OK(retU)) ParseReport(PJOB_REPARSE, retU);
 }
 
 void wxEDID_Frame::evt_assemble_edid(wxCommandEvent& evt) {
@@ -1710,6 +2135,30 @@ void wxEDID_Frame::evt_log_win(wxCommandEvent& evt) {
    this->SetFocus();
 }
 
+void wxEDID_Frame::evt_mode_list(wxCommandEvent& evt) {
+   rcode    retU;
+   wxString sval;
+
+   if (parse_thr != NULL) return; //parser busy
+
+   retU = modes.Build(EDID);
+   if (! RCD_IS_OK(retU)) {
+      GLog.DoLog("Mode list: no EDID data.");
+      GLog.Show();
+      return;
+   }
+
+   sval.Printf("Mode list: %u modes", modes.Count());
+   if (modes.Dropped() > 0) sval << wxString::Format(", %u dropped (table full)", modes.Dropped());
+   GLog.DoLog(sval);
+
+   for (u32_t itm=0; itm<modes.Count(); itm++) {
+      modes.Print(itm, sval);
+      GLog.DoLog(sval);
+   }
+   GLog.Show();
+}
+
 void wxEDID_Frame::evt_blk_fdetails(wxCommandEvent& evt) {
    b_dta_grid_details        = mnu_fdetails->IsChecked();
    config.b_dta_grid_details = b_dta_grid_details;
@@ -1767,7 +2216,6 @@ void wxEDID_Frame::evt_Deferred(wxCommandEvent& evt) {
 
 rcode wxEDID_Frame::OpenEDID() {
    rcode  retU;
-   wxFile file;
 
    GLog.DoLog("OpenEDID()");
 
@@ -1794,65 +2242,14 @@ rcode wxEDID_Frame::OpenEDID() {
       config.b_cmd_bin_file = false; //single shot
    }
 
-   if (! file.Open(tmps, wxFile::read) ) RCD_RETURN_FAULT(retU);
-
-   //remember last used file path
-   config.last_used_fpath   = tmps;
-   config.b_have_last_fpath = true;
-
-   GLog.slog = "File opened:\n ";
-   GLog.slog << tmps;
-   GLog.DoLog();
-
-   RCD_SET_OK(retU);
-   ClearAll();
-   EDID.Clear();
-
-   u32_t idx    = EDI_BASE_IDX;
-   u32_t idxmax = 0;
-   ediblk_t *pblk = EDID.getEDID()->blk;
-   do {
-      if ( EDI_BLK_SIZE != file.Read(&pblk[idx], EDI_BLK_SIZE) ) {
-         RCD_SET_FAULT(retU);
-         GLog.slog.Printf("Failed to load EDID block[%d]: incorrect size.", idx);
-         GLog.DoLog();
-      } else if (! EDID.VerifyChksum(idx)) {
-         RCD_SET_FAULT(retU);
-      }
-      if (idx == 0) {
-         //only 1 extension block is currently supported (CEA)
-         idxmax = EDID.getEDID()->edi.base.num_extblk;
-         if (idxmax > EDI_EXT1_IDX) idxmax = EDI_EXT1_IDX;
-      }
-      idx++ ;
-   } while (idx <= idxmax);
-
-   flags.bits.data_loadeed = 1;
-
-   file.Close();
-   if (!RCD_IS_OK(retU)) {
-      GLog.DoLog("OpenEDID() FAILED.");
-
-      if (! EDID.Get_ERR_Ignore()) {
-         return retU;
-      } else {
-         GLog.DoLog("Error ignored: trying to Reparse().");
-      }
-   }
-
-   GLog.slog.Printf("Loaded %u EDID block(s)\n", idx);
-   GLog.DoLog();
-
-   retU = Reparse();
-   if (!RCD_IS_OK(retU)) {
-      GLog.DoLog("OpenEDID()->Reparse() FAILED.");
-   }
-
+   //read, verify & parse in background
+   retU = ParseStart(PJOB_OPEN_BIN, tmps);
    return retU;
 }
 
 rcode wxEDID_Frame::SaveEDID() {
-   rcode retU;
+   rcode     retU;
+   edi_buf_t ebuf;
    RCD_SET_OK(retU);
 
    GLog.DoLog("SaveEDID()");
@@ -1862,7 +2259,8 @@ rcode wxEDID_Frame::SaveEDID() {
       RCD_RETURN_FAULT(retU);
    }
 
-   retU = AssembleEDID_main();
+   //the edited data is not modified: checksums are generated in the local copy
+   retU = EDID.AssembleEDID(ebuf);
    if (!RCD_IS_OK(retU)) return retU;
 
    wxFileDialog dlg_open(this, "Save EDID binary file", "", "",
@@ -1883,7 +2281,7 @@ rcode wxEDID_Frame::SaveEDID() {
       RCD_RETURN_FAULT(retU);
    }
    //save edid_t + extensions
-   if ( dtalen != file.Write(EDID.getEDID()->buff, dtalen) ) {
+   if ( dtalen != file.Write(ebuf.buff, dtalen) ) {
       RCD_SET_FAULT(retU);
    }
    file.Close();
@@ -2078,11 +2476,24 @@ rcode wxEDID_Frame::SaveReport() {
    *reps = "wxEDID v";
    *reps << ver << "\nEDID structure and data:\nSource file: \"";
    *reps << edid_file_name << "\"";
+   {
+      const char *vendor;
+
+      vendor = pnp_id_cl::Vendor(EDID.getEDID()->edi.base.mfc_id.ar8);
+      if (vendor != NULL) *reps << "\nVendor: " << wxString::FromUTF8(vendor);
+   }
 
    if (EDID.getNumValidBlocks() == 0) {
       delete reps;
       RCD_RETURN_FAULT(retU);
    }
+   {
+      clr_stat_t  clr;
+
+      colorim_cl::Analyse(EDID.getEDID()->buff, (EDID.getNumValidBlocks() * sizeof(edid_t)), clr);
+      *reps << "\nColorimetry: ";
+      colorim_cl::Print(clr, *reps);
+   }
 
    for (u32_t blk=0; blk<EDID.getNumValidBlocks(); blk++ ) {
       tmps.Printf("\n\n----| EDID block [%u] |----\n", blk);
@@ -2143,7 +2554,8 @@ rcode wxEDID_Frame::SaveReport() {
 }
 
 rcode wxEDID_Frame::ExportEDID_hex() {
-   rcode retU;
+   rcode     retU;
+   edi_buf_t ebuf;
    RCD_SET_OK(retU);
 
    GLog.DoLog("ExportEDID_hex()");
@@ -2153,7 +2565,7 @@ rcode wxEDID_Frame::ExportEDID_hex() {
       RCD_RETURN_FAULT(retU);
    }
 
-   retU = AssembleEDID_main();
+   retU = EDID.AssembleEDID(ebuf);
    if (!RCD_IS_OK(retU)) return retU;
 
    wxFileDialog dlg_open(this, "Export EDID as text (hex)", "", "",
@@ -2174,7 +2586,7 @@ rcode wxEDID_Frame::ExportEDID_hex() {
 
    shex->Alloc(1024);
    tmps.Empty();
-   u8_t *edi = reinterpret_cast <u8_t*> (EDID.getEDID());
+   u8_t *edi = ebuf.buff;
 
    for (u32_t itb=0; itb<dtalen; itb++) {
       tmps.Printf("%02X", edi[itb]);
@@ -2206,10 +2618,6 @@ rcode wxEDID_Frame::ExportEDID_hex() {
 
 rcode wxEDID_Frame::ImportEDID_hex() {
    rcode    retU;
-   char    *buff8 = NULL;
-   u32_t    itb;
-   ssize_t  itc, len;
-   wxFile   file;
 
    RCD_SET_OK(retU);
 
@@ -2238,101 +2646,22 @@ rcode wxEDID_Frame::ImportEDID_hex() {
       config.b_cmd_txt_file = false; //single shot
    }
 
-   if (! file.Open(tmps, wxFile::read) ) RCD_RETURN_FAULT(retU);
-
-   //remember last used file path
-   config.last_used_fpath   = tmps;
-   config.b_have_last_fpath = true;
+   //read, convert & parse in background
+   retU = ParseStart(PJOB_IMPORT_HEX, tmps);
+   return retU;
+}
 
-   len = file.Length();
-   if ( (len < (128*2)) || (len > (1024*4)) ) {
-      /* reject files which are too small
-         but also prevent importing essays :)
-      */
-      GLog.DoLog("[E!] Bad file. Allowed size is 256...4096 bytes.");
-      file.Close();
-      RCD_RETURN_FAULT(retU);
-   }
+rcode wxEDID_Frame::AssembleEDID_main() {
+   rcode         retU;
+   u32_t         n_ext;
+   u32_t         cksum;
+   edi_grp_cl   *p_grp;
+   edi_dynfld_t *p_fld;
 
-   buff8 = new char[len+1];
-   if (buff8 == NULL) {
-      file.Close();
-      RCD_RETURN_FAULT(retU);
-   }
-   //read text
-   if ( len != file.Read(buff8, len) ) {
-      RCD_SET_FAULT(retU);
-   }
+   GLog.DoLog("Assemble EDID:");
 
-   flags.bits.data_loadeed = 1; //allows parsing partially loaded data
-
-   file.Close();
-   if (!RCD_IS_OK(retU)) {
-      delete [] buff8;
-      return retU;
-   }
-
-   GLog.slog = "File imported:\n ";
-   GLog.slog << tmps;
-   GLog.DoLog();
-
-   ClearAll();
-   EDID.Clear();
-   //hex to bin
-   itb = 0;
-   u8_t *edi = EDID.getEDID()->buff;
-   for (itc=0; itc<len; itc++) {
-      bool conv_ok;
-      ulong chr = buff8[itc];
-      if ( (chr < '0') || ((chr > '9') && (chr < 'A')) || \
-          ((chr > 'F') && (chr < 'a')) || (chr > 'f') ) continue;
-      //Not UTF8, just take 2 chars in one call;
-      tmps    = wxString::FromUTF8(&buff8[itc], 2); itc++;
-      conv_ok = tmps.ToULong(&chr, 16);
-
-      if (! conv_ok) {
-         static const char msg[] = "[E!] ImportEDID_hex() parsing file content failed @offs=%d";
-         wxedid_RCD_SET_FAULT_VMSG(retU, msg, (int) itc);
-         if (! EDID.Get_ERR_Ignore()) {
-            delete [] buff8;
-            return retU;
-         } else {
-            GLog.PrintRcode(retU);
-            GLog.DoLog("Error ignored: trying to Reparse().");
-            goto err_reparse;
-         }
-      }
-
-      edi[itb] = static_cast <u8_t> (chr);
-
-      if (itb == offsetof(edid_t, num_extblk)) {
-         /*don't read extensions if they are not claimed,
-           otherwise read until end of the buffer or file */
-         if (chr == 0) len = (itc+1);
-      }
-      if (itb > sizeof(edi_buf_t)) break;
-      itb++ ;
-   }
-
-err_reparse:
-   delete [] buff8;
-
-   retU = Reparse();
-
-   return retU;
-}
-
-rcode wxEDID_Frame::AssembleEDID_main() {
-   rcode         retU;
-   u32_t         n_ext;
-   u32_t         cksum;
-   edi_grp_cl   *p_grp;
-   edi_dynfld_t *p_fld;
-
-   GLog.DoLog("Assemble EDID:");
-
-   retU = EDID.AssembleEDID();
-   if (!RCD_IS_OK(retU)) goto err;
+   retU = EDID.AssembleEDID();
+   if (!RCD_IS_OK(retU)) goto err;
 
    retU = CalcVerifyChksum(EDI_BASE_IDX);
    if (!RCD_IS_OK(retU)) goto err;
@@ -2344,6 +2673,7 @@ rcode wxEDID_Frame::AssembleEDID_main() {
    p_fld = p_grp->FieldsAr.Item(9);    //BED.checksum field
    retU  = (EDID.*p_fld->field.handlerfn)(OP_WRINT, tmps, cksum, p_fld);
    if (!RCD_IS_OK(retU)) goto err;
+   srch_pane->IndexUpdate(p_grp);
 
    //if EDID.BASE.BED is currently selected, refresh the BlockData grid
    if (p_grp == edigrp_sel) {
@@ -2375,6 +2705,7 @@ rcode wxEDID_Frame::AssembleEDID_main() {
       p_fld = p_grp->FieldsAr.Item(8);    //CHD.checksum field
       retU  = (EDID.*p_fld->field.handlerfn)(OP_WRINT, tmps, cksum, p_fld);
       if (!RCD_IS_OK(retU)) goto err;
+      srch_pane->IndexUpdate(p_grp);
    }
 
    //if EDID.CEA.CHD is currently selected, refresh the BlockData grid
@@ -2400,6 +2731,7 @@ rcode wxEDID_Frame::UpdateBlockTree() {
    wxTreeItemId trRoot, trBlock;
 
    BlockTree->DeleteAllItems();
+   hex_view ->Invalidate();
 
    if (EDID.EDI_BaseGrpAr.GetCount() < 1) RCD_RETURN_FAULT(retU);
 
@@ -2451,7 +2783,7 @@ wxTreeItemId wxEDID_Frame::BlkTreeInsGrp(wxTreeItemId trItemID, edi_grp_cl* pgrp
    trItemID = BlockTree->InsertItem(trItemID, idx, tmps, -1, -1, pgrp);
    n_subg   = pgrp->getSubGrpCount();
 
-   if (n_subg == 0) return trItemID;
+   if (n_subg == 0) goto idx_add;
 
    { //insert subgroups
       GroupAr_cl   *subg_ar;
@@ -2465,6 +2797,8 @@ wxTreeItemId wxEDID_Frame::BlkTreeInsGrp(wxTreeItemId trItemID, edi_grp_cl* pgrp
          BlockTree->AppendItem(trItemID, tmps, -1, -1, psubg);
       }
    }
+idx_add:
+   srch_pane->IndexAdd(pgrp); //including subgroups
    return trItemID;
 }
 
@@ -2476,6 +2810,11 @@ void wxEDID_Frame::BlkTreeDelGrp(edi_grp_cl* pgrp) {
    trItem = pgrp->GetId();
    n_subg = pgrp->getSubGrpCount();
 
+   //the grid table can't keep pointers to deleted fields
+   grid_tbl->DetachGroup(pgrp);
+   if (pgrp == edigrp_sel) DTD_Ctor_Cancel();
+   srch_pane->IndexRemove(pgrp); //including subgroups
+
    if (n_subg == 0) goto del_node;
 
    { //detach subgroups
@@ -2497,130 +2836,242 @@ del_node:
    BlockTree->Delete     (trItem);
 }
 
-rcode wxEDID_Frame::UpdateDataGridRow(int nrow, edi_dynfld_t *p_field) {
-   rcode        retU;
-   u32_t        tmpi;
-   static const wxString fmsg = "[E!] UpdateDataGridRow(): failed to read field value.";
-
-   //p_field name
-   tmps = wxString::FromAscii(p_field->field.name);
-   BlkDataGrid->SetCellValue(nrow, DATGR_COL_NAME, tmps);
-   BlkDataGrid->SetReadOnly (nrow, DATGR_COL_NAME, true);
-   //p_field value
-   tmps.Empty();
-   retU = (EDID.*p_field->field.handlerfn)(OP_READ, tmps, tmpi, p_field);
+void wxEDID_Frame::UndoPush(const wxString& op) {
+   rcode retU;
+
+   retU = undo.Push(EDID, op);
    if (!RCD_IS_OK(retU)) {
-      GLog.DoLog(fmsg);
       GLog.PrintRcode(retU);
-      //return retU;
-      tmps = "<error!>";
    }
-   BlkDataGrid->SetCellValue(nrow, DATGR_COL_VAL, tmps);
-   //is read-only
-   if (EDID.Get_RD_Ignore()) {
-      BlkDataGrid->SetReadOnly(nrow, DATGR_COL_VAL, false);
-   } else {
-      BlkDataGrid->SetReadOnly(nrow, DATGR_COL_VAL, (p_field->field.flags & EF_RD));
+   UndoUpdateUI();
+   hex_view->Refresh(); //changed field values
+}
+
+void wxEDID_Frame::UndoUpdateUI() {
+   undo_snap_cl *psnap;
+
+   psnap = undo.CanUndo() ? undo.Current() : NULL;
+   tmps  = "Undo";
+   if (psnap != NULL) tmps << ": " << psnap->op;
+   tmps << "\tctrl-Z";
+   mnu_undo->SetItemLabel(tmps);
+   mnu_undo->Enable(psnap != NULL);
+
+   psnap = undo.NextRedo();
+   tmps  = "Redo";
+   if (psnap != NULL) tmps << ": " << psnap->op;
+   tmps << "\tctrl-Y";
+   mnu_redo->SetItemLabel(tmps);
+   mnu_redo->Enable(psnap != NULL);
+}
+
+//remove a group replaced/deleted by UndoRestore()
+void wxEDID_Frame::UndoDelGrp(edi_grp_cl* pgrp) {
+   rcode retU;
+
+   //copy source: keep an orphaned copy
+   if ((! b_srcgrp_orphaned) && (edigrp_src != NULL)) {
+      if ((edigrp_src == pgrp) || (edigrp_src->getParentGrp() == pgrp)) {
+         edigrp_src        = edigrp_src->Clone(retU, 0);
+         b_srcgrp_orphaned = (edigrp_src != NULL);
+      }
    }
-   //get types
-   retU = EDID.getValTypeName(tmps, p_field->field.flags);
-   if (!RCD_IS_OK(retU)) return retU;
-   BlkDataGrid->SetCellValue(nrow, DATGR_COL_TYPE, tmps);
-   BlkDataGrid->SetReadOnly (nrow, DATGR_COL_TYPE, true);
-   //get units
-   retU = EDID.getValUnitName(tmps, p_field->field.flags);
-   if (!RCD_IS_OK(retU)) return retU;
-   if (tmps.IsEmpty()) tmps = "--";
-   BlkDataGrid->SetCellValue(nrow, DATGR_COL_UNIT, tmps);
-   BlkDataGrid->SetReadOnly (nrow, DATGR_COL_UNIT, true);
-   //get flags
-   retU = EDID.getValFlagsAsString(tmps, p_field->field.flags);
-   if (!RCD_IS_OK(retU)) return retU;
-   BlkDataGrid->SetCellValue(nrow, DATGR_COL_FLG, tmps);
-   BlkDataGrid->SetReadOnly (nrow, DATGR_COL_FLG, true);
-   //show field details
-   if (b_dta_grid_details) {
-      u32_t  fval;
-      //base offset
-      fval  = p_field->field.offs;
-      tmps.Empty(); tmps << fval;
-      BlkDataGrid->SetCellValue(nrow, DATGR_COL_OFFS, tmps);
-      BlkDataGrid->SetReadOnly (nrow, DATGR_COL_OFFS, true);
-      //field offset in bits/bytes
-      fval  = p_field->field.shift;
-      tmps.Empty(); tmps << fval;
-      BlkDataGrid->SetCellValue(nrow, DATGR_COL_SHIFT, tmps);
-      BlkDataGrid->SetReadOnly (nrow, DATGR_COL_SHIFT, true);
-      //field size in bits/bytes
-      fval  = p_field->field.fldsize;
-      tmps.Empty(); tmps << fval;
-      BlkDataGrid->SetCellValue(nrow, DATGR_COL_FSZ, tmps);
-      BlkDataGrid->SetReadOnly (nrow, DATGR_COL_FSZ, true);
+   //selected sub-group: BlkTreeDelGrp() detaches only the parent group from the grid
+   if ((edigrp_sel != NULL) && (edigrp_sel->getParentGrp() == pgrp)) {
+      grid_tbl->SetGroup(NULL);
+      edigrp_sel = NULL;
    }
 
-   //set row color for type
+   BlkTreeDelGrp(pgrp);
+   if (edigrp_sel == pgrp) edigrp_sel = NULL;
+
+   //sub-groups are not owned by the parent group
+   for (u32_t its=0; its<pgrp->getSubGrpCount(); its++) {
+      delete pgrp->getSubGroup(its);
+   }
+}
+
+//Only the changed groups are restored: groups of the same type and data layout are updated
+//in-place, the others are replaced by clones of the frozen groups. The BlockTree items are
+//re-created only for the replaced groups, the grid is refreshed only if the selected group
+//was changed. Fallback: the snapshot block data is reparsed.
+rcode wxEDID_Frame::UndoRestore(undo_snap_cl *psnap) {
+   rcode        retU;
+   rcode        retU2;
+   edi_grp_cl  *ptop;
+   i32_t        sel_blk  = -1;
+   u32_t        sel_idx  = 0;
+   i32_t        sel_sub  = -1;
+   bool         b_sel_rm = false; //selected group replaced/deleted
+   bool         b_sel_up = false; //selected group updated in-place
+
    RCD_SET_OK(retU);
 
-   wxGridCellAttr *RowAttr = BlkDataGrid->GetOrCreateCellAttr(nrow, DATGR_COL_NAME);
-   RowAttr->SetTextColour(*wxBLACK);
+   if (ntbook->GetSelection() != 0) ntbook->SetSelection(0); //go to tree view
+   BlkDataGrid->HideCellEditControl();
 
-   {
-      __label__  set_bgcol;
-      u32_t      fflags;
-      wxColour  *rowColour;
+   if (psnap->nblk != EDID.getNumValidBlocks()) goto reparse;
 
-      fflags = p_field->field.flags;
+   //selection: block, group index, sub-group index
+   if (edigrp_sel != NULL) {
+      ptop = edigrp_sel;
+      if (ptop->getParentGrp() != NULL) {
+         sel_sub = ptop->getParentArIdx();
+         ptop    = ptop->getParentGrp();
+      }
+      sel_idx = ptop->getParentArIdx();
 
-      if (fflags & EF_FLT) {
-         rowColour = &grid_color_float;
-         goto set_bgcol;
+      for (u32_t itb=0; itb<psnap->nblk; itb++) {
+         if (ptop->getParentAr() == EDID.BlkGroupsAr[itb]) sel_blk = itb;
       }
-      if (fflags & EF_HEX) {
-         rowColour = &grid_color_hex;
-         goto set_bgcol;
+   }
+
+   //fixed groups have no Clone(): these can be restored only in-place
+   for (u32_t itb=0; itb<psnap->nblk; itb++) {
+      GroupAr_cl  *p_grp_ar;
+      undo_grp_t **frz_ar;
+      u32_t        first;
+      u32_t        last;
+      u32_t        flast;
+
+      p_grp_ar = EDID.BlkGroupsAr[itb];
+      frz_ar   = psnap->grp[itb];
+
+      if ((p_grp_ar->GetCount() == 0) || (psnap->ngrp[itb] == 0)) {
+         if (p_grp_ar->GetCount() != psnap->ngrp[itb]) goto reparse;
+         continue;
       }
-      if (fflags & EF_BIT) {
-         rowColour = &grid_color_bit;
-         goto set_bgcol;
+
+      undo_stack_cl::Diff(p_grp_ar, frz_ar, psnap->ngrp[itb], first, last, flast);
+
+      for (u32_t idx=first; idx<flast; idx++) {
+         if (frz_ar[idx]->proto != NULL) continue;
+         if (idx >= last) goto reparse;
+         if (! undo_stack_cl::CanCopyTo(p_grp_ar->Item(idx), frz_ar[idx])) goto reparse;
       }
-      goto def_color;
+   }
+
+   for (u32_t itb=0; itb<psnap->nblk; itb++) {
+      GroupAr_cl  *p_grp_ar;
+      undo_grp_t **frz_ar;
+      edi_grp_cl  *pgrp;
+      edi_grp_cl  *pnew;
+      wxTreeItemId trBlock;
+      u32_t        first;
+      u32_t        last;
+      u32_t        flast;
+      u32_t        idx;
+
+      p_grp_ar = EDID.BlkGroupsAr[itb];
+      frz_ar   = psnap->grp[itb];
+      if (p_grp_ar->GetCount() == 0) continue;
 
-      set_bgcol:
-         RowAttr->SetBackgroundColour(*rowColour);
-         goto exit;
+      undo_stack_cl::Diff(p_grp_ar, frz_ar, psnap->ngrp[itb], first, last, flast);
+      if ((first == last) && (first == flast)) continue;
+
+      trBlock = BlockTree->GetItemParent(p_grp_ar->Item(0)->GetId());
+
+      //changed groups
+      for (idx=first; (idx<last) && (idx<flast); idx++) {
+         bool b_sel;
+
+         pgrp  = p_grp_ar->Item(idx);
+         b_sel = ((i32_t) itb == sel_blk) && (idx == sel_idx);
+
+         if (undo_stack_cl::CanCopyTo(pgrp, frz_ar[idx])) {
+            retU2 = undo_stack_cl::CopyTo(pgrp, frz_ar[idx]);
+            if (!RCD_IS_OK(retU2)) retU = retU2;
+            srch_pane->IndexUpdate(pgrp);
+
+            b_sel_up |= b_sel;
+            continue;
+         }
+
+         pnew = frz_ar[idx]->proto->Clone(retU2, 0);
+         if (pnew == NULL) goto fault;
+
+         UndoDelGrp(pgrp);
+         p_grp_ar->Paste(idx, pnew);
+         BlkTreeInsGrp(trBlock, pnew, idx);
+
+         b_sel_rm |= b_sel;
+      }
+      //removed groups
+      for (; idx<last; idx++) {
+         pgrp      = p_grp_ar->Item(flast);
+         b_sel_rm |= ((i32_t) itb == sel_blk) && (idx == sel_idx);
+
+         UndoDelGrp(pgrp);
+         p_grp_ar->Delete(flast);
+      }
+      //re-inserted groups
+      for (idx=last; idx<flast; idx++) {
+         pnew = frz_ar[idx]->proto->Clone(retU2, 0);
+         if (pnew == NULL) goto fault;
+
+         if (idx < p_grp_ar->GetCount()) {
+            p_grp_ar->InsertUp(idx, pnew);
+         } else {
+            p_grp_ar->InsertDn(idx -1, pnew);
+         }
+         BlkTreeInsGrp(trBlock, pnew, idx);
+      }
    }
+   hex_view->Invalidate();
 
-def_color:
-   RowAttr->SetBackgroundColour(*wxWHITE);
-exit:
-   BlkDataGrid->SetRowAttr(nrow, RowAttr);
+   if (b_sel_rm || (edigrp_sel == NULL)) {
+      GroupAr_cl *p_grp_ar;
+      edi_grp_cl *pgrp;
+
+      if (sel_blk < 0) return retU;
+
+      p_grp_ar = EDID.BlkGroupsAr[sel_blk];
+      if (p_grp_ar->GetCount() == 0) return retU;
+
+      if (sel_idx >= p_grp_ar->GetCount()) sel_idx = (p_grp_ar->GetCount() -1);
+      pgrp = p_grp_ar->Item(sel_idx);
+
+      if ((sel_sub >= 0) && (pgrp->getSubGrpCount() > 0)) {
+         if (sel_sub >= (i32_t) pgrp->getSubGrpCount()) sel_sub = (pgrp->getSubGrpCount() -1);
+         pgrp = pgrp->getSubGroup(sel_sub);
+      }
+
+      BlockTree->SelectItem(pgrp->GetId()); //triggers evt_blktree_sel()
+      return retU;
+   }
+
+   if (b_sel_up) {
+      //field layout can change: EF_FGR
+      retU2 = UpdateDataGrid(edigrp_sel);
+      if (!RCD_IS_OK(retU2)) retU = retU2;
+   }
 
    return retU;
+
+reparse:
+   GLog.DoLog("Undo: group layout changed, reparsing the EDID buffer.");
+
+   for (u32_t itb=0; itb<psnap->nblk; itb++) {
+      memcpy(EDID.getEDID()->blk[itb], psnap->blk[itb]->data, EDI_BLK_SIZE);
+   }
+
+   //job result is reported by ParseFinish()
+   retU = Reparse();
+   if (!RCD_IS_OK(retU)) ParseReport(PJOB_REPARSE, retU);
+   return retU;
+
+fault:
+   GLog.PrintRcode(retU2);
+   hex_view->Invalidate(); //some groups are already replaced
+   goto reparse;
 }
 
 rcode wxEDID_Frame::UpdateDataGrid(edi_grp_cl* pgrp) {
    rcode  retU;
-   int    NumR;
-   int    nGrpF;
-   int    itf;
 
    if (pgrp == NULL) RCD_RETURN_FAULT(retU);
 
-   NumR  = BlkDataGrid->GetNumberRows();
-   nGrpF = pgrp->FieldsAr.GetCount();
-
-   if (NumR < nGrpF) {
-      BlkDataGrid->AppendRows(nGrpF-NumR);
-   } else if (NumR > nGrpF) {
-      NumR -= nGrpF;
-      BlkDataGrid->DeleteRows(0, NumR);
-   }
-
-   for (itf=0; itf<nGrpF; itf++) {
-      edi_dynfld_t *field = pgrp->FieldsAr.Item(itf);
-      if (field == NULL) RCD_RETURN_FAULT(retU);
-      retU = UpdateDataGridRow(itf, field);
-   }
+   grid_tbl->SetGroup(pgrp);
 
    BlkDataGrid->AutoSizeColumns(false);
    BlkDataGrid->AutoSizeRows(false);
@@ -2640,10 +3091,7 @@ void wxEDID_Frame::DataGrid_ChangeView() {
 
    if (b_dta_grid_details) {
       if (ncol == DATGR_NCOL_2) return;
-      BlkDataGrid->AppendCols(DATGR_NCOL_DIFF);
-      BlkDataGrid->SetColLabelValue(DATGR_COL_OFFS , "offs" );
-      BlkDataGrid->SetColLabelValue(DATGR_COL_SHIFT, "shift");
-      BlkDataGrid->SetColLabelValue(DATGR_COL_FSZ  , "size" );
+      grid_tbl->SetDetails(true);
 
       if (! BlkDataGrid->IsEnabled()) return;
 
@@ -2654,7 +3102,7 @@ void wxEDID_Frame::DataGrid_ChangeView() {
       }
    } else {
       if (ncol == DATGR_NCOL_1) return;
-      BlkDataGrid->DeleteCols(DATGR_NCOL_1, DATGR_NCOL_DIFF);
+      grid_tbl->SetDetails(false);
    }
 }
 
@@ -2675,10 +3123,86 @@ rcode wxEDID_Frame::SetFieldDesc(int row) {
       } else {
          txc_edid_info->SetValue(wxString::FromUTF8(p_field->field.desc));
       }
+      {
+         wxString tmg_info;
+         GetFieldTiming(row, tmg_info);
+         if (! tmg_info.IsEmpty()) {
+            txc_edid_info->AppendText("\n\n");
+            txc_edid_info->AppendText(tmg_info);
+         }
+      }
    }
    return retU;
 }
 
+//ETM/STI/AST/DTD: full timing of the mode described by the selected field (DMT database)
+void wxEDID_Frame::GetFieldTiming(int row, wxString& info) {
+   const dmt_mode_t *pmode = NULL;
+   const u8_t       *pinst;
+   u32_t             std_code;
+   u32_t             type_id;
+
+   info.Empty();
+   if ((edigrp_sel == NULL) || (row < 0)) return;
+
+   pinst   = edigrp_sel->getInsPtr();
+   type_id = (edigrp_sel->getTypeID() & ID_EDID_MASK);
+
+   switch (type_id) {
+      case ID_BED:
+         //mfc_id: vendor name from the PNP ID registry
+         if (row == 1) {
+            const char *vendor;
+
+            vendor = pnp_id_cl::Vendor(pinst + offsetof(edid_t, mfc_id));
+            info   = "Vendor: ";
+            info  << ((vendor != NULL) ? wxString::FromUTF8(vendor) : wxString("unknown PNP ID"));
+         }
+         return;
+      case ID_ETM:
+         pmode = dmt_cl::ByETM(row);
+         if (pmode == NULL) return;
+         break;
+      case ID_STI:
+      case ID_AST:
+         if (type_id == ID_AST) {
+            //3 header fields, then 6x STI: x_res8, v_freq, pix_ratio
+            if ((row < 3) || (row >= (3 + 6*3))) return;
+            pinst += offsetof(ast_t, x0_res8) + (((row - 3) / 3) * sizeof(std_timg_t));
+         }
+         std_code = ((pinst[0] << 8) | pinst[1]);
+         pmode    = dmt_cl::BySTD(std_code);
+         if (pmode == NULL) {
+            u32_t  h_act, v_act, vrefr;
+            rcode  retU;
+
+            retU = dmt_cl::DecodeSTD(std_code, h_act, v_act, vrefr);
+            if (! RCD_IS_OK(retU)) return;
+
+            info.Printf("STD code 0x%04X: %ux%u@%u: not a DMT mode (CVT/GTF timing)",
+                        std_code, h_act, v_act, vrefr);
+            return;
+         }
+         break;
+      case ID_DTD:
+         {
+            vtiming_t  tmg;
+            rcode      retU;
+
+            retU = dmt_cl::FromDTD(pinst, tmg);
+            if (! RCD_IS_OK(retU)) return;
+
+            pmode = dmt_cl::MatchDTD(tmg);
+            if (pmode == NULL) return;
+         }
+         break;
+      default:
+         return;
+   }
+
+   dmt_cl::Print(pmode, info);
+}
+
 rcode wxEDID_Frame::DTD_Ctor_ModeLine() {
    rcode  retU;
    int    tmpi;
@@ -2714,11 +3238,10 @@ rcode wxEDID_Frame::DTD_Ctor_ModeLine() {
 
 rcode wxEDID_Frame::DTD_Ctor_WriteInt(dtd_sct_cl& sct) {
    static const wxString fmsg  = "FAULT: DTD_Ctor_WriteInt()";
-   static       wxString s_oldv;
 
    rcode         retU, retU2;
-   uint          val;
-   wxString      sval;
+   u32_t         val;
+   u32_t         oldv;
    edi_dynfld_t *p_field = sct.field;
 
    if (p_field == NULL) {
@@ -2728,43 +3251,38 @@ rcode wxEDID_Frame::DTD_Ctor_WriteInt(dtd_sct_cl& sct) {
       return retU;
    }
 
-   //read old value
-   s_oldv.Empty();
-   retU = (EDID.*p_field->field.handlerfn)(OP_READ, s_oldv, val, p_field);
+   //binary fast path: the field handlers would format/parse strings
+   retU = dtd_cl::RawRead(p_field->base, sct.fld_idx, oldv);
    if (! RCD_IS_OK(retU)) {
       GLog.PrintRcode(retU); GLog.Show(); return retU;
    }
 
    val = sct.data;
-   GetFullGroupName(edigrp_sel, tmps);
-   tmps << ", " << win_stat_bar->GetStatusText(SBAR_GRPOFFS) << wxLF;
-   tmps << "field changed: " << wxString::FromAscii(p_field->field.name);
-   tmps << ", old value: " << s_oldv;
+   if (val == oldv) RCD_RETURN_OK(retU); //nothing to write
 
-   sval.Empty();
-   retU = (EDID.*p_field->field.handlerfn)(OP_WRINT, sval, val, p_field);
+   retU = dtd_cl::RawWrite(p_field->base, sct.fld_idx, val);
    if (!RCD_IS_OK(retU)) {
       GLog.DoLog(fmsg);
       GLog.PrintRcode(retU);
    }
-   tmps << "\nnew value: " << val;
 
    //re-read p_field -> immediately check the value/revert to last correct value
-   sval.Empty();
-   retU2 = (EDID.*p_field->field.handlerfn)(OP_READ, sval, val, p_field);
+   retU2 = dtd_cl::RawRead(p_field->base, sct.fld_idx, val);
    if (!RCD_IS_OK(retU2)) {
       GLog.DoLog(fmsg);
       GLog.PrintRcode(retU2);
    }
-   sct.SetValue(val);
-   tmps << ", verified value: " << val << wxLF;
-   GLog.DoLog(tmps);
-
-   if (!RCD_IS_OK(retU)) {
-      GLog.DoLog(fmsg);
-      GLog.PrintRcode(retU);
+   if (val != (u32_t) sct.data) {
+      sct.data = val;
+      sct.SetValue(val);
    }
 
+   GetFullGroupName(edigrp_sel, tmps);
+   GLog.slog.Printf("%s, %s\nfield changed: %s, old value: %u, new value: %u\n",
+                    tmps, win_stat_bar->GetStatusText(SBAR_GRPOFFS),
+                    p_field->field.name, oldv, val);
+   GLog.DoLog();
+
    return retU;
 }
 
@@ -2790,18 +3308,18 @@ rcode wxEDID_Frame::DTD_Ctor_read_field(dtd_sct_cl& sct, const edi_grp_cl& group
    uint          val   = 0;
    edi_dynfld_t *p_field = NULL;
 
-   tmps.Empty();
    p_field = group.FieldsAr.Item(idx_field);
    if (p_field == NULL) RCD_RETURN_FAULT(retU);
 
-   retU = (EDID.*p_field->field.handlerfn)(OP_READ, tmps, val, p_field);
+   retU = dtd_cl::RawRead(p_field->base, idx_field, val);
    sct.SetValue(val);
    if (! RCD_IS_OK(retU)) {
       GLog.DoLog("DTD_Ctor_read_field() FAILED.");
       GLog.PrintRcode(retU);
    }
-   sct.field = p_field;
-   sct.data = val;
+   sct.field   = p_field;
+   sct.fld_idx = idx_field;
+   sct.data    = val;
    return retU;
 }
 
@@ -2830,69 +3348,331 @@ rcode wxEDID_Frame::DTD_Ctor_read_all() {
 }
 
 rcode wxEDID_Frame::Reparse() {
-   rcode retU;
-   rcode retU2;
-   bool  err_ignore;
-   u32_t n_extblk;
+   //parse a copy of the buffer in background
+   return ParseStart(PJOB_REPARSE, wxEmptyString);
+}
 
-   GLog.DoLog("Reparse()");
+static const char *parse_stage_msg[] = {
+   "Reading file...",
+   "Verifying checksums...",
+   "Parsing EDID base block...",
+   "Parsing CTA-861 extension block...",
+   "Done."
+};
 
-   RCD_SET_OK(retU2);
+rcode wxEDID_Frame::ParseStart(u32_t job_type, const wxString& fpath, const u8_t *pbuf) {
+   rcode               retU;
+   edid_parser_thr_cl *thr;
 
-   ntbook->SetSelection(0); //go to tree view
+   if (parse_thr != NULL) RCD_RETURN_FAULT(retU);
 
-   if (b_srcgrp_orphaned) delete edigrp_src;
-   edigrp_src = NULL;
-   edigrp_sel = NULL;
+   parse_job ++ ;
+
+   thr = new edid_parser_thr_cl(this, id_parse_thr, parse_job, job_type, EDID, pbuf);
+   if (thr == NULL) RCD_RETURN_FAULT(retU);
+
+   thr->fpath = fpath;
+
+   if (thr->Run() != wxTHREAD_NO_ERROR) {
+      delete thr;
+      RCD_RETURN_FAULT(retU);
+   }
+
+   parse_thr   = thr;
+   parse_stage = PSTAGE_READ;
+
+   //current data is kept until the job is done: block the editor & loaders meanwhile
+   BlockTree   ->Enable(false);
+   BlkDataGrid ->Enable(false);
+   mnu_open_edi->Enable(false);
+   mnu_imphex  ->Enable(false);
+   mnu_reparse ->Enable(false);
+
+   parse_timer.Start(PARSE_DLG_DELAY_MS, wxTIMER_ONE_SHOT);
+
+   RCD_RETURN_OK(retU);
+}
+
+void wxEDID_Frame::ParseEndUI() {
+   parse_timer.Stop();
+
+   if (parse_dlg != NULL) {
+      delete parse_dlg;
+      parse_dlg = NULL;
+   }
+
+   BlockTree   ->Enable(true);
+   mnu_open_edi->Enable(true);
+   mnu_imphex  ->Enable(true);
+}
+
+void wxEDID_Frame::ParseCancel() {
+   if (parse_thr == NULL) return;
+
+   //joinable thread: Delete() waits for the job to stop at next stage boundary.
+   parse_thr->Delete();
+   //partial results are freed by the thread object
+   delete parse_thr;
+   parse_thr = NULL;
+
+   ParseEndUI();
+   //the data was not changed
+   BlkDataGrid->Enable(flags.bits.ctrl_enabled && (edigrp_sel != NULL));
+   mnu_reparse->Enable(flags.bits.data_loadeed);
 
-   err_ignore = EDID.Get_ERR_Ignore();
+   GLog.DoLog("Parser job canceled by user.");
+   DrmMonReload();
+   CorpusLoad();
+}
+
+void wxEDID_Frame::ParseFinish() {
+   rcode               retU;
+   u32_t               job_type;
+   edid_parser_thr_cl *thr;
+
+   thr       = parse_thr;
+   parse_thr = NULL;
+
+   thr->Wait();
+   ParseEndUI();
+
+   job_type = thr->getJobType();
+   retU     = thr->job_rcd;
+
+   //file not loaded: current data is unchanged
+   if (! thr->b_loaded) {
+      BlkDataGrid->Enable(flags.bits.ctrl_enabled && (edigrp_sel != NULL));
+      goto done;
+   }
+
+   if (job_type != PJOB_REPARSE) {
+      //remember last used file path
+      config.last_used_fpath   = thr->fpath;
+      config.b_have_last_fpath = true;
+      flags.bits.data_loadeed  = 1; //allows parsing partially loaded data
+   }
+
+   //apply the results in one step: old groups are released with the BlockTree items
+   ntbook->SetSelection(0); //go to tree view
+   edigrp_sel = NULL;
    dtd_panel->Enable(false);
-   BlkDataGrid->Enable(false);
-   ClearAll(false); //do not clear BlockTree & BlkGrid
+   ClearAll();
 
-   retU = VerifyChksum(EDI_BASE_IDX);
-   if (!RCD_IS_OK(retU)) {
-      if (! err_ignore) return retU;
-      GLog.PrintRcode(retU);
-      retU2 = retU;
+   if (! thr->b_parsed) thr->EDID.DeleteGroups(); //incomplete, only the buffer is taken over
+   EDID.MoveFrom(thr->EDID);
+
+   //faults ignored by the parser: the messages are formatted only for the log
+   diag.Swap(thr->diag);
+   for (u32_t itd=0; itd<diag.Count(); itd++) {
+      diag.Render(itd, tmps);
+      GLog.DoLog(tmps);
+   }
+   if (diag.Dropped() > 0) {
+      tmps.Printf("Parser diagnostics: %u messages dropped.", diag.Dropped());
+      GLog.DoLog(tmps);
    }
 
-   retU = EDID.ParseEDID_Base(n_extblk);
-   if (!RCD_IS_OK(retU)) {
-      if (! err_ignore) return retU;
-      GLog.PrintRcode(retU);
-      retU2 = retU;
+   if (thr->b_parsed) {
+      rcode retU2;
+
+      retU2 = UpdateBlockTree();
+      if (RCD_IS_OK(retU2)) {
+         EnableControl(true);
+      } else {
+         retU = retU2;
+      }
    }
 
-   if (n_extblk > 0) {
-      retU = VerifyChksum(EDI_EXT0_IDX);
-      if (!RCD_IS_OK(retU)) {
-         if (! err_ignore) return retU;
-         GLog.PrintRcode(retU);
-         retU2 = retU;
+   //the snapshots don't reference the groups: the history is kept after reparsing
+   //and after replacing modified data with a DRM connector reload
+   if (drm_keep) {
+      UndoPush("DRM reload");
+   } else {
+      if (job_type != PJOB_REPARSE) undo.Clear();
+      UndoPush((job_type != PJOB_REPARSE) ? "Open" : "Reparse");
+   }
+
+done:
+   drm_keep = false;
+   delete thr;
+   ParseReport(job_type, retU);
+   DrmMonReload();
+   CorpusLoad();
+}
+
+void wxEDID_Frame::DrmMonStart() {
+   rcode           retU;
+   drm_mon_thr_cl *thr;
+
+   if (drm_mon != NULL) return;
+
+   drm_gen ++ ;
+   thr = new drm_mon_thr_cl(this, id_drm_mon, config.drm_root, drm_gen);
+   if (thr == NULL) return;
+
+   retU = thr->Init();
+   if (! RCD_IS_OK(retU)) goto fail;
+
+   if (thr->Run() != wxTHREAD_NO_ERROR) {
+      RCD_SET_FAULT(retU);
+      goto fail;
+   }
+
+   drm_mon = thr;
+   mnu_drm_mon->Check(true);
+   return;
+
+fail:
+   delete thr;
+   mnu_drm_mon->Check(false);
+
+   GLog.DoLog("DRM monitor FAILED.");
+   GLog.PrintRcode(retU);
+   GLog.Show();
+}
+
+void wxEDID_Frame::DrmMonStop() {
+
+   if (drm_mon == NULL) return;
+
+   drm_mon->Stop();
+   drm_mon->Wait();
+   delete drm_mon;
+
+   drm_mon    = NULL;
+   drm_reload = -1;
+   drm_ok     = false;
+   mnu_drm_mon->Check(false);
+}
+
+void wxEDID_Frame::DrmMonReload() {
+   rcode     retU;
+   u32_t     idx;
+   wxString  fpath;
+   edi_buf_t ebuf;
+
+   if (drm_reload < 0  ) return;
+   if (drm_mon == NULL ) return;
+   if (drm_ask         ) return; //answered by the user first
+   if (parse_thr != NULL) return; //parser busy: retried by ParseFinish()
+
+   idx = drm_reload;
+
+   //disconnected: the editor keeps the last data
+   if (! drm_mon->getConnData(idx, ebuf.buff, sizeof(edi_buf_t), fpath)) goto skip;
+   //another file was opened meanwhile
+   if (fpath != config.last_used_fpath) goto skip;
+
+   //modified data: replaced only if the user agrees
+   if (undo.CanUndo() && ! drm_ok) {
+      int  ans;
+
+      tmps.Printf("DRM: %s: EDID changed, the data in the editor is modified.", fpath);
+      GLog.DoLog(tmps);
+
+      drm_ask = true;
+      ans     = wxMessageBox("The EDID of the connector opened in the editor has changed.\n\n"
+                             "Reload it and replace the modified data?\n"
+                             "The modifications can be restored with Undo.",
+                             txt_WARNING, wxYES_NO|wxCENTRE|wxICON_QUESTION);
+      drm_ask = false;
+
+      if (ans != wxYES) {
+         GLog.DoLog("DRM: reload skipped.");
+         goto skip;
       }
+      //the question is not repeated, the data is read again: it could change meanwhile
+      drm_ok = true;
+      DrmMonReload();
+      return;
+   }
 
-      retU = EDID.ParseEDID_CEA();
-      if (!RCD_IS_OK(retU)) {
-         if (err_ignore) {
-            EDID.ForceNumValidBlocks(2);
-            GLog.PrintRcode(retU);
-            retU2 = retU;
-         } else
-         return retU;
+   drm_reload = -1;
+   drm_ok     = false;
+
+   //the edit history is kept: the reload is an undoable step
+   drm_keep = undo.CanUndo();
+
+   retU = ParseStart(PJOB_LOAD_BUF, fpath, ebuf.buff);
+   if (! RCD_IS_OK(retU)) {
+      drm_keep = false;
+      ParseReport(PJOB_OPEN_BIN, retU);
+   }
+   return;
+
+skip:
+   drm_reload = -1;
+   drm_ok     = false;
+}
+
+void wxEDID_Frame::ParseReport(u32_t job_type, rcode retU) {
+
+   if (!RCD_IS_OK(retU)) {
+      if (job_type == PJOB_REPARSE) {
+         GLog.DoLog("Reparse() FAILED.");
+         GLog.PrintRcode(retU);
+         GLog.Show();
+      } else {
+         GLog.PrintRcode(retU);
+
+         if (! EDID.Get_ERR_Ignore()) {
+            tmps = msgF_LOAD;
+            wxMessageBox(tmps, txt_REMARK, wxOK|wxCENTRE|wxICON_INFORMATION);
+         } else {
+            GLog.Show();
+         }
       }
    }
+   mnu_reparse ->Enable(flags.bits.data_loadeed);
+   mnu_assemble->Enable(flags.bits.data_loadeed);
+}
+
+void wxEDID_Frame::evt_parse_thr(wxThreadEvent& evt) {
+   //drop events from canceled jobs
+   if (parse_thr == NULL) return;
+   if (evt.GetExtraLong() != parse_job) return;
+
+   parse_stage = evt.GetInt();
+
+   if (parse_stage >= PSTAGE_DONE) {
+      ParseFinish();
+      return;
+   }
 
-   retU = UpdateBlockTree();
-   if (!RCD_IS_OK(retU)) return retU;
+   if (parse_dlg != NULL) {
+      tmps = wxString::FromAscii(parse_stage_msg[parse_stage]);
+      if (! parse_dlg->Update(parse_stage, tmps)) ParseCancel();
+   }
+}
 
-   EnableControl(true);
-   if (!RCD_IS_OK(retU2)) return retU2;
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void wxEDID_Frame::evt_parse_timer(wxTimerEvent& evt) {
+   if (parse_thr == NULL) return;
+
+   if (parse_dlg == NULL) {
+      //the job takes longer than PARSE_DLG_DELAY_MS: show progress
+      tmps      = wxString::FromAscii(parse_stage_msg[parse_stage]);
+      parse_dlg = new wxProgressDialog("wxEDID: parsing", tmps, PSTAGE_DONE, this,
+                                       wxPD_APP_MODAL|wxPD_CAN_ABORT|wxPD_ELAPSED_TIME);
+      parse_timer.Start(PARSE_POLL_MS);
+      return;
+   }
+   //the dialog reports the cancel button state on update
+   if (! parse_dlg->Update(parse_stage)) ParseCancel();
+}
 
-   RCD_RETURN_OK(retU);
+void wxEDID_Frame::evt_log_timer(wxTimerEvent& evt) {
+   guilog_cl::Flush();
 }
+#pragma GCC diagnostic warning "-Wunused-parameter"
 
 void wxEDID_Frame::ClearAll(bool b_clrBlocks) {
+   DTD_Ctor_Cancel();
+   //groups are deleted: the grid table must be detached in any case
+   BlkDataGrid->ClearGrid();
+   hex_view   ->Clear();
+   srch_pane  ->IndexClear();
+
    EDID.EDI_BaseGrpAr.Empty();
    EDID.EDI_Ext0GrpAr.Empty();
    EDID.EDI_Ext1GrpAr.Empty();
@@ -2910,7 +3690,6 @@ void wxEDID_Frame::ClearAll(bool b_clrBlocks) {
    }
 
    if (b_clrBlocks) {
-      BlkDataGrid->ClearGrid();
       BlockTree->DeleteAllItems();
    }
    BlkDataGrid->Enable(false);
@@ -3008,7 +3787,6 @@ rcode wxEDID_Frame::WriteField() {
    if (!RCD_IS_OK(retU)) {
       GLog.PrintRcode(retU);
    }
-   BlkDataGrid->SetCellValue(row_op, DATGR_COL_VAL, tmps);
    sval << ", verified value: " << tmps;
    GLog.DoLog(sval);
 
@@ -3034,7 +3812,7 @@ rcode wxEDID_Frame::WriteField() {
       if (new_len > blk_free) {
          tmps.Empty();
          tmps << tmpi;
-         BlkDataGrid->SetCellValue(row_op, DATGR_COL_VAL, s_oldv); //restore last value
+         //restore last value
          retU  = (EDID.*p_field->field.handlerfn)(OP_WRINT, s_oldv, u_oldv, p_field);
          if (!RCD_IS_OK(retU)) {
             GLog.PrintRcode(retU);
@@ -3053,7 +3831,6 @@ rcode wxEDID_Frame::WriteField() {
          retU = BlkTreeChangeGrpType(); //spawn new group after tag code change
          if (!RCD_IS_OK(retU)) {
             //restore last value
-            BlkDataGrid->SetCellValue(row_op, DATGR_COL_VAL, s_oldv);
             retU  = (EDID.*p_field->field.handlerfn)(OP_WRINT, s_oldv, u_oldv, p_field);
             RCD_RETURN_OK(retU);
          }
@@ -3213,6 +3990,11 @@ void wxEDID_Frame::AppLayout() {
       tmps = wxString::FromAscii(AUI_DefLayout);
       AuiMgrEDID->LoadPerspective(tmps);
    }
+   //layout saved before the hex view was added: the pane would stay hidden
+   if (! AuiMgrEDID->GetPane(hex_view).IsShown()) {
+      AuiMgrEDID->GetPane(hex_view).Show();
+      AuiMgrEDID->Update();
+   }
 }
 
 
@@ -3265,11 +4047,326 @@ void fgrid_cl::evt_datagrid_vmnu(wxCommandEvent& evt) {
 }
 
 
+u32_t fval_cache_cl::hash(const edi_dynfld_t *p_field, const u8_t *raw, u32_t rawsz) {
+   //FNV-1a: field offset/size/flags + raw data
+   const u8_t *pb;
+   u32_t       hval = 0x811C9DC5;
+
+   pb = reinterpret_cast <const u8_t*> (&p_field->field.offs);
+   for (u32_t itb=0; itb<(4*sizeof(u32_t)); ++itb) { //offs, shift, fldsize, flags
+      hval ^= pb[itb];
+      hval *= 0x01000193;
+   }
+   for (u32_t itb=0; itb<rawsz; ++itb) {
+      hval ^= raw[itb];
+      hval *= 0x01000193;
+   }
+   return (hval & FVC_MASK);
+}
+
+bool fval_cache_cl::Lookup(const edi_dynfld_t *p_field, const u8_t *raw, u32_t rawsz, wxString& sval) {
+   fvc_entry_t *pent;
+
+   if (rawsz == 0) return false;
+
+   pent = &slot[hash(p_field, raw, rawsz)];
+
+   if (! pent->valid          ) return false;
+   if (pent->rawsz != rawsz   ) return false;
+   if (0 != memcmp(pent->raw, raw, rawsz)) return false;
+   if (0 != memcmp(&pent->field, &p_field->field, EDI_FIELD_SZ)) return false;
+
+   sval = pent->sval;
+   return true;
+}
+
+void fval_cache_cl::Store(const edi_dynfld_t *p_field, const u8_t *raw, u32_t rawsz, const wxString& sval) {
+   fvc_entry_t *pent;
+
+   if ((rawsz == 0) || (rawsz > FVC_RAW_MAX)) return;
+
+   pent = &slot[hash(p_field, raw, rawsz)];
+
+   memcpy(&pent->field, &p_field->field, EDI_FIELD_SZ);
+   memcpy( pent->raw  , raw, rawsz);
+   pent->rawsz = rawsz;
+   pent->sval  = sval;
+   pent->valid = true;
+}
+
+void fval_cache_cl::Clear() {
+   for (u32_t its=0; its<FVC_NSLOTS; ++its) {
+      slot[its].valid = false;
+      slot[its].rawsz = 0;
+      slot[its].sval.Empty();
+   }
+}
+
+
+fgrid_tbl_cl::fgrid_tbl_cl(wxEDID_Frame *pframe) :
+   pwin(pframe), pgrp(NULL), nrows(0), ncols(DATGR_NCOL_1), edit_row(-1)
+{
+   wxColour *pcolor[FGATTR_NCOLOR];
+
+   pcolor[FGATTR_INT] = &pwin->grid_color_int;
+   pcolor[FGATTR_BIT] = &pwin->grid_color_bit;
+   pcolor[FGATTR_FLT] = &pwin->grid_color_float;
+   pcolor[FGATTR_HEX] = &pwin->grid_color_hex;
+
+   for (u32_t itc=0; itc<FGATTR_NCOLOR; ++itc) {
+      wxGridCellAttr *attr;
+      //read-write
+      attr = new wxGridCellAttr();
+      attr->SetTextColour(*wxBLACK);
+      attr->SetBackgroundColour(*pcolor[itc]);
+      attr_ar[itc] = attr;
+      //read-only
+      attr = attr->Clone();
+      attr->SetReadOnly(true);
+      attr_ar[itc + FGATTR_NCOLOR] = attr;
+   }
+}
+
+fgrid_tbl_cl::~fgrid_tbl_cl() {
+   for (u32_t ita=0; ita<FGATTR_NATTR; ++ita) {
+      attr_ar[ita]->DecRef();
+   }
+}
+
+edi_dynfld_t* fgrid_tbl_cl::getField(int row) {
+   if (pgrp == NULL) return NULL;
+   if ((row < 0) || (row >= (int) pgrp->FieldsAr.GetCount())) return NULL;
+
+   return pgrp->FieldsAr.Item(row);
+}
+
+u32_t fgrid_tbl_cl::getRawSpan(edi_dynfld_t *p_field, u8_t **pp_raw) {
+   //The handlers can read any byte of the group instance (f.e. DTD fields),
+   //so the whole instance data (from the field base) is used as the cache key.
+   //Sub-groups fields can point to the parent group's instance data.
+   edi_grp_cl *owner;
+   u8_t       *base;
+
+   base    = p_field->base;
+   *pp_raw = base;
+   owner   = pgrp;
+
+   for (u32_t lvl=0; lvl<2; ++lvl) {
+      u8_t  *inst;
+      u32_t  dsz;
+
+      if (owner == NULL) break;
+
+      inst = owner->getInsPtr();
+      if ((base >= inst) && (base < (inst + FVC_RAW_MAX))) {
+         dsz = owner->getTotalSize();
+         if (dsz > FVC_RAW_MAX) dsz = FVC_RAW_MAX;
+         dsz -= (base - inst);
+         if (dsz > FVC_RAW_MAX) return 0; //base beyond data size
+         return dsz;
+      }
+      owner = owner->getParentGrp();
+   }
+   //unknown data span: don't cache
+   return 0;
+}
+
+rcode fgrid_tbl_cl::ReadField(edi_dynfld_t *p_field, wxString& sval) {
+   rcode   retU;
+   u8_t   *raw;
+   u32_t   rawsz;
+   u32_t   ival;
+
+   rawsz = getRawSpan(p_field, &raw);
+
+   if (fvcache.Lookup(p_field, raw, rawsz, sval)) RCD_RETURN_OK(retU);
+
+   sval.Empty();
+   retU = (pwin->EDID.*p_field->field.handlerfn)(OP_READ, sval, ival, p_field);
+   if (!RCD_IS_OK(retU)) {
+      //the failed result is cached too: logged once for the same data
+      pwin->GLog.DoLog("[E!] fgrid_tbl_cl::ReadField(): failed to read field value.");
+      pwin->GLog.PrintRcode(retU);
+      sval = "<error!>";
+   }
+
+   fvcache.Store(p_field, raw, rawsz, sval);
+   return retU;
+}
+
+wxString fgrid_tbl_cl::GetValue(int row, int col) {
+   rcode         retU;
+   edi_dynfld_t *p_field;
+
+   p_field = getField(row);
+   if (p_field == NULL) return wxEmptyString;
+
+   tmps.Empty();
+
+   switch (col) {
+      case DATGR_COL_NAME:
+         tmps = wxString::FromAscii(p_field->field.name);
+         break;
+      case DATGR_COL_TYPE:
+         retU = pwin->EDID.getValTypeName(tmps, p_field->field.flags);
+         if (!RCD_IS_OK(retU)) tmps = "<error!>";
+         break;
+      case DATGR_COL_VAL:
+         if (row == edit_row) return edit_val;
+         ReadField(p_field, tmps);
+         break;
+      case DATGR_COL_UNIT:
+         retU = pwin->EDID.getValUnitName(tmps, p_field->field.flags);
+         if (!RCD_IS_OK(retU)) tmps = "<error!>";
+         if (tmps.IsEmpty()) tmps = "--";
+         break;
+      case DATGR_COL_FLG:
+         retU = pwin->EDID.getValFlagsAsString(tmps, p_field->field.flags);
+         if (!RCD_IS_OK(retU)) tmps = "<error!>";
+         break;
+      //field details
+      case DATGR_COL_OFFS:
+         tmps << p_field->field.offs;
+         break;
+      case DATGR_COL_SHIFT:
+         tmps << p_field->field.shift;
+         break;
+      case DATGR_COL_FSZ:
+         tmps << p_field->field.fldsize;
+         break;
+      default:
+         break;
+   }
+
+   return tmps;
+}
+
+void fgrid_tbl_cl::SetValue(int row, int col, const wxString& sval) {
+   //the value is stored until WriteField() is called from evt_datagrid_write()
+   if (col != DATGR_COL_VAL) return;
+   if (getField(row) == NULL) return;
+
+   edit_row = row;
+   edit_val = sval;
+}
+
+wxString fgrid_tbl_cl::GetColLabelValue(int col) {
+   static const char *col_label[DATGR_NCOL_2] = {
+      "Name", "Type", "Value", "Unit", "Flags", "offs", "shift", "size"
+   };
+
+   if ((col < 0) || (col >= DATGR_NCOL_2)) return wxEmptyString;
+
+   return wxString::FromAscii(col_label[col]);
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+wxGridCellAttr* fgrid_tbl_cl::GetAttr(int row, int col, wxGridCellAttr::wxAttrKind kind) {
+   edi_dynfld_t   *p_field;
+   wxGridCellAttr *attr;
+   u32_t           fflags;
+   u32_t           idx;
+   bool            b_rdonly;
+
+   p_field = getField(row);
+   if (p_field == NULL) return NULL;
+
+   fflags = p_field->field.flags;
+
+   //set row color for type
+   if (fflags & EF_FLT) {
+      idx = FGATTR_FLT;
+   } else if (fflags & EF_HEX) {
+      idx = FGATTR_HEX;
+   } else if (fflags & EF_BIT) {
+      idx = FGATTR_BIT;
+   } else {
+      idx = FGATTR_INT;
+   }
+   //is read-only
+   b_rdonly = true;
+   if (col == DATGR_COL_VAL) {
+      b_rdonly = ((fflags & EF_RD) != 0);
+      if (pwin->EDID.Get_RD_Ignore()) b_rdonly = false;
+   }
+   if (b_rdonly) idx += FGATTR_NCOLOR;
+
+   attr = attr_ar[idx];
+   attr->IncRef();
+   return attr;
+}
+#pragma GCC diagnostic warning "-Wunused-parameter"
+
+void fgrid_tbl_cl::notify_rows(int n_rows) {
+   wxGrid *grid;
+   int     n_old;
+
+   n_old = nrows;
+   nrows = n_rows;
+   grid  = GetView();
+
+   if ((grid == NULL) || (n_rows == n_old)) return;
+
+   if (n_rows > n_old) {
+      wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED, (n_rows - n_old));
+      grid->ProcessTableMessage(msg);
+   } else {
+      wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_DELETED, n_rows, (n_old - n_rows));
+      grid->ProcessTableMessage(msg);
+   }
+}
+
+void fgrid_tbl_cl::notify_cols(int n_cols) {
+   wxGrid *grid;
+   int     n_old;
+
+   n_old = ncols;
+   ncols = n_cols;
+   grid  = GetView();
+
+   if ((grid == NULL) || (n_cols == n_old)) return;
+
+   if (n_cols > n_old) {
+      wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_COLS_APPENDED, (n_cols - n_old));
+      grid->ProcessTableMessage(msg);
+   } else {
+      wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_COLS_DELETED, n_cols, (n_old - n_cols));
+      grid->ProcessTableMessage(msg);
+   }
+}
+
+void fgrid_tbl_cl::SetGroup(edi_grp_cl *grp) {
+   wxGrid *grid;
+   int     n_rows;
+
+   pgrp     = grp;
+   edit_row = -1;
+   n_rows   = (grp == NULL) ? 0 : grp->FieldsAr.GetCount();
+
+   notify_rows(n_rows);
+
+   grid = GetView();
+   if (grid != NULL) grid->ForceRefresh();
+}
+
+void fgrid_tbl_cl::DetachGroup(edi_grp_cl *grp) {
+   if (pgrp == NULL) return;
+
+   if ((pgrp == grp) || (pgrp->getParentGrp() == grp)) {
+      SetGroup(NULL);
+   }
+}
+
+void fgrid_tbl_cl::SetDetails(bool b_details) {
+   notify_cols(b_details ? DATGR_NCOL_2 : DATGR_NCOL_1);
+}
+
+
 wxBEGIN_EVENT_TABLE( dtd_screen_cl, wxPanel   )
     EVT_PAINT      ( dtd_screen_cl::evt_paint )
 wxEND_EVENT_TABLE()
 
-void dtd_screen_cl::scr_aspect_ratio(wxSize& dcsize, wxPaintDC& dc) {
+void dtd_screen_cl::scr_aspect_ratio(wxSize& dcsize, wxDC& dc) {
    float  faspHV;
    bool   b_scaling_to_dc_Y;
 
@@ -3389,7 +4486,7 @@ rcode dtd_screen_cl::calc_coords(wxSize& dcsize) {
    RCD_RETURN_OK(retU);
 }
 
-void dtd_screen_cl::scr_area_str(wxPaintDC& dc) {
+void dtd_screen_cl::scr_area_str(wxDC& dc) {
 
    {  //active area size to string
       int  Xres, Yres, tmpi;
@@ -3445,17 +4542,53 @@ void dtd_screen_cl::scr_area_str(wxPaintDC& dc) {
 
 }
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-void dtd_screen_cl::evt_paint(wxPaintEvent& evt){
-   rcode     retU;
-   wxPaintDC dc(this);
-   wxSize    dcsize = dc.GetSize();
-   wxBrush   bgbrush(*wxMEDIUM_GREY_BRUSH);
+bool dtd_screen_cl::geom_changed(const wxSize& dcsize) {
+   int geom[SCR_GEOM_NVAL];
+
+   geom[SCR_GEOM_DCX]    = dcsize.x;
+   geom[SCR_GEOM_DCY]    = dcsize.y;
+   geom[SCR_GEOM_ENB]    = IsEnabled();
+   geom[SCR_GEOM_ASP]    = pwin->b_dtd_keep_aspect;
+   geom[SCR_GEOM_SCT   ] = pwin->sct_xres   ->data;
+   geom[SCR_GEOM_SCT +1] = pwin->sct_hblank ->data;
+   geom[SCR_GEOM_SCT +2] = pwin->sct_hsoffs ->data;
+   geom[SCR_GEOM_SCT +3] = pwin->sct_hswidth->data;
+   geom[SCR_GEOM_SCT +4] = pwin->sct_hborder->data;
+   geom[SCR_GEOM_SCT +5] = pwin->sct_vres   ->data;
+   geom[SCR_GEOM_SCT +6] = pwin->sct_vblank ->data;
+   geom[SCR_GEOM_SCT +7] = pwin->sct_vsoffs ->data;
+   geom[SCR_GEOM_SCT +8] = pwin->sct_vswidth->data;
+   geom[SCR_GEOM_SCT +9] = pwin->sct_vborder->data;
+
+   if (b_bmp_ok && (0 == memcmp(geom, scr_geom, sizeof(scr_geom)))) return false;
+
+   memcpy(scr_geom, geom, sizeof(scr_geom));
+   return true;
+}
+
+void dtd_screen_cl::render(wxSize dcsize) {
+   rcode      retU;
+   wxMemoryDC dc;
+   wxBrush    bgbrush(*wxMEDIUM_GREY_BRUSH);
+
+   b_bmp_ok = false;
+
+   if ((dcsize.x <= 0) || (dcsize.y <= 0)) return;
+
+   if ((! bmp_cache.IsOk()) || (bmp_cache.GetSize() != dcsize)) {
+      if (! bmp_cache.Create(dcsize.x, dcsize.y)) return;
+   }
+
+   dc.SelectObject(bmp_cache);
+   dc.SetBackground(wxBrush(GetBackgroundColour()));
+   dc.Clear();
+
+   b_bmp_ok = true;
 
    if (!IsEnabled()) {
       dc.SetBrush(bgbrush);
       dc.DrawRectangle(0, 0, dcsize.x, dcsize.y);
-      return;
+      goto done;
    }
 
    if (pwin->b_dtd_keep_aspect) {
@@ -3464,9 +4597,9 @@ void dtd_screen_cl::evt_paint(wxPaintEvent& evt){
 
    retU = calc_coords(dcsize);
    if (! RCD_IS_OK(retU)) {
-      pwin->GLog.DoLog("dtd_screen:evt_paint():calc_coords() FAILED.");
+      pwin->GLog.DoLog("dtd_screen:render():calc_coords() FAILED.");
       pwin->GLog.PrintRcode(retU);
-      return;
+      goto done;
    }
 
    //background
@@ -3518,6 +4651,24 @@ void dtd_screen_cl::evt_paint(wxPaintEvent& evt){
                        szVborder.x,
                        szVborder.y);
    }
+
+done:
+   dc.SelectObject(wxNullBitmap);
+}
+
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void dtd_screen_cl::evt_paint(wxPaintEvent& evt){
+   wxPaintDC dc(this);
+   wxSize    dcsize = GetClientSize();
+
+   //the screen is re-rendered only if the geometry has changed
+   if (geom_changed(dcsize)) {
+      render(dcsize);
+   }
+
+   if (b_bmp_ok) {
+      dc.DrawBitmap(bmp_cache, 0, 0, false);
+   }
 }
 #pragma GCC diagnostic warning "-Wunused-parameter"
 
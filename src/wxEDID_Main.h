@@ -33,10 +33,23 @@
 #include "rcode/rcode.h"
 #include "EDID_class.h"
 #include "guilog.h"
+#include "parse_thr.h"
+#include "corpus.h"
+#include "drm_mon.h"
+#include "undo.h"
+#include "dmt.h"
+#include "modelist.h"
+#include "pnp_id.h"
+#include "colorim.h"
+#include "hexview.h"
+#include "search.h"
 
 #include <wx/menu.h>
 #include <wx/dcclient.h>
+#include <wx/dcmemory.h>
 #include <wx/bitmap.h>
+#include <wx/timer.h>
+#include <wx/progdlg.h>
 
 //config
 typedef struct {
@@ -47,17 +60,39 @@ typedef struct {
    bool     b_cmd_txt_file;
    bool     b_cmd_ignore_err;
    bool     b_cmd_ignore_rd;
+   bool     b_cmd_drm_mon;
+   bool     b_batch;      //batch decoder: no GUI
+   long     batch_threads; //0: auto
+   long     batch_qdepth;  //0: default
+   wxString batch_dir;
+   wxString batch_out;    //empty: stdout
+   bool     b_read_bench; //batch_dir: compare the file readers, no decoding
+   bool     b_scaling;    //batch_dir: decode with 1, 2, 4 .. N workers, files/s only
+   bool     b_scan_image; //batch: EDIDs embedded in a firmware image
+   wxString scan_image;
+   bool     b_synth;      //batch: generate EDIDs from a spec file
+   wxString synth_spec;
+   long     synth_count;
+   long     synth_seed;
+   bool     b_patch;      //batch: field edits applied to batch_dir, written to batch_out
+   wxString patch_file;
+   bool     b_splice;     //batch: template groups spliced into batch_dir, written to batch_out
+   wxString splice_tmpl;
+   wxString splice_groups; //group code names, empty: all data blocks
+   bool     b_color_rank; //batch_dir: EDIDs ranked by the color gamut & HDR luminance, no decoding
    bool     b_have_layout;
    wxString cmd_open_file_path;
    wxString last_used_fpath;
    wxString last_used_fname;
    wxString aui_layout;
+   wxString drm_root; //sysfs DRM class dir, can be a copy for tests
    wxPoint  win_pos;
    wxSize   win_size;
 } config_t;
 
 class blktree_cl;
 class fgrid_cl;
+class fgrid_tbl_cl;
 class dtd_sct_cl;
 class dtd_screen_cl;
 
@@ -82,6 +117,15 @@ enum { //status bar field idx
    SBAR_GRPOFFS = 1
 };
 
+enum { //DTD constructor: spin events are applied once per frame
+   DTD_FRAME_MS = 16
+};
+
+enum { //background parser: progress dialog is shown only for long jobs
+   PARSE_DLG_DELAY_MS = 250,
+   PARSE_POLL_MS      = 100
+};
+
 typedef union main_flags_u {
    u32_t u32;
    struct {
@@ -112,6 +156,7 @@ typedef union op_flags_u {
 
 class wxEDID_Frame: public wxFrame {
     friend class dtd_screen_cl;
+    friend class fgrid_tbl_cl;
 
     public:
         rcode OpenEDID();
@@ -125,20 +170,33 @@ class wxEDID_Frame: public wxFrame {
         rcode UpdateBlockTree();
         rcode UpdateDataGrid(edi_grp_cl* edigrp);
         void  DataGrid_ChangeView();
-        rcode UpdateDataGridRow(int nrow, edi_dynfld_t *field);
 
         rcode DTD_Ctor_Recalc();
         rcode DTD_Ctor_read_field(dtd_sct_cl& sct, const edi_grp_cl& group, u32_t idx_field);
         rcode DTD_Ctor_read_all();
         rcode DTD_Ctor_ModeLine();
         rcode DTD_Ctor_WriteInt(dtd_sct_cl& sct);
+        void  DTD_Ctor_Update(int evtid);
+        void  DTD_Ctor_Flush();
+        void  DTD_Ctor_Cancel();
 
         rcode SetFieldDesc(int row);
+        void  GetFieldTiming(int row, wxString& info);
         rcode WriteField();
 
         rcode VerifyChksum(uint block);
         rcode CalcVerifyChksum(uint block);
         rcode Reparse();
+        rcode ParseStart (u32_t job_type, const wxString& fpath, const u8_t *pbuf = NULL);
+        void  ParseCancel();
+        void  ParseFinish();
+        void  ParseEndUI ();
+        void  ParseReport(u32_t job_type, rcode retU);
+
+        void  DrmMonStart ();
+        void  DrmMonStop  ();
+        void  DrmMonReload();
+        void  CorpusLoad  ();
 
         void  AppLayout();
         void  ClearAll(bool b_clrBlocks = true);
@@ -152,6 +210,12 @@ class wxEDID_Frame: public wxFrame {
                 void  BlkTreeDelGrp(edi_grp_cl* pgrp);
                 void  BlkTreeUpdateGrp();
                 rcode BlkTreeChangeGrpType();
+                void  SelectField(edi_grp_cl* pgrp, i32_t fidx);
+
+        void  UndoPush    (const wxString& op);
+        void  UndoUpdateUI();
+        void  UndoDelGrp  (edi_grp_cl* pgrp);
+        rcode UndoRestore (undo_snap_cl *psnap);
 
         wxEDID_Frame(wxWindow* parent, wxWindowID id = -1);
         ~wxEDID_Frame();
@@ -196,6 +260,8 @@ class wxEDID_Frame: public wxFrame {
         int           subg_idx;          //index of selected subgroup: restore selection after reparse/re-init
         op_flags_t    opFlags;
 
+        fgrid_tbl_cl *grid_tbl; //virtual table for BlkDataGrid, owned by the grid
+
         int           row_sel;
         int           row_op;
 
@@ -203,6 +269,36 @@ class wxEDID_Frame: public wxFrame {
         bool          b_dtd_keep_aspect;
         int           dtd_Htotal; //for DTD aspect ratio calculations, updated by evt_dtdctor_sct()
         int           dtd_Vtotal;
+        wxTimer       dtd_timer;  //coalescing of spin events: one write & recalc per frame
+        int           dtd_sct_pend; //id of spin control with pending update, wxID_NONE: none
+
+        edid_parser_thr_cl *parse_thr;   //background parser, NULL: idle
+        long                parse_job;   //id of the current parser job
+        u32_t               parse_stage; //last reported PSTAGE_*
+        wxTimer             parse_timer; //delayed progress dialog, polling of the cancel button
+        wxProgressDialog   *parse_dlg;
+
+        wxTimer             log_timer;   //async log: queued messages are written in batches
+
+        corpus_list_cl     *corpus_list; //corpus browser pane
+        long                corpus_pend; //row selected while the parser was busy, -1: none
+        hexview_cl         *hex_view;    //raw bytes of the blocks, byte -> field
+        srch_pane_cl       *srch_pane;   //search box + results
+
+        drm_mon_thr_cl     *drm_mon;     //DRM connectors monitor, NULL: stopped
+        long                drm_reload;  //connector to reload when the parser is idle, -1: none
+        u32_t               drm_gen;     //current monitor: events of the stopped ones are dropped
+        bool                drm_ask;     //reload question shown: nested events are left pending
+        bool                drm_ok;      //pending reload confirmed by the user
+        bool                drm_keep;    //running parser job replaces modified data: keep the edit history
+        wxMenuItem         *mnu_drm_mon;
+
+        undo_stack_cl       undo;        //edit history
+        diag_list_cl        diag;        //faults ignored by the last parser job
+        modelist_cl         modes;       //timings from all the sources, merged
+        wxMenu             *mnu_edit;
+        wxMenuItem         *mnu_undo;
+        wxMenuItem         *mnu_redo;
 
         //(*Handlers(wxEDID_Frame)
         //*)
@@ -215,6 +311,7 @@ class wxEDID_Frame: public wxFrame {
         void evt_reparse            (wxCommandEvent    & evt);
         void evt_assemble_edid      (wxCommandEvent    & evt);
         void evt_log_win            (wxCommandEvent    & evt);
+        void evt_mode_list          (wxCommandEvent    & evt);
         void evt_dtd_asp            (wxCommandEvent    & evt);
         void evt_blk_fdetails       (wxCommandEvent    & evt);
         void evt_open_edid_bin      (wxCommandEvent    & evt);
@@ -222,16 +319,29 @@ class wxEDID_Frame: public wxFrame {
         void evt_save_report        (wxCommandEvent    & evt);
         void evt_export_hex         (wxCommandEvent    & evt);
         void evt_import_hex         (wxCommandEvent    & evt);
+        void evt_open_dir           (wxCommandEvent    & evt);
+        void evt_open_arch          (wxCommandEvent    & evt);
+        void evt_scan_image         (wxCommandEvent    & evt);
+        void evt_corpus_sel         (wxListEvent       & evt);
+        void evt_drm_mon_toggle     (wxCommandEvent    & evt);
+        void evt_drm_mon            (wxThreadEvent     & evt);
         void evt_blktree_sel        (wxTreeEvent       & evt);
         void evt_blktree_rmb        (wxTreeEvent       & evt);
         void evt_blktree_key        (wxTreeEvent       & evt);
         void evt_blktree_focus      (wxFocusEvent      & evt) {evt.Skip(false);};
         void evt_datagrid_select    (wxGridEvent       & evt);
+        void evt_hexview_sel        (wxCommandEvent    & evt);
+        void evt_find               (wxCommandEvent    & evt);
+        void evt_srch_sel           (wxListEvent       & evt);
         void evt_datagrid_vsel      (wxGridEvent       & evt); //show value selector menu
         void evt_datagrid_edit_hide (wxGridEvent       & evt);
         void evt_datagrid_write     (wxGridEvent       & evt);
         void evt_ntbook_page        (wxAuiNotebookEvent& evt);
         void evt_dtdctor_sct        (wxSpinEvent       & evt);
+        void evt_dtd_timer          (wxTimerEvent      & evt);
+        void evt_parse_thr          (wxThreadEvent     & evt);
+        void evt_parse_timer        (wxTimerEvent      & evt);
+        void evt_log_timer          (wxTimerEvent      & evt);
         void evt_Deferred           (wxCommandEvent    & evt);
 
         void evt_blktree_reparse    (wxCommandEvent    & evt);
@@ -241,6 +351,7 @@ class wxEDID_Frame: public wxFrame {
         void evt_blktree_delete     (wxCommandEvent    & evt);
         void evt_blktree_insert     (wxCommandEvent    & evt);
         void evt_blktree_move       (wxCommandEvent    & evt);
+        void evt_undo               (wxCommandEvent    & evt); //wxID_UNDO, wxID_REDO
 
         //(* Identifiers(wxEDID_Frame)
         static const long id_block_tree;
@@ -330,10 +441,25 @@ class wxEDID_Frame: public wxFrame {
         static const long id_win_stat_bar;
         //*)
         static const long id_app_layout;
+        static const long id_dtd_timer;
+        static const long id_parse_thr;
+        static const long id_parse_timer;
+        static const long id_log_timer;
+        static const long id_mnu_opendir;
+        static const long id_mnu_openarch;
+        static const long id_mnu_fwscan;
+        static const long id_corpus_list;
+        static const long id_mnu_drm_mon;
+        static const long id_drm_mon;
         static const long id_mnu_info;
         static const long id_mnu_ins_up;
         static const long id_mnu_ins_dn;
         static const long id_mnu_ins_in;
+        static const long id_mnu_modes;
+        static const long id_hex_view;
+        static const long id_srch_pane;
+        static const long id_srch_list;
+        static const long id_mnu_find;
 
         //(* Declarations(wxEDID_Frame)
         dtd_screen_cl* dtd_screen;
@@ -476,18 +602,110 @@ class fgrid_cl : public wxGrid {
    wxDECLARE_EVENT_TABLE();
 };
 
+//formatted field values cache: the key is the field descriptor + raw instance data
+enum {
+   FVC_NSLOTS  = 256,
+   FVC_MASK    = (FVC_NSLOTS -1),
+   FVC_RAW_MAX = 32  //sizeof(edi_grp_cl::inst_data)
+};
+
+typedef struct {
+   edi_field_t  field;
+   u8_t         raw[FVC_RAW_MAX];
+   u32_t        rawsz;
+   bool         valid;
+   wxString     sval;
+} fvc_entry_t;
+
+class fval_cache_cl {
+   private:
+      fvc_entry_t  slot[FVC_NSLOTS];
+
+      u32_t  hash  (const edi_dynfld_t *p_field, const u8_t *raw, u32_t rawsz);
+
+   public:
+      bool   Lookup(const edi_dynfld_t *p_field, const u8_t *raw, u32_t rawsz, wxString& sval);
+      void   Store (const edi_dynfld_t *p_field, const u8_t *raw, u32_t rawsz, const wxString& sval);
+      void   Clear ();
+
+   fval_cache_cl() {Clear();};
+};
+
+enum { //BlkDataGrid row attributes: bg color * read-only
+   FGATTR_INT = 0,
+   FGATTR_BIT,
+   FGATTR_FLT,
+   FGATTR_HEX,
+   FGATTR_NCOLOR,
+   FGATTR_NATTR = (FGATTR_NCOLOR *2)
+};
+
+//BlkDataGrid virtual table: cells are rendered on demand from edi_grp_cl::FieldsAr
+class fgrid_tbl_cl : public wxGridTableBase {
+   private:
+      wxEDID_Frame   *pwin;
+      edi_grp_cl     *pgrp;
+      int             nrows;
+      int             ncols;
+      int             edit_row; //value written by the cell editor, not yet processed by WriteField()
+      wxString        edit_val;
+      wxString        tmps;
+      fval_cache_cl   fvcache;
+      wxGridCellAttr *attr_ar[FGATTR_NATTR];
+
+      edi_dynfld_t*   getField   (int row);
+      u32_t           getRawSpan (edi_dynfld_t *p_field, u8_t **pp_raw);
+      void            notify_rows(int n_rows);
+      void            notify_cols(int n_cols);
+
+   public:
+      int             GetNumberRows() {return nrows;};
+      int             GetNumberCols() {return ncols;};
+      bool            IsEmptyCell  (int , int ) {return false;};
+      wxString        GetValue     (int row, int col);
+      void            SetValue     (int row, int col, const wxString& sval);
+      wxString        GetColLabelValue(int col);
+      bool            CanHaveAttributes() {return true;};
+      wxGridCellAttr* GetAttr      (int row, int col, wxGridCellAttr::wxAttrKind kind);
+      void            Clear        () {SetGroup(NULL);};
+
+      rcode           ReadField    (edi_dynfld_t *p_field, wxString& sval);
+      void            SetGroup     (edi_grp_cl *grp);
+      void            DetachGroup  (edi_grp_cl *grp);
+      void            SetDetails   (bool b_details);
+      inline void     ClearEditVal () {edit_row = -1;};
+      inline edi_grp_cl* GetGroup  () {return pgrp;};
+
+   fgrid_tbl_cl(wxEDID_Frame *pframe);
+   ~fgrid_tbl_cl();
+};
+
+enum { //dtd_screen_cl: geometry values for the cached bitmap
+   SCR_GEOM_DCX = 0,
+   SCR_GEOM_DCY,
+   SCR_GEOM_ENB,
+   SCR_GEOM_ASP,
+   SCR_GEOM_SCT, //spin controls data: 10 values
+   SCR_GEOM_NVAL = (SCR_GEOM_SCT + 10)
+};
+
 class dtd_screen_cl : public wxPanel {
    private:
       wxColour cScrArea, cHsync, cVsync, cSandC, cResStr;
       wxRect   rcHsync, rcVsync, rcScreen;
       wxSize   szHborder, szVborder;
       wxString tmps;
+      wxBitmap bmp_cache; //pre-rendered screen, re-rendered only on geometry change
+      int      scr_geom[SCR_GEOM_NVAL];
+      bool     b_bmp_ok;
 
       wxEDID_Frame *pwin;
 
-      void    scr_aspect_ratio(wxSize& dcsize, wxPaintDC& dc);
+      void    scr_aspect_ratio(wxSize& dcsize, wxDC& dc);
       rcode   calc_coords     (wxSize& dcsize);
-      void    scr_area_str    (wxPaintDC& dc);
+      void    scr_area_str    (wxDC& dc);
+      bool    geom_changed    (const wxSize& dcsize);
+      void    render          (wxSize dcsize);
       void    evt_paint       (wxPaintEvent& event);
 
    public:
@@ -511,6 +729,10 @@ class dtd_screen_cl : public wxPanel {
                rcVsync   = rcHsync;
                rcScreen  = rcHsync;
 
+               b_bmp_ok  = false;
+               memset(scr_geom, 0, sizeof(scr_geom));
+               //the whole area is painted from bmp_cache
+               SetBackgroundStyle(wxBG_STYLE_PAINT);
             };
 
    wxDECLARE_EVENT_TABLE();
@@ -519,6 +741,7 @@ class dtd_screen_cl : public wxPanel {
 class dtd_sct_cl : public wxSpinCtrl {
    public:
       edi_dynfld_t *field;
+      u32_t         fld_idx; //DTD_IDX_*
       int           data;
 
    dtd_sct_cl(wxWindow* parent, wxWindowID id = -1, const wxString& value = wxEmptyString,
@@ -527,8 +750,9 @@ class dtd_sct_cl : public wxSpinCtrl {
               const wxString& name = "wxSpinCtrl") :
               wxSpinCtrl(parent, id, value, pos, size, style, min, max, initial, name)
             {
-               data  = 0;
-               field = NULL;
+               data    = 0;
+               fld_idx = 0;
+               field   = NULL;
             };
 };
 